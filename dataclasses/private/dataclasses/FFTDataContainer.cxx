@@ -6,6 +6,8 @@
 #include <serialization/nvp.hpp>
 #include <serialization/complex.hpp>
 
+#include <map>
+
 #include <dataclasses/fft/FFTDataContainer.h>
 #include <dataclasses/fft/FFTWPlan.h>
 
@@ -132,14 +134,11 @@ FFTDataContainer<I3Position, I3ComplexVector>::UpdateTimeSeries() {
     complexData[2][i] = frequencySpectrum_[i].GetZ() * frequencySpectrum_.GetBinning();
   }
 
-  FFTWPlan plan(nComp, fft::eC2R); //Make FFTW plan
-
-  //Do the FFT for each dimension
-  for (unsigned int i = 0; i < 3; i++) {
-    plan.CopyIntoPlanC(&complexData[i][0], nComp);
-    plan.ExecutePlan();  //Actually do the FFT
-    plan.CopyOutOfPlan(&realData[i][0]);  //Copy the result out of the fft
-  }
+  //Do the FFT for all three dimensions in one batch
+  FFTWPlan plan(nComp, fft::eC2R, FFTW_BACKWARD, FFTW_MEASURE, 3); //Make FFTW plan
+  plan.CopyIntoPlanC(complexData.data(), 3 * nComp);
+  plan.ExecutePlan();  //Actually do the FFT
+  plan.CopyOutOfPlan(realData.data());  //Copy the result out of the fft
 
   //Convert from array to I3Position
   for (unsigned int i = 0; i < nReal; i++) {
@@ -186,14 +185,11 @@ void FFTDataContainer<I3Position, I3ComplexVector>::UpdateFrequencySpectrum() {
     realData[2][i] = timeSeries_[i].GetZ() * timeSeries_.GetBinning();
   }
 
-  FFTWPlan plan(nReal, fft::eR2C); //Make FFTW plan
-
-  //Do the FFT for each dimension
-  for (unsigned int i = 0; i < 3; i++) {
-    plan.CopyIntoPlan(&realData[i][0], nReal);
-    plan.ExecutePlan();  //Actually do the FFT
-    plan.CopyOutOfPlanC(&complexData[i][0]);  //Copy the result out of the fft
-  }
+  //Do the FFT for all three dimensions in one batch
+  FFTWPlan plan(nReal, fft::eR2C, FFTW_FORWARD, FFTW_MEASURE, 3); //Make FFTW plan
+  plan.CopyIntoPlan(realData.data(), 3 * nReal);
+  plan.ExecutePlan();  //Actually do the FFT
+  plan.CopyOutOfPlanC(complexData.data());  //Copy the result out of the fft
 
   //Convert from array to vector
   for (unsigned int i = 0; i < nComp; i++) {
@@ -208,6 +204,120 @@ void FFTDataContainer<I3Position, I3ComplexVector>::UpdateFrequencySpectrum() {
   upToDateDomain_ = Both;
 }
 
+/////////////////////////////////////////////////
+///////Batched transforms of many containers/////
+/////////////////////////////////////////////////
+
+//Containers with traces of equal length are transformed together with one
+//batched fftw plan. Anything unusual (empty or odd-length traces, a single
+//trace of its length) goes through the one-at-a-time update, which also
+//takes care of the warnings.
+
+template<>
+void FFTDataContainer<double, std::complex<double>>::UpdateAllFrequencySpectra(const std::vector<FFTData*>& containers) {
+  std::map<unsigned int, std::vector<FFTData*> > groups;
+  for (FFTData* data : containers) {
+    if (data->upToDateDomain_ != Time)
+      continue;
+    const unsigned int nReal = data->timeSeries_.GetSize();
+    if (nReal == 0 || nReal % 2 || std::isnan(data->timeSeries_.GetBinning()))
+      data->UpdateFrequencySpectrum();
+    else
+      groups[nReal].push_back(data);
+  }
+
+  for (const auto& group : groups) {
+    const unsigned int nReal = group.first;
+    const unsigned int nComp = fft::GetNCFromNR(nReal);
+    const unsigned int howMany = group.second.size();
+    if (howMany == 1) {
+      group.second.front()->UpdateFrequencySpectrum();
+      continue;
+    }
+
+    array2d<double> realData(howMany, nReal);
+    array2d<std::complex<double>> complexData(howMany, nComp);
+    for (unsigned int j = 0; j < howMany; j++) {
+      const I3AntennaWaveform<double>& trace = group.second[j]->timeSeries_;
+      for (unsigned int i = 0; i < nReal; i++)
+        realData[j][i] = trace[i] * trace.GetBinning();
+    }
+
+    FFTWPlan plan(nReal, fft::eR2C, FFTW_FORWARD, FFTW_MEASURE, howMany); //Make FFTW plan
+    plan.CopyIntoPlan(realData.data(), howMany * nReal);
+    plan.ExecutePlan();  //Actually do the FFT
+    plan.CopyOutOfPlanC(complexData.data());  //Copy the result out of the fft
+
+    for (unsigned int j = 0; j < howMany; j++) {
+      FFTData& data = *group.second[j];
+      data.frequencySpectrum_.CopyIntoTrace(complexData[j], nComp);
+      data.frequencySpectrum_.SetBinning(0.5 / data.timeSeries_.GetBinning() / (double(nComp) - 1));
+      data.upToDateDomain_ = Both;
+    }
+  }
+}
+
+template<>
+void FFTDataContainer<double, std::complex<double>>::UpdateAllTimeSeries(const std::vector<FFTData*>& containers) {
+  std::map<unsigned int, std::vector<FFTData*> > groups;
+  for (FFTData* data : containers) {
+    if (data->upToDateDomain_ != Frequency)
+      continue;
+    const unsigned int nComp = data->frequencySpectrum_.GetSize();
+    if (nComp == 0 || std::isnan(data->frequencySpectrum_.GetBinning()))
+      data->UpdateTimeSeries();
+    else
+      groups[nComp].push_back(data);
+  }
+
+  for (const auto& group : groups) {
+    const unsigned int nComp = group.first;
+    const unsigned int nReal = fft::GetNRFromNC(nComp);
+    const unsigned int howMany = group.second.size();
+    if (howMany == 1) {
+      group.second.front()->UpdateTimeSeries();
+      continue;
+    }
+
+    array2d<double> realData(howMany, nReal);
+    array2d<std::complex<double>> complexData(howMany, nComp);
+    for (unsigned int j = 0; j < howMany; j++) {
+      const I3AntennaWaveform<std::complex<double>>& spectrum = group.second[j]->frequencySpectrum_;
+      for (unsigned int i = 0; i < nComp; i++)
+        complexData[j][i] = spectrum[i] * spectrum.GetBinning();
+    }
+
+    FFTWPlan plan(nComp, fft::eC2R, FFTW_BACKWARD, FFTW_MEASURE, howMany); //Make FFTW plan
+    plan.CopyIntoPlanC(complexData.data(), howMany * nComp);
+    plan.ExecutePlan();  //Actually do the FFT
+    plan.CopyOutOfPlan(realData.data());  //Copy the result out of the fft
+
+    for (unsigned int j = 0; j < howMany; j++) {
+      FFTData& data = *group.second[j];
+      data.timeSeries_.CopyIntoTrace(realData[j], nReal);
+      data.timeSeries_.SetBinning(1. / data.frequencySpectrum_.GetBinning() / nReal);
+      data.upToDateDomain_ = Both;
+    }
+  }
+}
+
+//The three dimensions of a single container are already batched
+template<>
+void FFTDataContainer<I3Position, I3ComplexVector>::UpdateAllFrequencySpectra(const std::vector<FFTData3D*>& containers) {
+  for (FFTData3D* data : containers) {
+    if (data->upToDateDomain_ == Time)
+      data->UpdateFrequencySpectrum();
+  }
+}
+
+template<>
+void FFTDataContainer<I3Position, I3ComplexVector>::UpdateAllTimeSeries(const std::vector<FFTData3D*>& containers) {
+  for (FFTData3D* data : containers) {
+    if (data->upToDateDomain_ == Frequency)
+      data->UpdateTimeSeries();
+  }
+}
+
 template<typename T, typename F>
 template <class Archive>
 void FFTDataContainer<T, F>::serialize(Archive& ar, unsigned version) {
@@ -4,4 +4,25 @@
 
 #include <dataclasses/I3AntennaDataMap.h>
 
+namespace {
+
+std::vector<FFTData*> CollectFFTData(I3AntennaDataMap& data) {
+  std::vector<FFTData*> containers;
+  for (I3AntennaDataMap::value_type& antenna : data) {
+    for (I3AntennaChannelMap::value_type& channel : antenna.second)
+      containers.push_back(&channel.second.GetFFTData());
+  }
+  return containers;
+}
+
+}
+
+void fft::UpdateAllFrequencySpectra(I3AntennaDataMap& data) {
+  FFTData::UpdateAllFrequencySpectra(CollectFFTData(data));
+}
+
+void fft::UpdateAllTimeSeries(I3AntennaDataMap& data) {
+  FFTData::UpdateAllTimeSeries(CollectFFTData(data));
+}
+
 I3_SERIALIZABLE(I3AntennaDataMap);
@@ -0,0 +1,178 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <icetray/serialization.h>
+#include <dataclasses/I3GCDDelta.h>
+
+// I3GeometryDelta
+
+I3GeometryDelta::I3GeometryDelta() :
+  snowHeightProvenance(I3Geometry::Unknown) {}
+
+I3GeometryDelta::I3GeometryDelta(const I3Geometry& base, const I3Geometry& current) :
+  omgeo(base.omgeo, current.omgeo),
+  stationgeo(base.stationgeo, current.stationgeo),
+  scintgeo(base.scintgeo, current.scintgeo),
+  antennageo(base.antennageo, current.antennageo),
+  iceactgeo(base.iceactgeo, current.iceactgeo),
+  snowHeightProvenance(current.snowHeightProvenance),
+  startTime(current.startTime),
+  endTime(current.endTime)
+{}
+
+I3GeometryDelta::~I3GeometryDelta() {}
+
+I3GeometryPtr
+I3GeometryDelta::Apply(const I3Geometry& base) const
+{
+  I3GeometryPtr geometry(new I3Geometry(base));
+  omgeo.Apply(geometry->omgeo);
+  stationgeo.Apply(geometry->stationgeo);
+  scintgeo.Apply(geometry->scintgeo);
+  antennageo.Apply(geometry->antennageo);
+  iceactgeo.Apply(geometry->iceactgeo);
+  geometry->snowHeightProvenance = snowHeightProvenance;
+  geometry->startTime = startTime;
+  geometry->endTime = endTime;
+  return geometry;
+}
+
+bool
+I3GeometryDelta::operator==(const I3GeometryDelta& rhs) const
+{
+  return (omgeo == rhs.omgeo &&
+          stationgeo == rhs.stationgeo &&
+          scintgeo == rhs.scintgeo &&
+          antennageo == rhs.antennageo &&
+          iceactgeo == rhs.iceactgeo &&
+          snowHeightProvenance == rhs.snowHeightProvenance &&
+          startTime == rhs.startTime &&
+          endTime == rhs.endTime);
+}
+
+template <class Archive>
+void
+I3GeometryDelta::serialize(Archive& ar, unsigned version)
+{
+  if (version > i3geometrydelta_version_)
+    log_fatal("Attempting to read version %u from file but running version %u of I3GeometryDelta class.",
+              version, i3geometrydelta_version_);
+
+  ar & make_nvp("I3FrameObject", base_object<I3FrameObject>(*this));
+  ar & make_nvp("OMGeo", omgeo);
+  ar & make_nvp("StationGeo", stationgeo);
+  ar & make_nvp("ScintGeo", scintgeo);
+  ar & make_nvp("AntennaGeo", antennageo);
+  ar & make_nvp("IceActGeo", iceactgeo);
+  ar & make_nvp("SnowHeightProvenance", snowHeightProvenance);
+  ar & make_nvp("StartTime", startTime);
+  ar & make_nvp("EndTime", endTime);
+}
+
+I3_SERIALIZABLE(I3GeometryDelta);
+
+// I3CalibrationDelta
+
+I3CalibrationDelta::I3CalibrationDelta() {}
+
+I3CalibrationDelta::I3CalibrationDelta(const I3Calibration& base, const I3Calibration& current) :
+  domCal(base.domCal, current.domCal),
+  vemCal(base.vemCal, current.vemCal),
+  startTime(current.startTime),
+  endTime(current.endTime)
+{}
+
+I3CalibrationDelta::~I3CalibrationDelta() {}
+
+I3CalibrationPtr
+I3CalibrationDelta::Apply(const I3Calibration& base) const
+{
+  I3CalibrationPtr calibration(new I3Calibration(base));
+  domCal.Apply(calibration->domCal);
+  vemCal.Apply(calibration->vemCal);
+  calibration->startTime = startTime;
+  calibration->endTime = endTime;
+  return calibration;
+}
+
+bool
+I3CalibrationDelta::operator==(const I3CalibrationDelta& rhs) const
+{
+  return (domCal == rhs.domCal &&
+          vemCal == rhs.vemCal &&
+          startTime == rhs.startTime &&
+          endTime == rhs.endTime);
+}
+
+template <class Archive>
+void
+I3CalibrationDelta::serialize(Archive& ar, unsigned version)
+{
+  if (version > i3calibrationdelta_version_)
+    log_fatal("Attempting to read version %u from file but running version %u of I3CalibrationDelta class.",
+              version, i3calibrationdelta_version_);
+
+  ar & make_nvp("I3FrameObject", base_object<I3FrameObject>(*this));
+  ar & make_nvp("domcal", domCal);
+  ar & make_nvp("vemcal", vemCal);
+  ar & make_nvp("StartTime", startTime);
+  ar & make_nvp("EndTime", endTime);
+}
+
+I3_SERIALIZABLE(I3CalibrationDelta);
+
+// I3DetectorStatusDelta
+
+I3DetectorStatusDelta::I3DetectorStatusDelta() {}
+
+I3DetectorStatusDelta::I3DetectorStatusDelta(const I3DetectorStatus& base,
+                                             const I3DetectorStatus& current) :
+  domStatus(base.domStatus, current.domStatus),
+  triggerStatus(base.triggerStatus, current.triggerStatus),
+  daqConfigurationName(current.daqConfigurationName),
+  startTime(current.startTime),
+  endTime(current.endTime)
+{}
+
+I3DetectorStatusDelta::~I3DetectorStatusDelta() {}
+
+I3DetectorStatusPtr
+I3DetectorStatusDelta::Apply(const I3DetectorStatus& base) const
+{
+  I3DetectorStatusPtr status(new I3DetectorStatus(base));
+  domStatus.Apply(status->domStatus);
+  triggerStatus.Apply(status->triggerStatus);
+  status->daqConfigurationName = daqConfigurationName;
+  status->startTime = startTime;
+  status->endTime = endTime;
+  return status;
+}
+
+bool
+I3DetectorStatusDelta::operator==(const I3DetectorStatusDelta& rhs) const
+{
+  return (domStatus == rhs.domStatus &&
+          triggerStatus == rhs.triggerStatus &&
+          daqConfigurationName == rhs.daqConfigurationName &&
+          startTime == rhs.startTime &&
+          endTime == rhs.endTime);
+}
+
+template <class Archive>
+void
+I3DetectorStatusDelta::serialize(Archive& ar, unsigned version)
+{
+  if (version > i3detectorstatusdelta_version_)
+    log_fatal("Attempting to read version %u from file but running version %u of I3DetectorStatusDelta class.",
+              version, i3detectorstatusdelta_version_);
+
+  ar & make_nvp("I3FrameObject", base_object<I3FrameObject>(*this));
+  ar & make_nvp("DomStatus", domStatus);
+  ar & make_nvp("TriggerStatus", triggerStatus);
+  ar & make_nvp("DaqConfigurationName", daqConfigurationName);
+  ar & make_nvp("StartTime", startTime);
+  ar & make_nvp("EndTime", endTime);
+}
+
+I3_SERIALIZABLE(I3DetectorStatusDelta);
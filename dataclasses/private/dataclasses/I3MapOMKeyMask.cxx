@@ -127,6 +127,51 @@ I3RecoPulseSeriesMapMask::I3RecoPulseSeriesMapMask(const I3Frame &frame,
 	}
 }
 
+I3RecoPulseSeriesMapMask::I3RecoPulseSeriesMapMask(const I3Frame &frame,
+    const std::string &key, double tmin, double tmax,
+    const std::vector<OMKey> &doms)
+    : key_(key)
+{
+	source_ = frame.Get<boost::shared_ptr<const I3RecoPulseSeriesMap> >(key_);
+
+	if (!source_)
+		log_fatal("The map named '%s' doesn't exist in the frame!\n", key_.c_str());
+
+	omkey_mask_ = bitmask(source_->size(), false);
+
+	std::vector<OMKey> selected(doms);
+	std::sort(selected.begin(), selected.end());
+	std::vector<OMKey>::const_iterator dom = selected.begin();
+
+	size_t om_idx(0);
+	for (I3RecoPulseSeriesMap::const_iterator it = source_->begin();
+	    it != source_->end(); it++, om_idx++) {
+		if (!selected.empty()) {
+			while (dom != selected.end() && *dom < it->first)
+				dom++;
+			if (dom == selected.end())
+				break;
+			if (it->first < *dom)
+				continue;
+		}
+
+		bitmask mask = bitmask(it->second.size(), false);
+		bool any = false;
+		for (unsigned idx = 0; idx < it->second.size(); idx++) {
+			const double t = it->second[idx].GetTime();
+			if (t >= tmin && t <= tmax) {
+				mask.set(idx, true);
+				any = true;
+			}
+		}
+
+		if (any) {
+			omkey_mask_.set(om_idx, true);
+			element_masks_.push_back(mask);
+		}
+	}
+}
+
 void
 I3RecoPulseSeriesMapMask::SetNone()
 {
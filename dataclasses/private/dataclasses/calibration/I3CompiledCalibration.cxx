@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <cmath>
+
+#include <icetray/I3Units.h>
+#include <dataclasses/I3DOMFunctions.h>
+#include <dataclasses/calibration/I3CompiledCalibration.h>
+
+const unsigned int I3CompiledCalibration::N_ATWD_CHIPS;
+const unsigned int I3CompiledCalibration::N_ATWD_CHANNELS;
+const unsigned int I3CompiledCalibration::N_ATWD_BINS;
+const size_t I3CompiledCalibration::npos;
+
+namespace {
+
+  // Same relation as PMTGain(), without the diagnostics for DOMs
+  // that are switched off or have no HV/gain fit.
+  double CompilePMTGain(const I3DOMStatus& status, const I3DOMCalibration& calib)
+  {
+    const LinearFit hvgain = calib.GetHVGainFit();
+    if (hvgain.slope == 0 && hvgain.intercept == 0)
+      return NAN;
+
+    const double voltage = status.pmtHV/I3Units::volt;
+    if (!(voltage > 0.0))
+      return 0.0;
+
+    return pow(10.0, hvgain.slope*log10(voltage) + hvgain.intercept);
+  }
+
+  // Same relation as ATWDSamplingRate(), without the diagnostics.
+  double CompileATWDSamplingRate(unsigned int chip, const I3DOMStatus& status,
+                                 const I3DOMCalibration& calib)
+  {
+    const QuadraticFit fit = calib.GetATWDFreqFit(chip);
+    const double dacTrigBias = (chip == 0) ?
+      status.dacTriggerBias0 : status.dacTriggerBias1;
+
+    double rate = 0;
+    if (std::isnan(fit.quadFitC))
+      rate = (fit.quadFitB*dacTrigBias + fit.quadFitA)*20.;
+    else if (fit.quadFitC != 0.0)
+      rate = fit.quadFitC*dacTrigBias*dacTrigBias +
+        fit.quadFitB*dacTrigBias + fit.quadFitA;
+
+    return rate/I3Units::microsecond;
+  }
+
+}
+
+I3CompiledCalibration::I3CompiledCalibration() {}
+
+I3CompiledCalibration::I3CompiledCalibration(const I3Calibration& calibration,
+                                             const I3DetectorStatus& status)
+{
+  Compile(calibration, status);
+}
+
+void
+I3CompiledCalibration::Compile(const I3Calibration& calibration,
+                               const I3DetectorStatus& status)
+{
+  keys_.clear();
+  entries_.clear();
+  atwdBinSlopes_.clear();
+
+  // Both maps are sorted by OMKey, so a merge yields the DOMs that
+  // have calibration and status information, in order.
+  I3DOMCalibrationMap::const_iterator cal = calibration.domCal.begin();
+  I3DOMStatusMap::const_iterator stat = status.domStatus.begin();
+  while (cal != calibration.domCal.end() && stat != status.domStatus.end()) {
+    if (cal->first < stat->first) {
+      ++cal;
+      continue;
+    }
+    if (stat->first < cal->first) {
+      ++stat;
+      continue;
+    }
+
+    keys_.push_back(cal->first);
+    entries_.push_back(DOMEntry());
+    atwdBinSlopes_.resize(atwdBinSlopes_.size() +
+                          N_ATWD_CHIPS*N_ATWD_CHANNELS*N_ATWD_BINS);
+    CompileEntry(keys_.size()-1, cal->second, stat->second);
+
+    ++cal;
+    ++stat;
+  }
+}
+
+void
+I3CompiledCalibration::Update(const I3Calibration& calibration,
+                              const I3DetectorStatus& status,
+                              const std::vector<OMKey>& changed)
+{
+  // Recompile in place as long as the set of DOMs stays the same
+  std::vector<std::pair<size_t, OMKey> > updates;
+  for (const OMKey& key : changed) {
+    const size_t index = GetIndex(key);
+    I3DOMCalibrationMap::const_iterator cal = calibration.domCal.find(key);
+    I3DOMStatusMap::const_iterator stat = status.domStatus.find(key);
+    const bool compiled = (cal != calibration.domCal.end() &&
+                           stat != status.domStatus.end());
+    if (compiled != (index != npos)) {
+      Compile(calibration, status);
+      return;
+    }
+    if (compiled)
+      updates.push_back(std::make_pair(index, key));
+  }
+
+  for (const std::pair<size_t, OMKey>& update : updates)
+    CompileEntry(update.first, calibration.domCal.find(update.second)->second,
+                 status.domStatus.find(update.second)->second);
+}
+
+void
+I3CompiledCalibration::CompileEntry(size_t i, const I3DOMCalibration& domcal,
+                                    const I3DOMStatus& domstatus)
+{
+  DOMEntry& entry = entries_[i];
+
+  entry.pmtGain = CompilePMTGain(domstatus, domcal);
+  entry.speMean = (entry.pmtGain > 0.0) ?
+    entry.pmtGain*I3Units::eSI*I3Units::C : NAN;
+  entry.transitTime = TransitTime(domstatus, domcal);
+  entry.frontEndImpedance = domcal.GetFrontEndImpedance();
+  entry.fadcBaseline = FADCBaseline(domstatus, domcal);
+  entry.fadcGain = domcal.GetFADCGain();
+  entry.fadcBeaconBaseline = domcal.GetFADCBeaconBaseline();
+  entry.fadcDeltaT = domcal.GetFADCDeltaT();
+  entry.meanSPECharge = MeanSPECharge(domcal);
+
+  for (unsigned int channel = 0; channel < N_ATWD_CHANNELS; channel++)
+    entry.atwdGain[channel] = domcal.GetATWDGain(channel);
+
+  for (unsigned int chip = 0; chip < N_ATWD_CHIPS; chip++) {
+    entry.atwdSamplingRate[chip] = CompileATWDSamplingRate(chip, domstatus, domcal);
+    entry.atwdDeltaT[chip] = domcal.GetATWDDeltaT(chip);
+    for (unsigned int channel = 0; channel < N_ATWD_CHANNELS; channel++) {
+      entry.atwdBeaconBaseline[chip][channel] =
+        domcal.GetATWDBeaconBaseline(chip, channel);
+      double* slopes = &atwdBinSlopes_[((i*N_ATWD_CHIPS + chip)*N_ATWD_CHANNELS
+                                        + channel)*N_ATWD_BINS];
+      for (unsigned int bin = 0; bin < N_ATWD_BINS; bin++)
+        slopes[bin] = domcal.GetATWDBinCalibSlope(chip, channel, bin);
+    }
+  }
+}
+
+size_t
+I3CompiledCalibration::GetIndex(const OMKey& key) const
+{
+  std::vector<OMKey>::const_iterator it =
+    std::lower_bound(keys_.begin(), keys_.end(), key);
+  if (it == keys_.end() || *it != key)
+    return npos;
+  return it - keys_.begin();
+}
@@ -3,6 +3,9 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <tuple>
 #include <fftw3.h>
 #include <math.h>
 
@@ -12,22 +15,131 @@
 const unsigned int fft::GetNCFromNR(unsigned int nReal) {return nReal / 2 + 1;}
 const unsigned int fft::GetNRFromNC(unsigned int nComp) {return (nComp - 1) * 2;}
 
+namespace {
+
+//Process-wide cache of fftw plans. The fftw planner is not thread-safe, so
+//all planning, wisdom and cache access goes through one mutex. The plans are
+//only ever run with the new-array execute functions, which are thread-safe.
+class PlanCache {
+ public:
+  typedef std::tuple<unsigned int, int, int, unsigned int, unsigned int> Key;
+
+  static PlanCache& Instance() {
+    static PlanCache cache;
+    return cache;
+  }
+
+  ~PlanCache() {Clear();}
+
+  fftw_plan Get(unsigned int inN, fft::FFTType type, int sign, unsigned int flag, unsigned int howMany) {
+    //The sign only matters for complex to complex transforms
+    if (type != fft::eC2C)
+      sign = 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Key key(inN, type, sign, flag, howMany);
+    std::map<Key, fftw_plan>::const_iterator it = plans_.find(key);
+    if (it != plans_.end())
+      return it->second;
+
+    fftw_plan plan = Make(inN, type, sign, flag, howMany);
+    plans_[key] = plan;
+    return plan;
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::map<Key, fftw_plan>::value_type& entry : plans_)
+      fftw_destroy_plan(entry.second);
+    plans_.clear();
+  }
+
+  unsigned int Size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return plans_.size();
+  }
+
+  std::mutex& Mutex() {return mutex_;}
+
+ private:
+  //Plan on scratch buffers. FFTWPlan allocates its own with fftw_alloc, which
+  //guarantees the same alignment, as required by fftw_execute_dft & co.
+  static fftw_plan Make(unsigned int inN, fft::FFTType type, int sign, unsigned int flag, unsigned int howMany) {
+    fftw_plan plan = NULL;
+    if (type == fft::eC2C) {
+      int n = inN;
+      fftw_complex *in = fftw_alloc_complex(size_t(inN) * howMany);
+      fftw_complex *out = fftw_alloc_complex(size_t(inN) * howMany);
+      plan = fftw_plan_many_dft(1, &n, howMany, in, NULL, 1, inN, out, NULL, 1, inN, sign, flag);
+      fftw_free(in);
+      fftw_free(out);
+    } else if (type == fft::eC2R) {
+      const unsigned int outN = fft::GetNRFromNC(inN);
+      int n = outN;
+      fftw_complex *in = fftw_alloc_complex(size_t(inN) * howMany);
+      double *out = fftw_alloc_real(size_t(outN) * howMany);
+      plan = fftw_plan_many_dft_c2r(1, &n, howMany, in, NULL, 1, inN, out, NULL, 1, outN, flag);
+      fftw_free(in);
+      fftw_free(out);
+    } else if (type == fft::eR2C) {
+      const unsigned int outN = fft::GetNCFromNR(inN);
+      int n = inN;
+      double *in = fftw_alloc_real(size_t(inN) * howMany);
+      fftw_complex *out = fftw_alloc_complex(size_t(outN) * howMany);
+      plan = fftw_plan_many_dft_r2c(1, &n, howMany, in, NULL, 1, inN, out, NULL, 1, outN, flag);
+      fftw_free(in);
+      fftw_free(out);
+    }
+
+    if (plan == NULL)
+      log_fatal("fftw could not create a plan of size %u (type %d, batch of %u)", inN, int(type), howMany);
+    return plan;
+  }
+
+  std::mutex mutex_;
+  std::map<Key, fftw_plan> plans_;
+};
+
+}
+
+bool fft::LoadWisdom(const std::string& filename) {
+  PlanCache& cache = PlanCache::Instance();
+  std::lock_guard<std::mutex> lock(cache.Mutex());
+  if (!fftw_import_wisdom_from_filename(filename.c_str())) {
+    log_warn("Could not import fftw wisdom from %s", filename.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool fft::SaveWisdom(const std::string& filename) {
+  PlanCache& cache = PlanCache::Instance();
+  std::lock_guard<std::mutex> lock(cache.Mutex());
+  if (!fftw_export_wisdom_to_filename(filename.c_str())) {
+    log_error("Could not export fftw wisdom to %s", filename.c_str());
+    return false;
+  }
+  return true;
+}
+
+void fft::ClearPlanCache() {PlanCache::Instance().Clear();}
+
+unsigned int fft::GetPlanCacheSize() {return PlanCache::Instance().Size();}
+
 //Reset the variables
 void FFTWPlan::SetToNull() {
   thePlan_ = NULL;
   inN_ = outN_ = -1;
+  howMany_ = 1;
   inr_ = outr_ = NULL;
   inc_ = outc_ = NULL;
   planSet_ = false;
   isExecuted_ = false;
 }
 
-//Safely unallocate using fftw_free
+//Safely unallocate using fftw_free, the plan itself belongs to the cache
 void FFTWPlan::Free() {
 
-  if (thePlan_ != NULL)
-    fftw_destroy_plan(thePlan_);
-
   if (inr_ != NULL)
     fftw_free(inr_);
   if (outr_ != NULL)
@@ -41,52 +153,48 @@ void FFTWPlan::Free() {
 }
 
 //Constructor
-FFTWPlan::FFTWPlan(unsigned int inN, fft::FFTType type, int sign, unsigned int flag) {
+FFTWPlan::FFTWPlan(unsigned int inN, fft::FFTType type, int sign, unsigned int flag, unsigned int howMany) {
   SetToNull();
 
-  if (inN == 0) {
+  if (inN == 0 || howMany == 0) {
     return;
   }
 
   inN_ = inN;
+  howMany_ = howMany;
   theType_ = type;
 
   if (type == fft::eC2C) {
     outN_ = inN_;
 
-    inc_ = fftw_alloc_complex(inN_);
-    outc_ = fftw_alloc_complex(outN_);
-
-    thePlan_ = fftw_plan_dft_1d(inN, inc_, outc_, sign, flag);
-    planSet_ = true;
+    inc_ = fftw_alloc_complex(inN_ * howMany_);
+    outc_ = fftw_alloc_complex(outN_ * howMany_);
   } else if (type == fft::eC2R) {
     outN_ = fft::GetNRFromNC(inN_);
 
-    inc_ = fftw_alloc_complex(inN_);
-    outr_ = fftw_alloc_real(outN_);
-
-    thePlan_ = fftw_plan_dft_c2r_1d(outN_, inc_, outr_, flag);
-    planSet_ = true;
+    inc_ = fftw_alloc_complex(inN_ * howMany_);
+    outr_ = fftw_alloc_real(outN_ * howMany_);
   } else if (type == fft::eR2C) {
     outN_ = fft::GetNCFromNR(inN_);
 
-    inr_ = fftw_alloc_real(inN_);
-    outc_ = fftw_alloc_complex(outN_);
-
-    thePlan_ = fftw_plan_dft_r2c_1d(inN_, inr_, outc_, flag);
-    planSet_ = true;
+    inr_ = fftw_alloc_real(inN_ * howMany_);
+    outc_ = fftw_alloc_complex(outN_ * howMany_);
   } else {
     log_fatal("The FFT type you chose has not been implemented.");
     planSet_ = false;
+    return;
   }
+
+  thePlan_ = PlanCache::Instance().Get(inN_, type, sign, flag, howMany_);
+  planSet_ = true;
 }
 
 //Copy the REAL data into the plan
 void FFTWPlan::CopyIntoPlan(double *arr, unsigned int n) {
   isExecuted_ = false;
 
-  if (n != inN_) {
-    log_fatal("I cannot copy this vector in, Boss. It is size %d and I am expecting %d", n, inN_);
+  if (n != inN_ * howMany_) {
+    log_fatal("I cannot copy this vector in, Boss. It is size %d and I am expecting %d", n, inN_ * howMany_);
   }
 
   for (unsigned int i = 0; i < n; i++) {
@@ -98,8 +206,8 @@ void FFTWPlan::CopyIntoPlan(double *arr, unsigned int n) {
 void FFTWPlan::CopyIntoPlanC(double arr[][2], unsigned int n) {
   isExecuted_ = false;
 
-  if (n != inN_) {
-    log_fatal("I cannot copy this vector in, Boss. It is size %d and I am expecting %d", n, inN_);
+  if (n != inN_ * howMany_) {
+    log_fatal("I cannot copy this vector in, Boss. It is size %d and I am expecting %d", n, inN_ * howMany_);
   }
 
   for (unsigned int i = 0; i < n; i++) {
@@ -112,8 +220,8 @@ void FFTWPlan::CopyIntoPlanC(double arr[][2], unsigned int n) {
 void FFTWPlan::CopyIntoPlanC(std::complex<double> *arr, unsigned int n) {
   isExecuted_ = false;
 
-  if (n != inN_) {
-    log_fatal("I cannot copy this vector in, Boss. It is size %d and I am expecting %d", n, inN_);
+  if (n != inN_ * howMany_) {
+    log_fatal("I cannot copy this vector in, Boss. It is size %d and I am expecting %d", n, inN_ * howMany_);
   }
 
   for (unsigned int i = 0; i < n; i++) {
@@ -130,7 +238,7 @@ void FFTWPlan::CopyOutOfPlan(double *arr, bool norm) {
     log_fatal("Asking for the real output of a complex FFT. I'll stop you before you segfault.");
   }
 
-  for (unsigned int i = 0; i < outN_; i++) {
+  for (unsigned int i = 0; i < outN_ * howMany_; i++) {
     arr[i] = outr_[i] * (norm ? sqrt(outN_) : 1.);
   }
 }
@@ -139,7 +247,7 @@ void FFTWPlan::CopyOutOfPlan(double *arr, bool norm) {
 void FFTWPlan::CopyOutOfPlanC(double arr[][2], bool norm) {
   ExecutePlan();
 
-  for (unsigned int i = 0; i < outN_; i++) {
+  for (unsigned int i = 0; i < outN_ * howMany_; i++) {
     for (unsigned int ireal = 0; ireal < 2; ireal++)
       arr[i][ireal] = outc_[i][ireal] * (norm ? sqrt(inN_) : 1.);
   }
@@ -149,7 +257,7 @@ void FFTWPlan::CopyOutOfPlanC(double arr[][2], bool norm) {
 void FFTWPlan::CopyOutOfPlanC(std::complex<double> *arr, bool norm) {
   ExecutePlan();
 
-  for (unsigned int i = 0; i < outN_; i++) {
+  for (unsigned int i = 0; i < outN_ * howMany_; i++) {
     arr[i] = std::complex<double>(outc_[i][0], outc_[i][1]) * (norm ? sqrt(inN_) : 1.);
   }
 }
@@ -160,7 +268,13 @@ void FFTWPlan::ExecutePlan() {
     if (!planSet_) {
       log_fatal("Cannot get results because the plan is not set!");
     }
-    fftw_execute(thePlan_);
+    //New-array execute: the cached plan runs on this object's buffers
+    if (theType_ == fft::eC2C)
+      fftw_execute_dft(thePlan_, inc_, outc_);
+    else if (theType_ == fft::eC2R)
+      fftw_execute_dft_c2r(thePlan_, inc_, outr_);
+    else
+      fftw_execute_dft_r2c(thePlan_, inr_, outc_);
     isExecuted_ = true;
   }
 }
@@ -168,11 +282,11 @@ void FFTWPlan::ExecutePlan() {
 //Print the result to the terminal
 void FFTWPlan::PrintPlan() const {
   if (theType_ == fft::eC2C || theType_ == fft::eR2C) {
-    for (unsigned int i = 0; i < outN_; i++) {
+    for (unsigned int i = 0; i < outN_ * howMany_; i++) {
       std::cerr << '(' << outc_[i][0] << ',' << outc_[i][1] << ')' << std::endl;
     }
   } else if (theType_ == fft::eC2R) {
-    for (unsigned int i = 0; i < outN_; i++) {
+    for (unsigned int i = 0; i < outN_ * howMany_; i++) {
       std::cerr << outr_[i] << std::endl;
     }
   }
@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+
+#include <icetray/serialization.h>
+#include <dataclasses/geometry/I3OMKeyIndex.h>
+
+const size_t I3OMKeyIndex::npos;
+
+I3OMKeyIndex::I3OMKeyIndex() : minString_(0) {}
+
+I3OMKeyIndex::I3OMKeyIndex(const I3OMGeoMap& omgeo) : minString_(0)
+{
+  keys_.reserve(omgeo.size());
+  for (const auto& pair : omgeo)
+    keys_.push_back(pair.first);
+  BuildTable();
+}
+
+I3OMKeyIndex::I3OMKeyIndex(const I3Geometry& geometry)
+  : I3OMKeyIndex(geometry.omgeo)
+{}
+
+I3OMKeyIndex::I3OMKeyIndex(const std::vector<OMKey>& keys)
+  : keys_(keys), minString_(0)
+{
+  std::sort(keys_.begin(), keys_.end());
+  keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
+  BuildTable();
+}
+
+void
+I3OMKeyIndex::BuildTable()
+{
+  strings_.clear();
+  slots_.clear();
+  if (keys_.empty())
+    return;
+
+  if (keys_.size() >= std::numeric_limits<uint32_t>::max())
+    log_fatal("Too many keys (%zu) for an I3OMKeyIndex", keys_.size());
+
+  minString_ = keys_.front().GetString();
+  const int maxString = keys_.back().GetString();
+  strings_.resize(size_t(maxString - minString_) + 1, StringSlots{0, 0, 0});
+
+  // find the OM range of each string
+  for (std::vector<OMKey>::const_iterator begin = keys_.begin(); begin != keys_.end(); ) {
+    std::vector<OMKey>::const_iterator end = begin;
+    while (end != keys_.end() && end->GetString() == begin->GetString())
+      ++end;
+    StringSlots& string = strings_[begin->GetString() - minString_];
+    string.omBegin = begin->GetOM();
+    string.omCount = (end-1)->GetOM() - begin->GetOM() + 1;
+    begin = end;
+  }
+
+  size_t nslots = 0;
+  for (StringSlots& string : strings_) {
+    string.offset = nslots;
+    nslots += string.omCount;
+  }
+
+  // keys are sorted, so the first key of every (string, om) wins
+  slots_.assign(nslots, uint32_t(keys_.size()));
+  for (size_t i = keys_.size(); i-- > 0; ) {
+    const StringSlots& string = strings_[keys_[i].GetString() - minString_];
+    slots_[string.offset + keys_[i].GetOM() - string.omBegin] = uint32_t(i);
+  }
+}
+
+size_t
+I3OMKeyIndex::GetIndex(const OMKey& key) const
+{
+  if (strings_.empty() || key.GetString() < minString_ ||
+      size_t(key.GetString() - minString_) >= strings_.size())
+    return npos;
+
+  const StringSlots& string = strings_[key.GetString() - minString_];
+  if (key.GetOM() < string.omBegin ||
+      key.GetOM() - string.omBegin >= string.omCount)
+    return npos;
+
+  // multi-PMT modules occupy consecutive indices
+  for (size_t i = slots_[string.offset + key.GetOM() - string.omBegin];
+       i < keys_.size() && keys_[i].GetString() == key.GetString() &&
+         keys_[i].GetOM() == key.GetOM(); i++) {
+    if (keys_[i].GetPMT() == key.GetPMT())
+      return i;
+  }
+  return npos;
+}
+
+std::ostream&
+I3OMKeyIndex::Print(std::ostream& oss) const
+{
+  oss << "[I3OMKeyIndex with " << keys_.size() << " keys]";
+  return oss;
+}
+
+std::ostream&
+operator<<(std::ostream& oss, const I3OMKeyIndex& index)
+{
+  return index.Print(oss);
+}
+
+template <class Archive>
+void
+I3OMKeyIndex::save(Archive& ar, unsigned version) const
+{
+  ar & make_nvp("I3FrameObject", base_object<I3FrameObject>(*this));
+  ar & make_nvp("Keys", keys_);
+}
+
+template <class Archive>
+void
+I3OMKeyIndex::load(Archive& ar, unsigned version)
+{
+  if (version > i3omkeyindex_version_)
+    log_fatal("Attempting to read version %u from file but running version %u of I3OMKeyIndex class.",
+              version, i3omkeyindex_version_);
+
+  ar & make_nvp("I3FrameObject", base_object<I3FrameObject>(*this));
+  ar & make_nvp("Keys", keys_);
+  BuildTable();
+}
+
+I3_SPLIT_SERIALIZABLE(I3OMKeyIndex);
@@ -292,3 +292,4 @@ std::ostream& operator<<(std::ostream& oss, const I3DOMLaunch& d)
 I3_SPLIT_SERIALIZABLE(I3DOMLaunch);
 
 I3_SERIALIZABLE(I3DOMLaunchSeriesMap);
+I3_SERIALIZABLE(I3DOMLaunchSeriesFlatMap);
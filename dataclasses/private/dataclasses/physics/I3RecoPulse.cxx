@@ -101,3 +101,4 @@ I3_SERIALIZABLE(I3RecoPulse);
 
 I3_SERIALIZABLE(I3RecoPulseSeriesMap);
 I3_SERIALIZABLE(I3RecoPulseMap);
+I3_SERIALIZABLE(I3RecoPulseSeriesFlatMap);
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <dataclasses/I3GCDDelta.h>
+#include <icetray/python/dataclass_suite.hpp>
+
+namespace bp = boost::python;
+
+namespace {
+
+  bp::list key_list(const std::vector<OMKey>& keys)
+  {
+    bp::list result;
+    for (const OMKey& key : keys)
+      result.append(key);
+    return result;
+  }
+
+  bp::list geometry_om_keys(const I3GeometryDelta& self)
+  {
+    return key_list(self.GetOMKeys());
+  }
+
+  bp::list calibration_dom_keys(const I3CalibrationDelta& self)
+  {
+    return key_list(self.GetDOMKeys());
+  }
+
+  bp::list status_dom_keys(const I3DetectorStatusDelta& self)
+  {
+    return key_list(self.GetDOMKeys());
+  }
+
+}
+
+void register_I3GCDDelta()
+{
+  bp::class_<I3GeometryDelta, I3GeometryDeltaPtr, bp::bases<I3FrameObject> >
+    ("I3GeometryDelta",
+     "The changes of an I3Geometry relative to a base geometry",
+     bp::init<>())
+    .def(bp::init<const I3Geometry&, const I3Geometry&>((bp::arg("base"), bp::arg("current"))))
+    .def("apply", &I3GeometryDelta::Apply, bp::arg("base"),
+         "The geometry this delta was made from, given its base")
+    .def("om_keys", &geometry_om_keys,
+         "OMs whose geometry was added, modified or removed")
+    .def_readwrite("start_time", &I3GeometryDelta::startTime)
+    .def_readwrite("end_time", &I3GeometryDelta::endTime)
+    .def(bp::self == bp::self)
+    .def(bp::self != bp::self)
+    ;
+  register_pointer_conversions<I3GeometryDelta>();
+
+  bp::class_<I3CalibrationDelta, I3CalibrationDeltaPtr, bp::bases<I3FrameObject> >
+    ("I3CalibrationDelta",
+     "The changes of an I3Calibration relative to a base calibration",
+     bp::init<>())
+    .def(bp::init<const I3Calibration&, const I3Calibration&>((bp::arg("base"), bp::arg("current"))))
+    .def("apply", &I3CalibrationDelta::Apply, bp::arg("base"),
+         "The calibration this delta was made from, given its base")
+    .def("dom_keys", &calibration_dom_keys,
+         "DOMs whose calibration was added, modified or removed")
+    .def_readwrite("start_time", &I3CalibrationDelta::startTime)
+    .def_readwrite("end_time", &I3CalibrationDelta::endTime)
+    .def(bp::self == bp::self)
+    .def(bp::self != bp::self)
+    ;
+  register_pointer_conversions<I3CalibrationDelta>();
+
+  bp::class_<I3DetectorStatusDelta, I3DetectorStatusDeltaPtr, bp::bases<I3FrameObject> >
+    ("I3DetectorStatusDelta",
+     "The changes of an I3DetectorStatus relative to a base detector status",
+     bp::init<>())
+    .def(bp::init<const I3DetectorStatus&, const I3DetectorStatus&>((bp::arg("base"), bp::arg("current"))))
+    .def("apply", &I3DetectorStatusDelta::Apply, bp::arg("base"),
+         "The detector status this delta was made from, given its base")
+    .def("dom_keys", &status_dom_keys,
+         "DOMs whose status was added, modified or removed")
+    .def_readwrite("daq_configuration_name", &I3DetectorStatusDelta::daqConfigurationName)
+    .def_readwrite("start_time", &I3DetectorStatusDelta::startTime)
+    .def_readwrite("end_time", &I3DetectorStatusDelta::endTime)
+    .def(bp::self == bp::self)
+    .def(bp::self != bp::self)
+    ;
+  register_pointer_conversions<I3DetectorStatusDelta>();
+}
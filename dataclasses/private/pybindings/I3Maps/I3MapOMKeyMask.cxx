@@ -52,6 +52,9 @@ void register_I3RecoPulseSeriesMapMask()
 		.def("__init__", bp::make_constructor(&from_callable))
 		.def(bp::init<const I3Frame&, const std::string &, const I3RecoPulseSeriesMap &>())
 		.def(bp::init<const I3Frame&, const std::string &, callback_t>())
+		.def(bp::init<const I3Frame&, const std::string &, double, double,
+		    bp::optional<const std::vector<OMKey> &> >(
+		    bp::args("frame", "key", "tmin", "tmax", "doms")))
 		.add_property("source", &I3RecoPulseSeriesMapMask::GetSource)
 		.add_property("bits", &getbits)
 // hush this false positive. appears to be fixed as of Apple Clang 16
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <dataclasses/geometry/I3OMKeyIndex.h>
+#include <icetray/python/dataclass_suite.hpp>
+
+namespace bp = boost::python;
+
+namespace {
+
+  // npos is not a useful value in python
+  bp::object get_index(const I3OMKeyIndex& self, const OMKey& key)
+  {
+    const size_t index = self.GetIndex(key);
+    if (index == I3OMKeyIndex::npos)
+      return bp::object();
+    return bp::object(index);
+  }
+
+}
+
+void register_I3OMKeyIndex()
+{
+  bp::class_<I3OMKeyIndex, I3OMKeyIndexPtr, bp::bases<I3FrameObject> >
+    ("I3OMKeyIndex",
+     "Dense numbering of the OMKeys of a geometry",
+     bp::init<>())
+    .def(bp::init<const I3Geometry&>())
+    .def(bp::init<const I3OMGeoMap&>())
+    .def(bp::init<const std::vector<OMKey>&>())
+    .def("get_index", &get_index,
+         "Dense index of an OMKey, or None if it is not indexed")
+    .def("get_key", &I3OMKeyIndex::GetKey, bp::return_value_policy<bp::copy_const_reference>())
+    .add_property("keys", bp::make_function(&I3OMKeyIndex::GetKeys,
+                                            bp::return_value_policy<bp::copy_const_reference>()))
+    .def("__len__", &I3OMKeyIndex::size)
+    .def("__contains__", &I3OMKeyIndex::Contains)
+    .def(bp::dataclass_suite<I3OMKeyIndex>())
+    ;
+
+  register_pointer_conversions<I3OMKeyIndex>();
+}
@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <dataclasses/fft/FFTWPlan.h>
+#include <dataclasses/I3AntennaDataMap.h>
+
+#include <icetray/python/dataclass_suite.hpp>
+
+namespace bp = boost::python;
+
+void register_FFTWPlan() {
+  void (*UpdateSpectra)(I3AntennaDataMap&) = &fft::UpdateAllFrequencySpectra;
+  void (*UpdateTraces)(I3AntennaDataMap&) = &fft::UpdateAllTimeSeries;
+
+  std::string nested_name = bp::extract<std::string>(bp::scope().attr("__name__") + ".fft");
+  bp::object nested_module(bp::handle<>(bp::borrowed(PyImport_AddModule(nested_name.c_str()))));
+  bp::scope().attr("fft") = nested_module;
+  bp::scope parent = nested_module;
+
+  bp::def("LoadWisdom", &fft::LoadWisdom, bp::arg("filename"),
+          "Import FFTW wisdom from a file, returns False if it could not be read");
+  bp::def("SaveWisdom", &fft::SaveWisdom, bp::arg("filename"),
+          "Export the accumulated FFTW wisdom to a file");
+  bp::def("ClearPlanCache", &fft::ClearPlanCache, "Destroy all cached FFTW plans");
+  bp::def("GetPlanCacheSize", &fft::GetPlanCacheSize, "Number of cached FFTW plans");
+  bp::def("UpdateAllFrequencySpectra", UpdateSpectra,
+          "Do the FFTs of all channels of an I3AntennaDataMap, batching channels of equal length");
+  bp::def("UpdateAllTimeSeries", UpdateTraces,
+          "Do the inverse FFTs of all channels of an I3AntennaDataMap, batching channels of equal length");
+}
@@ -81,6 +81,7 @@ namespace bp = boost::python;
   (I3Double)(I3String)(I3Constants)(I3RecoPulseSeriesMapMask)           \
   (I3RecoPulseSeriesMapUnion)(I3SuperDST)(TankKey)(I3Orientation)       \
   (ModuleKey)(I3ModuleGeo)(I3OMGeo)(I3TankGeo)(I3FilterResult)          \
+  (I3OMKeyIndex)(I3GCDDelta)                                            \
   (I3MapI3ParticleID)(I3VectorChar)(I3VectorString)(I3VectorBool)       \
   (I3VectorOMKey)(I3VectorModuleKey)(I3VectorShort)(I3VectorTankKey)    \
   (I3VectorUShort)(I3VectorInt)(I3VectorUInt)(I3VectorInt64)            \
@@ -97,7 +98,7 @@ namespace bp = boost::python;
   (AntennaKey)(I3AntennaChannel)(I3AntennaDataMap)(I3AntennaGeo)        \
   (I3AntennaWaveform)(FFTDataContainer)(FFTHilbertEnvelope)             \
   (I3MapAntennaKeyAntennaKey)(I3MapAntennaKeyVectorDouble)(I3AntennaCal)\
-  (FFTResamplingTools)(I3ComplexVector)                                 \
+  (FFTResamplingTools)(FFTWPlan)(I3ComplexVector)                       \
   (IceActKey)(I3IceActGeo)(I3IceActRecoPulseSeries)                     \
   (I3IceActRecoPulseSeriesMap)(I3IceActWaveform)(I3IceActWaveformMap)   \
   (I3IceActPixelPositionMap)                                            \
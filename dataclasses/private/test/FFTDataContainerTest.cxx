@@ -247,3 +247,44 @@ TEST(tests_with_warnings) {
   log_info("This should yell about loading a frequency binning of NAN");
   fftData.LoadFrequencySpectrum(freqSpec);
 }
+
+TEST(batched_updates) {
+  std::vector<FFTData> batched(4), single(4);
+  std::vector<FFTData*> pointers;
+  for (unsigned int j = 0; j < batched.size(); j++) {
+    AntennaTimeSeries trace;
+    //one trace of a different length goes through the unbatched path
+    const unsigned int n = (j == 3) ? 8 : 16;
+    for (unsigned int i = 0; i < n; i++)
+      trace.PushBack(sin(0.3 * (j + 1) * i));
+    trace.SetBinning(2.);
+    trace.SetOffset(0.);
+    batched[j].LoadTimeSeries(trace);
+    single[j].LoadTimeSeries(trace);
+    pointers.push_back(&batched[j]);
+  }
+
+  FFTData::UpdateAllFrequencySpectra(pointers);
+  for (unsigned int j = 0; j < batched.size(); j++) {
+    const AntennaSpectrum& expected = single[j].GetConstFrequencySpectrum();
+    const AntennaSpectrum& spectrum = batched[j].GetConstFrequencySpectrum();
+    ENSURE_EQUAL(spectrum.GetSize(), expected.GetSize());
+    ENSURE_DISTANCE(spectrum.GetBinning(), expected.GetBinning(), 1e-12);
+    for (unsigned int i = 0; i < spectrum.GetSize(); i++)
+      ENSURE_DISTANCE(std::abs(spectrum[i] - expected[i]), 0, 1e-12);
+  }
+
+  //modify the spectra and transform back
+  for (unsigned int j = 0; j < batched.size(); j++) {
+    batched[j].GetFrequencySpectrum()[1] *= 2.;
+    single[j].GetFrequencySpectrum()[1] *= 2.;
+  }
+  FFTData::UpdateAllTimeSeries(pointers);
+  for (unsigned int j = 0; j < batched.size(); j++) {
+    const AntennaTimeSeries& expected = single[j].GetConstTimeSeries();
+    const AntennaTimeSeries& trace = batched[j].GetConstTimeSeries();
+    ENSURE_EQUAL(trace.GetSize(), expected.GetSize());
+    for (unsigned int i = 0; i < trace.GetSize(); i++)
+      ENSURE_DISTANCE(trace[i], expected[i], 1e-12);
+  }
+}
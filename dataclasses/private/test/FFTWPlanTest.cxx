@@ -222,3 +222,61 @@ TEST(tests_with_warnings) {
     log_info("We are good");
   }
 }
+
+TEST(plan_cache) {
+  fft::ClearPlanCache();
+  ENSURE_EQUAL(fft::GetPlanCacheSize(), 0u);
+
+  FFTWPlan plan1(8, fft::eR2C);
+  FFTWPlan plan2(8, fft::eR2C);
+  ENSURE_EQUAL(fft::GetPlanCacheSize(), 1u, "plans of the same shape are shared");
+  FFTWPlan plan3(8, fft::eC2C, FFTW_FORWARD);
+  FFTWPlan plan4(8, fft::eC2C, FFTW_BACKWARD);
+  ENSURE_EQUAL(fft::GetPlanCacheSize(), 3u);
+
+  //Both plans produce the same result on their own buffers
+  double data[8];
+  FillRealData(data, 8);
+  plan1.CopyIntoPlan(data, 8);
+  plan2.CopyIntoPlan(data, 8);
+  complexD out1[5], out2[5];
+  plan1.CopyOutOfPlanC(out1);
+  plan2.CopyOutOfPlanC(out2);
+  for (unsigned int i = 0; i < 5; i++)
+    ENSURE_DISTANCE(std::abs(out1[i] - out2[i]), 0, 1e-12);
+}
+
+TEST(batched_transform) {
+  const unsigned int n = 6;
+  const unsigned int howMany = 3;
+  const unsigned int nc = fft::GetNCFromNR(n);
+
+  double data[howMany * n];
+  for (unsigned int j = 0; j < howMany; j++) {
+    FillRealData(&data[j * n], n);
+    for (unsigned int i = 0; i < n; i++)
+      data[j * n + i] *= (j + 1) + 0.1 * i;
+  }
+
+  FFTWPlan batch(n, fft::eR2C, FFTW_FORWARD, FFTW_MEASURE, howMany);
+  batch.CopyIntoPlan(data, howMany * n);
+  complexD batchOut[howMany * nc];
+  batch.CopyOutOfPlanC(batchOut);
+
+  for (unsigned int j = 0; j < howMany; j++) {
+    FFTWPlan single(n, fft::eR2C);
+    single.CopyIntoPlan(&data[j * n], n);
+    complexD out[nc];
+    single.CopyOutOfPlanC(out);
+    for (unsigned int i = 0; i < nc; i++)
+      ENSURE_DISTANCE(std::abs(batchOut[j * nc + i] - out[i]), 0, 1e-12);
+  }
+
+  //and back again
+  FFTWPlan inverse(nc, fft::eC2R, FFTW_BACKWARD, FFTW_MEASURE, howMany);
+  inverse.CopyIntoPlanC(batchOut, howMany * nc);
+  double roundTrip[howMany * n];
+  inverse.CopyOutOfPlan(roundTrip);
+  for (unsigned int i = 0; i < howMany * n; i++)
+    ENSURE_DISTANCE(roundTrip[i] / n, data[i], 1e-12);
+}
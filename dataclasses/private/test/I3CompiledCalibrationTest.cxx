@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include "dataclasses/calibration/I3CompiledCalibration.h"
+#include "dataclasses/I3DOMFunctions.h"
+#include "icetray/I3Units.h"
+
+namespace {
+
+  void FillDOM(I3Calibration& calibration, I3DetectorStatus& status,
+               const OMKey& key, double hv)
+  {
+    I3DOMCalibration& calib = calibration.domCal[key];
+    I3DOMStatus& rawstatus = status.domStatus[key];
+
+    rawstatus.pmtHV = hv;
+    rawstatus.dacTriggerBias0 = 850;
+    rawstatus.dacTriggerBias1 = 850;
+    rawstatus.dacFADCRef = 800;
+
+    QuadraticFit qfit0, qfit1;
+    qfit0.quadFitA = 24.725868;
+    qfit0.quadFitB = 0.31952357;
+    qfit0.quadFitC = -2.9083156E-5;
+    qfit1.quadFitA = 2.3853257;
+    qfit1.quadFitB = 0.014224272;
+    qfit1.quadFitC = NAN;
+    calib.SetATWDFreqFit(0, qfit0);
+    calib.SetATWDFreqFit(1, qfit1);
+
+    LinearFit hvgainfit;
+    hvgainfit.intercept = -15.1997;
+    hvgainfit.slope = 7.0842533;
+    calib.SetHVGainFit(hvgainfit);
+
+    LinearFit transit;
+    transit.slope = 1800.;
+    transit.intercept = 80.;
+    calib.SetTransitTime(transit);
+
+    LinearFit fadcbase;
+    fadcbase.slope = 1.25;
+    fadcbase.intercept = -850.;
+    calib.SetFADCBaselineFit(fadcbase);
+    calib.SetFrontEndImpedance(43*I3Units::ohm);
+
+    for (unsigned int chip = 0; chip < 2; chip++)
+      for (unsigned int channel = 0; channel < 3; channel++)
+        for (unsigned int bin = 0; bin < 128; bin++)
+          calib.SetATWDBinCalibSlope(chip, channel, bin,
+                                     chip + 0.1*channel + 0.001*bin);
+  }
+
+}
+
+TEST_GROUP(I3CompiledCalibration);
+
+TEST(MatchesDOMFunctions)
+{
+  I3Calibration calibration;
+  I3DetectorStatus status;
+  FillDOM(calibration, status, OMKey(21, 30), 1400*I3Units::V);
+  FillDOM(calibration, status, OMKey(1, 1), 1250*I3Units::V);
+
+  I3CompiledCalibration compiled(calibration, status);
+  ENSURE_EQUAL(compiled.size(), 2u);
+  ENSURE(compiled.GetKeys()[0] == OMKey(1, 1), "keys are sorted");
+
+  for (size_t i = 0; i < compiled.size(); i++) {
+    const OMKey& key = compiled.GetKeys()[i];
+    ENSURE_EQUAL(compiled.GetIndex(key), i);
+    const I3DOMCalibration& calib = calibration.domCal[key];
+    const I3DOMStatus& rawstatus = status.domStatus[key];
+
+    ENSURE_DISTANCE(compiled.GetPMTGain(i), PMTGain(rawstatus, calib), 1e-6);
+    ENSURE_DISTANCE(compiled.GetSPEMean(i)/I3Units::pC,
+                    SPEMean(rawstatus, calib)/I3Units::pC, 1e-9);
+    ENSURE_DISTANCE(compiled.GetTransitTime(i), TransitTime(rawstatus, calib), 1e-9);
+    ENSURE_DISTANCE(compiled.GetFADCBaseline(i), FADCBaseline(rawstatus, calib), 1e-9);
+    for (unsigned int chip = 0; chip < 2; chip++) {
+      ENSURE_DISTANCE(compiled.GetATWDSamplingRate(i, chip),
+                      ATWDSamplingRate(chip, rawstatus, calib), 1e-12);
+      for (unsigned int channel = 0; channel < 3; channel++) {
+        const double* slopes = compiled.GetATWDBinCalibSlopes(i, chip, channel);
+        for (unsigned int bin = 0; bin < 128; bin++)
+          ENSURE_EQUAL(slopes[bin], calib.GetATWDBinCalibSlope(chip, channel, bin));
+      }
+    }
+  }
+}
+
+TEST(MissingDOMs)
+{
+  I3Calibration calibration;
+  I3DetectorStatus status;
+  FillDOM(calibration, status, OMKey(1, 1), 1400*I3Units::V);
+  FillDOM(calibration, status, OMKey(1, 2), 0.);
+  // calibration without status is not compiled
+  calibration.domCal[OMKey(1, 3)] = I3DOMCalibration();
+
+  I3CompiledCalibration compiled(calibration, status);
+  ENSURE_EQUAL(compiled.size(), 2u);
+  ENSURE_EQUAL(compiled.GetIndex(OMKey(1, 3)), I3CompiledCalibration::npos);
+  ENSURE_EQUAL(compiled.GetIndex(OMKey(2, 1)), I3CompiledCalibration::npos);
+
+  // switched-off DOMs have no gain
+  size_t off = compiled.GetIndex(OMKey(1, 2));
+  ENSURE_EQUAL(compiled.GetPMTGain(off), 0.);
+  ENSURE(std::isnan(compiled.GetSPEMean(off)), "SPEMean of a DOM without HV is NAN");
+
+  // recompiling replaces the previous contents
+  status.domStatus.erase(OMKey(1, 1));
+  compiled.Compile(calibration, status);
+  ENSURE_EQUAL(compiled.size(), 1u);
+  ENSURE_EQUAL(compiled.GetIndex(OMKey(1, 2)), 0u);
+}
@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include <sstream>
+
+#include "dataclasses/I3FlatMap.h"
+#include "dataclasses/physics/I3RecoPulse.h"
+#include "icetray/serialization.h"
+
+namespace {
+
+  template <typename T>
+  std::string Serialize(const T& object)
+  {
+    std::ostringstream oss;
+    {
+      icecube::archive::portable_binary_oarchive oa(oss);
+      oa << object;
+    }
+    return oss.str();
+  }
+
+  template <typename T>
+  T Deserialize(const std::string& blob)
+  {
+    T object;
+    std::istringstream iss(blob);
+    icecube::archive::portable_binary_iarchive ia(iss);
+    ia >> object;
+    return object;
+  }
+
+  I3RecoPulseSeriesMap MakePulses()
+  {
+    I3RecoPulseSeriesMap pulses;
+    for (int string = 3; string > 0; string--) {
+      for (unsigned om = 1; om <= 10; om += 3) {
+        I3RecoPulseSeries& series = pulses[OMKey(string, om)];
+        // more pulses than fit in the inline buffer on some DOMs
+        for (unsigned i = 0; i < om; i++) {
+          I3RecoPulse pulse;
+          pulse.SetTime(100.*i + om);
+          pulse.SetCharge(0.5*string);
+          pulse.SetWidth(3.3);
+          series.push_back(pulse);
+        }
+      }
+    }
+    return pulses;
+  }
+
+}
+
+TEST_GROUP(I3FlatMap);
+
+TEST(MapInterface)
+{
+  I3FlatMap<OMKey, double> map;
+  ENSURE(map.empty());
+  map[OMKey(2, 1)] = 2.;
+  map[OMKey(1, 1)] = 1.;
+  map[OMKey(3, 1)] = 3.;
+  ENSURE(!map.insert(std::make_pair(OMKey(1, 1), 5.)).second,
+         "existing keys are not replaced");
+  ENSURE(map.insert(std::make_pair(OMKey(1, 2), 1.5)).second);
+
+  ENSURE_EQUAL(map.size(), 4u);
+  OMKey last;
+  for (const auto& entry : map) {
+    ENSURE(last < entry.first, "entries are sorted");
+    last = entry.first;
+  }
+  ENSURE_EQUAL(map.at(OMKey(1, 1)), 1.);
+  ENSURE_EQUAL(map.count(OMKey(1, 2)), 1u);
+  ENSURE(map.find(OMKey(4, 1)) == map.end());
+
+  ENSURE_EQUAL(map.erase(OMKey(1, 2)), 1u);
+  ENSURE_EQUAL(map.erase(OMKey(1, 2)), 0u);
+  ENSURE_EQUAL(map.size(), 3u);
+}
+
+TEST(SameBytesAsI3Map)
+{
+  I3RecoPulseSeriesMap pulses = MakePulses();
+  I3RecoPulseSeriesFlatMap flat(pulses);
+  ENSURE_EQUAL(flat.size(), pulses.size());
+  ENSURE_EQUAL(Serialize(flat), Serialize(pulses));
+
+  I3Map<OMKey, double> charges;
+  charges[OMKey(7, 3)] = 1.5;
+  charges[OMKey(1, 60)] = 0.25;
+  ENSURE_EQUAL(Serialize(I3FlatMap<OMKey, double>(charges)), Serialize(charges));
+}
+
+TEST(CrossLoad)
+{
+  I3RecoPulseSeriesMap pulses = MakePulses();
+
+  I3RecoPulseSeriesFlatMap flat =
+    Deserialize<I3RecoPulseSeriesFlatMap>(Serialize(pulses));
+  ENSURE_EQUAL(flat.size(), pulses.size());
+  for (const auto& entry : pulses) {
+    const auto& series = flat.at(entry.first);
+    ENSURE_EQUAL(series.size(), entry.second.size());
+    ENSURE(std::equal(series.begin(), series.end(), entry.second.begin()));
+  }
+
+  I3RecoPulseSeriesMap restored =
+    Deserialize<I3RecoPulseSeriesMap>(Serialize(flat));
+  ENSURE(restored == pulses);
+
+  I3RecoPulseSeriesMap copied;
+  flat.CopyTo(copied);
+  ENSURE(copied == pulses);
+}
@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include <sstream>
+
+#include "dataclasses/I3GCDDelta.h"
+#include "dataclasses/calibration/I3CompiledCalibration.h"
+#include "icetray/I3Units.h"
+#include "icetray/serialization.h"
+
+namespace {
+
+  template <typename T>
+  boost::shared_ptr<T> RoundTrip(const T& object)
+  {
+    std::ostringstream oss;
+    {
+      icecube::archive::portable_binary_oarchive oa(oss);
+      oa << object;
+    }
+    boost::shared_ptr<T> restored(new T);
+    std::istringstream iss(oss.str());
+    icecube::archive::portable_binary_iarchive ia(iss);
+    ia >> *restored;
+    return restored;
+  }
+
+  void FillGCD(I3Geometry& geometry, I3Calibration& calibration,
+               I3DetectorStatus& status)
+  {
+    for (int string = 1; string <= 4; string++) {
+      for (unsigned om = 1; om <= 60; om++) {
+        const OMKey key(string, om);
+        geometry.omgeo[key].position = I3Position(10.*string, 0, -17.*om);
+
+        I3DOMCalibration& cal = calibration.domCal[key];
+        LinearFit hvgain;
+        hvgain.slope = 7.08;
+        hvgain.intercept = -15.2 + 0.001*om;
+        cal.SetHVGainFit(hvgain);
+        cal.SetRelativeDomEff(1.0);
+
+        status.domStatus[key].pmtHV = (1200. + om)*I3Units::V;
+      }
+    }
+    geometry.stationgeo[1].resize(2);
+    status.triggerStatus[TriggerKey(TriggerKey::IN_ICE, TriggerKey::SIMPLE_MULTIPLICITY, 1011)];
+    calibration.startTime = I3Time(2024, 0);
+    calibration.endTime = I3Time(2025, 0);
+  }
+
+}
+
+TEST_GROUP(I3GCDDelta);
+
+TEST(MapDelta)
+{
+  std::map<int, double> base, current;
+  for (int i = 0; i < 10; i++)
+    base[i] = current[i] = i;
+  current[3] = 30.;
+  current.erase(5);
+  current[12] = 1.;
+
+  I3MapDelta<int, double> delta(base, current);
+  ENSURE_EQUAL(delta.changed.size(), 2u);
+  ENSURE_EQUAL(delta.removed.size(), 1u);
+  ENSURE_EQUAL(delta.removed[0], 5);
+
+  std::vector<int> keys = delta.GetKeys();
+  ENSURE_EQUAL(keys.size(), 3u);
+  ENSURE_EQUAL(keys[0], 3);
+  ENSURE_EQUAL(keys[1], 5);
+  ENSURE_EQUAL(keys[2], 12);
+
+  ENSURE(I3MapDeltaKeys(base, current) == keys);
+
+  delta.Apply(base);
+  ENSURE(base == current, "applying a delta to its base gives the current map");
+  I3MapDelta<int, double> none(base, current);
+  ENSURE(none.empty());
+}
+
+TEST(ApplyRestoresGCD)
+{
+  I3Geometry geometry;
+  I3Calibration calibration;
+  I3DetectorStatus status;
+  FillGCD(geometry, calibration, status);
+
+  I3Geometry newGeometry(geometry);
+  I3Calibration newCalibration(calibration);
+  I3DetectorStatus newStatus(status);
+  newGeometry.omgeo[OMKey(2, 7)].position.SetZ(-100);
+  newGeometry.omgeo.erase(OMKey(4, 60));
+  newGeometry.endTime = I3Time(2030, 0);
+  newCalibration.domCal[OMKey(3, 3)].SetRelativeDomEff(1.35);
+  newCalibration.domCal.erase(OMKey(1, 1));
+  newStatus.domStatus[OMKey(3, 4)].pmtHV = 1500*I3Units::V;
+  newStatus.daqConfigurationName = "sps-IC86-test";
+
+  I3GeometryDelta geoDelta(geometry, newGeometry);
+  I3CalibrationDelta calDelta(calibration, newCalibration);
+  I3DetectorStatusDelta statusDelta(status, newStatus);
+  ENSURE_EQUAL(geoDelta.GetOMKeys().size(), 2u);
+  ENSURE_EQUAL(calDelta.GetDOMKeys().size(), 2u);
+  ENSURE_EQUAL(statusDelta.GetDOMKeys().size(), 1u);
+  ENSURE(statusDelta.triggerStatus.empty());
+
+  ENSURE(*geoDelta.Apply(geometry) == newGeometry);
+  ENSURE(*calDelta.Apply(calibration) == newCalibration);
+  ENSURE(*statusDelta.Apply(status) == newStatus);
+
+  // the serialized deltas restore to the same deltas
+  ENSURE(*RoundTrip(geoDelta) == geoDelta);
+  ENSURE(*RoundTrip(calDelta) == calDelta);
+  ENSURE(*RoundTrip(statusDelta) == statusDelta);
+}
+
+TEST(CompiledCalibrationUpdate)
+{
+  I3Geometry geometry;
+  I3Calibration calibration;
+  I3DetectorStatus status;
+  FillGCD(geometry, calibration, status);
+  I3CompiledCalibration compiled(calibration, status);
+
+  I3Calibration newCalibration(calibration);
+  I3DetectorStatus newStatus(status);
+  LinearFit hvgain = newCalibration.domCal[OMKey(2, 2)].GetHVGainFit();
+  hvgain.intercept += 0.1;
+  newCalibration.domCal[OMKey(2, 2)].SetHVGainFit(hvgain);
+  newStatus.domStatus[OMKey(1, 9)].pmtHV = 1400*I3Units::V;
+
+  std::vector<OMKey> changed = I3CalibrationDelta(calibration, newCalibration).GetDOMKeys();
+  std::vector<OMKey> statusChanged = I3DetectorStatusDelta(status, newStatus).GetDOMKeys();
+  changed.insert(changed.end(), statusChanged.begin(), statusChanged.end());
+  compiled.Update(newCalibration, newStatus, changed);
+
+  I3CompiledCalibration expected(newCalibration, newStatus);
+  ENSURE_EQUAL(compiled.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    ENSURE(compiled.GetKeys()[i] == expected.GetKeys()[i]);
+    ENSURE_EQUAL(compiled.GetPMTGain(i), expected.GetPMTGain(i));
+    ENSURE_EQUAL(compiled.GetSPEMean(i), expected.GetSPEMean(i));
+  }
+
+  // a DOM that disappears forces a full recompilation
+  newStatus.domStatus.erase(OMKey(4, 4));
+  compiled.Update(newCalibration, newStatus, std::vector<OMKey>(1, OMKey(4, 4)));
+  ENSURE_EQUAL(compiled.size(), expected.size() - 1);
+  ENSURE_EQUAL(compiled.GetIndex(OMKey(4, 4)), I3CompiledCalibration::npos);
+}
@@ -643,6 +643,43 @@ TEST(XOr)
 	ENSURE_EQUAL(mask_3.GetSum(), 0u);
 }
 
+static bool
+In67Window(const OMKey &key, unsigned idx, const I3RecoPulse &p)
+{
+	return key.GetString() == 67 && p.GetTime() >= 12 && p.GetTime() <= 15;
+}
+
+TEST(TimeWindow)
+{
+	I3RecoPulseSeriesMapPtr pulses = manufacture_pulsemap();
+	I3Frame frame;
+	frame.Put("foo", pulses);
+
+	/* Window on a subset of DOMs matches the equivalent predicate */
+	std::vector<OMKey> doms;
+	doms.push_back(OMKey(67, 12));
+	doms.push_back(OMKey(1, 1));
+	I3RecoPulseSeriesMapMask window(frame, "foo", 12, 15, doms);
+	I3RecoPulseSeriesMapMask predicate(frame, "foo", In67Window);
+	ENSURE(window == predicate);
+	ENSURE_EQUAL(window.GetSum(), 4u);
+
+	I3RecoPulseSeriesMapConstPtr masked = window.Apply(frame);
+	ENSURE_EQUAL(masked->size(), 1u);
+	ENSURE_EQUAL(masked->begin()->second.size(), 4u);
+	ENSURE_EQUAL(masked->begin()->second.front().GetTime(), 12.0);
+
+	/* An empty DOM list selects all DOMs */
+	I3RecoPulseSeriesMapMask all(frame, "foo", 1, 2);
+	ENSURE_EQUAL(all.GetSum(), 4u);
+	ENSURE_EQUAL(all.Apply(frame)->size(), 2u);
+
+	/* An empty window leaves no DOMs behind */
+	I3RecoPulseSeriesMapMask none(frame, "foo", 100, 200);
+	ENSURE_EQUAL(none.GetSum(), 0u);
+	ENSURE(none.Apply(frame)->empty());
+}
+
 #define ROUND_UP(num, denom) (num % denom == 0) ? num/denom : (num/denom) + 1
 
 #if 0
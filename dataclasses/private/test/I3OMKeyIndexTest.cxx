@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include <sstream>
+
+#include "dataclasses/geometry/I3OMKeyIndex.h"
+#include "dataclasses/physics/I3RecoPulse.h"
+#include "icetray/serialization.h"
+
+namespace {
+
+  I3OMGeoMap MakeGeometry()
+  {
+    I3OMGeoMap omgeo;
+    for (int string = 1; string <= 3; string++)
+      for (unsigned om = 1; om <= 60; om++)
+        omgeo[OMKey(string, om)].position = I3Position(string, 0, om);
+    // IceTop DOMs, with a gap in the OM numbers
+    omgeo[OMKey(1, 61)];
+    omgeo[OMKey(1, 63)];
+    // a multi-PMT module on a far string
+    for (unsigned char pmt = 0; pmt < 24; pmt++)
+      omgeo[OMKey(89, 5, pmt)];
+    return omgeo;
+  }
+
+}
+
+TEST_GROUP(I3OMKeyIndex);
+
+TEST(DenseIndex)
+{
+  I3OMGeoMap omgeo = MakeGeometry();
+  I3OMKeyIndex index(omgeo);
+  ENSURE_EQUAL(index.size(), omgeo.size());
+
+  size_t i = 0;
+  for (const auto& pair : omgeo) {
+    ENSURE_EQUAL(index.GetIndex(pair.first), i);
+    ENSURE(index.GetKey(i) == pair.first);
+    i++;
+  }
+
+  ENSURE_EQUAL(index.GetIndex(OMKey(1, 62)), I3OMKeyIndex::npos);
+  ENSURE_EQUAL(index.GetIndex(OMKey(1, 0)), I3OMKeyIndex::npos);
+  ENSURE_EQUAL(index.GetIndex(OMKey(4, 1)), I3OMKeyIndex::npos);
+  ENSURE_EQUAL(index.GetIndex(OMKey(-1, 1)), I3OMKeyIndex::npos);
+  ENSURE_EQUAL(index.GetIndex(OMKey(1, 1, 1)), I3OMKeyIndex::npos);
+  ENSURE_EQUAL(index.GetIndex(OMKey(89, 5, 24)), I3OMKeyIndex::npos);
+  ENSURE(index.Contains(OMKey(89, 5, 23)));
+
+  I3OMKeyIndex empty;
+  ENSURE_EQUAL(empty.GetIndex(OMKey(1, 1)), I3OMKeyIndex::npos);
+}
+
+TEST(FlattenAndForEach)
+{
+  I3OMGeoMap omgeo = MakeGeometry();
+  I3OMKeyIndex index(omgeo);
+
+  std::vector<I3OMGeo> flat = index.Flatten(omgeo);
+  ENSURE_EQUAL(flat.size(), index.size());
+  ENSURE(flat[index.GetIndex(OMKey(2, 30))].position == I3Position(2, 0, 30));
+
+  I3RecoPulseSeriesMap pulses;
+  pulses[OMKey(1, 1)].push_back(I3RecoPulse());
+  pulses[OMKey(2, 5)].push_back(I3RecoPulse());
+  pulses[OMKey(7, 7)].push_back(I3RecoPulse());
+  pulses[OMKey(89, 5, 3)].push_back(I3RecoPulse());
+
+  std::vector<size_t> visited;
+  index.ForEach(pulses, [&](size_t i, const I3RecoPulseSeriesMap::value_type& pair) {
+      ENSURE_EQUAL(i, index.GetIndex(pair.first));
+      visited.push_back(i);
+    });
+  ENSURE_EQUAL(visited.size(), pulses.size());
+  ENSURE_EQUAL(visited[2], I3OMKeyIndex::npos);
+}
+
+TEST(Serialization)
+{
+  I3OMKeyIndex index(MakeGeometry());
+
+  std::ostringstream oss;
+  {
+    icecube::archive::portable_binary_oarchive oa(oss);
+    oa << index;
+  }
+  I3OMKeyIndex restored;
+  {
+    std::istringstream iss(oss.str());
+    icecube::archive::portable_binary_iarchive ia(iss);
+    ia >> restored;
+  }
+
+  ENSURE(restored == index);
+  for (size_t i = 0; i < index.size(); i++)
+    ENSURE_EQUAL(restored.GetIndex(index.GetKey(i)), i);
+}
@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include "dataclasses/calibration/SPEChargeDistribution.h"
+
+TEST_GROUP(SPEChargeDistribution);
+
+TEST(BatchedEvaluation)
+{
+  SPEChargeDistribution spe(6.9, 0.032, 0.56, 0.41, 0.76, 1.03, 0.28, 1.3, 1.02);
+
+  std::vector<double> q;
+  for (double charge = 0.; charge < 4.; charge += 0.013)
+    q.push_back(charge);
+
+  std::vector<double> batched = spe.Evaluate(q);
+  ENSURE_EQUAL(batched.size(), q.size());
+  for (size_t i = 0; i < q.size(); i++)
+    ENSURE_DISTANCE(batched[i], spe(q[i]), 1e-12*spe(q[i]));
+
+  std::vector<double> out(q.size());
+  for (const SPEChargeDistribution::PDFPtr& pdf : spe.PDFs) {
+    pdf->Probabilities(q.data(), out.data(), q.size());
+    for (size_t i = 0; i < q.size(); i++)
+      ENSURE_DISTANCE(out[i], pdf->Probability(q[i]), 1e-12*pdf->Probability(q[i]));
+    pdf->Weights(q.data(), out.data(), q.size());
+    for (size_t i = 0; i < q.size(); i++)
+      ENSURE_DISTANCE(out[i], pdf->Weight(q[i]), 1e-12*pdf->Weight(q[i]));
+  }
+
+  // without residuals the distribution is the plain sum of its components
+  SPEChargeDistribution plain;
+  plain.PDFs = spe.PDFs;
+  plain.Evaluate(q.data(), out.data(), q.size());
+  for (size_t i = 0; i < q.size(); i++) {
+    double sum = 0;
+    for (const SPEChargeDistribution::PDFPtr& pdf : spe.PDFs)
+      sum += pdf->Weight(q[i]);
+    ENSURE_DISTANCE(out[i], sum, 1e-12*sum);
+  }
+}
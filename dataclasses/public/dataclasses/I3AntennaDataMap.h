@@ -21,4 +21,13 @@
 typedef I3Map<AntennaKey, I3AntennaChannelMap> I3AntennaDataMap;  //Cluster of ChannelMaps
 I3_POINTER_TYPEDEFS(I3AntennaDataMap);
 
+namespace fft {
+
+//Bring the frequency spectra (time series) of all channels of all antennas
+//up to date, transforming channels of equal length in one batched FFT
+void UpdateAllFrequencySpectra(I3AntennaDataMap& data);
+void UpdateAllTimeSeries(I3AntennaDataMap& data);
+
+} //fft
+
 #endif
@@ -0,0 +1,276 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef DATACLASSES_I3FLATMAP_H_INCLUDED
+#define DATACLASSES_I3FLATMAP_H_INCLUDED
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <icetray/serialization.h>
+#include <icetray/I3Logging.h>
+#include <icetray/I3FrameObject.h>
+#include <serialization/collections_save_imp.hpp>
+#include <serialization/collections_load_imp.hpp>
+#include <serialization/split_member.hpp>
+#include <dataclasses/I3Map.h>
+#include <dataclasses/I3SmallVector.h>
+
+#include <boost/lexical_cast.hpp>
+
+namespace I3FlatMapDetail {
+
+  /**
+   * Stands in for the std::map base of an I3Map in the archive. It has the
+   * same serialization traits as std::map (class info, version 0, no
+   * tracking) and writes the same element count and items, so the bytes of
+   * an I3FlatMap and of the equivalent I3Map are identical.
+   */
+  template <typename Container>
+  struct MapPayload
+  {
+    explicit MapPayload(Container& c) : elements(c) {}
+    Container& elements;
+
+    template <class Archive>
+    void save(Archive& ar, unsigned version) const
+    {
+      icecube::serialization::stl::save_collection<Archive, Container>(ar, elements);
+    }
+
+    template <class Archive>
+    void load(Archive& ar, unsigned version)
+    {
+      icecube::serialization::stl::load_collection<Archive, Container,
+        icecube::serialization::stl::archive_input_seq<Archive, Container>,
+        icecube::serialization::stl::reserve_imp<Container> >(ar, elements);
+    }
+
+    I3_SERIALIZATION_SPLIT_MEMBER();
+  };
+
+  // values are converted either directly or element-wise, e.g. from a
+  // std::vector to an I3SmallVector
+  template <typename To, typename From>
+  To convert(const From& from)
+  {
+    if constexpr (std::is_constructible<To, const From&>::value)
+      return To(from);
+    else
+      return To(from.begin(), from.end());
+  }
+
+}
+
+/**
+ * @brief A sorted, contiguous alternative to I3Map.
+ *
+ * The entries live in a single vector ordered by key, so an event with a
+ * few dozen keys costs one allocation instead of one tree node per key, and
+ * iteration is a linear scan. Lookups are binary searches; insertion and
+ * erasure in the middle are linear, so the map is best filled in key order
+ * (or with Insert() followed by nothing but reads).
+ *
+ * Paired with an I3SmallVector value (see I3RecoPulseSeriesFlatMap) the
+ * payload of a typical DOM needs no allocation of its own.
+ *
+ * I3FlatMap<Key, Value> is written exactly like I3Map<Key, Value>, or
+ * like I3Map<Key, std::vector<T>> if Value is an I3SmallVector<T, N>,
+ * so either can be read from an archive of the other.
+ */
+template <typename Key, typename Value>
+class I3FlatMap : public I3FrameObject
+{
+public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef std::pair<Key, Value> value_type;
+  typedef std::vector<value_type> container_type;
+  typedef typename container_type::size_type size_type;
+  typedef typename container_type::iterator iterator;
+  typedef typename container_type::const_iterator const_iterator;
+
+  I3FlatMap() {}
+
+  /// Copy an I3Map (or any std::map) with convertible values
+  template <typename MapValue, typename Compare, typename Allocator>
+  explicit I3FlatMap(const std::map<Key, MapValue, Compare, Allocator>& map)
+  {
+    elements_.reserve(map.size());
+    for (const auto& entry : map)
+      elements_.emplace_back(entry.first,
+                             I3FlatMapDetail::convert<Value>(entry.second));
+  }
+
+  /// Copy the contents into an I3Map (or any std::map) with convertible values
+  template <typename MapValue, typename Compare, typename Allocator>
+  void CopyTo(std::map<Key, MapValue, Compare, Allocator>& map) const
+  {
+    map.clear();
+    for (const value_type& entry : elements_)
+      map.emplace_hint(map.end(), entry.first,
+                       I3FlatMapDetail::convert<MapValue>(entry.second));
+  }
+
+  iterator begin() { return elements_.begin(); }
+  iterator end() { return elements_.end(); }
+  const_iterator begin() const { return elements_.begin(); }
+  const_iterator end() const { return elements_.end(); }
+
+  size_type size() const { return elements_.size(); }
+  bool empty() const { return elements_.empty(); }
+  void clear() { elements_.clear(); }
+  void reserve(size_type n) { elements_.reserve(n); }
+
+  iterator lower_bound(const Key& key)
+  {
+    return std::lower_bound(elements_.begin(), elements_.end(), key, KeyLess());
+  }
+
+  const_iterator lower_bound(const Key& key) const
+  {
+    return std::lower_bound(elements_.begin(), elements_.end(), key, KeyLess());
+  }
+
+  iterator upper_bound(const Key& key)
+  {
+    return std::upper_bound(elements_.begin(), elements_.end(), key, KeyLess());
+  }
+
+  const_iterator upper_bound(const Key& key) const
+  {
+    return std::upper_bound(elements_.begin(), elements_.end(), key, KeyLess());
+  }
+
+  iterator find(const Key& key)
+  {
+    iterator it = lower_bound(key);
+    return (it != end() && !(key < it->first)) ? it : end();
+  }
+
+  const_iterator find(const Key& key) const
+  {
+    const_iterator it = lower_bound(key);
+    return (it != end() && !(key < it->first)) ? it : end();
+  }
+
+  size_type count(const Key& key) const { return find(key) != end() ? 1 : 0; }
+
+  /**
+   * Insert an entry unless its key is already present. Appending in key
+   * order is amortized constant time.
+   */
+  std::pair<iterator, bool> insert(const value_type& value)
+  {
+    if (elements_.empty() || elements_.back().first < value.first) {
+      elements_.push_back(value);
+      return std::make_pair(elements_.end() - 1, true);
+    }
+    iterator it = lower_bound(value.first);
+    if (it != end() && !(value.first < it->first))
+      return std::make_pair(it, false);
+    return std::make_pair(elements_.insert(it, value), true);
+  }
+
+  Value& operator[](const Key& key)
+  {
+    if (elements_.empty() || elements_.back().first < key) {
+      elements_.emplace_back(key, Value());
+      return elements_.back().second;
+    }
+    iterator it = lower_bound(key);
+    if (it == end() || key < it->first)
+      it = elements_.insert(it, value_type(key, Value()));
+    return it->second;
+  }
+
+  const Value& at(const Key& where) const
+  {
+    const_iterator iter = find(where);
+    if (iter == end())
+      log_fatal("Map contains nothing at %s.", boost::lexical_cast<std::string>(where).c_str());
+    return iter->second;
+  }
+
+  Value& at(const Key& where)
+  {
+    iterator iter = find(where);
+    if (iter == end())
+      log_fatal("Map contains nothing at %s.", boost::lexical_cast<std::string>(where).c_str());
+    return iter->second;
+  }
+
+  iterator erase(const_iterator pos) { return elements_.erase(pos); }
+
+  size_type erase(const Key& key)
+  {
+    iterator it = find(key);
+    if (it == end())
+      return 0;
+    elements_.erase(it);
+    return 1;
+  }
+
+  bool operator==(const I3FlatMap& rhs) const { return elements_ == rhs.elements_; }
+  bool operator!=(const I3FlatMap& rhs) const { return !operator==(rhs); }
+
+  std::ostream& Print(std::ostream& os) const override
+  {
+    os << '[' << size() << " element" << (size()==1?"":"s") << ']';
+    return os;
+  }
+
+private:
+  struct KeyLess
+  {
+    bool operator()(const value_type& a, const Key& b) const { return a.first < b; }
+    bool operator()(const Key& a, const value_type& b) const { return a < b.first; }
+  };
+
+  container_type elements_;
+
+  friend class icecube::serialization::access;
+
+  template <class Archive>
+  void save(Archive& ar, unsigned version) const
+  {
+    ar & make_nvp("I3FrameObject", base_object<I3FrameObject>(*this));
+    const I3FlatMapDetail::MapPayload<container_type>
+      payload(const_cast<container_type&>(elements_));
+    ar & make_nvp("map", payload);
+  }
+
+  template <class Archive>
+  void load(Archive& ar, unsigned version)
+  {
+    ar & make_nvp("I3FrameObject", base_object<I3FrameObject>(*this));
+    I3FlatMapDetail::MapPayload<container_type> payload(elements_);
+    ar & make_nvp("map", payload);
+
+    // archives written from an I3Map are already sorted and unique
+    if (!std::is_sorted(elements_.begin(), elements_.end(),
+                        [](const value_type& a, const value_type& b) { return a.first < b.first; })) {
+      std::stable_sort(elements_.begin(), elements_.end(),
+                       [](const value_type& a, const value_type& b) { return a.first < b.first; });
+      elements_.erase(std::unique(elements_.begin(), elements_.end(),
+                                  [](const value_type& a, const value_type& b) {
+                                    return !(a.first < b.first) && !(b.first < a.first);
+                                  }), elements_.end());
+    }
+  }
+
+  I3_SERIALIZATION_SPLIT_MEMBER();
+};
+
+template <typename Key, typename Value>
+std::ostream& operator<<(std::ostream& os, const I3FlatMap<Key, Value>& map)
+{
+  return map.Print(os);
+}
+
+#endif // DATACLASSES_I3FLATMAP_H_INCLUDED
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef I3GCDDELTA_H_INCLUDED
+#define I3GCDDELTA_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+#include <icetray/I3FrameObject.h>
+#include <icetray/I3DefaultName.h>
+#include <dataclasses/I3MapDelta.h>
+#include <dataclasses/I3Time.h>
+#include <dataclasses/geometry/I3Geometry.h>
+#include <dataclasses/calibration/I3Calibration.h>
+#include <dataclasses/status/I3DetectorStatus.h>
+
+/**
+ * @file I3GCDDelta.h
+ *
+ * Delta encodings of I3Geometry, I3Calibration and I3DetectorStatus
+ * relative to a base object. Each delta keeps the entries of the per-DOM
+ * (per-station, per-trigger, ...) maps that were added, modified or removed,
+ * plus the small scalar members in full. Apply() rebuilds the complete
+ * object from the base it was made against, and the Get...Keys() functions
+ * tell consumers which entries they have to recompute.
+ *
+ * A delta does not know its base. Writers have to store it next to, or
+ * after, the frame holding the base object.
+ */
+
+static const unsigned i3geometrydelta_version_ = 0;
+
+class I3GeometryDelta : public I3FrameObject
+{
+public:
+  I3GeometryDelta();
+  I3GeometryDelta(const I3Geometry& base, const I3Geometry& current);
+  ~I3GeometryDelta();
+
+  I3MapDelta<OMKey, I3OMGeo> omgeo;
+  I3MapDelta<int, I3StationGeo> stationgeo;
+  I3MapDelta<ScintKey, I3ScintGeo> scintgeo;
+  I3MapDelta<AntennaKey, I3AntennaGeo> antennageo;
+  I3MapDelta<IceActKey, I3IceActGeo> iceactgeo;
+  I3Geometry::SnowHeightProvenance snowHeightProvenance;
+  I3Time startTime;
+  I3Time endTime;
+
+  /// The geometry this delta was made from, given its base
+  I3GeometryPtr Apply(const I3Geometry& base) const;
+
+  /// OMs whose geometry was added, modified or removed
+  std::vector<OMKey> GetOMKeys() const { return omgeo.GetKeys(); }
+
+  bool operator==(const I3GeometryDelta& rhs) const;
+  bool operator!=(const I3GeometryDelta& rhs) const { return !operator==(rhs); }
+
+private:
+  friend class icecube::serialization::access;
+  template <class Archive> void serialize(Archive & ar, unsigned version);
+};
+
+I3_CLASS_VERSION(I3GeometryDelta, i3geometrydelta_version_);
+I3_DEFAULT_NAME(I3GeometryDelta);
+I3_POINTER_TYPEDEFS(I3GeometryDelta);
+
+static const unsigned i3calibrationdelta_version_ = 0;
+
+class I3CalibrationDelta : public I3FrameObject
+{
+public:
+  I3CalibrationDelta();
+  I3CalibrationDelta(const I3Calibration& base, const I3Calibration& current);
+  ~I3CalibrationDelta();
+
+  I3MapDelta<OMKey, I3DOMCalibration> domCal;
+  I3MapDelta<OMKey, I3VEMCalibration> vemCal;
+  I3Time startTime;
+  I3Time endTime;
+
+  /// The calibration this delta was made from, given its base
+  I3CalibrationPtr Apply(const I3Calibration& base) const;
+
+  /// DOMs whose I3DOMCalibration was added, modified or removed
+  std::vector<OMKey> GetDOMKeys() const { return domCal.GetKeys(); }
+
+  bool operator==(const I3CalibrationDelta& rhs) const;
+  bool operator!=(const I3CalibrationDelta& rhs) const { return !operator==(rhs); }
+
+private:
+  friend class icecube::serialization::access;
+  template <class Archive> void serialize(Archive & ar, unsigned version);
+};
+
+I3_CLASS_VERSION(I3CalibrationDelta, i3calibrationdelta_version_);
+I3_DEFAULT_NAME(I3CalibrationDelta);
+I3_POINTER_TYPEDEFS(I3CalibrationDelta);
+
+static const unsigned i3detectorstatusdelta_version_ = 0;
+
+class I3DetectorStatusDelta : public I3FrameObject
+{
+public:
+  I3DetectorStatusDelta();
+  I3DetectorStatusDelta(const I3DetectorStatus& base, const I3DetectorStatus& current);
+  ~I3DetectorStatusDelta();
+
+  I3MapDelta<OMKey, I3DOMStatus> domStatus;
+  I3MapDelta<TriggerKey, I3TriggerStatus> triggerStatus;
+  std::string daqConfigurationName;
+  I3Time startTime;
+  I3Time endTime;
+
+  /// The detector status this delta was made from, given its base
+  I3DetectorStatusPtr Apply(const I3DetectorStatus& base) const;
+
+  /// DOMs whose I3DOMStatus was added, modified or removed
+  std::vector<OMKey> GetDOMKeys() const { return domStatus.GetKeys(); }
+
+  bool operator==(const I3DetectorStatusDelta& rhs) const;
+  bool operator!=(const I3DetectorStatusDelta& rhs) const { return !operator==(rhs); }
+
+private:
+  friend class icecube::serialization::access;
+  template <class Archive> void serialize(Archive & ar, unsigned version);
+};
+
+I3_CLASS_VERSION(I3DetectorStatusDelta, i3detectorstatusdelta_version_);
+I3_DEFAULT_NAME(I3DetectorStatusDelta);
+I3_POINTER_TYPEDEFS(I3DetectorStatusDelta);
+
+#endif // I3GCDDELTA_H_INCLUDED
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef I3MAPDELTA_H_INCLUDED
+#define I3MAPDELTA_H_INCLUDED
+
+#include <map>
+#include <vector>
+
+#include <icetray/serialization.h>
+
+/**
+ * The keys whose entries differ between two sorted maps: keys that were
+ * added, removed, or whose values are not equal. Unlike I3MapDelta, no
+ * values are copied.
+ */
+template <typename Map>
+std::vector<typename Map::key_type>
+I3MapDeltaKeys(const Map& base, const Map& current)
+{
+  std::vector<typename Map::key_type> keys;
+  typename Map::const_iterator b = base.begin();
+  typename Map::const_iterator c = current.begin();
+  while (b != base.end() || c != current.end()) {
+    if (c == current.end() || (b != base.end() && b->first < c->first)) {
+      keys.push_back((b++)->first);
+    } else if (b == base.end() || c->first < b->first) {
+      keys.push_back((c++)->first);
+    } else {
+      if (!(b->second == c->second))
+        keys.push_back(c->first);
+      ++b;
+      ++c;
+    }
+  }
+  return keys;
+}
+
+/**
+ * @brief The difference between two sorted maps with the same key and value
+ * types.
+ *
+ * A delta holds the entries of the current map that are new or differ from
+ * the base map, and the keys of the base map that are gone. Applying it to
+ * the base map gives back the current map. Both maps are walked once in key
+ * order, so building a delta costs one comparison per entry.
+ */
+template <typename Key, typename Value>
+struct I3MapDelta
+{
+  /// Entries that were added or modified
+  std::map<Key, Value> changed;
+  /// Keys that were removed, sorted
+  std::vector<Key> removed;
+
+  I3MapDelta() {}
+
+  template <typename Map>
+  I3MapDelta(const Map& base, const Map& current)
+  {
+    typename Map::const_iterator b = base.begin();
+    typename Map::const_iterator c = current.begin();
+    while (b != base.end() || c != current.end()) {
+      if (c == current.end() || (b != base.end() && b->first < c->first)) {
+        removed.push_back(b->first);
+        ++b;
+      } else if (b == base.end() || c->first < b->first) {
+        changed.insert(changed.end(), *c);
+        ++c;
+      } else {
+        if (!(b->second == c->second))
+          changed.insert(changed.end(), *c);
+        ++b;
+        ++c;
+      }
+    }
+  }
+
+  bool empty() const { return changed.empty() && removed.empty(); }
+
+  /// Turn the base map into the current map
+  template <typename Map>
+  void Apply(Map& map) const
+  {
+    for (const Key& key : removed)
+      map.erase(key);
+    for (const typename std::map<Key, Value>::value_type& entry : changed)
+      map[entry.first] = entry.second;
+  }
+
+  /// All keys whose entry was added, modified or removed, sorted
+  std::vector<Key> GetKeys() const
+  {
+    std::vector<Key> keys;
+    keys.reserve(changed.size() + removed.size());
+    typename std::map<Key, Value>::const_iterator c = changed.begin();
+    typename std::vector<Key>::const_iterator r = removed.begin();
+    while (c != changed.end() || r != removed.end()) {
+      if (r == removed.end() || (c != changed.end() && c->first < *r))
+        keys.push_back((c++)->first);
+      else
+        keys.push_back(*r++);
+    }
+    return keys;
+  }
+
+  bool operator==(const I3MapDelta& rhs) const
+  {
+    return changed == rhs.changed && removed == rhs.removed;
+  }
+  bool operator!=(const I3MapDelta& rhs) const
+  {
+    return !operator==(rhs);
+  }
+
+  template <class Archive>
+  void serialize(Archive& ar, unsigned version)
+  {
+    ar & make_nvp("Changed", changed);
+    ar & make_nvp("Removed", removed);
+  }
+};
+
+#endif // I3MAPDELTA_H_INCLUDED
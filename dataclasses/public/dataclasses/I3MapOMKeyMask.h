@@ -14,6 +14,7 @@
 #include <functional>
 #include <string>
 #include <list>
+#include <vector>
 #include <boost/foreach.hpp>
 #include <boost/function.hpp>
 #include <boost/dynamic_bitset.hpp>
@@ -47,6 +48,17 @@ public:
  	I3RecoPulseSeriesMapMask(const I3Frame&, const std::string &key,
  	    boost::function<bool (const OMKey&, size_t, const I3RecoPulse&)> predicate);
 
+	/*
+	 * Construct a mask that selects the pulses with times in
+	 * [tmin, tmax] on the DOMs in `doms'. An empty list selects all
+	 * DOMs. The keys of the map are walked once, up to the last
+	 * selected DOM, but only the pulses of the selected DOMs are
+	 * looked at, and no predicate is called per pulse.
+	 */
+	I3RecoPulseSeriesMapMask(const I3Frame&, const std::string &key,
+	    double tmin, double tmax,
+	    const std::vector<OMKey> &doms = std::vector<OMKey>());
+
 	I3RecoPulseSeriesMapMask();
 
 	std::ostream& Print(std::ostream&) const override;
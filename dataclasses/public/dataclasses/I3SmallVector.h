@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef DATACLASSES_I3SMALLVECTOR_H_INCLUDED
+#define DATACLASSES_I3SMALLVECTOR_H_INCLUDED
+
+#include <cstddef>
+
+#include <boost/container/small_vector.hpp>
+
+#include <icetray/serialization.h>
+#include <serialization/collections_save_imp.hpp>
+#include <serialization/collections_load_imp.hpp>
+#include <serialization/split_free.hpp>
+#include <serialization/array.hpp>
+
+/**
+ * A vector that keeps up to N elements inline, without a heap allocation.
+ * It is serialized exactly like a std::vector of the same element type, so
+ * the two can be read from each other's archives.
+ */
+template <typename T, std::size_t N>
+using I3SmallVector = boost::container::small_vector<T, N>;
+
+namespace icecube {
+namespace serialization {
+
+template <class Archive, class T, std::size_t N, class Allocator>
+inline void save(Archive& ar,
+                 const boost::container::small_vector<T, N, Allocator>& t,
+                 const unsigned int /* file_version */, boost::mpl::false_)
+{
+  stl::save_collection<Archive, boost::container::small_vector<T, N, Allocator> >(ar, t);
+}
+
+template <class Archive, class T, std::size_t N, class Allocator>
+inline void load(Archive& ar,
+                 boost::container::small_vector<T, N, Allocator>& t,
+                 const unsigned int /* file_version */, boost::mpl::false_)
+{
+  typedef boost::container::small_vector<T, N, Allocator> container;
+  stl::load_collection<Archive, container,
+                       stl::archive_input_seq<Archive, container>,
+                       stl::reserve_imp<container> >(ar, t);
+}
+
+// bitwise-serializable elements go out as a single array, as for std::vector
+template <class Archive, class T, std::size_t N, class Allocator>
+inline void save(Archive& ar,
+                 const boost::container::small_vector<T, N, Allocator>& t,
+                 const unsigned int /* file_version */, boost::mpl::true_)
+{
+  const collection_size_type count(t.size());
+  ar << I3_SERIALIZATION_NVP(count);
+  if (!t.empty())
+    ar << make_array(t.data(), t.size());
+}
+
+template <class Archive, class T, std::size_t N, class Allocator>
+inline void load(Archive& ar,
+                 boost::container::small_vector<T, N, Allocator>& t,
+                 const unsigned int /* file_version */, boost::mpl::true_)
+{
+  collection_size_type count(t.size());
+  ar >> I3_SERIALIZATION_NVP(count);
+  t.resize(count);
+  if (!t.empty())
+    ar >> make_array(t.data(), t.size());
+}
+
+template <class Archive, class T, std::size_t N, class Allocator>
+inline void save(Archive& ar,
+                 const boost::container::small_vector<T, N, Allocator>& t,
+                 const unsigned int file_version)
+{
+  save(ar, t, file_version,
+       typename use_array_optimization<Archive>::template apply<T>::type());
+}
+
+template <class Archive, class T, std::size_t N, class Allocator>
+inline void load(Archive& ar,
+                 boost::container::small_vector<T, N, Allocator>& t,
+                 const unsigned int file_version)
+{
+  load(ar, t, file_version,
+       typename use_array_optimization<Archive>::template apply<T>::type());
+}
+
+template <class Archive, class T, std::size_t N, class Allocator>
+inline void serialize(Archive& ar,
+                      boost::container::small_vector<T, N, Allocator>& t,
+                      const unsigned int file_version)
+{
+  split_free(ar, t, file_version);
+}
+
+} // namespace serialization
+} // namespace icecube
+
+#endif // DATACLASSES_I3SMALLVECTOR_H_INCLUDED
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef I3COMPILEDCALIBRATION_H_INCLUDED
+#define I3COMPILEDCALIBRATION_H_INCLUDED
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <icetray/OMKey.h>
+#include <dataclasses/Utility.h>
+#include <dataclasses/calibration/I3Calibration.h>
+#include <dataclasses/status/I3DetectorStatus.h>
+
+/**
+ * @brief Per-DOM derived calibration quantities, evaluated once per C/D frame.
+ *
+ * The functions in I3DOMFunctions.h (PMTGain, SPEMean, ATWDSamplingRate,
+ * TransitTime, ...) combine an I3DOMCalibration with an I3DOMStatus every
+ * time they are called. I3CompiledCalibration evaluates them once for every
+ * DOM that is present in both the I3Calibration and the I3DetectorStatus and
+ * stores the results in flat arrays. DOMs are addressed by a dense index,
+ * their position in GetKeys(), so that code which calibrates many launches
+ * per event pays for one lookup per DOM and an array access per quantity.
+ *
+ * Invalid calibrations are stored as they would be returned by
+ * I3DOMFunctions (NAN or 0), but without the log messages emitted there.
+ */
+class I3CompiledCalibration {
+public:
+  static const unsigned int N_ATWD_CHIPS = 2;
+  static const unsigned int N_ATWD_CHANNELS = 3;
+  static const unsigned int N_ATWD_BINS = 128;
+
+  /// Returned by GetIndex() for DOMs that were not compiled
+  static const size_t npos = std::numeric_limits<size_t>::max();
+
+  /**
+   * Scalar quantities of one DOM. The record is aligned to a cache line so
+   * that the quantities needed to calibrate one launch share as few lines as
+   * possible.
+   */
+  struct alignas(64) DOMEntry {
+    double pmtGain;
+    double speMean;
+    double transitTime;
+    double frontEndImpedance;
+    double fadcBaseline;
+    double fadcGain;
+    double fadcBeaconBaseline;
+    double fadcDeltaT;
+    double atwdSamplingRate[N_ATWD_CHIPS];
+    double atwdDeltaT[N_ATWD_CHIPS];
+    double atwdGain[N_ATWD_CHANNELS];
+    double atwdBeaconBaseline[N_ATWD_CHIPS][N_ATWD_CHANNELS];
+    double meanSPECharge;
+  };
+
+  I3CompiledCalibration();
+  I3CompiledCalibration(const I3Calibration& calibration,
+                        const I3DetectorStatus& status);
+
+  /**
+   * Recompute all entries from a new calibration and detector status.
+   * The storage of the previous compilation is reused.
+   */
+  void Compile(const I3Calibration& calibration,
+               const I3DetectorStatus& status);
+
+  /**
+   * Recompute only the entries of the DOMs in changed, e.g. the keys of an
+   * I3CalibrationDelta and an I3DetectorStatusDelta. If a DOM gains or
+   * loses its calibration or status, everything is recompiled.
+   */
+  void Update(const I3Calibration& calibration,
+              const I3DetectorStatus& status,
+              const std::vector<OMKey>& changed);
+
+  /// Number of compiled DOMs
+  size_t size() const { return keys_.size(); }
+  bool empty() const { return keys_.empty(); }
+
+  /// The compiled DOMs, sorted. The position of a key is its dense index.
+  const std::vector<OMKey>& GetKeys() const { return keys_; }
+
+  /// Dense index of a DOM, or npos if it was not compiled
+  size_t GetIndex(const OMKey& key) const;
+
+  const DOMEntry& GetEntry(size_t index) const { return entries_[index]; }
+
+  double GetPMTGain(size_t index) const { return entries_[index].pmtGain; }
+  double GetSPEMean(size_t index) const { return entries_[index].speMean; }
+  double GetTransitTime(size_t index) const { return entries_[index].transitTime; }
+  double GetFrontEndImpedance(size_t index) const { return entries_[index].frontEndImpedance; }
+  double GetFADCBaseline(size_t index) const { return entries_[index].fadcBaseline; }
+  double GetFADCGain(size_t index) const { return entries_[index].fadcGain; }
+  double GetMeanSPECharge(size_t index) const { return entries_[index].meanSPECharge; }
+
+  double GetATWDSamplingRate(size_t index, unsigned int chip) const
+  {
+    return entries_[index].atwdSamplingRate[chip];
+  }
+
+  double GetATWDGain(size_t index, unsigned int channel) const
+  {
+    return entries_[index].atwdGain[channel];
+  }
+
+  double GetATWDBeaconBaseline(size_t index, unsigned int chip,
+                               unsigned int channel) const
+  {
+    return entries_[index].atwdBeaconBaseline[chip][channel];
+  }
+
+  /**
+   * The N_ATWD_BINS bin calibration slopes of one ATWD chip and channel,
+   * contiguous in memory.
+   */
+  const double* GetATWDBinCalibSlopes(size_t index, unsigned int chip,
+                                      unsigned int channel) const
+  {
+    return &atwdBinSlopes_[((index*N_ATWD_CHIPS + chip)*N_ATWD_CHANNELS
+                            + channel)*N_ATWD_BINS];
+  }
+
+private:
+  void CompileEntry(size_t index, const I3DOMCalibration& calibration,
+                    const I3DOMStatus& status);
+
+  std::vector<OMKey> keys_;
+  std::vector<DOMEntry> entries_;
+  std::vector<double> atwdBinSlopes_;
+};
+
+I3_POINTER_TYPEDEFS(I3CompiledCalibration);
+
+#endif // I3COMPILEDCALIBRATION_H_INCLUDED
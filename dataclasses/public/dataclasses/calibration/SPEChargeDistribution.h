@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <algorithm>
 
 static const unsigned SPEChargeDistribution_version_ = 4;
 static const unsigned SPEChargeDistribution_PDF_version_ = 0;
@@ -46,6 +47,23 @@ struct SPEChargeDistribution
     virtual double RelativeNormalization(){return 0;};
     virtual double Probability(double q){return 0;};
     virtual double Weight(double q){return 0;};
+    /// Add Weight(q[i]) to out[i] for n charges
+    virtual void AddWeights(const double* q, double* out, size_t n){
+      for(size_t i=0; i<n; ++i)
+        out[i] += Weight(q[i]);
+    }
+    /// Batched Weight(q), out[i] = Weight(q[i])
+    void Weights(const double* q, double* out, size_t n){
+      std::fill(out, out+n, 0.);
+      AddWeights(q, out, n);
+    }
+    /// Batched Probability(q); the normalization is computed once per call
+    void Probabilities(const double* q, double* out, size_t n){
+      Weights(q, out, n);
+      const double inv_norm = 1. / RelativeNormalization();
+      for(size_t i=0; i<n; ++i)
+        out[i] *= inv_norm;
+    }
     virtual bool IsGaussian(){return false;}
     virtual bool IsExponential(){return false;}
     virtual bool IsValid(){return false;}
@@ -73,6 +91,14 @@ struct SPEChargeDistribution
       double e = (q - mean_) / sigma_;
       return amplitude_ * exp(-.5 * e * e);
     }
+    void AddWeights(const double* q, double* out, size_t n){
+      // branch-free so that the compiler can vectorize the exp
+      const double inv_sigma = 1. / sigma_;
+      for(size_t i=0; i<n; ++i){
+        const double e = (q[i] - mean_) * inv_sigma;
+        out[i] += amplitude_ * std::exp(-.5 * e * e);
+      }
+    }
     template<class rng> double Sample(boost::shared_ptr<rng> random) {return random->Gaus(mean_, sigma_);}
     bool IsGaussian(){return true;}
     bool IsExponential(){return false;}
@@ -109,6 +135,11 @@ struct SPEChargeDistribution
     double Weight(double q){
       return amplitude_ * exp(-q/width_);
     }
+    void AddWeights(const double* q, double* out, size_t n){
+      const double inv_width = 1. / width_;
+      for(size_t i=0; i<n; ++i)
+        out[i] += amplitude_ * std::exp(-q[i] * inv_width);
+    }
     template<class rng> double Sample(boost::shared_ptr<rng> random) {return random->Exp(width_);}
     bool IsGaussian(){return false;}
     bool IsExponential(){return true;}
@@ -214,6 +245,15 @@ struct SPEChargeDistribution
       double y = yL + dydx * ( q - xL );
       return y;
     }
+    /// Multiply out[i] by ComputeResidual(q[i]) for n charges
+    void ApplyResiduals(const double* q, double* out, size_t n) const{
+      if (x.size() == 0){
+        return;
+      }
+      for(size_t i=0; i<n; ++i){
+        out[i] *= ComputeResidual(q[i]);
+      }
+    }
 
   private:
     friend class icecube::serialization::access;
@@ -385,6 +425,22 @@ struct SPEChargeDistribution
     return correction*p;
   }
 
+  /// Batched operator(), out[i] = (*this)(q[i]) for n charges. Each component
+  /// is evaluated over the whole batch at once, with its constants hoisted.
+  void Evaluate(const double* q, double* out, size_t n) const{
+    std::fill(out, out+n, 0.);
+    for(const PDFPtr& pdf: PDFs){
+      pdf->AddWeights(q, out, n);
+    }
+    residuals->ApplyResiduals(q, out, n);
+  }
+
+  std::vector<double> Evaluate(const std::vector<double>& q) const{
+    std::vector<double> out(q.size());
+    Evaluate(q.data(), out.data(), q.size());
+    return out;
+  }
+
 public:
   std::vector<PDFPtr> PDFs;
   double compensation_factor;
@@ -221,6 +221,11 @@ class FFTDataContainer : public I3FrameObject {
     }
   }
 
+  //Bring the frequency spectra (time series) of many containers up to date at
+  //once. Traces of equal length are transformed with a single batched FFT.
+  static void UpdateAllFrequencySpectra(const std::vector<FFTDataContainer<T, F>*>& containers);
+  static void UpdateAllTimeSeries(const std::vector<FFTDataContainer<T, F>*>& containers);
+
   friend std::ostream &operator<<(std::ostream &os, const FFTDataContainer <T, F> &rhs) {
     os << "FFTDataContainer( TimeSeries of length " << rhs.timeSeries_.GetSize()
        << " and FreqSpec of length " << rhs.frequencySpectrum_.GetSize() << " )";
@@ -10,6 +10,12 @@
 //You can request a normalized output in CopyOutOfPlan
 //It is not recommended that you use this class to do FFTs, instead
 //use the wrapper class FFTDataContainer
+//
+//The fftw plans themselves are kept in a process-wide cache keyed by size,
+//type, direction, flags and batch size, so only the first FFTWPlan of a
+//given shape pays for planning. Each FFTWPlan owns its own buffers and runs
+//the shared plan on them, so plans may be used from several threads.
+//FFTW wisdom can be saved and reloaded to skip planning in later jobs.
 
 
 #ifndef RADCUBE_UTIL_FFTWPLAN_H
@@ -18,6 +24,7 @@
 #include <fftw3.h>
 #include <vector>
 #include <complex>
+#include <string>
 
 namespace fft {
 
@@ -32,17 +39,29 @@ enum FFTType {
 const unsigned int GetNCFromNR(unsigned int nReal);
 const unsigned int GetNRFromNC(unsigned int nComp);
 
+//Import/export FFTW wisdom, returns false if the file could not be read/written
+bool LoadWisdom(const std::string& filename);
+bool SaveWisdom(const std::string& filename);
+
+//Destroy all cached plans. No FFTWPlan may be executing while this is called.
+void ClearPlanCache();
+unsigned int GetPlanCacheSize();
+
 } //fft
 
 class FFTWPlan {
  public:
   FFTWPlan() {SetToNull();}
-  FFTWPlan(unsigned int inN, fft::FFTType type, int sign = FFTW_FORWARD, unsigned int flag = FFTW_MEASURE);
+  //With howMany > 1 the plan transforms that many traces of length inN at once,
+  //stored back to back in the arrays passed to CopyIntoPlan/CopyOutOfPlan
+  FFTWPlan(unsigned int inN, fft::FFTType type, int sign = FFTW_FORWARD, unsigned int flag = FFTW_MEASURE,
+           unsigned int howMany = 1);
   ~FFTWPlan() {Free();}
 
   fft::FFTType GetType() {return theType_;}
 
   /////Setters and getters of the information (careful, un-normalized)
+  //n is the total number of bins, i.e. inN times howMany
   void CopyIntoPlan(double * arr, unsigned int n);
   void CopyIntoPlanC(double arr[][2], unsigned int n);
   void CopyIntoPlanC(std::complex<double>* arr, unsigned int n);
@@ -58,7 +77,7 @@ class FFTWPlan {
   void SetToNull(); //Reset the variables
   void Free(); //Safely unallocate using fftw_free
 
-  fftw_plan thePlan_;
+  fftw_plan thePlan_; //Owned by the plan cache
   bool planSet_;
   bool isExecuted_;
 
@@ -66,6 +85,7 @@ class FFTWPlan {
 
   unsigned int inN_;
   unsigned int outN_;
+  unsigned int howMany_;
 
   fftw_complex *inc_, *outc_;
   double *inr_, *outr_;
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef I3OMKEYINDEX_H_INCLUDED
+#define I3OMKEYINDEX_H_INCLUDED
+
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <vector>
+#include <stdint.h>
+
+#include <icetray/I3FrameObject.h>
+#include <icetray/I3DefaultName.h>
+#include <icetray/OMKey.h>
+#include <dataclasses/Utility.h>
+#include <dataclasses/geometry/I3Geometry.h>
+
+static const unsigned i3omkeyindex_version_ = 0;
+
+/**
+ * @brief A dense numbering of the OMKeys of a geometry.
+ *
+ * Every OMKey of an I3OMGeoMap (in-ice DOMs, IceTop DOMs and the PMTs of
+ * Upgrade modules alike) is assigned a contiguous integer in [0, size()),
+ * in OMKey order. Per-DOM quantities can then be kept in plain arrays
+ * (see Flatten()) and looked up with GetIndex(), which goes through a
+ * direct (string, om) table instead of a search tree.
+ *
+ * Only the keys are serialized; the lookup table is rebuilt on load.
+ */
+class I3OMKeyIndex : public I3FrameObject {
+public:
+  /// Returned by GetIndex() for keys that are not part of the index
+  static const size_t npos = std::numeric_limits<size_t>::max();
+
+  I3OMKeyIndex();
+  explicit I3OMKeyIndex(const I3OMGeoMap& omgeo);
+  explicit I3OMKeyIndex(const I3Geometry& geometry);
+  /// Index an arbitrary set of keys. Duplicates are removed.
+  explicit I3OMKeyIndex(const std::vector<OMKey>& keys);
+
+  std::ostream& Print(std::ostream&) const override;
+
+  size_t size() const { return keys_.size(); }
+  bool empty() const { return keys_.empty(); }
+
+  /// The indexed keys, sorted. The position of a key is its index.
+  const std::vector<OMKey>& GetKeys() const { return keys_; }
+  const OMKey& GetKey(size_t index) const { return keys_[index]; }
+
+  /// Dense index of a key, or npos if it is not part of the index
+  size_t GetIndex(const OMKey& key) const;
+
+  bool Contains(const OMKey& key) const { return GetIndex(key) != npos; }
+
+  /**
+   * Copy a map keyed by OMKey into an array aligned with this index.
+   * Keys missing from the map are filled with @c missing, keys that are
+   * not part of the index are ignored.
+   */
+  template <typename Map>
+  std::vector<typename Map::mapped_type>
+  Flatten(const Map& map, const typename Map::mapped_type& missing =
+          typename Map::mapped_type()) const
+  {
+    std::vector<typename Map::mapped_type> flat(keys_.size(), missing);
+    ForEach(map, [&flat](size_t index, const typename Map::value_type& pair) {
+        if (index != npos)
+          flat[index] = pair.second;
+      });
+    return flat;
+  }
+
+  /**
+   * Walk a sorted map keyed by OMKey (an I3Map, e.g. a pulse or launch
+   * map) and call @c f(index, pair) for every entry, where index is the
+   * dense index of the key or npos if it is not part of the index. The
+   * map and the index are merged in a single linear pass.
+   */
+  template <typename Map, typename Function>
+  void ForEach(const Map& map, Function f) const
+  {
+    std::vector<OMKey>::const_iterator key = keys_.begin();
+    for (typename Map::const_iterator it = map.begin(); it != map.end(); ++it) {
+      while (key != keys_.end() && *key < it->first)
+        ++key;
+      if (key != keys_.end() && *key == it->first)
+        f(size_t(key - keys_.begin()), *it);
+      else
+        f(npos, *it);
+    }
+  }
+
+  bool operator==(const I3OMKeyIndex& rhs) const { return keys_ == rhs.keys_; }
+  bool operator!=(const I3OMKeyIndex& rhs) const { return !operator==(rhs); }
+
+private:
+  void BuildTable();
+
+  std::vector<OMKey> keys_;
+
+  /**
+   * Direct lookup table. For every string between minString_ and the
+   * largest string there is a range [omBegin, omBegin+omCount) of OM
+   * numbers, each pointing to its first key in keys_ (or to
+   * keys_.size() if there is no key with that string and OM).
+   */
+  struct StringSlots {
+    unsigned int omBegin;
+    unsigned int omCount;
+    size_t offset;
+  };
+  int minString_;
+  std::vector<StringSlots> strings_;
+  std::vector<uint32_t> slots_;
+
+  friend class icecube::serialization::access;
+  template <class Archive> void save(Archive& ar, unsigned version) const;
+  template <class Archive> void load(Archive& ar, unsigned version);
+  I3_SERIALIZATION_SPLIT_MEMBER();
+};
+
+std::ostream& operator<<(std::ostream& oss, const I3OMKeyIndex& index);
+
+I3_CLASS_VERSION(I3OMKeyIndex, i3omkeyindex_version_);
+I3_DEFAULT_NAME(I3OMKeyIndex);
+I3_POINTER_TYPEDEFS(I3OMKeyIndex);
+
+#endif // I3OMKEYINDEX_H_INCLUDED
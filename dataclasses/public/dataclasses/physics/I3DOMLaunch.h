@@ -14,6 +14,7 @@
 
 #include <vector>
 #include <dataclasses/I3Map.h>
+#include <dataclasses/I3FlatMap.h>
 #include <icetray/OMKey.h>
 
 /**
@@ -326,9 +327,12 @@ I3_POINTER_TYPEDEFS(I3DOMLaunch);
 
 typedef std::vector<I3DOMLaunch> I3DOMLaunchSeries;
 typedef I3Map<OMKey, I3DOMLaunchSeries> I3DOMLaunchSeriesMap;
+/// Compact form of I3DOMLaunchSeriesMap with the same serialized layout
+typedef I3FlatMap<OMKey, I3SmallVector<I3DOMLaunch, 2> > I3DOMLaunchSeriesFlatMap;
 
 I3_POINTER_TYPEDEFS(I3DOMLaunchSeries);
 I3_POINTER_TYPEDEFS(I3DOMLaunchSeriesMap);
+I3_POINTER_TYPEDEFS(I3DOMLaunchSeriesFlatMap);
 
 bool operator==(const I3DOMLaunch& lhs, const I3DOMLaunch& rhs);
 std::ostream& operator<<(std::ostream&, const I3DOMLaunch&);
@@ -13,6 +13,7 @@
 #include "dataclasses/I3Vector.h"
 #include "icetray/OMKey.h"
 #include "dataclasses/I3Map.h"
+#include "dataclasses/I3FlatMap.h"
 #include "icetray/I3Frame.h"
 
 
@@ -116,12 +117,15 @@ I3_CLASS_VERSION(I3RecoPulse, i3recopulse_version_);
 typedef std::vector<I3RecoPulse> I3RecoPulseSeries;
 typedef I3Map<OMKey, I3RecoPulseSeries> I3RecoPulseSeriesMap;
 typedef I3Map<OMKey, I3RecoPulse> I3RecoPulseMap;
+/// Compact form of I3RecoPulseSeriesMap with the same serialized layout
+typedef I3FlatMap<OMKey, I3SmallVector<I3RecoPulse, 4> > I3RecoPulseSeriesFlatMap;
 
 std::ostream& operator<<(std::ostream& oss, const I3RecoPulse& p);
 
 I3_POINTER_TYPEDEFS(I3RecoPulseSeries);
 I3_POINTER_TYPEDEFS(I3RecoPulseSeriesMap);
 I3_POINTER_TYPEDEFS(I3RecoPulseMap);
+I3_POINTER_TYPEDEFS(I3RecoPulseSeriesFlatMap);
 
 /*
  * Specialize I3Frame::Get() to turn convert various objects
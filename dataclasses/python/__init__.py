@@ -28,7 +28,7 @@ from icecube._dataclasses import (
     I3MapAntennaKeyAntennaKey, I3MapI3ParticleIDDouble, I3MapIntVectorInt, I3MapKeyDouble, I3MapKeyUInt,
     I3MapKeyVectorDouble, I3MapKeyVectorInt, I3MapModuleKeyString, I3MapStringBool, I3MapStringDouble, I3MapStringInt,
     I3MapStringStringDouble, I3MapStringVectorDouble, I3MapTriggerDouble, I3MapTriggerUInt, I3MapTriggerVectorUInt,
-    I3MapUShortUShort, I3MapUnsignedUnsigned, I3Matrix, I3ModuleGeo, I3ModuleGeoMap, I3OMGeo, I3OMGeoMap, I3Orientation,
+    I3MapUShortUShort, I3MapUnsignedUnsigned, I3Matrix, I3ModuleGeo, I3ModuleGeoMap, I3OMGeo, I3OMGeoMap, I3OMKeyIndex, I3Orientation,
     I3Particle, I3ParticleID, I3Position, I3RecoHit, I3RecoHitSeriesMap, I3RecoPulse, I3RecoPulseSeriesMap,
     I3RecoPulseSeriesMapApplySPECorrection, I3RecoPulseSeriesMapCombineByModule, I3RecoPulseSeriesMapMask,
     I3RecoPulseSeriesMapUnion, I3ScintGeo, I3ScintGeoMap, I3ScintRecoPulseSeriesMap, I3ScintWaveformSeriesMap,
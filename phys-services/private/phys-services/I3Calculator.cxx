@@ -541,3 +541,291 @@ I3Position I3Calculator::InShowerSystem(const I3Position& core,
   v.RotateY(-theta);
   return v;
 }
+
+//--------------------------------------------------------------
+// Batched versions
+//--------------------------------------------------------------
+
+namespace {
+
+  // Track quantities that do not depend on the OM position, computed once
+  // per track instead of once per position.
+  struct TrackKernel
+  {
+    TrackKernel(const I3Particle& track,
+		const double IndexRefG=I3Constants::n_ice_group,
+		const double IndexRefP=I3Constants::n_ice_phase)
+    {
+      x0 = track.GetX();
+      y0 = track.GetY();
+      z0 = track.GetZ();
+      ex = track.GetDir().GetX();
+      ey = track.GetDir().GetY();
+      ez = track.GetDir().GetZ();
+
+      const double changle = acos(1/IndexRefP);
+      invSin = 1/sin(changle);
+      invTan = 1/tan(changle);
+      indexRefG = IndexRefG;
+
+      // Range of the distance along the track covered by the particle.
+      // Written so that a NAN length (no end point) means no limit, as in
+      // the scalar functions.
+      amin = -INFINITY;
+      amax = INFINITY;
+      if (track.GetShape()==I3Particle::StartingTrack)
+	amin = 0;
+      else if (track.GetShape()==I3Particle::StoppingTrack)
+	amax = 0;
+      else if (track.GetShape()==I3Particle::ContainedTrack) {
+	amin = 0;
+	amax = track.GetLength();
+      }
+    }
+
+    double x0, y0, z0;
+    double ex, ey, ez;
+    double invSin, invTan, indexRefG;
+    double amin, amax;
+  };
+
+  void Resize(const I3Calculator::PositionArrays& positions,
+	      std::vector<double>& out)
+  {
+    out.resize(positions.size());
+  }
+
+}
+
+I3Calculator::PositionArrays::PositionArrays(const std::vector<I3Position>& positions)
+{
+  reserve(positions.size());
+  for (const I3Position& pos : positions)
+    push_back(pos);
+}
+
+//--------------------------------------------------------------
+void I3Calculator::CherenkovCalc(const I3Particle& track,
+				 const PositionArrays& positions,
+				 std::vector<double>& chtime,
+				 std::vector<double>& chdist,
+				 std::vector<double>& chapangle,
+				 const double IndexRefG,
+				 const double IndexRefP,
+				 const I3Direction& direction)
+{
+  Resize(positions, chtime);
+  Resize(positions, chdist);
+  Resize(positions, chapangle);
+  const size_t n = positions.size();
+
+  if (!track.IsTrack()) {
+    log_debug("CherenkovCalc() - particle is not a track. Not calculating.");
+    std::fill(chtime.begin(), chtime.end(), NAN);
+    std::fill(chdist.begin(), chdist.end(), NAN);
+    std::fill(chapangle.begin(), chapangle.end(), NAN);
+    return;
+  }
+
+  const TrackKernel k(track, IndexRefG, IndexRefP);
+  const double dx = direction.GetX();
+  const double dy = direction.GetY();
+  const double dz = direction.GetZ();
+  const double* px = positions.x.data();
+  const double* py = positions.y.data();
+  const double* pz = positions.z.data();
+  double* t = chtime.data();
+  double* d = chdist.data();
+  double* ang = chapangle.data();
+
+  for (size_t i = 0; i < n; i++) {
+    const double hx = px[i] - k.x0;
+    const double hy = py[i] - k.y0;
+    const double hz = pz[i] - k.z0;
+    const double s = k.ex*hx + k.ey*hy + k.ez*hz;
+    const double qx = hx - s*k.ex;
+    const double qy = hy - s*k.ey;
+    const double qz = hz - s*k.ez;
+    const double apdist = sqrt(qx*qx + qy*qy + qz*qz);
+    const double dist = apdist*k.invSin;
+    const double a = s - apdist*k.invTan;
+    // vector from the Cherenkov emission point to the OM
+    const double cx = hx - a*k.ex;
+    const double cy = hy - a*k.ey;
+    const double cz = hz - a*k.ez;
+    const bool valid = !(a < k.amin) && !(a > k.amax);
+    t[i] = valid ? (a + dist*k.indexRefG)/I3Constants::c : NAN;
+    d[i] = valid ? dist : NAN;
+    ang[i] = valid ? std::acos(-(dx*cx + dy*cy + dz*cz)/dist) : NAN;
+  }
+}
+
+//--------------------------------------------------------------
+void I3Calculator::CherenkovTime(const I3Particle& particle,
+				 const PositionArrays& positions,
+				 std::vector<double>& chtime,
+				 const double IndexRefG,
+				 const double IndexRefP)
+{
+  Resize(positions, chtime);
+  const size_t n = positions.size();
+  const double* px = positions.x.data();
+  const double* py = positions.y.data();
+  const double* pz = positions.z.data();
+  double* t = chtime.data();
+
+  if (particle.IsTrack()) {
+    const TrackKernel k(particle, IndexRefG, IndexRefP);
+    for (size_t i = 0; i < n; i++) {
+      const double hx = px[i] - k.x0;
+      const double hy = py[i] - k.y0;
+      const double hz = pz[i] - k.z0;
+      const double s = k.ex*hx + k.ey*hy + k.ez*hz;
+      const double qx = hx - s*k.ex;
+      const double qy = hy - s*k.ey;
+      const double qz = hz - s*k.ez;
+      const double apdist = sqrt(qx*qx + qy*qy + qz*qz);
+      const double a = s - apdist*k.invTan;
+      const bool valid = !(a < k.amin) && !(a > k.amax);
+      t[i] = valid ? (a + apdist*k.invSin*k.indexRefG)/I3Constants::c : NAN;
+    }
+  }
+  else if (particle.IsCascade()) {
+    const double x0 = particle.GetX();
+    const double y0 = particle.GetY();
+    const double z0 = particle.GetZ();
+    const double speed = I3Constants::c/IndexRefG;
+    for (size_t i = 0; i < n; i++) {
+      const double hx = px[i] - x0;
+      const double hy = py[i] - y0;
+      const double hz = pz[i] - z0;
+      t[i] = sqrt(hx*hx + hy*hy + hz*hz)/speed;
+    }
+  }
+  else {
+    log_debug("CherenkovTime() - particle is neither a track nor a cascade.");
+    std::fill(chtime.begin(), chtime.end(), NAN);
+  }
+}
+
+//--------------------------------------------------------------
+void I3Calculator::TimeResidual(const I3Particle& particle,
+				const PositionArrays& positions,
+				const std::vector<double>& hittimes,
+				std::vector<double>& residuals,
+				const double IndexRefG,
+				const double IndexRefP)
+{
+  if (hittimes.size() != positions.size())
+    log_fatal("Got %zu hit times for %zu positions",
+	      hittimes.size(), positions.size());
+
+  CherenkovTime(particle, positions, residuals, IndexRefG, IndexRefP);
+  const double t0 = particle.GetTime();
+  const size_t n = residuals.size();
+  const double* hit = hittimes.data();
+  double* res = residuals.data();
+  for (size_t i = 0; i < n; i++)
+    res[i] = (hit[i] - t0) - res[i];
+}
+
+//--------------------------------------------------------------
+void I3Calculator::ClosestApproachDistance(const I3Particle& particle,
+					   const PositionArrays& positions,
+					   std::vector<double>& apdist)
+{
+  Resize(positions, apdist);
+  const size_t n = positions.size();
+  const double* px = positions.x.data();
+  const double* py = positions.y.data();
+  const double* pz = positions.z.data();
+  double* out = apdist.data();
+
+  if (particle.HasDirection() && particle.IsTrack()) {
+    const TrackKernel k(particle);
+    for (size_t i = 0; i < n; i++) {
+      const double hx = px[i] - k.x0;
+      const double hy = py[i] - k.y0;
+      const double hz = pz[i] - k.z0;
+      double s = k.ex*hx + k.ey*hy + k.ez*hz;
+      // stick to the start or end point of the track
+      s = s < k.amin ? k.amin : s;
+      s = s > k.amax ? k.amax : s;
+      const double qx = hx - s*k.ex;
+      const double qy = hy - s*k.ey;
+      const double qz = hz - s*k.ez;
+      out[i] = sqrt(qx*qx + qy*qy + qz*qz);
+    }
+  }
+  else if (particle.HasDirection() && particle.IsCascade()) {
+    const double x0 = particle.GetX();
+    const double y0 = particle.GetY();
+    const double z0 = particle.GetZ();
+    for (size_t i = 0; i < n; i++) {
+      const double hx = px[i] - x0;
+      const double hy = py[i] - y0;
+      const double hz = pz[i] - z0;
+      out[i] = sqrt(hx*hx + hy*hy + hz*hz);
+    }
+  }
+  else {
+    log_debug("ClosestApproachDistance() - particle has no position, "
+	      "or is neither a track nor cascade.");
+    std::fill(apdist.begin(), apdist.end(), NAN);
+  }
+}
+
+//--------------------------------------------------------------
+void I3Calculator::DistanceAlongTrack(const I3Particle& track,
+				      const PositionArrays& positions,
+				      std::vector<double>& dist)
+{
+  Resize(positions, dist);
+  if (!track.IsTrack()) {
+    log_debug("DistanceAlongTrack() - particle is not a track.");
+    std::fill(dist.begin(), dist.end(), NAN);
+    return;
+  }
+
+  const TrackKernel k(track);
+  const size_t n = positions.size();
+  const double* px = positions.x.data();
+  const double* py = positions.y.data();
+  const double* pz = positions.z.data();
+  double* out = dist.data();
+  for (size_t i = 0; i < n; i++)
+    out[i] = k.ex*(px[i] - k.x0) + k.ey*(py[i] - k.y0) + k.ez*(pz[i] - k.z0);
+}
+
+//--------------------------------------------------------------
+void I3Calculator::CherenkovTime(const std::vector<I3Particle>& particles,
+				 const I3Position& position,
+				 std::vector<double>& chtime,
+				 const double IndexRefG,
+				 const double IndexRefP)
+{
+  chtime.resize(particles.size());
+  const double changle = acos(1/IndexRefP);
+  const double invSin = 1/sin(changle);
+  const double invTan = 1/tan(changle);
+
+  for (size_t i = 0; i < particles.size(); i++) {
+    const I3Particle& particle = particles[i];
+    if (particle.IsTrack()) {
+      const I3Position h = position - particle.GetPos();
+      const I3Direction& e = particle.GetDir();
+      const double s = e.GetX()*h.GetX() + e.GetY()*h.GetY() + e.GetZ()*h.GetZ();
+      const double apdist = (h - s*e).Magnitude();
+      const double a = s - apdist*invTan;
+      const I3Particle::ParticleShape shape = particle.GetShape();
+      if ((shape==I3Particle::StartingTrack && a<0) ||
+	  (shape==I3Particle::StoppingTrack && a>0) ||
+	  (shape==I3Particle::ContainedTrack && (a<0 || particle.GetLength()<a)))
+	chtime[i] = NAN;
+      else
+	chtime[i] = (a + apdist*invSin*IndexRefG)/I3Constants::c;
+    }
+    else
+      chtime[i] = CherenkovTime(particle, position, IndexRefG, IndexRefP);
+  }
+}
@@ -17,9 +17,17 @@ void I3CascadeCutValues::Calculate(const I3Particle& vertex,
 			    const double& begTWindow,
 			    const double& endTWindow)
 {
-  I3Cuts::CascadeCutsCalc(vertex, geometry, pulsemap, begTWindow, endTWindow,
+  Calculate(vertex, I3Cuts::EventHits(geometry, pulsemap), begTWindow, endTWindow);
+}
+
+void I3CascadeCutValues::Calculate(const I3Particle& vertex,
+			    const I3Cuts::EventHits& hits,
+			    const double& begTWindow,
+			    const double& endTWindow)
+{
+  I3Cuts::CascadeCutsCalc(vertex, hits, begTWindow, endTWindow,
 		   Nchan, Nhit, N_1hit, Nstring, Ndir, Nearly, Nlate);
-  cog = I3Cuts::COG(geometry, pulsemap);
+  cog = hits.cog;
 }
 
 I3CascadeCutValues::~I3CascadeCutValues() { }
@@ -13,8 +13,10 @@
  */
 #include "phys-services/I3CrossSection.h"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <limits>
 
 #include <icetray/I3Logging.h>
 #include <icetray/I3Units.h>
@@ -70,7 +72,8 @@ namespace
             return false;
         }
 
-        if (2.*M*E*y*(1.-x) + pow(M, 2) < pow(M + particleMass(I3Particle::Pi0)*I3Units::GeV, 2)) {
+        static const double pionMass = particleMass(I3Particle::Pi0)*I3Units::GeV;
+        if (2.*M*E*y*(1.-x) + pow(M, 2) < pow(M + pionMass, 2)) {
             // W^2 = Q^2 (1 - x) / x + M^2 = 2 M E y (1 - x) + M^2
             // W^2 must be greater than the threshold (M + m_pi0)^2
             return false;
@@ -87,6 +90,61 @@ namespace
         // eq. 7
         return ((ad - bd) <= d*y && d*y <= (ad + bd));
     }
+
+    // Width in log10(E) of the energy bins of the proposal tables, and the
+    // number of cells in log10(x) and log10(y)
+    const double tableEnergyBinWidth = 0.05;
+    const size_t tableBinsX = 64;
+    const size_t tableBinsY = 64;
+    // Fraction of the total weight spread evenly over all cells
+    const double tableFloor = 0.01;
+
+    /**
+     * Uniform numbers in [0,1), fetched from the random service in blocks
+     */
+    class UniformBlock
+    {
+        public:
+            explicit UniformBlock(I3RandomService& random)
+                : random_(random), next_(blockSize)
+            {}
+
+            double operator()()
+            {
+                if (next_ == blockSize)
+                {
+                    random_.FillUniform(block_.data(), blockSize);
+                    next_ = 0;
+                }
+                return block_[next_++];
+            }
+
+        private:
+            static constexpr size_t blockSize = 256;
+            I3RandomService& random_;
+            std::array<double, blockSize> block_;
+            size_t next_;
+    };
+
+    /**
+     * Evaluate a spline at many points. The result is NaN where the
+     * point is outside the support of the spline.
+     */
+    template <size_t N>
+    void evaluateSpline(const photospline::splinetable<>& spline,
+                        const std::vector<std::array<double, N>>& points,
+                        std::vector<double>& values)
+    {
+        values.resize(points.size());
+        std::array<int, N> centers;
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            if (spline.searchcenters(points[i].data(), centers.data()))
+                values[i] = spline.ndsplineeval(points[i].data(), centers.data(), 0);
+            else
+                values[i] = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
 }
 
 
@@ -364,6 +422,197 @@ I3CrossSection::sampleFinalState_GR(double energy,
 }
 
 
+std::vector<I3CrossSection::finalStateRecord>
+I3CrossSection::sampleFinalStates(const std::vector<double>& energies,
+                                  I3Particle::ParticleType scatteredType,
+                                  boost::shared_ptr<I3RandomService> random) const
+{
+    std::vector<finalStateRecord> states;
+    states.reserve(energies.size());
+
+    if (interaction_ == 1 || interaction_ == 2){
+        sampleFinalStates_DIS(energies, scatteredType, *random, states);
+    }else if (interaction_ == 3){
+        for (double energy : energies)
+            states.push_back(sampleFinalState_GR(energy, scatteredType, random));
+    }else{
+        log_fatal_stream("Unknown interaction number "<<interaction_<<". Your fits files are funky.");
+    }
+
+    return states;
+}
+
+const I3CrossSection::FinalStateTable&
+I3CrossSection::getFinalStateTable(double logEnergy) const
+{
+    const double logEMin = crossSection_->lower_extent(0);
+    const double logEMax = crossSection_->upper_extent(0);
+    const size_t nBins = size_t(std::ceil((logEMax - logEMin)/tableEnergyBinWidth)) + 1;
+    const size_t bin = std::min(size_t(std::lround((logEnergy - logEMin)/tableEnergyBinWidth)), nBins - 1);
+
+    std::lock_guard<std::mutex> lock(finalStateTables_->mutex);
+    std::vector<std::unique_ptr<const FinalStateTable>>& tables = finalStateTables_->tables;
+    if (tables.size() < nBins)
+        tables.resize(nBins);
+    if (tables[bin])
+        return *tables[bin];
+
+    std::unique_ptr<FinalStateTable> table(new FinalStateTable);
+    table->logXMin = crossSection_->lower_extent(1);
+    table->logYMin = crossSection_->lower_extent(2);
+    table->binWidthX = (std::min(0., crossSection_->upper_extent(1)) - table->logXMin)/tableBinsX;
+    table->binWidthY = (crossSection_->upper_extent(2) - table->logYMin)/tableBinsY;
+    table->binsY = tableBinsY;
+
+    const double nodeEnergy = std::min(logEMin + bin*tableEnergyBinWidth, logEMax);
+    std::vector<std::array<double,3>> centers;
+    centers.reserve(tableBinsX*tableBinsY);
+    for (size_t i = 0; i < tableBinsX; i++)
+        for (size_t j = 0; j < tableBinsY; j++)
+            centers.push_back({{nodeEnergy,
+                                table->logXMin + (i + 0.5)*table->binWidthX,
+                                table->logYMin + (j + 0.5)*table->binWidthY}});
+    std::vector<double> values;
+    evaluateSpline(*crossSection_, centers, values);
+
+    // Bx * By * xs(E, x, y), as in the sampler
+    table->weights.resize(centers.size());
+    double total = 0;
+    for (size_t i = 0; i < centers.size(); i++)
+    {
+        const double weight = std::pow(10., values[i] + centers[i][1] + centers[i][2]);
+        table->weights[i] = std::isfinite(weight) ? weight : 0.;
+        total += table->weights[i];
+    }
+    const double floor = total > 0 ? tableFloor*total/centers.size() : 1.;
+    table->cdf.resize(centers.size());
+    total = 0;
+    for (size_t i = 0; i < centers.size(); i++)
+    {
+        table->weights[i] += floor;
+        total += table->weights[i];
+        table->cdf[i] = total;
+    }
+
+    tables[bin] = std::move(table);
+    return *tables[bin];
+}
+
+void I3CrossSection::sampleFinalStates_DIS(const std::vector<double>& energies,
+                                           I3Particle::ParticleType scatteredType,
+                                           I3RandomService& random,
+                                           std::vector<finalStateRecord>& states) const
+{
+    if (crossSection_->get_ndim()!=3){
+        log_fatal_stream("I expected 3 dimensions in the cross section spline, but got "<< crossSection_->get_ndim() <<". Maybe your fits file doesn't have the right 'INTERACTION' key?");
+    }
+
+    const double m = particleMass(scatteredType);
+    const size_t burnin = 40;
+    // proposals rejected in a row before giving up on an energy
+    const size_t maxRejections = 1000000;
+    UniformBlock uniform(random);
+
+    // the proposals of one chain, their table weights and spline values
+    std::vector<std::array<double,3>> proposals;
+    std::vector<double> proposalWeights, values;
+    proposals.reserve(burnin+2);
+    proposalWeights.reserve(burnin+2);
+
+    for (double energy : energies)
+    {
+        // the same limits as sampleFinalState_DIS()
+        const double yMax = 1 - m/energy;
+        const double logYMax = std::log10(yMax);
+        const double s = targetMass_*targetMass_ + 2*targetMass_*energy;
+        const double logYMin = std::log10(Q2Min_/s);
+        const double logXMin = std::log10(Q2Min_/((s - targetMass_*targetMass_)*yMax));
+        const double logEnergy = std::log10(energy);
+
+        if (logEnergy < crossSection_->lower_extent(0)
+            || logEnergy > crossSection_->upper_extent(0))
+        {
+            log_fatal_stream("Interaction energy out of cross section table range: ["
+                             << std::pow(10.,crossSection_->lower_extent(0)) << " GeV,"
+                             << std::pow(10.,crossSection_->upper_extent(0)) << " GeV]");
+        }
+
+        const FinalStateTable& table = getFinalStateTable(logEnergy);
+        const double totalWeight = table.cdf.back();
+
+        bool started = false;
+        size_t steps = 0;
+        std::array<double,3> kin_vars{};
+        double ratio = 0;
+        while (steps <= burnin)
+        {
+            // rejection sample kinematically allowed points from the table
+            const size_t nProposals = started ? burnin + 1 - steps : burnin + 2;
+            proposals.clear();
+            proposalWeights.clear();
+            size_t rejections = 0;
+            while (proposals.size() < nProposals)
+            {
+                if (rejections == maxRejections)
+                {
+                    log_fatal_stream("No kinematically allowed final state in " << maxRejections
+                                     << " proposals at " << energy << " GeV. Does the cross section"
+                                     " spline cover the allowed region?");
+                }
+                rejections++;
+                const size_t cell = std::min(size_t(
+                    std::upper_bound(table.cdf.begin(), table.cdf.end(),
+                                     uniform()*totalWeight) - table.cdf.begin()),
+                    table.cdf.size() - 1);
+                const double logX = table.logXMin + (cell/table.binsY + uniform())*table.binWidthX;
+                const double logY = table.logYMin + (cell%table.binsY + uniform())*table.binWidthY;
+                if (logX < logXMin || logX > 0 || logY < logYMin || logY > logYMax)
+                    continue;
+                if ((s - targetMass_*targetMass_)*std::pow(10., logX + logY) < Q2Min_
+                    || !kinematicallyAllowed(std::pow(10., logX), std::pow(10., logY),
+                                             energy, targetMass_, m))
+                    continue;
+                proposals.push_back({{logEnergy, logX, logY}});
+                proposalWeights.push_back(table.weights[cell]);
+                rejections = 0;
+            }
+
+            evaluateSpline(*crossSection_, proposals, values);
+
+            for (size_t i = 0; i < proposals.size(); i++)
+            {
+                if (std::isnan(values[i]))
+                {
+                    if (started)
+                        steps++;
+                    continue;
+                }
+                // target over proposal density
+                const double testRatio = std::pow(
+                    10., values[i] + proposals[i][1] + proposals[i][2])/proposalWeights[i];
+                if (!started)
+                {
+                    kin_vars = proposals[i];
+                    ratio = testRatio;
+                    started = true;
+                    continue;
+                }
+                if (steps > burnin)
+                    break;
+                steps++;
+                const double odds = testRatio/ratio;
+                if (odds > 1. || uniform() < odds)
+                {
+                    kin_vars = proposals[i];
+                    ratio = testRatio;
+                }
+            }
+        }
+
+        states.emplace_back(std::pow(10., kin_vars[1]), std::pow(10., kin_vars[2]));
+    }
+}
+
 double I3CrossSection::evaluateCrossSection(double energy, double x, double y,
                                             I3Particle::ParticleType scatteredType) const{
 	double log_energy=std::log10(energy);
@@ -435,6 +684,9 @@ void I3CrossSection::load(
     const std::string& dd_crossSectionFile,
     const std::string& total_crossSectionFile)
 {
+    // the proposal tables belong to the old splines
+    finalStateTables_ = std::make_shared<FinalStateTableCache>();
+
     bool success = crossSection_->read_fits(dd_crossSectionFile);
     if (!success)
     {
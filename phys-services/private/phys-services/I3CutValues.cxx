@@ -16,9 +16,17 @@ void I3CutValues::Calculate(const I3Particle& track,
 			    const double& begTWindow,
 			    const double& endTWindow)
 {
-  I3Cuts::CutsCalc(track, geometry, pulsemap, begTWindow, endTWindow,
+  Calculate(track, I3Cuts::EventHits(geometry, pulsemap), begTWindow, endTWindow);
+}
+
+void I3CutValues::Calculate(const I3Particle& track,
+			    const I3Cuts::EventHits& hits,
+			    const double& begTWindow,
+			    const double& endTWindow)
+{
+  I3Cuts::CutsCalc(track, hits, begTWindow, endTWindow,
 		   Nchan, Nhit, Nstring, Ndir, Ldir, Sdir, Sall);
-  cog = I3Cuts::COG(geometry, pulsemap);
+  cog = hits.cog;
 }
 
 I3CutValues::~I3CutValues() { }
@@ -10,6 +10,7 @@
 #include "dataclasses/geometry/I3Geometry.h"
 #include "dataclasses/I3Position.h"
 
+#include <algorithm>
 #include <vector>
 #include <cassert>
 #include <cmath>
@@ -48,103 +49,132 @@ rotate(double a[3], double delphi, int axis)
 	a[y] = r*sin(phi);
 }
 
+// Smoothness of the hit projections onto the track: how uniformly they
+// are distributed along it. Sorts the projections in place.
+static double
+Smoothness(std::vector<double>& lengths)
+{
+  sort(lengths.begin(),lengths.end());
+  for (unsigned int i=0; i<lengths.size(); i++)
+    log_trace("lengths[%i]=%f",i,lengths[i]);
+  int N = lengths.size()-1;
+  double Smax = 0;
+  for (unsigned int j=1; j<lengths.size(); j++) {
+    double lj = lengths[j]-lengths[0];
+    double lN = lengths[N]-lengths[0];
+    double S = (double)j/(double)N - lj/lN;
+    log_trace("j: %i  N: %i  S: %f",j,N,S);
+    if (fabs(S)>fabs(Smax)) Smax = S;
+  }
+  // calculation is meaningless for less than 3 hits
+  if(lengths.size() <= 2) Smax = NAN;
+  return Smax;
+}
+
 //--------------------------------------------------------------
-void CutsCalcImpl(const I3Particle& track, const I3Geometry& geometry,
-		  const I3RecoPulseSeriesMap& hitmap,
-		  const double t1, const double t2,int& Nchan, int& Nhit, int& Nstring,
-		  int& Ndir, double& Ldir, double& Sdir, double& Sall)
+I3Cuts::EventHits::EventHits(const I3Geometry& geometry,
+			     const I3RecoPulseSeriesMap& hitmap)
+  : Nchan(hitmap.size()), Nhit(0), N_1hit(0), Nstring(0)
 {
-  int StringNumber[120] = {0};
-  Ndir = 0;
-  Nhit = 0;
-  Nstring = 0;
-  std::vector<double> lengthAll;
-  std::vector<double> lengthDir;
-  double min = 999999;
-  double max = -999999;
+  std::vector<int> strings;
+  double cogsum[3] = {0, 0, 0};
+  double ampsum = 0;
+
+  size_t npulses = 0;
+  for (const auto& hits : hitmap)
+    npulses += hits.second.size();
+  positions.reserve(npulses);
+  times.reserve(npulses);
+
+  // Both maps are sorted by OMKey, so the geometry of every hit DOM is
+  // found by walking them side by side instead of one search per DOM.
+  I3OMGeoMap::const_iterator geom = geometry.omgeo.begin();
   I3RecoPulseSeriesMap::const_iterator hits_i;
   for (hits_i=hitmap.begin(); hits_i!=hitmap.end(); hits_i++) {
     const I3RecoPulseSeries& hits = hits_i->second;
-    OMKey omkey = hits_i->first;
-    I3OMGeoMap::const_iterator geom = geometry.omgeo.find(omkey);
-    if (geom==geometry.omgeo.end()) {
+    const OMKey& omkey = hits_i->first;
+
+    if(hits.size()==1){
+      log_trace("found a DOM with a single hit...");
+      N_1hit++;
+    }
+
+    while (geom!=geometry.omgeo.end() && geom->first<omkey)
+      geom++;
+    const bool found = (geom!=geometry.omgeo.end() && geom->first==omkey);
+
+    for (const I3RecoPulse& hit : hits) {
+      double amp = hit.GetCharge();
+      if (std::isnan(amp) || std::isinf(amp)) {
+	log_warn("Got a nan or inf pulse charge.  Setting it to 0 instead.  Something could be screwy with a DOM calibration!!");
+	amp = 0;
+      }
+      // the COG is normalized to the charge of all pulses, including
+      // those on DOMs that are missing from the geometry
+      ampsum += amp;
+      if (found) {
+	cogsum[0] += amp*geom->second.position.GetX();
+	cogsum[1] += amp*geom->second.position.GetY();
+	cogsum[2] += amp*geom->second.position.GetZ();
+      }
+    }
+
+    if (!found) {
       log_trace("Didn't find the current OMKey in Geometry");
       continue;
     }
 
-    StringNumber[(int) 19+omkey.GetString()] = 1; // "19+" includes AMANDA std::strings
+    strings.push_back(omkey.GetString());
     const I3Position& ompos = geom->second.position;
+    for (const I3RecoPulse& hit : hits) {
+      positions.push_back(ompos);
+      times.push_back(hit.GetTime());
+    }
+  }
 
-    I3RecoPulseSeries::const_iterator hit;
-    for (hit=hits.begin(); hit!=hits.end(); hit++) {
-
-      double Tres = TimeResidual(track, ompos, hit->GetTime());
-      log_trace("residual: %f",Tres);
-
-      // calculate projections of hits onto track...
-      Nhit++; // keep track of total hits
-      // Replace this with the function version
-      double dist = DistanceAlongTrack(track, ompos);
-      log_trace("dist: %f",dist);
-      lengthAll.push_back(dist);        // set up for SmoothnessAll calculation
-
-      // this is a direct hit...
-      if (Tres>t1 && Tres<t2) {
-	Ndir+=1;                     // add direct hits
-	if (dist<min) min = dist;    // set minimum for "event length"
-	if (dist>max) max = dist;    // set maximum for "event length"
-	lengthDir.push_back(dist);  // set up for SmoothnessDir calculation
-      }
-
-    } // end loop over hitseries
+  std::sort(strings.begin(), strings.end());
+  Nstring = std::unique(strings.begin(), strings.end()) - strings.begin();
+  Nhit = times.size();
 
-  } // end loop over hitseriesmap
+  if (ampsum==0) ampsum=1.0;
+  cog = I3Position(cogsum[0]/ampsum, cogsum[1]/ampsum, cogsum[2]/ampsum);
+}
 
-  //calculate Nstring
-  for (int i = 0; i < 120; i++) {
-    if (StringNumber[i])
-      ++Nstring;
-  }
+//--------------------------------------------------------------
+void I3Cuts::CutsCalc(const I3Particle& track, const EventHits& hits,
+		      const double t1, const double t2, int& Nchan, int& Nhit, int& Nstring,
+		      int& Ndir, double& Ldir, double& Sdir, double& Sall)
+{
+  std::vector<double> residuals;
+  std::vector<double> lengthAll;
+  TimeResidual(track, hits.positions, hits.times, residuals);
+  // projections of hits onto track...
+  DistanceAlongTrack(track, hits.positions, lengthAll);
 
-    // calculate SmoothnessAll...
-  {
-    sort(lengthAll.begin(),lengthAll.end());
-    for (unsigned int i=0; i<lengthAll.size(); i++)
-      log_trace("lengthAll[%i]=%f",i,lengthAll[i]);
-    int N = lengthAll.size()-1;
-    Sall = 0;
-    for (unsigned int j=1; j<lengthAll.size(); j++) {
-      double lj = lengthAll[j]-lengthAll[0];
-      double lN = lengthAll[N]-lengthAll[0];
-      double S = (double)j/(double)N - lj/lN;
-      log_trace("j: %i  N: %i  S: %f",j,N,S);
-      if (fabs(S)>fabs(Sall)) Sall = S;
+  std::vector<double> lengthDir;
+  double min = 999999;
+  double max = -999999;
+  Ndir = 0;
+  for (size_t i=0; i<residuals.size(); i++) {
+    log_trace("residual: %f  dist: %f",residuals[i],lengthAll[i]);
+    // this is a direct hit...
+    if (residuals[i]>t1 && residuals[i]<t2) {
+      const double dist = lengthAll[i];
+      Ndir+=1;                     // add direct hits
+      if (dist<min) min = dist;    // set minimum for "event length"
+      if (dist>max) max = dist;    // set maximum for "event length"
+      lengthDir.push_back(dist);  // set up for SmoothnessDir calculation
     }
-    // calculation is meaningless for less than 3 hits
-    if(lengthAll.size() <= 2) Sall = NAN;
   }
 
-  // calculate SmoothnessDir...
-  {
-    sort(lengthDir.begin(),lengthDir.end());
-    for (unsigned int i=0; i<lengthDir.size(); i++)
-      log_trace("lengthDir[%i]=%f",i,lengthDir[i]);
-    int N = lengthDir.size()-1;
-    Sdir = 0;
-    for (unsigned int j=1; j<lengthDir.size(); j++) {
-      double lj = lengthDir[j]-lengthDir[0];
-      double lN = lengthDir[N]-lengthDir[0];
-      double S = (double)j/(double)N - lj/lN;
-      log_trace("j: %i  N: %i  S: %f",j,N,S);
-      if (fabs(S)>fabs(Sdir)) Sdir = S;
-    }
-    // calculation is meaningless for less than 3 direct hits
-    if(lengthDir.size() <= 2) Sdir = NAN;
-  }
+  Sall = Smoothness(lengthAll);
+  Sdir = Smoothness(lengthDir);
 
   Ldir = max-min; // length of event
   if (lengthDir.size()==0) Ldir = NAN;
-  Nchan = hitmap.size();
+  Nchan = hits.Nchan;
+  Nhit = hits.Nhit;
+  Nstring = hits.Nstring;
   log_debug("-----> Nchan: %i",Nchan);
   log_debug("-----> Ndir: %i",Ndir);
   log_debug("-----> Nhit: %i",Nhit);
@@ -152,79 +182,33 @@ void CutsCalcImpl(const I3Particle& track, const I3Geometry& geometry,
   log_debug("-----> Ldir: %f",Ldir);
   log_debug("-----> Sall: %f",Sall);
   log_debug("-----> Sdir: %f",Sdir);
-  return;
 }
 
 //--------------------------------------------------------------
-void CascadeCutsCalcImpl(const I3Particle& vertex, const I3Geometry& geometry,
-		  const I3RecoPulseSeriesMap& hitmap,
-		  const double t1, const double t2,int& Nchan, int& Nhit, int& N_1hit, int& Nstring,
-		  int& Ndir, int& Nearly, int& Nlate)
+void I3Cuts::CascadeCutsCalc(const I3Particle& vertex, const EventHits& hits,
+			     const double t1, const double t2,int& Nchan, int& Nhit, int& N_1hit, int& Nstring,
+			     int& Ndir, int& Nearly, int& Nlate)
 {
-  int StringNumber[120] = {0};
-  Nhit    = 0;
-  N_1hit  = 0;
+  //TimeResidual function checks if the input particle is a cascade or track and then
+  //handles the residual calculation appropriately
+  std::vector<double> residuals;
+  TimeResidual(vertex, hits.positions, hits.times, residuals);
+
   Ndir    = 0;
   Nearly  = 0;
   Nlate   = 0;
-  Nstring = 0;
-  I3RecoPulseSeriesMap::const_iterator hits_i;
-  for (hits_i=hitmap.begin(); hits_i!=hitmap.end(); hits_i++) {
-    const I3RecoPulseSeries& hits = hits_i->second;
-    OMKey omkey = hits_i->first;
-
-    if(hits.size()==1){
-      log_trace("found a DOM with a single hit...");
-      N_1hit++;
-    }
-
-    I3OMGeoMap::const_iterator geom = geometry.omgeo.find(omkey);
-    if (geom==geometry.omgeo.end()) {
-      log_trace("Didn't find the current OMKey in Geometry");
-      continue;
-    }
-
-    StringNumber[(int) 19+omkey.GetString()] = 1; // "19+" includes AMANDA std::strings
-    const I3Position& ompos = geom->second.position;
-
-    I3RecoPulseSeries::const_iterator hit;
-    for (hit=hits.begin(); hit!=hits.end(); hit++) {
-
-      //TimeResidual function checks if the input particle is a cascade or track and then
-      //handles the residual calculation appropriately
-      double Tres = TimeResidual(vertex, ompos, hit->GetTime());
-      log_trace("cascade time: %f",vertex.GetTime());
-      log_trace("    hit time: %f",hit->GetTime());
-      log_trace("    residual: %f",Tres);
-
-      Nhit++; // keep track of total hits
-
-      // this is an early hit...
-      if (Tres<t1) {
-	Nearly+=1;                     // add early hits
-      }
-
-      // this is a direct hit...
-      if (Tres>t1 && Tres<t2) {
-	Ndir+=1;                     // add direct hits
-      }
-
-      // this is a late hit...
-      if (Tres>t2) {
-	Nlate+=1;                     // add late hits
-      }
-
-    } // end loop over hitseries
-
-  } // end loop over hitseriesmap
-
-  //calculate Nstring
-  for (int i = 0; i < 120; i++) {
-    if (StringNumber[i])
-      ++Nstring;
+  for (size_t i=0; i<residuals.size(); i++) {
+    const double Tres = residuals[i];
+    log_trace("    residual: %f",Tres);
+    Nearly += (Tres<t1);          // this is an early hit...
+    Ndir += (Tres>t1 && Tres<t2); // this is a direct hit...
+    Nlate += (Tres>t2);           // this is a late hit...
   }
 
-  Nchan = hitmap.size();
+  Nchan   = hits.Nchan;
+  Nhit    = hits.Nhit;
+  N_1hit  = hits.N_1hit;
+  Nstring = hits.Nstring;
   log_debug("-----> Nchan: %i",Nchan);
   log_debug("-----> Nhit: %i",Nhit);
   log_debug("-----> N_1hit: %i",N_1hit);
@@ -232,7 +216,26 @@ void CascadeCutsCalcImpl(const I3Particle& vertex, const I3Geometry& geometry,
   log_debug("-----> Ndir: %i",Ndir);
   log_debug("-----> Nearly: %i",Nearly);
   log_debug("-----> Nlate: %i", Nlate);
-  return;
+}
+
+//--------------------------------------------------------------
+void CutsCalcImpl(const I3Particle& track, const I3Geometry& geometry,
+		  const I3RecoPulseSeriesMap& hitmap,
+		  const double t1, const double t2,int& Nchan, int& Nhit, int& Nstring,
+		  int& Ndir, double& Ldir, double& Sdir, double& Sall)
+{
+  I3Cuts::CutsCalc(track, I3Cuts::EventHits(geometry, hitmap), t1, t2,
+		   Nchan, Nhit, Nstring, Ndir, Ldir, Sdir, Sall);
+}
+
+//--------------------------------------------------------------
+void CascadeCutsCalcImpl(const I3Particle& vertex, const I3Geometry& geometry,
+		  const I3RecoPulseSeriesMap& hitmap,
+		  const double t1, const double t2,int& Nchan, int& Nhit, int& N_1hit, int& Nstring,
+		  int& Ndir, int& Nearly, int& Nlate)
+{
+  I3Cuts::CascadeCutsCalc(vertex, I3Cuts::EventHits(geometry, hitmap), t1, t2,
+			  Nchan, Nhit, N_1hit, Nstring, Ndir, Nearly, Nlate);
 }
 
 
@@ -562,51 +565,24 @@ double I3Cuts::CylinderSize(const I3Particle& track,
 //------------------------------------
 // Generalized version of "CylinderSize" for a general in-ice
 // array shape
-double I3Cuts::ContainmentVolumeSize(const I3Particle& track,
-				     std::vector<double> x,
-				     std::vector<double> y,
-				     double zhigh,
-				     double zlow) {
-  double bestanswer = NAN;
-
-  // Error-checking... need at least three std::strings
-  if (x.size()<3) {
-  log_warn("ContainmentVolume of zero/1/2 strings: will be NAN");
-    return NAN;
-  }
-
-  // First, compute the center of mass
-  double xcm, ycm, zcm;
-  CMPolygon(x, y, &xcm, &ycm);
-  zcm = (zhigh+zlow)/2;
-  I3Position CM(xcm,ycm,zcm);
-
-  // Some debugging statements
-  for (unsigned int i=0; i<x.size(); i++)
-    log_debug("X = %f, Y= %f", x[i], y[i]);
 
-  log_debug("Analyzing track: (%f, %f, %f) / (%f, %f)", 
-            track.GetPos().GetX(),
-            track.GetPos().GetY(),
-            track.GetPos().GetZ(),
-            track.GetDir().GetZenith(),
-            track.GetDir().GetAzimuth());  
-
-  // Error-catching: what if the track goes right through the center of mass?
-  if (I3Calculator::IsOnTrack(track,CM,DBL_EPSILON)) return 0;
-
-  //---- BUG 2/16/09:
-  //---- With IC-40, we have no choice but to assume they are in order!
-  // do NOT do this!
-  //PutPointsInOrder(&x,&y,xcm,ycm,0);
+// The top, bottom and side walls of a prism, as pairs of corners
+struct PrismWalls
+{
+  I3Position CM;
+  std::vector<std::vector<I3Position> > pairs1;
+  std::vector<std::vector<I3Position> > pairs2;
+};
 
-  if (x.size() != y.size()) log_fatal("X and Y are not the same size");
+static PrismWalls
+MakeWalls(const I3Cuts::ContainmentPolygon& polygon, double zhigh, double zlow)
+{
+  const std::vector<double>& x = polygon.x;
+  const std::vector<double>& y = polygon.y;
+  PrismWalls walls;
+  walls.CM = I3Position(polygon.xcm, polygon.ycm, (zhigh+zlow)/2);
   int n = x.size();
 
-  // We're going to loop through each "wall" of the structure, extending
-  // out from the center.
-
-
   // Set up pairs of points which make "walls"
   I3Position B;
   I3Position C;
@@ -657,14 +633,40 @@ double I3Cuts::ContainmentVolumeSize(const I3Particle& track,
   log_debug("Number of highs: %zu", highs1.size());
   log_debug("Number of lows: %zu", lows1.size());
   log_debug("Number of verts: %zu", verts1.size());
-  std::vector<std::vector<I3Position> > pairs1;
-  std::vector<std::vector<I3Position> > pairs2;
-  pairs1.push_back(highs1);
-  pairs1.push_back(lows1);
-  pairs1.push_back(verts1);
-  pairs2.push_back(highs2);
-  pairs2.push_back(lows2);
-  pairs2.push_back(verts2);
+  walls.pairs1.push_back(highs1);
+  walls.pairs1.push_back(lows1);
+  walls.pairs1.push_back(verts1);
+  walls.pairs2.push_back(highs2);
+  walls.pairs2.push_back(lows2);
+  walls.pairs2.push_back(verts2);
+  return walls;
+}
+
+static double
+ContainmentVolumeSizeImpl(const I3Particle& track,
+                          const I3Cuts::ContainmentPolygon& polygon,
+                          const PrismWalls& walls)
+{
+  using namespace I3Cuts;
+  double bestanswer = NAN;
+  const std::vector<I3Position>* pairs1 = walls.pairs1.data();
+  const std::vector<I3Position>* pairs2 = walls.pairs2.data();
+  const I3Position& CM = walls.CM;
+
+  // Some debugging statements
+  for (unsigned int i=0; i<polygon.x.size(); i++)
+    log_debug("X = %f, Y= %f", polygon.x[i], polygon.y[i]);
+
+  log_debug("Analyzing track: (%f, %f, %f) / (%f, %f)", 
+            track.GetPos().GetX(),
+            track.GetPos().GetY(),
+            track.GetPos().GetZ(),
+            track.GetDir().GetZenith(),
+            track.GetDir().GetAzimuth());  
+
+  // Error-catching: what if the track goes right through the center of mass?
+  if (I3Calculator::IsOnTrack(track,CM,DBL_EPSILON)) return 0;
+
 
 
   // Now, compute intersection points for each "wall",
@@ -672,7 +674,7 @@ double I3Cuts::ContainmentVolumeSize(const I3Particle& track,
   // "through the goalposts"
 
   // Loop over the high series, low series, and vertical series
-  for (unsigned int j=0; j<pairs1.size(); j++) {
+  for (unsigned int j=0; j<walls.pairs1.size(); j++) {
 
   std::vector<double> cvector;  // collection of odd number of segments intersected
 
@@ -816,6 +818,42 @@ double I3Cuts::ContainmentVolumeSize(const I3Particle& track,
 
 }
 
+double I3Cuts::ContainmentVolumeSize(const I3Particle& track,
+				     std::vector<double> x,
+				     std::vector<double> y,
+				     double zhigh,
+				     double zlow) {
+  return ContainmentVolumeSize(track, ContainmentPolygon(x, y), zhigh, zlow);
+}
+
+double I3Cuts::ContainmentVolumeSize(const I3Particle& track,
+				     const ContainmentPolygon& polygon,
+				     double zhigh,
+				     double zlow) {
+  // Error-checking... need at least three std::strings
+  if (polygon.x.size()<3) {
+  log_warn("ContainmentVolume of zero/1/2 strings: will be NAN");
+    return NAN;
+  }
+  return ContainmentVolumeSizeImpl(track, polygon, MakeWalls(polygon, zhigh, zlow));
+}
+
+std::vector<double>
+I3Cuts::ContainmentVolumeSize(const std::vector<I3Particle>& tracks,
+			      const ContainmentPolygon& polygon,
+			      double zhigh,
+			      double zlow) {
+  if (polygon.x.size()<3) {
+    log_warn("ContainmentVolume of zero/1/2 strings: will be NAN");
+    return std::vector<double>(tracks.size(), NAN);
+  }
+  const PrismWalls walls = MakeWalls(polygon, zhigh, zlow);
+  std::vector<double> sizes(tracks.size());
+  for (size_t i = 0; i < tracks.size(); i++)
+    sizes[i] = ContainmentVolumeSizeImpl(tracks[i], polygon, walls);
+  return sizes;
+}
+
 
 //------------------------------------
 // 2-dimensional version of containment size, for a general icetop
@@ -825,6 +863,26 @@ double I3Cuts::ContainmentAreaSize(const I3Particle& track,
 				   std::vector<double> y,
 				   double z)
 {
+  return ContainmentAreaSize(track, ContainmentPolygon(x, y), z);
+}
+
+std::vector<double>
+I3Cuts::ContainmentAreaSize(const std::vector<I3Particle>& tracks,
+			    const ContainmentPolygon& polygon,
+			    double z)
+{
+  std::vector<double> sizes(tracks.size());
+  for (size_t i = 0; i < tracks.size(); i++)
+    sizes[i] = ContainmentAreaSize(tracks[i], polygon, z);
+  return sizes;
+}
+
+double I3Cuts::ContainmentAreaSize(const I3Particle& track,
+				   const ContainmentPolygon& polygon,
+				   double z)
+{
+  const std::vector<double>& x = polygon.x;
+  const std::vector<double>& y = polygon.y;
 
   // Error-checking... need at least three std::strings to have an area
   unsigned xsize = x.size();
@@ -833,9 +891,9 @@ double I3Cuts::ContainmentAreaSize(const I3Particle& track,
     return NAN;
   }
 
-  // First, compute the center of mass
-  double xcm, ycm;
-  CMPolygon(x, y, &xcm, &ycm);
+  // The center of mass and the corner angles come with the polygon
+  const double xcm = polygon.xcm;
+  const double ycm = polygon.ycm;
 
   // Find the (x,y) of the point at some depth
   double dist;
@@ -864,15 +922,8 @@ double I3Cuts::ContainmentAreaSize(const I3Particle& track,
   double cvector[9];  // collection of odd number of segments intersected
   int nc = 0;
 
-  // Now, compute angles for each corner point,
-  // and figure out which two bracket the point
-  //int xsize = 7;
-  double ang[100];
-
-  for (unsigned int i=0; i<xsize; i++) {
-    I3Direction dd(x[i]-xcm,y[i]-ycm,0);
-    ang[i] = dd.CalcPhi();
-  }
+  // Now, figure out which two corner points bracket the point
+  const std::vector<double>& ang = polygon.angles;
   for (unsigned int i=0; i<xsize; i++) {
     unsigned int inext = i+1;
     if (inext==xsize) inext = 0;
@@ -934,6 +985,45 @@ double I3Cuts::ContainmentAreaSize(const I3Particle& track,
 
 ////// HELPER FUNCTIONS FOR GEOMETRIC STUFF ///////
 
+I3Cuts::ContainmentPolygon::ContainmentPolygon()
+  : xcm(NAN), ycm(NAN)
+{}
+
+I3Cuts::ContainmentPolygon::ContainmentPolygon(const std::vector<double>& xcorners,
+					       const std::vector<double>& ycorners)
+  : x(xcorners), y(ycorners), xcm(NAN), ycm(NAN)
+{
+  // the containment functions return NAN for these
+  if (x.size()<3)
+    return;
+
+  CMPolygon(x, y, &xcm, &ycm);
+  angles.resize(x.size());
+  for (unsigned int i=0; i<x.size(); i++) {
+    I3Direction dd(x[i]-xcm,y[i]-ycm,0);
+    angles[i] = dd.CalcPhi();
+  }
+}
+
+bool I3Cuts::ContainmentPolygon::IsInside(double xp, double yp) const
+{
+  // count the crossings of a ray from the point towards -x
+  int inter = 0;
+  const size_t n = x.size();
+  for (size_t i=0; i<n; ++i) {
+    const size_t next = (i+1 == n) ? 0 : i+1;
+    const double xn = x[next];
+    const double yn = y[next];
+    if (y[i] == yn) continue;
+    if (yp <= y[i] && yp <= yn) continue;
+    if (y[i] < yp && yn < yp) continue;
+
+    const double xint = x[i] + (yp-y[i])*(xn-x[i])/(yn-y[i]);
+    if (xp < xint) inter++;
+  }
+  return inter % 2;
+}
+
 //------------------------------------
 // Intersection point of two lines (in 2-d)
 void I3Cuts::IntersectionOfTwoLines(double x1, double y1, double x2, double y2,
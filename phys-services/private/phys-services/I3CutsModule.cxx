@@ -11,6 +11,7 @@
 #include "I3CutsModule.h"
 #include "phys-services/I3CutValues.h"
 #include "phys-services/I3CascadeCutValues.h"
+#include "phys-services/I3Cuts.h"
 
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/predicate.hpp>
@@ -108,6 +109,9 @@ void I3CutsModule::Physics(I3FramePtr frame)
     return;
   }
 
+  //---The pulses are the same for every particle, so flatten them only once
+  const I3Cuts::EventHits hits(geometry, *pulsemap);
+
   //if the user did not specify then process all particles in the frame.
   std::vector<std::string> particleNames(particleNameList_);
   //if the user has specified the I3Particles to process, process them...
@@ -140,11 +144,15 @@ void I3CutsModule::Physics(I3FramePtr frame)
     if(particle->IsTrack()){
       log_debug(" ---> I3Particle '%s' is a track, so proceeding accordingly...",
                 name.c_str());
-      cuts = I3CutValuesPtr(new I3CutValues());
+      I3CutValuesPtr trackCuts(new I3CutValues());
+      trackCuts->Calculate(*particle,hits,timeRange_[0],timeRange_[1]);
+      cuts = trackCuts;
     }else if(particle->IsCascade()){
       log_debug(" ---> I3Particle '%s' is a cascade, so proceeding accordingly...",
                 name.c_str());
-      cuts = I3CascadeCutValuesPtr(new I3CascadeCutValues());
+      I3CascadeCutValuesPtr cascadeCuts(new I3CascadeCutValues());
+      cascadeCuts->Calculate(*particle,hits,timeRange_[0],timeRange_[1]);
+      cuts = cascadeCuts;
     } else {
       //this is probably just a failed fit; if not, something is really screwy...
       if(particle->GetFitStatusString()=="OK"){
@@ -155,8 +163,6 @@ void I3CutsModule::Physics(I3FramePtr frame)
     }
 
     if(cuts){
-      cuts->Calculate(*particle,geometry,*pulsemap,timeRange_[0],timeRange_[1]);
-
       frame->Put(name+"Cuts"+nameTag_, cuts);
       log_debug("%s",AsXML(cuts).c_str());
     }
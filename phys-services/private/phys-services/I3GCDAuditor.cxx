@@ -13,6 +13,9 @@
 #include <dataclasses/calibration/I3Calibration.h>
 #include <dataclasses/status/I3DetectorStatus.h>
 #include <dataclasses/I3DOMFunctions.h>
+#include <dataclasses/I3MapDelta.h>
+
+#include <algorithm>
 
 class I3GCDAuditor : public I3Module
 {
@@ -21,6 +24,8 @@ class I3GCDAuditor : public I3Module
 		void Configure();
 		void DetectorStatus(I3FramePtr frame);
 	private:
+		bool CheckOM(const OMKey &om, const I3OMGeo &omgeo,
+		    const I3Calibration &calib, const I3DetectorStatus &status);
 		bool CheckDOM(OMKey om, const I3OMGeo &omgeo,
 		    const I3DOMCalibration &cal, const I3DOMStatus &status);
 		std::string bad_dom_list_;
@@ -28,6 +33,13 @@ class I3GCDAuditor : public I3Module
 		bool max_paranoia_;
 		bool NAN_is_error_;
 		bool Not1_is_error_;
+
+		// The last G/C/D that passed, so that the next D frame only
+		// checks the OMs whose entries changed
+		I3GeometryConstPtr audited_geo_;
+		I3CalibrationConstPtr audited_calib_;
+		I3DetectorStatusConstPtr audited_status_;
+		std::vector<OMKey> bad_doms_;
 };
 
 I3_MODULE(I3GCDAuditor);
@@ -68,6 +80,13 @@ I3GCDAuditor::DetectorStatus(I3FramePtr frame)
 	const I3Geometry &geo = frame->Get<I3Geometry>();
 	const I3Calibration &calib = frame->Get<I3Calibration>();
 	const I3DetectorStatus &status = frame->Get<I3DetectorStatus>();
+	I3GeometryConstPtr geo_ptr = frame->Get<I3GeometryConstPtr>();
+	I3CalibrationConstPtr calib_ptr = frame->Get<I3CalibrationConstPtr>();
+	I3DetectorStatusConstPtr status_ptr =
+	    frame->Get<I3DetectorStatusConstPtr>();
+
+	std::vector<OMKey> bad_doms(bdl.begin(), bdl.end());
+	std::sort(bad_doms.begin(), bad_doms.end());
 
 	bool err = false;
 
@@ -123,46 +142,88 @@ I3GCDAuditor::DetectorStatus(I3FramePtr frame)
 
 	log_info("bad_dom_list_ %s", bad_dom_list_.c_str());
 
-	for (I3OMGeoMap::const_iterator i = geo.omgeo.begin();
-	   i != geo.omgeo.end(); i++) {
-		if (std::find(bdl.begin(), bdl.end(), i->first) != bdl.end())
-			continue;
-
-		#define bad_dom(...) { log_error(__VA_ARGS__); err = true; \
-		    continue; }
-
-		// Check for AMANDA OMs, skipping if they are not an error
-		if (i->second.omtype == I3OMGeo::AMANDA && AMANDA_is_error_)
-			bad_dom("Geometry contains AMANDA OM%s",
-			    i->first.str().c_str());
-		// Also skip scintillator or unknown OMs
-		if (i->second.omtype == I3OMGeo::AMANDA || 
-		    i->second.omtype == I3OMGeo::Scintillator ||
-		    i->second.omtype == I3OMGeo::UnknownType)
-			continue;
-
-		if (calib.domCal.find(i->first) == calib.domCal.end())
-			bad_dom("OM%s has no calibration",
-			    i->first.str().c_str());
-		if (status.domStatus.find(i->first) == status.domStatus.end())
-			bad_dom("OM%s has no detector status",
-			    i->first.str().c_str());
-
-		#undef bad_dom
-
-		if (!CheckDOM(i->first, i->second,
-		    calib.domCal.find(i->first)->second,
-		    status.domStatus.find(i->first)->second))
-			err = true;
+	if (!audited_geo_ || bad_doms != bad_doms_) {
+		for (I3OMGeoMap::const_iterator i = geo.omgeo.begin();
+		   i != geo.omgeo.end(); i++) {
+			if (std::binary_search(bad_doms.begin(), bad_doms.end(),
+			    i->first))
+				continue;
+			if (!CheckOM(i->first, i->second, calib, status))
+				err = true;
+		}
+	} else {
+		// Only OMs whose geometry, calibration or status differ from
+		// the last audited frame can have become bad.
+		std::vector<OMKey> changed;
+		if (geo_ptr != audited_geo_) {
+			std::vector<OMKey> keys =
+			    I3MapDeltaKeys(audited_geo_->omgeo, geo.omgeo);
+			changed.insert(changed.end(), keys.begin(), keys.end());
+		}
+		if (calib_ptr != audited_calib_) {
+			std::vector<OMKey> keys =
+			    I3MapDeltaKeys(audited_calib_->domCal, calib.domCal);
+			changed.insert(changed.end(), keys.begin(), keys.end());
+		}
+		if (status_ptr != audited_status_) {
+			std::vector<OMKey> keys = I3MapDeltaKeys(
+			    audited_status_->domStatus, status.domStatus);
+			changed.insert(changed.end(), keys.begin(), keys.end());
+		}
+		std::sort(changed.begin(), changed.end());
+		changed.erase(std::unique(changed.begin(), changed.end()),
+		    changed.end());
+		log_debug("Auditing %zu OMs changed since the last frame",
+		    changed.size());
+
+		for (const OMKey &key : changed) {
+			I3OMGeoMap::const_iterator i = geo.omgeo.find(key);
+			if (i == geo.omgeo.end() || std::binary_search(
+			    bad_doms.begin(), bad_doms.end(), key))
+				continue;
+			if (!CheckOM(i->first, i->second, calib, status))
+				err = true;
+		}
 	}
 
 	if (err)
 		log_fatal("Errors in GCD information. Check above for "
 		    "details.");
 
+	audited_geo_ = geo_ptr;
+	audited_calib_ = calib_ptr;
+	audited_status_ = status_ptr;
+	bad_doms_.swap(bad_doms);
+
 	PushFrame(frame);
 }
 
+bool I3GCDAuditor::CheckOM(const OMKey &om, const I3OMGeo &omgeo,
+    const I3Calibration &calib, const I3DetectorStatus &status)
+{
+	#define bad_dom(...) { log_error(__VA_ARGS__); return false; }
+
+	// Check for AMANDA OMs, skipping if they are not an error
+	if (omgeo.omtype == I3OMGeo::AMANDA && AMANDA_is_error_)
+		bad_dom("Geometry contains AMANDA OM%s", om.str().c_str());
+	// Also skip scintillator or unknown OMs
+	if (omgeo.omtype == I3OMGeo::AMANDA ||
+	    omgeo.omtype == I3OMGeo::Scintillator ||
+	    omgeo.omtype == I3OMGeo::UnknownType)
+		return true;
+
+	I3DOMCalibrationMap::const_iterator cal = calib.domCal.find(om);
+	if (cal == calib.domCal.end())
+		bad_dom("OM%s has no calibration", om.str().c_str());
+	I3DOMStatusMap::const_iterator stat = status.domStatus.find(om);
+	if (stat == status.domStatus.end())
+		bad_dom("OM%s has no detector status", om.str().c_str());
+
+	#undef bad_dom
+
+	return CheckDOM(om, omgeo, cal->second, stat->second);
+}
+
 bool I3GCDAuditor::CheckDOM(OMKey om, const I3OMGeo &omgeo,
     const I3DOMCalibration &cal, const I3DOMStatus &status)
 {
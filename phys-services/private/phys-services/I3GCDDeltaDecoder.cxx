@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <icetray/I3Module.h>
+#include <dataclasses/I3GCDDelta.h>
+
+/**
+ * @brief Restores the I3Geometry, I3Calibration and I3DetectorStatus that
+ * I3GCDDeltaEncoder replaced with deltas.
+ *
+ * Full objects native to a G, C or D frame become the base of the deltas
+ * that follow them. A delta (the object name with "Delta" appended) is
+ * applied to that base and replaced with the full object, which frame
+ * mixing then hands on to the frames downstream. Put this module right
+ * after the I3Reader.
+ */
+class I3GCDDeltaDecoder : public I3Module
+{
+public:
+    I3GCDDeltaDecoder(const I3Context& context);
+    void Configure();
+    void Geometry(I3FramePtr frame);
+    void Calibration(I3FramePtr frame);
+    void DetectorStatus(I3FramePtr frame);
+
+private:
+    std::string geometryName_;
+    std::string calibrationName_;
+    std::string detectorStatusName_;
+
+    I3GeometryConstPtr geometry_;
+    I3CalibrationConstPtr calibration_;
+    I3DetectorStatusConstPtr detectorStatus_;
+
+    template <typename Delta, typename T>
+    void Decode(I3Frame& frame, const std::string& name,
+                boost::shared_ptr<const T>& base);
+};
+
+I3_MODULE(I3GCDDeltaDecoder);
+
+I3GCDDeltaDecoder::I3GCDDeltaDecoder(const I3Context& context)
+:
+I3Module(context),
+geometryName_(I3DefaultName<I3Geometry>::value()),
+calibrationName_(I3DefaultName<I3Calibration>::value()),
+detectorStatusName_(I3DefaultName<I3DetectorStatus>::value())
+{
+    AddParameter("GeometryName",
+                 "Name of the I3Geometry to restore",
+                 geometryName_);
+    AddParameter("CalibrationName",
+                 "Name of the I3Calibration to restore",
+                 calibrationName_);
+    AddParameter("DetectorStatusName",
+                 "Name of the I3DetectorStatus to restore",
+                 detectorStatusName_);
+
+    AddOutBox("OutBox");
+}
+
+void
+I3GCDDeltaDecoder::Configure()
+{
+    GetParameter("GeometryName", geometryName_);
+    GetParameter("CalibrationName", calibrationName_);
+    GetParameter("DetectorStatusName", detectorStatusName_);
+}
+
+void
+I3GCDDeltaDecoder::Geometry(I3FramePtr frame)
+{
+    Decode<I3GeometryDelta>(*frame, geometryName_, geometry_);
+    PushFrame(frame);
+}
+
+void
+I3GCDDeltaDecoder::Calibration(I3FramePtr frame)
+{
+    Decode<I3CalibrationDelta>(*frame, calibrationName_, calibration_);
+    PushFrame(frame);
+}
+
+void
+I3GCDDeltaDecoder::DetectorStatus(I3FramePtr frame)
+{
+    Decode<I3DetectorStatusDelta>(*frame, detectorStatusName_, detectorStatus_);
+    PushFrame(frame);
+}
+
+template <typename Delta, typename T>
+void
+I3GCDDeltaDecoder::Decode(I3Frame& frame, const std::string& name,
+                          boost::shared_ptr<const T>& base)
+{
+    if (frame.Has(name) && frame.GetStop(name) == frame.GetStop()) {
+        base = frame.Get<boost::shared_ptr<const T> >(name);
+        return;
+    }
+
+    const std::string deltaName = name + "Delta";
+    if (!frame.Has(deltaName) || frame.GetStop(deltaName) != frame.GetStop())
+        return;
+
+    boost::shared_ptr<const Delta> delta =
+        frame.Get<boost::shared_ptr<const Delta> >(deltaName);
+    if (!delta)
+        log_fatal("'%s' is not an %s", deltaName.c_str(),
+                  I3DefaultName<Delta>::value());
+    if (!base)
+        log_fatal("Found '%s', but no earlier '%s' to apply it to.",
+                  deltaName.c_str(), name.c_str());
+
+    frame.Delete(deltaName);
+    frame.Put(name, delta->Apply(*base));
+}
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <icetray/I3Module.h>
+#include <boost/make_shared.hpp>
+#include <dataclasses/I3GCDDelta.h>
+
+/**
+ * @brief Replaces the I3Geometry, I3Calibration and I3DetectorStatus of
+ * G, C and D frames with deltas against the last full object of their type.
+ *
+ * The first object of each type, and every full object after a delta
+ * chain of MaxDeltas, is kept as is and becomes the new base. The others
+ * are replaced by an I3GeometryDelta (I3CalibrationDelta,
+ * I3DetectorStatusDelta) named after the object with "Delta" appended.
+ * Only objects native to the frame are encoded, so the deltas go to
+ * the file in the frame that carried the full object.
+ *
+ * I3GCDDeltaDecoder restores the full objects when the file is read back.
+ */
+class I3GCDDeltaEncoder : public I3Module
+{
+public:
+    I3GCDDeltaEncoder(const I3Context& context);
+    void Configure();
+    void Geometry(I3FramePtr frame);
+    void Calibration(I3FramePtr frame);
+    void DetectorStatus(I3FramePtr frame);
+
+private:
+    std::string geometryName_;
+    std::string calibrationName_;
+    std::string detectorStatusName_;
+    unsigned maxDeltas_;
+
+    template <typename T>
+    struct Base {
+        boost::shared_ptr<const T> object;
+        unsigned deltas;
+        Base() : deltas(0) {}
+    };
+
+    Base<I3Geometry> geometry_;
+    Base<I3Calibration> calibration_;
+    Base<I3DetectorStatus> detectorStatus_;
+
+    template <typename Delta, typename T>
+    void Encode(I3Frame& frame, const std::string& name, Base<T>& base);
+};
+
+I3_MODULE(I3GCDDeltaEncoder);
+
+I3GCDDeltaEncoder::I3GCDDeltaEncoder(const I3Context& context)
+:
+I3Module(context),
+geometryName_(I3DefaultName<I3Geometry>::value()),
+calibrationName_(I3DefaultName<I3Calibration>::value()),
+detectorStatusName_(I3DefaultName<I3DetectorStatus>::value()),
+maxDeltas_(0)
+{
+    AddParameter("GeometryName",
+                 "Name of the I3Geometry to encode",
+                 geometryName_);
+    AddParameter("CalibrationName",
+                 "Name of the I3Calibration to encode",
+                 calibrationName_);
+    AddParameter("DetectorStatusName",
+                 "Name of the I3DetectorStatus to encode",
+                 detectorStatusName_);
+    AddParameter("MaxDeltas",
+                 "Write a full object again after this many deltas against "
+                 "the same base (0: never)",
+                 maxDeltas_);
+
+    AddOutBox("OutBox");
+}
+
+void
+I3GCDDeltaEncoder::Configure()
+{
+    GetParameter("GeometryName", geometryName_);
+    GetParameter("CalibrationName", calibrationName_);
+    GetParameter("DetectorStatusName", detectorStatusName_);
+    GetParameter("MaxDeltas", maxDeltas_);
+}
+
+void
+I3GCDDeltaEncoder::Geometry(I3FramePtr frame)
+{
+    Encode<I3GeometryDelta>(*frame, geometryName_, geometry_);
+    PushFrame(frame);
+}
+
+void
+I3GCDDeltaEncoder::Calibration(I3FramePtr frame)
+{
+    Encode<I3CalibrationDelta>(*frame, calibrationName_, calibration_);
+    PushFrame(frame);
+}
+
+void
+I3GCDDeltaEncoder::DetectorStatus(I3FramePtr frame)
+{
+    Encode<I3DetectorStatusDelta>(*frame, detectorStatusName_, detectorStatus_);
+    PushFrame(frame);
+}
+
+template <typename Delta, typename T>
+void
+I3GCDDeltaEncoder::Encode(I3Frame& frame, const std::string& name, Base<T>& base)
+{
+    // objects mixed in from earlier frames were encoded there
+    if (!frame.Has(name) || frame.GetStop(name) != frame.GetStop())
+        return;
+
+    boost::shared_ptr<const T> current = frame.Get<boost::shared_ptr<const T> >(name);
+    if (!current)
+        log_fatal("'%s' is not an %s", name.c_str(),
+                  I3DefaultName<T>::value());
+
+    if (!base.object || (maxDeltas_ > 0 && base.deltas >= maxDeltas_)) {
+        base.object = current;
+        base.deltas = 0;
+        return;
+    }
+
+    frame.Delete(name);
+    frame.Put(name + "Delta", boost::make_shared<Delta>(*base.object, *current));
+    base.deltas++;
+}
@@ -14,6 +14,7 @@
 #include <dataclasses/geometry/I3OMGeo.h>
 #include <dataclasses/geometry/I3TankGeo.h>
 #include <dataclasses/geometry/I3ModuleGeo.h>
+#include <dataclasses/geometry/I3OMKeyIndex.h>
 #include <dataclasses/I3Time.h>
 #include <dataclasses/I3Double.h>
 #include <dataclasses/I3Orientation.h>
@@ -23,7 +24,8 @@
  * components (I3OMGeoMap, I3StationGeoMap and
  * I3Time) and stores them in the Geometry frame.
  *
- * While at it, this also generates an I3ModuleGeoMap.
+ * While at it, this also generates an I3ModuleGeoMap and
+ * an I3OMKeyIndex.
  */
 class I3GeometryDecomposer : public I3Module
 {
@@ -106,6 +108,7 @@ I3GeometryDecomposer::Geometry(I3FramePtr frame)
 
     frame->Put("I3OMGeoMap",      I3OMGeoMapPtr     (new I3OMGeoMap     (geometry->omgeo     )));
     frame->Put("I3ModuleGeoMap",  GenerateI3ModuleGeo(geometry->omgeo));
+    frame->Put("I3OMKeyIndex",    I3OMKeyIndexPtr   (new I3OMKeyIndex   (geometry->omgeo     )));
     frame->Put("I3StationGeoMap", I3StationGeoMapPtr(new I3StationGeoMap(geometry->stationgeo)));
     frame->Put("StartTime",     I3TimePtr         (new I3Time         (geometry->startTime )));
     frame->Put("EndTime",       I3TimePtr         (new I3Time         (geometry->endTime   )));
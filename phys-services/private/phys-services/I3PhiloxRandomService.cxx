@@ -0,0 +1,255 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <cmath>
+#include <sstream>
+
+#include "phys-services/I3PhiloxRandomService.h"
+#include "dataclasses/I3String.h"
+
+namespace {
+
+  const uint32_t PHILOX_M0 = 0xD2511F53;
+  const uint32_t PHILOX_M1 = 0xCD9E8D57;
+  const uint32_t PHILOX_W0 = 0x9E3779B9;
+  const uint32_t PHILOX_W1 = 0xBB67AE85;
+
+  inline void
+  mulhilo(uint32_t a, uint32_t b, uint32_t& hi, uint32_t& lo)
+  {
+    const uint64_t product = uint64_t(a)*uint64_t(b);
+    hi = uint32_t(product >> 32);
+    lo = uint32_t(product);
+  }
+
+  // Box-Muller transform of two uniform numbers in [0,1)
+  inline void
+  boxmuller(double u1, double u2, double& z0, double& z1)
+  {
+    const double r = std::sqrt(-2*std::log(1-u1));
+    const double phi = 2*M_PI*u2;
+    z0 = r*std::cos(phi);
+    z1 = r*std::sin(phi);
+  }
+
+  // FNV-1a, to turn module names into stream keys
+  uint32_t
+  hash_name(const std::string& name)
+  {
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : name) {
+      hash ^= c;
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+}
+
+I3PhiloxEngine::block_type
+I3PhiloxEngine::Philox(block_type ctr, key_type key)
+{
+  for (int round = 0; round < 10; round++) {
+    if (round > 0) {
+      key[0] += PHILOX_W0;
+      key[1] += PHILOX_W1;
+    }
+    uint32_t hi0, lo0, hi1, lo1;
+    mulhilo(PHILOX_M0, ctr[0], hi0, lo0);
+    mulhilo(PHILOX_M1, ctr[2], hi1, lo1);
+    ctr = {{hi1^ctr[1]^key[0], lo1, hi0^ctr[3]^key[1], lo0}};
+  }
+  return ctr;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const I3PhiloxEngine& engine)
+{
+  os << engine.GetKey()[0] << ' ' << engine.GetKey()[1] << ' '
+     << engine.GetStream()[0] << ' ' << engine.GetStream()[1] << ' '
+     << engine.GetPosition();
+  return os;
+}
+
+std::istream&
+operator>>(std::istream& is, I3PhiloxEngine& engine)
+{
+  I3PhiloxEngine::key_type key, stream;
+  uint64_t position;
+  if (is >> key[0] >> key[1] >> stream[0] >> stream[1] >> position) {
+    engine = I3PhiloxEngine(key, stream);
+    engine.Seek(position);
+  }
+  return is;
+}
+
+I3PhiloxRandomService::I3PhiloxRandomService(uint64_t seed)
+  : engine_({{uint32_t(seed), uint32_t(seed >> 32)}}, {{0, 0}})
+{}
+
+I3PhiloxRandomService::I3PhiloxRandomService(const I3PhiloxEngine& engine)
+  : engine_(engine)
+{}
+
+I3PhiloxRandomService::~I3PhiloxRandomService(){}
+
+I3PhiloxRandomServicePtr
+I3PhiloxRandomService::GetStream(uint32_t run, uint32_t event, uint32_t module) const
+{
+  // The first bijection makes every (run, event, module) a distinct
+  // 128-bit block, the second mixes in the stream of this generator. The
+  // result is the key and stream of the child.
+  const I3PhiloxEngine::key_type& key = engine_.GetKey();
+  const I3PhiloxEngine::key_type& stream = engine_.GetStream();
+  I3PhiloxEngine::block_type block =
+    I3PhiloxEngine::Philox({{run, event, module, 0}}, key);
+  block[0] ^= stream[0];
+  block[1] ^= stream[1];
+  block = I3PhiloxEngine::Philox(block, key);
+
+  return I3PhiloxRandomServicePtr(new I3PhiloxRandomService(
+    I3PhiloxEngine({{block[0], block[1]}}, {{block[2], block[3]}})));
+}
+
+I3PhiloxRandomServicePtr
+I3PhiloxRandomService::GetStream(uint32_t run, uint32_t event, const std::string& module) const
+{
+  return GetStream(run, event, hash_name(module));
+}
+
+unsigned int
+I3PhiloxRandomService::Integer(unsigned int imax)
+{
+  if (imax == 0)
+    return 0;
+  // Lemire's nearly divisionless method: no modulo bias
+  uint64_t m = uint64_t(engine_())*imax;
+  uint32_t low = uint32_t(m);
+  if (low < imax) {
+    const uint32_t threshold = uint32_t(-imax) % imax;
+    while (low < threshold) {
+      m = uint64_t(engine_())*imax;
+      low = uint32_t(m);
+    }
+  }
+  return m >> 32;
+}
+
+uint32_t
+I3PhiloxRandomService::Integer32()
+{
+  return engine_();
+}
+
+double
+I3PhiloxRandomService::Uniform(double x)
+{
+  return x*engine_.Canonical();
+}
+
+double
+I3PhiloxRandomService::Uniform(double x1, double x2)
+{
+  return x1 + (x2-x1)*engine_.Canonical();
+}
+
+double
+I3PhiloxRandomService::Exp(double tau)
+{
+  return -tau*std::log(1-engine_.Canonical());
+}
+
+double
+I3PhiloxRandomService::Gaus(double mean, double stddev)
+{
+  const double u1 = engine_.Canonical();
+  const double u2 = engine_.Canonical();
+  double z0, z1;
+  boxmuller(u1, u2, z0, z1);
+  return mean + stddev*z0;
+}
+
+void
+I3PhiloxRandomService::FillUniform(double* out, size_t n, double x1, double x2)
+{
+  const double width = x2-x1;
+  for (size_t i = 0; i < n; i++)
+    out[i] = x1 + width*engine_.Canonical();
+}
+
+void
+I3PhiloxRandomService::FillGaus(double* out, size_t n, double mean, double stddev)
+{
+  size_t i = 0;
+  for (; i+1 < n; i += 2) {
+    const double u1 = engine_.Canonical();
+    const double u2 = engine_.Canonical();
+    double z0, z1;
+    boxmuller(u1, u2, z0, z1);
+    out[i] = mean + stddev*z0;
+    out[i+1] = mean + stddev*z1;
+  }
+  if (i < n)
+    out[i] = Gaus(mean, stddev);
+}
+
+void
+I3PhiloxRandomService::FillExp(double* out, size_t n, double tau)
+{
+  for (size_t i = 0; i < n; i++)
+    out[i] = -tau*std::log(1-engine_.Canonical());
+}
+
+I3FrameObjectPtr
+I3PhiloxRandomService::GetState() const
+{
+  std::stringstream ss;
+  ss << engine_;
+  return I3StringPtr(new I3String(ss.str()));
+}
+
+void
+I3PhiloxRandomService::RestoreState(I3FrameObjectConstPtr vstate)
+{
+  I3StringConstPtr s = boost::dynamic_pointer_cast<const I3String>(vstate);
+  if (!s)
+    log_fatal("The state of an I3PhiloxRandomService is an I3String");
+  std::stringstream ss(s->value);
+  if (!(ss >> engine_))
+    log_fatal("Could not parse random state '%s'", s->value.c_str());
+}
+
+// Service Factory
+
+I3PhiloxRandomServiceFactory::I3PhiloxRandomServiceFactory(const I3Context& context)
+  : I3ServiceFactory(context), seed_(0)
+{
+  AddParameter("Seed",
+	       "Seed of the root stream. Independent streams for each event and "
+	       "module are derived from it with GetStream()",
+	       seed_);
+
+  installServiceAs_ = I3DefaultName<I3RandomService>::value();
+  AddParameter("InstallServiceAs",
+	       "Install the random service at the following location",
+	       installServiceAs_);
+}
+
+I3PhiloxRandomServiceFactory::~I3PhiloxRandomServiceFactory(){}
+
+void I3PhiloxRandomServiceFactory::Configure()
+{
+  GetParameter("Seed", seed_);
+  GetParameter("InstallServiceAs", installServiceAs_);
+}
+
+bool
+I3PhiloxRandomServiceFactory::InstallService(I3Context& services)
+{
+  if(!random_)
+    random_ = I3RandomServicePtr(new I3PhiloxRandomService(seed_));
+  return services.Put<I3RandomService>(installServiceAs_, random_);
+}
+
+I3_SERVICE_FACTORY(I3PhiloxRandomServiceFactory);
@@ -94,6 +94,24 @@ double I3RandomService::Uniform(double x2)
 	return Uniform(0, x2);
 }
 
+void I3RandomService::FillUniform(double* out, size_t n, double x1, double x2)
+{
+	for (size_t i = 0; i < n; i++)
+		out[i] = Uniform(x1, x2);
+}
+
+void I3RandomService::FillGaus(double* out, size_t n, double mean, double stddev)
+{
+	for (size_t i = 0; i < n; i++)
+		out[i] = Gaus(mean, stddev);
+}
+
+void I3RandomService::FillExp(double* out, size_t n, double tau)
+{
+	for (size_t i = 0; i < n; i++)
+		out[i] = Exp(tau);
+}
+
 const gsl_rng_wrap *
 I3RandomService::GSLRng() const
 {
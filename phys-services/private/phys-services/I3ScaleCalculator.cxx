@@ -6,8 +6,10 @@
 #include "phys-services/I3Cuts.h"
 
 #include <boost/foreach.hpp>
+#include <boost/weak_ptr.hpp>
 #include <vector>
 #include <map>
+#include <mutex>
 #include <set>
 #include <limits>
 
@@ -15,6 +17,22 @@
 
 using namespace std;
 
+/// The boundary of the detector, shared by all calculators with the same settings
+struct I3ScaleCalculator::Outline {
+  std::once_flag inIceOnce;
+  std::vector<double> inIceX;
+  std::vector<double> inIceY;
+  double zMin;
+  double zMax;
+  I3Cuts::ContainmentPolygon inIce;
+
+  std::once_flag iceTopOnce;
+  std::vector<double> iceTopX;
+  std::vector<double> iceTopY;
+  double zIceTop;
+  I3Cuts::ContainmentPolygon iceTop;
+};
+
 I3ScaleCalculator::I3ScaleCalculator (I3GeometryConstPtr geo,
                                       IceCubeConfig iceConf,
                                       IceTopConfig topConf,
@@ -82,6 +100,48 @@ I3ScaleCalculator::I3ScaleCalculator (I3GeometryConstPtr geo,
     topDOMid_ = 40;  // for a "normal" string, approximately at the height of the top of the bit of deepcore below the dustlayer (~-160 meters)
   }
 
+  // Calculators for the same geometry object share their outline. The
+  // geometry is only watched, so it is never kept alive by the cache.
+  if (geo_) {
+    struct CacheEntry {
+      boost::weak_ptr<const I3Geometry> geo;
+      IceCubeConfig iceConf;
+      IceTopConfig topConf;
+      std::vector<int> strings;
+      std::vector<int> stations;
+      int topDOMid;
+      int bottomDOMid;
+      std::shared_ptr<Outline> outline;
+    };
+    static std::mutex cacheMutex;
+    static std::vector<CacheEntry> cache;
+    const size_t maxCacheSize = 16;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cache.erase(std::remove_if(cache.begin(), cache.end(),
+                               [](const CacheEntry& e) { return e.geo.expired(); }),
+                cache.end());
+    for (const CacheEntry& e : cache) {
+      if (e.geo.lock() == geo_ && e.iceConf == iceConf_ && e.topConf == topConf_
+          && e.strings == listOfBoundaryDeepStrings_
+          && e.stations == listOfBoundarySurfaceStations_
+          && e.topDOMid == topDOMid_ && e.bottomDOMid == bottomDOMid_) {
+        outline_ = e.outline;
+        break;
+      }
+    }
+    if (!outline_) {
+      outline_ = std::make_shared<Outline>();
+      if (cache.size() >= maxCacheSize)
+        cache.erase(cache.begin());
+      cache.push_back(CacheEntry{geo_, iceConf_, topConf_,
+                                 listOfBoundaryDeepStrings_, listOfBoundarySurfaceStations_,
+                                 topDOMid_, bottomDOMid_, outline_});
+    }
+  } else {
+    outline_ = std::make_shared<Outline>();
+  }
+
 #ifndef NDEBUG
   log_debug("At the end of the constructor, we've got configs: %d / %d", iceConf_, topConf_);
   log_debug("And lists of strings (%ld):", listOfBoundaryDeepStrings_.size());
@@ -319,16 +379,22 @@ std::vector<int > I3ScaleCalculator::GetOuterStations () const {
 
 
 
-void I3ScaleCalculator::CalcOuterStringPositions (std::vector<double > &x,
-                                                  std::vector<double > &y,
-                                                  double &zMin,
-                                                  double &zMax) const {
+void I3ScaleCalculator::ComputeOuterStringPositions (std::vector<double > &x,
+                                                     std::vector<double > &y,
+                                                     double &zMin,
+                                                     double &zMax) const {
 
   // get the string numbers
   std::vector<int > outerStrings = GetOuterStrings ();
 
   // get the geo
-  I3OMGeoMap omMap = geo_->omgeo;
+  const I3OMGeoMap& omMap = geo_->omgeo;
+  // DOMs missing from the geometry count with the position of a default I3OMGeo
+  const I3OMGeo missing;
+  auto omGeo = [&omMap, &missing](const OMKey& key) -> const I3OMGeo& {
+    I3OMGeoMap::const_iterator it = omMap.find(key);
+    return it == omMap.end() ? missing : it->second;
+  };
 
   x.clear ();
   y.clear ();
@@ -344,16 +410,16 @@ void I3ScaleCalculator::CalcOuterStringPositions (std::vector<double > &x,
     OMKey key (stringNo, nmiddle);  // pick roughly the middle of the string
     if (omMap.find(key) == omMap.end() ) 
       log_fatal("Looks like you asked for a string %d (middle DOM %d) which is not in the I3Geometry.", stringNo, nmiddle);
-    double xPos = omMap[key].position.GetX ();
-    double yPos = omMap[key].position.GetY ();
+    double xPos = omGeo(key).position.GetX ();
+    double yPos = omGeo(key).position.GetY ();
     x.push_back (xPos);
     y.push_back (yPos);
     log_debug("String %d: x=%f y=%f", stringNo, xPos, yPos);
     // Get coordinates of top and bottom
     OMKey keyTop (stringNo, topDOMid_);  // top of the string
     OMKey keyBot (stringNo, bottomDOMid_);  // bottom of the string
-    zMax += omMap[keyTop].position.GetZ();
-    zMin += omMap[keyBot].position.GetZ();
+    zMax += omGeo(keyTop).position.GetZ();
+    zMin += omGeo(keyBot).position.GetZ();
   }
 
   zMin /= outerStrings.size ();
@@ -361,39 +427,79 @@ void I3ScaleCalculator::CalcOuterStringPositions (std::vector<double > &x,
 
 }
 
-void I3ScaleCalculator::CalcOuterStationPositions (std::vector<double > &x,
-                                                   std::vector<double > &y,
-                                                   double &z) const {
+void I3ScaleCalculator::ComputeOuterStationPositions (std::vector<double > &x,
+                                                      std::vector<double > &y,
+                                                      double &z) const {
 
   // get the station numbers
   std::vector<int > outerStrings = GetOuterStations ();
 
   // get the geometry
-  I3StationGeoMap stationMap = geo_->stationgeo;
+  const I3StationGeoMap& stationMap = geo_->stationgeo;
   x.clear ();
   y.clear ();
 
   // calculate the positions of the two tanks within the station, and average them (X and Y)
   // the z-coordinate is fixed.
   BOOST_FOREACH (int stringNo, outerStrings) {
-    if (stationMap.find(stringNo) == stationMap.end() ) 
+    I3StationGeoMap::const_iterator station = stationMap.find(stringNo);
+    if (station == stationMap.end() ) 
       log_fatal("Looks like you asked for a station %d which is not in the I3Geometry.", stringNo);
-    x.push_back ((stationMap[stringNo][0].position.GetX ()
-                  + stationMap[stringNo][1].position.GetX ()) / 2);
-    y.push_back ((stationMap[stringNo][0].position.GetY ()
-                  + stationMap[stringNo][1].position.GetY ()) / 2);
+    x.push_back ((station->second[0].position.GetX ()
+                  + station->second[1].position.GetX ()) / 2);
+    y.push_back ((station->second[0].position.GetY ()
+                  + station->second[1].position.GetY ()) / 2);
   }
   z = Z_TOP;
 }
 
 
+const I3ScaleCalculator::Outline& I3ScaleCalculator::GetInIceOutline () const {
+  Outline& outline = *outline_;
+  std::call_once(outline.inIceOnce, [this, &outline]() {
+      ComputeOuterStringPositions (outline.inIceX, outline.inIceY, outline.zMin, outline.zMax);
+      outline.inIce = I3Cuts::ContainmentPolygon (outline.inIceX, outline.inIceY);
+    });
+  return outline;
+}
+
+const I3ScaleCalculator::Outline& I3ScaleCalculator::GetIceTopOutline () const {
+  Outline& outline = *outline_;
+  std::call_once(outline.iceTopOnce, [this, &outline]() {
+      ComputeOuterStationPositions (outline.iceTopX, outline.iceTopY, outline.zIceTop);
+      outline.iceTop = I3Cuts::ContainmentPolygon (outline.iceTopX, outline.iceTopY);
+    });
+  return outline;
+}
+
+void I3ScaleCalculator::CalcOuterStringPositions (std::vector<double > &x,
+                                                  std::vector<double > &y,
+                                                  double &zMin,
+                                                  double &zMax) const {
+  const Outline& outline = GetInIceOutline ();
+  x = outline.inIceX;
+  y = outline.inIceY;
+  zMin = outline.zMin;
+  zMax = outline.zMax;
+}
+
+void I3ScaleCalculator::CalcOuterStationPositions (std::vector<double > &x,
+                                                   std::vector<double > &y,
+                                                   double &z) const {
+  const Outline& outline = GetIceTopOutline ();
+  x = outline.iceTopX;
+  y = outline.iceTopY;
+  z = outline.zIceTop;
+}
+
+
 double I3ScaleCalculator::ScaleInIce (I3Particle part) const {
   if (iceConf_ > IC_EMPTY) {
     if (part.IsCascade ()) {
-      return ScaleInIceCascade (part,false);
+      return ScaleInIceCascade (part, false, GetInIceOutline ());
     }
     else {
-      return ScaleInIceMuon (part);
+      return ScaleInIceMuon (part, GetInIceOutline ());
     }
   }
   else {
@@ -402,10 +508,37 @@ double I3ScaleCalculator::ScaleInIce (I3Particle part) const {
   }
 };
 
+std::vector<double> I3ScaleCalculator::ScaleInIce (const std::vector<I3Particle> &parts) const {
+  if (iceConf_ <= IC_EMPTY) {
+    log_error ("Unknown or empty IceCube Configuration.");
+    return std::vector<double>(parts.size(), std::numeric_limits<double >::signaling_NaN ());
+  }
+
+  const Outline& outline = GetInIceOutline ();
+  std::vector<double> scales(parts.size());
+  // the tracks share the walls of the detector prism
+  std::vector<I3Particle> tracks;
+  std::vector<size_t> trackIndex;
+  for (size_t i = 0; i < parts.size(); i++) {
+    if (parts[i].IsCascade ()) {
+      scales[i] = ScaleInIceCascade (parts[i], false, outline);
+    }
+    else {
+      tracks.push_back (parts[i]);
+      trackIndex.push_back (i);
+    }
+  }
+  std::vector<double> trackScales =
+    I3Cuts::ContainmentVolumeSize (tracks, outline.inIce, outline.zMax, outline.zMin);
+  for (size_t i = 0; i < tracks.size(); i++)
+    scales[trackIndex[i]] = trackScales[i];
+  return scales;
+}
+
 double I3ScaleCalculator::ScaleIceCubeDetectorPolygon (I3Particle part) const {
   if (iceConf_ > IC_EMPTY) {
     if (part.IsCascade ()) {
-      return ScaleInIceCascade (part,true);
+      return ScaleInIceCascade (part, true, GetInIceOutline ());
     }
     else {
       log_error ("Particle must be of shape Cascade to calculate IceCube detector polygon scaling factor");
@@ -420,11 +553,8 @@ double I3ScaleCalculator::ScaleIceCubeDetectorPolygon (I3Particle part) const {
 
 double I3ScaleCalculator::ScaleIceTop (I3Particle part) const {
   if (topConf_ > IT_EMPTY) {
-    std::vector<double > x;
-    std::vector<double > y;
-    double z;
-    CalcOuterStationPositions (x, y, z);
-    return I3Cuts::ContainmentAreaSize (part, x, y, z);
+    const Outline& outline = GetIceTopOutline ();
+    return I3Cuts::ContainmentAreaSize (part, outline.iceTop, outline.zIceTop);
   }
   else {
     log_error ("Unknown or empty IceTop Configuration.");
@@ -432,25 +562,28 @@ double I3ScaleCalculator::ScaleIceTop (I3Particle part) const {
   }
 }
 
+std::vector<double> I3ScaleCalculator::ScaleIceTop (const std::vector<I3Particle> &parts) const {
+  if (topConf_ > IT_EMPTY) {
+    const Outline& outline = GetIceTopOutline ();
+    return I3Cuts::ContainmentAreaSize (parts, outline.iceTop, outline.zIceTop);
+  }
+  else {
+    log_error ("Unknown or empty IceTop Configuration.");
+    return std::vector<double>(parts.size(), std::numeric_limits<double >::signaling_NaN ());
+  }
+}
+
 
-double I3ScaleCalculator::ScaleInIceMuon (I3Particle part) const {
-    std::vector<double > x;
-    std::vector<double > y;
-    double ztop;
-    double zbot;
-    CalcOuterStringPositions (x, y, zbot, ztop);
-    return I3Cuts::ContainmentVolumeSize (part, x, y, ztop, zbot);
+double I3ScaleCalculator::ScaleInIceMuon (const I3Particle &part, const Outline &outline) const {
+    return I3Cuts::ContainmentVolumeSize (part, outline.inIce, outline.zMax, outline.zMin);
 }
 
-double I3ScaleCalculator::ScaleInIceCascade (I3Particle part,bool areaonly) const {
+double I3ScaleCalculator::ScaleInIceCascade (const I3Particle &part, bool areaonly,
+                                             const Outline &outline) const {
 
   // get detector info
-  std::vector<double > x;
-  std::vector<double > y;
-  double zTop;
-  double zBot;
-
-  CalcOuterStringPositions (x, y, zBot, zTop);
+  double zTop = outline.zMax;
+  double zBot = outline.zMin;
 
   double zMiddle = (zTop + zBot) / 2;
 
@@ -460,7 +593,7 @@ double I3ScaleCalculator::ScaleInIceCascade (I3Particle part,bool areaonly) cons
   referenceTrack.SetDir (0, 0); // change to zenith 0
 
   // calculate the AreaSize
-  double areaScale = I3Cuts::ContainmentAreaSize (referenceTrack, x, y, zMiddle);
+  double areaScale = I3Cuts::ContainmentAreaSize (referenceTrack, outline.inIce, zMiddle);
 
   // calculate the z-Scale
   double zScale = abs (referenceTrack.GetZ () - zMiddle) / (zTop - zMiddle);
@@ -476,60 +609,26 @@ double I3ScaleCalculator::ScaleInIceCascade (I3Particle part,bool areaonly) cons
 bool I3ScaleCalculator::VertexIsInside (const I3Particle &part) const {
 
   // get detector info
-  std::vector<double > xp;
-  std::vector<double > yp;
-  double zTop;
-  double zBot;
+  const Outline& outline = GetInIceOutline ();
 
   double x = part.GetX ();
   double y = part.GetY ();
   double z = part.GetZ ();
 
-  CalcOuterStringPositions (xp, yp, zBot, zTop);
-
-  // close the polygon:
-  xp.push_back (xp[0]);
-  yp.push_back (yp[0]);
-
-  return ((z < zTop)
-          && (z > zBot)
-          && IsInside (x, y, xp, yp));
+  return ((z < outline.zMax)
+          && (z > outline.zMin)
+          && outline.inIce.IsInside (x, y));
 
 }
 
-bool I3ScaleCalculator::IsInside(double xp, double yp,
-                                 const std::vector<double > &x,
-                                 const std::vector<double > &y) const {
-  //  implementation found in root.
-   double xint;
-   int inter = 0;
-   double xn,yn;
-
-   int np = x.size () - 1;
-
-   for (int i=0; i < np; ++i) {
-
-      if (i <np-1) {
-        xn = x[i+1];
-        yn = y[i+1];
-      }
-      else {
-        xn = x[0];
-        yn = y[0];
-      }
-      if (y[i] == yn) continue;
-      if (yp <= y[i] && yp <= yn) continue;
-      if (y[i] < yp && yn < yp) continue;
-
-      xint = x[i] + (yp-y[i])*(xn-x[i])/(yn-y[i]);
-      if (xp < xint) inter++;
-   }
-
-   if (inter % 2) {
-     return true;
-   }
-   else {
-     return false;
-   }
+std::vector<bool> I3ScaleCalculator::VertexIsInside (const std::vector<I3Particle> &parts) const {
+  const Outline& outline = GetInIceOutline ();
+  std::vector<bool> inside(parts.size());
+  for (size_t i = 0; i < parts.size(); i++) {
+    const I3Position& pos = parts[i].GetPos ();
+    inside[i] = ((pos.GetZ () < outline.zMax)
+                 && (pos.GetZ () > outline.zMin)
+                 && outline.inIce.IsInside (pos.GetX (), pos.GetY ()));
+  }
+  return inside;
 }
-
@@ -9,6 +9,7 @@
 #include <icetray/I3Context.h>
 #include <icetray/I3Configuration.h>
 #include <dataclasses/physics/I3EventHeader.h>
+#include <dataclasses/I3MapOMKeyMask.h>
 
 #include "phys-services/I3Splitter.h"
 
@@ -60,3 +61,12 @@ I3Splitter::GetNextSubEvent(I3FramePtr daq) {
 	return frame;
 }
 
+
+void
+I3Splitter::PutSubEventPulses(I3Frame& subevent, const std::string& name,
+    const std::string& source, double tmin, double tmax,
+    const std::vector<OMKey>& doms)
+{
+	subevent.Put(name, I3RecoPulseSeriesMapMaskPtr(
+	    new I3RecoPulseSeriesMapMask(subevent, source, tmin, tmax, doms)));
+}
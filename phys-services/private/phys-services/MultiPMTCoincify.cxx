@@ -97,81 +97,57 @@ void MultiPMTCoincify::Configure()
 }
 
 void MultiPMTCoincify::Coincify(UpgradeReadoutSeriesMap& readoutMap){
+  // Without a geometry, index the PMTs that have readouts
+  std::vector<OMKey> pmts;
+  pmts.reserve(readoutMap.size());
+  for(const auto& entry : readoutMap){
+    pmts.push_back(entry.first);
+  }
+  Coincify(readoutMap, MultiPMTNeighbourIndex(pmts, moduleSpan_));
+}
+
+void MultiPMTCoincify::Coincify(UpgradeReadoutSeriesMap& readoutMap,
+                                const MultiPMTNeighbourIndex& neighbours){
   log_debug("Entering MultiPMTCoincify::Coincify()");
 
   //---------------------------
-  // Run the coincidence processing
-  // The plan here is to try to cleverly use four pieces of information:
-  //  (1) I3Map is a map, so we know we read out in order of OMKeys
-  //  (2) We can compare OMKeys to set the bound for a second loop
-  //  (3) Readouts are time ordered now, so we can use std::lower_bound for LC calculations
-  //  (4) LC conditions are symmetric, so we only need to look forward, not back.
+  // Run the coincidence processing. The index sweeps over the readouts of
+  // each string in time order and hands us every pair of readouts that is
+  // within the time window of two PMTs of one module or of two modules
+  // within the span. LC conditions are symmetric, so each pair is seen
+  // once. If we're not doing same-module LC, those pairs are skipped.
   //---------------------------
-  for(auto firstPmtIter=readoutMap.begin(); firstPmtIter!=readoutMap.end(); ++firstPmtIter){
-    OMKey firstOMKey = firstPmtIter->first;
-    UpgradeReadoutSeries& firstReadouts = firstPmtIter->second;
-
-    // Keep track of when we've gone too far...
-    const OMKey tooFar = OMKey(firstOMKey.GetString(), firstOMKey.GetOM()+moduleSpan_+1, 0);
-    for(auto secondPmtIter=std::next(firstPmtIter);
-	(secondPmtIter->first<tooFar) && (secondPmtIter!=readoutMap.end());
-	++secondPmtIter){
-      OMKey secondOMKey = secondPmtIter->first;
-      UpgradeReadoutSeries& secondReadouts = secondPmtIter->second;
-
-      // Choose the time window to use for checks
-      bool sameModule = ((firstOMKey.GetString() == secondOMKey.GetString())
-                         && (firstOMKey.GetOM() == secondOMKey.GetOM()));
-      double window = sameModule ? pmtTime_ : moduleTime_;
-
-      // If we're not doing same-module LC here, we can move on.
-      if(sameModule && !bool(lcTypes_ & UpgradeLCFlags::SingleModuleLC)){
-        continue;
+  const bool singleModule = bool(lcTypes_ & UpgradeLCFlags::SingleModuleLC);
+  const double pmtWindow = singleModule ? double(pmtTime_) : -1.;
+
+  neighbours.ForEachCoincidence(readoutMap, moduleTime_, pmtWindow,
+    [this](UpgradeReadout& firstHit, UpgradeReadout& secondHit, bool sameModule){
+      if(bool(lcTypes_ & UpgradeLCFlags::SingleModuleLC) && sameModule){
+        firstHit.AddLCFlags(UpgradeLCFlags::SingleModuleLC);
+        secondHit.AddLCFlags(UpgradeLCFlags::SingleModuleLC);
+      }
+      if (bool(lcTypes_ & UpgradeLCFlags::MultiModuleLC) && !sameModule){
+        firstHit.AddLCFlags(UpgradeLCFlags::MultiModuleLC);
+        secondHit.AddLCFlags(UpgradeLCFlags::MultiModuleLC);
+      }
+      if(bool(lcTypes_ & UpgradeLCFlags::DEggInclusiveLC) &&
+         ((firstHit.type == I3OMGeo::DEgg) || secondHit.type == I3OMGeo::DEgg)){
+        firstHit.AddLCFlags(UpgradeLCFlags::DEggInclusiveLC);
+        secondHit.AddLCFlags(UpgradeLCFlags::DEggInclusiveLC);
+      }
+      if(bool(lcTypes_ & UpgradeLCFlags::DEggExclusiveLC) &&
+         ((firstHit.type == I3OMGeo::DEgg) && secondHit.type == I3OMGeo::DEgg)){
+        firstHit.AddLCFlags(UpgradeLCFlags::DEggExclusiveLC);
+        secondHit.AddLCFlags(UpgradeLCFlags::DEggExclusiveLC);
       }
 
-      //---------------------------
-      // Start going through the launches, using std::lower_bound to
-      // find the first hits worth checking.
-      //---------------------------
-      for(auto& firstHit : firstReadouts){
-        auto secondHitIter = std::lower_bound(secondReadouts.begin(), secondReadouts.end(), firstHit,
-                                              [](const UpgradeReadout& A, const UpgradeReadout& B){return A.GetTime() < B.GetTime();});
-        for(; secondHitIter != secondReadouts.end(); ++secondHitIter){
-          double dt = secondHitIter->GetTime() - firstHit.GetTime();
-          if(dt > window){
-            break;
-          }
-          if(std::abs(dt) <= window){
-            if(bool(lcTypes_ & UpgradeLCFlags::SingleModuleLC) && sameModule){
-              firstHit.AddLCFlags(UpgradeLCFlags::SingleModuleLC);
-              secondHitIter->AddLCFlags(UpgradeLCFlags::SingleModuleLC);
-            }
-            if (bool(lcTypes_ & UpgradeLCFlags::MultiModuleLC) && !sameModule){
-              firstHit.AddLCFlags(UpgradeLCFlags::MultiModuleLC);
-              secondHitIter->AddLCFlags(UpgradeLCFlags::MultiModuleLC);
-            }
-            if(bool(lcTypes_ & UpgradeLCFlags::DEggInclusiveLC) &&
-               ((firstHit.type == I3OMGeo::DEgg) || secondHitIter->type == I3OMGeo::DEgg)){
-              firstHit.AddLCFlags(UpgradeLCFlags::DEggInclusiveLC);
-              secondHitIter->AddLCFlags(UpgradeLCFlags::DEggInclusiveLC);
-            }
-            if(bool(lcTypes_ & UpgradeLCFlags::DEggExclusiveLC) &&
-               ((firstHit.type == I3OMGeo::DEgg) && secondHitIter->type == I3OMGeo::DEgg)){
-              firstHit.AddLCFlags(UpgradeLCFlags::DEggExclusiveLC);
-              secondHitIter->AddLCFlags(UpgradeLCFlags::DEggExclusiveLC);
-            }
-
-            // The non-uniform LC is a catch-all, so just accept it here without other conditions.
-            // We're going to explicitly assume that the user knows what they're doing with this one.
-            if(bool(lcTypes_ & UpgradeLCFlags::NonUniformLC)){
-              firstHit.AddLCFlags(UpgradeLCFlags::NonUniformLC);
-              secondHitIter->AddLCFlags(UpgradeLCFlags::NonUniformLC);
-            }
-          }
-        }
+      // The non-uniform LC is a catch-all, so just accept it here without other conditions.
+      // We're going to explicitly assume that the user knows what they're doing with this one.
+      if(bool(lcTypes_ & UpgradeLCFlags::NonUniformLC)){
+        firstHit.AddLCFlags(UpgradeLCFlags::NonUniformLC);
+        secondHit.AddLCFlags(UpgradeLCFlags::NonUniformLC);
       }
-    }
-  }
+    });
 }
 
 void MultiPMTCoincify::DAQ(I3FramePtr frame){
@@ -206,9 +182,18 @@ void MultiPMTCoincify::DAQ(I3FramePtr frame){
   }
 
   //---------------------------
-  // Run the processing
+  // Run the processing. The neighbour index only changes with the geometry.
   //---------------------------
-  Coincify(readoutMap);
+  if(geo != neighboursGeometry_){
+    neighbours_ = MultiPMTNeighbourIndex(omgeoMap, moduleSpan_);
+    neighboursGeometry_ = geo;
+  }
+  if(neighbours_.Covers(readoutMap)){
+    Coincify(readoutMap, neighbours_);
+  }else{
+    log_debug("Readouts on PMTs missing from the geometry, indexing the readouts instead");
+    Coincify(readoutMap);
+  }
 
   //---------------------------
   // Write the newly coincified pulses back out.
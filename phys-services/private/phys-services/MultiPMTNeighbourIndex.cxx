@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <phys-services/MultiPMTNeighbourIndex.h>
+
+const size_t MultiPMTNeighbourIndex::npos;
+
+MultiPMTNeighbourIndex::MultiPMTNeighbourIndex()
+  : span_(0), neighbourOffsets_(1, 0)
+{
+}
+
+MultiPMTNeighbourIndex::MultiPMTNeighbourIndex(const I3OMGeoMap& omgeo, unsigned int moduleSpan)
+  : span_(moduleSpan)
+{
+  std::vector<OMKey> pmts;
+  pmts.reserve(omgeo.size());
+  for(const auto& entry : omgeo)
+    pmts.push_back(entry.first);
+  Build(pmts);
+}
+
+MultiPMTNeighbourIndex::MultiPMTNeighbourIndex(const std::vector<OMKey>& pmts, unsigned int moduleSpan)
+  : span_(moduleSpan)
+{
+  Build(pmts);
+}
+
+void MultiPMTNeighbourIndex::Build(const std::vector<OMKey>& pmts)
+{
+  pmts_ = I3OMKeyIndex(pmts);
+
+  // The keys are sorted, so the PMTs of a module are contiguous and the
+  // modules come out in OMKey order.
+  pmtModule_.resize(pmts_.size());
+  modules_.clear();
+  for(size_t i = 0; i < pmts_.size(); i++){
+    const OMKey& key = pmts_.GetKey(i);
+    const ModuleKey module(key.GetString(), key.GetOM());
+    if(modules_.empty() || modules_.back() != module)
+      modules_.push_back(module);
+    pmtModule_[i] = modules_.size() - 1;
+  }
+
+  // Neighbours are within [om - span, om + span] on the same string,
+  // which is a contiguous range of modules around each module.
+  neighbourOffsets_.assign(1, 0);
+  neighbours_.clear();
+  size_t begin = 0;
+  for(size_t m = 0; m < modules_.size(); m++){
+    while(!AreNeighbours(begin, m) && begin < m)
+      begin++;
+    for(size_t n = begin; n < modules_.size(); n++){
+      if(n == m)
+        continue;
+      if(!AreNeighbours(m, n))
+        break;
+      neighbours_.push_back(n);
+    }
+    neighbourOffsets_.push_back(neighbours_.size());
+  }
+}
+
+bool MultiPMTNeighbourIndex::Covers(const UpgradeReadoutSeriesMap& readouts) const
+{
+  for(const auto& entry : readouts){
+    if(!pmts_.Contains(entry.first))
+      return false;
+  }
+  return true;
+}
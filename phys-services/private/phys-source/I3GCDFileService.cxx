@@ -10,39 +10,119 @@
 #include "icetray/I3Frame.h"
 #include <iostream>
 #include <fstream>
+#include <map>
 #include <icetray/open.h>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/device/file.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 
+namespace {
+
+  // The same file has the same key as long as it is not modified.
+  // Sources that are not local files are identified by name.
+  std::string
+  file_key(const std::string& filename)
+  {
+    namespace fs = boost::filesystem;
+    boost::system::error_code ec;
+    const fs::path canonical = fs::canonical(filename, ec);
+    if (ec)
+      return filename;
+    const uintmax_t size = fs::file_size(canonical, ec);
+    if (ec)
+      return filename;
+    const std::time_t mtime = fs::last_write_time(canonical, ec);
+    if (ec)
+      return filename;
+    return canonical.string() + ":" + boost::lexical_cast<std::string>(size)
+      + ":" + boost::lexical_cast<std::string>(mtime);
+  }
+
+}
+
+I3GCDFilePtr
+I3GCDFile::Open(const std::string& filename){
+  static std::mutex cacheMutex;
+  static std::map<std::string, I3GCDFilePtr> cache;
+
+  const std::string key = file_key(filename);
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  for (auto it = cache.begin(); it != cache.end(); ) {
+    if (it->second.use_count() == 1 && it->second->expired())
+      it = cache.erase(it);
+    else
+      ++it;
+  }
+
+  I3GCDFilePtr& file = cache[key];
+  if (!file) {
+    file = I3GCDFilePtr(new I3GCDFile(filename));
+  } else {
+    log_debug("Sharing the objects of %s read from %s", filename.c_str(),
+              file->GetFilename().c_str());
+  }
+  return file;
+}
+
+I3GCDFile::I3GCDFile(const std::string& filename) :
+  filename_(filename)
+{}
+
+bool
+I3GCDFile::expired() const{
+  return geometry_.expired() && calibration_.expired() && status_.expired();
+}
+
 template <class T>
-T
-GetFromFile(I3Frame::Stream stop, std::string filename){
-  T null_ptr;
+boost::shared_ptr<const T>
+I3GCDFile::Get(boost::weak_ptr<const T>& object, I3Frame::Stream stop){
+  std::lock_guard<std::mutex> lock(mutex_);
+  boost::shared_ptr<const T> result = object.lock();
+  if (result)
+    return result;
 
   boost::iostreams::filtering_istream ifs;
-  I3::dataio::open(ifs,filename);
-  if(ifs.peek() == EOF) return null_ptr;
+  I3::dataio::open(ifs,filename_);
 
   while(ifs.peek() != EOF){
     I3FramePtr frame(new I3Frame);
     try { frame->load(ifs); }
     catch (const std::exception &e) {
       log_fatal("Error reading %s : %s",
-		filename.c_str(), e.what());
-      return null_ptr;
+		filename_.c_str(), e.what());
     }
-    if( frame && frame->GetStop() == stop){
-      return frame->Get<T>();
+    if (frame->GetStop() == stop){
+      // don't keep the serialized blob next to the object
+      frame->drop_blobs(true);
+      result = frame->Get<boost::shared_ptr<const T> >();
+      break;
     }
   }
-  return null_ptr;
+  object = result;
+  return result;
+}
+
+I3GeometryConstPtr
+I3GCDFile::GetGeometry(){
+  return Get(geometry_, I3Frame::Geometry);
+}
+
+I3CalibrationConstPtr
+I3GCDFile::GetCalibration(){
+  return Get(calibration_, I3Frame::Calibration);
+}
+
+I3DetectorStatusConstPtr
+I3GCDFile::GetDetectorStatus(){
+  return Get(status_, I3Frame::DetectorStatus);
 }
 
 I3GeometryConstPtr
 I3GCDFileGeometryService::GetGeometry(I3Time t){
   if(!geo_)
-    geo_ = GetFromFile<I3GeometryConstPtr>(I3Frame::Geometry,filename_);
+    geo_ = I3GCDFile::Open(filename_)->GetGeometry();
   return geo_;
 }
 
@@ -50,14 +130,13 @@ I3GCDFileGeometryService::GetGeometry(I3Time t){
 I3CalibrationConstPtr
 I3GCDFileCalibrationService::GetCalibration(I3Time t){
   if(!cal_)
-    cal_ = GetFromFile<I3CalibrationConstPtr>(I3Frame::Calibration, filename_);
+    cal_ = I3GCDFile::Open(filename_)->GetCalibration();
   return cal_;
 }
 
 I3DetectorStatusConstPtr
 I3GCDFileDetectorStatusService::GetDetectorStatus(I3Time t){
   if(!stat_)
-    stat_ = GetFromFile<I3DetectorStatusConstPtr>(I3Frame::DetectorStatus, filename_);
+    stat_ = I3GCDFile::Open(filename_)->GetDetectorStatus();
   return stat_;
 }
-
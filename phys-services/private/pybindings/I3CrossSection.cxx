@@ -14,13 +14,31 @@
 #include "phys-services/I3CrossSection.h"
 
 #include <string>
+#include <vector>
 
 #include <boost/noncopyable.hpp>
 #include <boost/python.hpp>
+#include <boost/python/stl_iterator.hpp>
 #include <boost/shared_ptr.hpp>
 
 namespace bp = boost::python;
 
+namespace {
+
+bp::list sample_final_states(const I3CrossSection& self, bp::object energies,
+    I3Particle::ParticleType scatteredType, boost::shared_ptr<I3RandomService> random)
+{
+    std::vector<double> e{bp::stl_input_iterator<double>(energies),
+        bp::stl_input_iterator<double>()};
+    bp::list states;
+    for (const I3CrossSection::finalStateRecord& state :
+        self.sampleFinalStates(e, scatteredType, random))
+        states.append(state);
+    return states;
+}
+
+}
+
 void register_I3CrossSection()
 {
     bp::class_<I3CrossSection::finalStateRecord>
@@ -42,6 +60,13 @@ void register_I3CrossSection()
         &I3CrossSection::sampleFinalState,
         bp::args("energy", "scatteredType", "random_service")
     )
+    .def(
+        "sample_final_states",
+        &sample_final_states,
+        bp::args("energies", "scatteredType", "random_service"),
+        "Sample one final state for each energy, proposing from tabulated "
+        "cross sections"
+    )
     .def(
         "evaluate_cross_section",
         &I3CrossSection::evaluateCrossSection,
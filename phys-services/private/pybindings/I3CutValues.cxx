@@ -41,7 +41,10 @@ namespace bp = boost::python;
 void register_I3CutValues()
 {
   class_<I3CutValues, bases<I3FrameObject>, boost::shared_ptr<I3CutValues> >("I3CutValues")
-    .def("calculate", &I3CutValues::Calculate)
+    .def("calculate", (void (I3CutValues::*)(const I3Particle&, const I3Geometry&,
+                                             const I3RecoPulseSeriesMap&,
+                                             const double&, const double&))
+         &I3CutValues::Calculate)
     .def_readwrite("nchan", &I3CutValues::Nchan)
     .def_readwrite("nhit", &I3CutValues::Nhit)
     .def_readwrite("nString", &I3CutValues::Nstring)
@@ -41,6 +41,7 @@ namespace bp = boost::python;
 #include <vector>
 
 #include <dataclasses/physics/I3Particle.h>
+#include <boost/python/stl_iterator.hpp>
 #include <boost/preprocessor/seq.hpp>
 #include <boost/preprocessor/seq/for_each.hpp>
 #include <boost/preprocessor/cat.hpp>
@@ -58,6 +59,40 @@ namespace bp = boost::python;
   (IT73) (IT81) (IT73_SMOOTH) (IT73_STRICT) (IT81_SMOOTH) (IT81_STRICT) \
   (IT_INFILL_STA2_STRICT) (IT_INFILL_STA2_BIGOVAL) (IT_INFILL_TRIANGLE)
 
+namespace {
+
+  std::vector<I3Particle> particle_vector(bp::object particles)
+  {
+    return std::vector<I3Particle>{bp::stl_input_iterator<I3Particle>(particles),
+                                   bp::stl_input_iterator<I3Particle>()};
+  }
+
+  template <typename T>
+  bp::list to_list(const std::vector<T>& values)
+  {
+    bp::list result;
+    for (size_t i = 0; i < values.size(); i++)
+      result.append(T(values[i]));
+    return result;
+  }
+
+  bp::list scale_inice_many(const I3ScaleCalculator& calc, bp::object particles)
+  {
+    return to_list(calc.ScaleInIce(particle_vector(particles)));
+  }
+
+  bp::list scale_icetop_many(const I3ScaleCalculator& calc, bp::object particles)
+  {
+    return to_list(calc.ScaleIceTop(particle_vector(particles)));
+  }
+
+  bp::list vertex_is_inside_many(const I3ScaleCalculator& calc, bp::object particles)
+  {
+    return to_list(calc.VertexIsInside(particle_vector(particles)));
+  }
+
+}
+
 void register_I3ScaleCalculator()
 {
 
@@ -77,19 +112,30 @@ void register_I3ScaleCalculator()
      .export_values()
      ;
   
-  def("scale_inice", &I3ScaleCalculator::ScaleInIce,
+  def("scale_inice", (double (I3ScaleCalculator::*)(I3Particle) const)&I3ScaleCalculator::ScaleInIce,
       "Calculate the factor by which the border polyhedron of the IceCube volume needs to be scaled to exactly contain the track (for tracks) or vertex (for cascades)",
       arg("particle"));
   def("scale_xy", &I3ScaleCalculator::ScaleIceCubeDetectorPolygon,
       "Calculate the factor by which the area of the border polygon of the IceCube volume needs to be scaled to exactly contain a cascade vertex",
       arg("particle"));
-  def("scale_icetop", &I3ScaleCalculator::ScaleIceTop,
+  def("scale_icetop", (double (I3ScaleCalculator::*)(I3Particle) const)&I3ScaleCalculator::ScaleIceTop,
       "Calculate the factor by which the border polygon of the IceTop surface needs to be scaled to exactly contain the track",
       arg("particle"));
-  def("vertex_is_inside", &I3ScaleCalculator::VertexIsInside,
+  def("vertex_is_inside", (bool (I3ScaleCalculator::*)(const I3Particle&) const)&I3ScaleCalculator::VertexIsInside,
       "Is the vertex position inside the IceCube volume?",
       arg("particle"));
 
+  // Batch versions, which look up the detector boundary once
+  def("scale_inice_many", &scale_inice_many,
+      "scale_inice() for each particle of a sequence, as a list",
+      arg("particles"));
+  def("scale_icetop_many", &scale_icetop_many,
+      "scale_icetop() for each particle of a sequence, as a list",
+      arg("particles"));
+  def("vertex_is_inside_many", &vertex_is_inside_many,
+      "vertex_is_inside() for each particle of a sequence, as a list",
+      arg("particles"));
+
   // For checking the boundary selection
   def("get_outer_strings", &I3ScaleCalculator::GetOuterStrings,
       "Vector of string numbers defining the boundary");
@@ -11,6 +11,10 @@ void register_I3Splitter()
 {
 	class_<I3Splitter, boost::noncopyable>("I3Splitter",
 	    init<const I3Configuration&>())
-		.def("get_next_sub_event", &I3Splitter::GetNextSubEvent);
+		.def("get_next_sub_event", &I3Splitter::GetNextSubEvent)
+		.def("put_sub_event_pulses", &I3Splitter::PutSubEventPulses,
+		    (arg("subevent"), arg("name"), arg("source"), arg("tmin"),
+		    arg("tmax"), arg("doms")=std::vector<OMKey>()))
+		.staticmethod("put_sub_event_pulses");
 }
 
@@ -36,6 +36,7 @@
 #endif
 #include <phys-services/I3GSLRandomService.h>
 #include <phys-services/I3MTRandomService.h>
+#include <phys-services/I3PhiloxRandomService.h>
 
 using namespace boost::python;
 namespace bp = boost::python;
@@ -90,6 +91,18 @@ void register_RandomServices()
 				    ).def(init<>()).def(init<uint32_t>((bp::arg("seed"))));
 	
 
+  register_randomservice<I3PhiloxRandomService>("I3PhiloxRandomService",
+				    "A counter-based (Philox4x32-10) random number generator with "
+				    "independent streams for each (run, event, module)",
+				    init<uint64_t>((bp::arg("seed")=0))
+				    )
+	  .def("stream", (I3PhiloxRandomServicePtr (I3PhiloxRandomService::*)(uint32_t, uint32_t, const std::string&) const)
+	       &I3PhiloxRandomService::GetStream, (bp::arg("run"), bp::arg("event"), bp::arg("module")),
+	       "An independent generator for the given run, event and module name")
+	  .def("stream", (I3PhiloxRandomServicePtr (I3PhiloxRandomService::*)(uint32_t, uint32_t, uint32_t) const)
+	       &I3PhiloxRandomService::GetStream, (bp::arg("run"), bp::arg("event"), bp::arg("module")))
+	  ;
+
   register_randomservice<I3GSLRandomService>("I3GSLRandomService", "gsl random goodness",
 					    init<unsigned long int,bool>((bp::arg("seed"),bp::arg("track_state")=true)))
 						.def(init<>());
@@ -21,6 +21,7 @@
 #include <phys-services/I3RandomService.h>
 #include <icetray/python/dataclass_suite.hpp>
 #include <icetray/python/gil_holder.hpp>
+#include <boost/python/stl_iterator.hpp>
 
 static boost::python::tuple SampleImpactRay(const I3Surfaces::SamplingSurface &s, I3RandomServicePtr rng, double cosMin, double cosMax)
 {
@@ -30,6 +31,33 @@ static boost::python::tuple SampleImpactRay(const I3Surfaces::SamplingSurface &s
 	return boost::python::make_tuple(pos, dir);
 }
 
+static boost::python::list GetIntersections(const I3Surfaces::Surface &s, boost::python::object pos, boost::python::object dir)
+{
+	using boost::python::stl_input_iterator;
+	std::vector<I3Position> positions((stl_input_iterator<I3Position>(pos)), stl_input_iterator<I3Position>());
+	std::vector<I3Direction> directions((stl_input_iterator<I3Direction>(dir)), stl_input_iterator<I3Direction>());
+
+	boost::python::list intersections;
+	for (const std::pair<double, double> &isect : s.GetIntersections(positions, directions))
+		intersections.append(isect);
+	return intersections;
+}
+
+static boost::python::tuple SampleImpactRays(const I3Surfaces::SamplingSurface &s, I3RandomServicePtr rng, size_t n, double cosMin, double cosMax)
+{
+	std::vector<I3Position> pos;
+	std::vector<I3Direction> dir;
+	std::vector<double> area = s.SampleImpactRays(pos, dir, n, *rng, cosMin, cosMax);
+
+	boost::python::list positions, directions, areas;
+	for (size_t i = 0; i < n; i++) {
+		positions.append(pos[i]);
+		directions.append(dir[i]);
+		areas.append(area[i]);
+	}
+	return boost::python::make_tuple(positions, directions, areas);
+}
+
 namespace I3Surfaces {
 
 using namespace boost::python;
@@ -60,6 +88,7 @@ void register_Surface()
 
 	class_<PySurface, PySurfacePtr, boost::noncopyable>("Surface")
 	    .def("intersection", &Surface::GetIntersection, (arg("pos"), arg("dir")))
+	    .def("intersections", &GetIntersections, (arg("self"), arg("pos"), arg("dir")))
 	;
 
 	implicitly_convertible<SurfacePtr, SurfaceConstPtr>();
@@ -68,6 +97,7 @@ void register_Surface()
 	    .def("area", &SamplingSurface::GetArea, (arg("dir")))
 	    .def("maximum_area", &SamplingSurface::GetMaximumArea)
 	    .def("sample_impact_ray", &SampleImpactRay, (arg("self"), arg("rng"), arg("cosMin")=0, arg("cosMax")=1))
+	    .def("sample_impact_rays", &SampleImpactRays, (arg("self"), arg("rng"), arg("n"), arg("cosMin")=0, arg("cosMax")=1))
 	    .def("sample_impact_position", &SamplingSurface::SampleImpactPosition, (arg("self"), arg("dir"), arg("rng")))
             .def("acceptance", &SamplingSurface::GetAcceptance, (arg("cosMin")=0., arg("cosMax")=1.))
 	;
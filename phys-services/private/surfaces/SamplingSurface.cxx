@@ -30,6 +30,19 @@ SamplingSurface::SampleImpactRay(I3Position &impact, I3Direction &dir, I3RandomS
 	return GetArea(dir);
 }
 
+std::vector<double>
+SamplingSurface::SampleImpactRays(std::vector<I3Position> &impact, std::vector<I3Direction> &dir,
+    size_t n, I3RandomService &rng, double cosMin, double cosMax) const
+{
+	impact.resize(n);
+	dir.resize(n);
+	std::vector<double> area(n);
+	for (size_t i = 0; i < n; i++)
+		area[i] = SampleImpactRay(impact[i], dir[i], rng, cosMin, cosMax);
+
+	return area;
+}
+
 I3Direction
 SamplingSurface::SampleDirection(I3RandomService &rng,
     double cosMin, double cosMax) const
@@ -11,11 +11,27 @@
  */
 
 #include <phys-services/surfaces/Surface.h>
+#include <dataclasses/I3Position.h>
+#include <dataclasses/I3Direction.h>
 
 namespace I3Surfaces {
 
 Surface::~Surface() {}
 
+std::vector<std::pair<double, double> >
+Surface::GetIntersections(const std::vector<I3Position> &p, const std::vector<I3Direction> &dir) const
+{
+	if (p.size() != dir.size())
+		log_fatal("Got %zu positions but %zu directions", p.size(), dir.size());
+
+	std::vector<std::pair<double, double> > intersections;
+	intersections.reserve(p.size());
+	for (size_t i = 0; i < p.size(); i++)
+		intersections.push_back(GetIntersection(p[i], dir[i]));
+
+	return intersections;
+}
+
 template <typename Archive>
 void
 Surface::serialize(Archive &ar, unsigned version)
@@ -112,6 +112,35 @@ TEST(ContainmentVolumeSize){
 }
 
 
+TEST(ContainmentPolygon){
+  const std::vector<double > x (myXPos ());
+  const std::vector<double > y (myYPos ());
+  const I3Cuts::ContainmentPolygon polygon (x, y);
+
+  std::vector<I3Particle > tracks;
+  for (int i = 0; i < 25; i++) {
+    I3Particle p (I3Particle::InfiniteTrack);
+    p.SetPos (-500 + 43.*i, 350 - 29.*i, -300 + 21.*i);
+    p.SetDir (0.11*i, 0.27*i);
+    tracks.push_back (p);
+  }
+
+  const std::vector<double > volumes
+    = I3Cuts::ContainmentVolumeSize (tracks, polygon, 500, -500);
+  const std::vector<double > areas
+    = I3Cuts::ContainmentAreaSize (tracks, polygon, 100);
+  ENSURE_EQUAL (volumes.size (), tracks.size ());
+  ENSURE_EQUAL (areas.size (), tracks.size ());
+  for (size_t i = 0; i < tracks.size (); i++) {
+    ENSURE_EQUAL (volumes[i], I3Cuts::ContainmentVolumeSize (tracks[i], x, y, 500, -500));
+    ENSURE_EQUAL (areas[i], I3Cuts::ContainmentAreaSize (tracks[i], x, y, 100));
+  }
+
+  ENSURE (polygon.IsInside (0, 200), "This should be in the detector.");
+  ENSURE (!polygon.IsInside (600, 400), "This should be outside the detector.");
+}
+
+
 // x-xoordnates for a simplified ic-40 geo
 std::vector<double > myXPos () {
   std::vector<double > x;
@@ -582,3 +582,81 @@ TEST(Rotation30)
     // need some more tests
 
 }
+
+// The batched functions must agree with the scalar ones, NANs included
+static void CompareBatched(const I3Particle& particle, const std::string& name)
+{
+  std::vector<I3Position> grid;
+  for (int ix = -2; ix <= 2; ix++)
+    for (int iy = -2; iy <= 2; iy++)
+      for (int iz = -3; iz <= 3; iz++)
+        grid.push_back(I3Position(37.*ix + 1.5, 41.*iy - 2.5, 53.*iz + 0.5));
+  PositionArrays positions(grid);
+  ENSURE_EQUAL(positions.size(), grid.size());
+
+  std::vector<double> chtime, chdist, changle, cht, apdist, along, residuals;
+  std::vector<double> hittimes(grid.size(), 1000.);
+  CherenkovCalc(particle, positions, chtime, chdist, changle);
+  CherenkovTime(particle, positions, cht);
+  ClosestApproachDistance(particle, positions, apdist);
+  DistanceAlongTrack(particle, positions, along);
+  TimeResidual(particle, positions, hittimes, residuals);
+
+  const double tol = 1e-9;
+  for (size_t i = 0; i < grid.size(); i++) {
+    ENSURE(positions[i] == grid[i]);
+    I3Position chpos;
+    double t, d, ang;
+    CherenkovCalc(particle, grid[i], chpos, t, d, ang);
+    const std::vector<double> batched = {chtime[i], chdist[i], changle[i],
+      cht[i], apdist[i], along[i], residuals[i]};
+    const std::vector<double> scalar = {t, d, ang,
+      CherenkovTime(particle, grid[i]),
+      ClosestApproachDistance(particle, grid[i]),
+      DistanceAlongTrack(particle, grid[i]),
+      TimeResidual(particle, grid[i], hittimes[i])};
+    for (size_t j = 0; j < scalar.size(); j++) {
+      if (std::isnan(scalar[j]))
+        ENSURE(std::isnan(batched[j]), name+": expected NAN");
+      else
+        ENSURE_DISTANCE(batched[j], scalar[j], tol*std::max(1., std::abs(scalar[j])),
+                        name+": batched and scalar results differ");
+    }
+  }
+}
+
+TEST(BatchedMatchesScalar)
+{
+  CompareBatched(inftrack(), "infinite track");
+  CompareBatched(muon(), "muon");
+  CompareBatched(starttrack(), "starting track");
+  CompareBatched(casc1(), "cascade");
+
+  I3Particle stopping;
+  stopping.SetPos(10, -20, 30);
+  stopping.SetDir(0.3, 0.4, -0.5);
+  stopping.SetTime(50);
+  stopping.SetShape(I3Particle::StoppingTrack);
+  CompareBatched(stopping, "stopping track");
+
+  I3Particle contained(stopping);
+  contained.SetShape(I3Particle::ContainedTrack);
+  contained.SetLength(80);
+  CompareBatched(contained, "contained track");
+}
+
+TEST(BatchedOverParticles)
+{
+  std::vector<I3Particle> particles = {inftrack(), muon(), starttrack(), casc1(), casc2()};
+  const I3Position pos(30, -40, 20);
+  std::vector<double> chtime;
+  CherenkovTime(particles, pos, chtime);
+  ENSURE_EQUAL(chtime.size(), particles.size());
+  for (size_t i = 0; i < particles.size(); i++) {
+    const double scalar = CherenkovTime(particles[i], pos);
+    if (std::isnan(scalar))
+      ENSURE(std::isnan(chtime[i]));
+    else
+      ENSURE_DISTANCE(chtime[i], scalar, 1e-9*std::max(1., std::abs(scalar)));
+  }
+}
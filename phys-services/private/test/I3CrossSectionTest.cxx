@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <phys-services/I3CrossSection.h>
+#include <phys-services/I3GSLRandomService.h>
+
+TEST_GROUP(I3CrossSection);
+
+namespace {
+
+  typedef I3CrossSection::finalStateRecord finalStateRecord;
+
+  const size_t nstates = 4000;
+
+  std::string CrossSectionFile(const std::string& name)
+  {
+    ENSURE(getenv("I3_TESTDATA") != NULL, "I3_TESTDATA is set");
+    return std::string(getenv("I3_TESTDATA"))
+      + "/neutrino-generator/cross_section_data/csms_differential_v1.0/" + name;
+  }
+
+  // eqs. 6-8 of S. Kretzer and M. H. Reno, Phys. Rev. D 66, 113007, and
+  // the pion production threshold, the same as I3CrossSection checks
+  bool KinematicallyAllowed(double x, double y, double E, double M, double m)
+  {
+    if (x > 1. || x < m*m/(2.*M*(E - m)))
+      return false;
+    const double pionMass = I3Particle(I3Particle::Null, I3Particle::Pi0).GetMass();
+    if (2.*M*E*y*(1. - x) + M*M < (M + pionMass)*(M + pionMass))
+      return false;
+    const double d = 2.*(1. + M*x/(2.*E));
+    const double ad = 1. - m*m*(1./(2.*M*E*x) + 1./(2.*E*E));
+    const double term = 1. - m*m/(2.*M*E*x);
+    const double bd = std::sqrt(term*term - m*m/(E*E));
+    return ad - bd <= d*y && d*y <= ad + bd;
+  }
+
+  // the means of a quantity in two independent samples agree within five
+  // standard errors
+  template <typename F>
+  void EnsureSameMean(const std::vector<finalStateRecord>& a,
+                      const std::vector<finalStateRecord>& b,
+                      F quantity, const std::string& name)
+  {
+    double mean[2] = {0, 0}, variance[2] = {0, 0};
+    const std::vector<finalStateRecord>* samples[2] = {&a, &b};
+    for (unsigned i = 0; i < 2; i++) {
+      for (const finalStateRecord& state : *samples[i])
+        mean[i] += quantity(state);
+      mean[i] /= samples[i]->size();
+      for (const finalStateRecord& state : *samples[i])
+        variance[i] += std::pow(quantity(state) - mean[i], 2);
+      variance[i] /= samples[i]->size() - 1;
+    }
+    const double error = std::sqrt(variance[0]/a.size() + variance[1]/b.size());
+    ENSURE(std::abs(mean[0] - mean[1]) < 5*error,
+           "The mean of " + name + " of sampleFinalStates() is that of sampleFinalState()");
+  }
+
+}
+
+TEST(batched_final_states_follow_the_spline)
+{
+  I3CrossSection crossSection(CrossSectionFile("dsdxdy_nu_CC_iso.fits"),
+                              CrossSectionFile("sigma_nu_CC_iso.fits"));
+  boost::shared_ptr<I3RandomService> random(new I3GSLRandomService(1337));
+  const double M = crossSection.getTargetMass();
+  const double m = I3Particle(I3Particle::Null, I3Particle::MuMinus).GetMass();
+
+  for (double energy : {1e3, 1e6}) {
+    std::vector<finalStateRecord> batched = crossSection.sampleFinalStates(
+      std::vector<double>(nstates, energy), I3Particle::MuMinus, random);
+    ENSURE_EQUAL(batched.size(), nstates, "One final state per energy");
+
+    const double s = M*M + 2*M*energy;
+    for (const finalStateRecord& state : batched) {
+      ENSURE(state.x > 0 && state.x <= 1, "x is in (0,1]");
+      ENSURE(state.y > 0 && state.y <= 1, "y is in (0,1]");
+      ENSURE((s - M*M)*state.x*state.y >= crossSection.getQ2Min()*(1 - 1e-9),
+             "Q^2 is above the smallest Q^2 of the spline");
+      ENSURE(KinematicallyAllowed(state.x, state.y, energy, M, m),
+             "Every final state is kinematically allowed");
+    }
+
+    std::vector<finalStateRecord> sequential;
+    for (size_t i = 0; i < nstates; i++)
+      sequential.push_back(crossSection.sampleFinalState(energy, I3Particle::MuMinus, random));
+
+    EnsureSameMean(batched, sequential,
+                   [](const finalStateRecord& state) { return state.x; }, "x");
+    EnsureSameMean(batched, sequential,
+                   [](const finalStateRecord& state) { return state.y; }, "y");
+    EnsureSameMean(batched, sequential,
+                   [](const finalStateRecord& state) { return std::log10(state.x); }, "log10(x)");
+    EnsureSameMean(batched, sequential,
+                   [](const finalStateRecord& state) { return std::log10(state.y); }, "log10(y)");
+  }
+}
@@ -630,3 +630,96 @@ TEST(Exactly_Vertical_Track)
   ENSURE_DISTANCE(c, 2.0, 0.00001, "ContainmentVolume horizontal track");
 
 }
+
+TEST(EventHitsReusedForSeveralFits)
+{
+  I3Geometry geometry;
+  for (int string = 1; string <= 3; string++) {
+    for (unsigned om = 1; om <= 10; om++) {
+      I3OMGeo geo;
+      geo.position = I3Position(20.*string, -10.*string, -17.*om);
+      geometry.omgeo[OMKey(string, om)] = geo;
+    }
+  }
+
+  I3RecoPulseSeriesMap hitsmap;
+  for (int string = 1; string <= 3; string++) {
+    for (unsigned om = 2; om <= 9; om += 2+string) {
+      for (unsigned i = 0; i <= om%3; i++) {
+        I3RecoPulse pulse;
+        pulse.SetTime(50.*om + 20.*i - 10.*string);
+        pulse.SetCharge(1. + i);
+        hitsmap[OMKey(string, om)].push_back(pulse);
+      }
+    }
+  }
+  // a DOM that is not in the geometry
+  I3RecoPulse pulse;
+  pulse.SetTime(100);
+  pulse.SetCharge(2);
+  hitsmap[OMKey(5, 1)].push_back(pulse);
+
+  const I3Cuts::EventHits hits(geometry, hitsmap);
+  ENSURE_EQUAL(hits.Nchan, int(hitsmap.size()));
+  ENSURE_EQUAL(hits.Nstring, 3);
+  int nhit = 0, n1hit = 0;
+  for (const auto& entry : hitsmap) {
+    n1hit += (entry.second.size()==1);
+    if (geometry.omgeo.count(entry.first))
+      nhit += entry.second.size();
+  }
+  ENSURE_EQUAL(hits.Nhit, nhit);
+  ENSURE_EQUAL(hits.N_1hit, n1hit);
+  ENSURE(hits.cog == I3Cuts::COG(geometry, hitsmap));
+
+  std::vector<I3Particle> fits(3);
+  fits[0].SetShape(I3Particle::InfiniteTrack);
+  fits[0].SetPos(30, -20, -80);
+  fits[0].SetDir(0.1, 0.2, 1.);
+  fits[1].SetShape(I3Particle::InfiniteTrack);
+  fits[1].SetPos(40, -30, -60);
+  fits[1].SetDir(0.3, -0.1, -1.);
+  fits[1].SetTime(-50);
+  fits[2].SetShape(I3Particle::Cascade);
+  fits[2].SetPos(40, -20, -90);
+  fits[2].SetTime(200);
+
+  for (const I3Particle& fit : fits) {
+    int nchan, nhit, n1hit, nstring, ndir, nearly, nlate;
+    double ldir, sdir, sall;
+    if (fit.IsTrack()) {
+      I3Cuts::CutsCalc(fit, hits, -15., 75.,
+                       nchan, nhit, nstring, ndir, ldir, sdir, sall);
+      ENSURE_EQUAL(ndir, Ndir(fit, geometry, hitsmap, -15., 75.));
+      ENSURE_EQUAL(nhit, hits.Nhit);
+      double expected = Ldir(fit, geometry, hitsmap, -15., 75.);
+      ENSURE(std::isnan(ldir) == std::isnan(expected));
+      if (!std::isnan(expected))
+        ENSURE_DISTANCE(ldir, expected, 1e-9);
+      ENSURE_DISTANCE(sall, SmoothAll(fit, geometry, hitsmap, -15., 75.), 1e-9);
+
+      // count the direct hits by hand
+      int direct = 0;
+      for (const auto& entry : hitsmap) {
+        I3OMGeoMap::const_iterator geo = geometry.omgeo.find(entry.first);
+        if (geo == geometry.omgeo.end())
+          continue;
+        for (const I3RecoPulse& p : entry.second) {
+          double tres = I3Calculator::TimeResidual(fit, geo->second.position, p.GetTime());
+          direct += (tres > -15. && tres < 75.);
+        }
+      }
+      ENSURE_EQUAL(ndir, direct);
+    } else {
+      I3Cuts::CascadeCutsCalc(fit, hits, -15., 75.,
+                              nchan, nhit, n1hit, nstring, ndir, nearly, nlate);
+      ENSURE_EQUAL(nearly + ndir + nlate, hits.Nhit,
+                   "no residual sits exactly on a window edge");
+      ENSURE_EQUAL(nearly, I3Cuts::Nearly(fit, geometry, hitsmap, -15., 75.));
+      ENSURE_EQUAL(nlate, I3Cuts::Nlate(fit, geometry, hitsmap, -15., 75.));
+      ENSURE_EQUAL(n1hit, hits.N_1hit);
+    }
+    ENSURE_EQUAL(nchan, hits.Nchan);
+    ENSURE_EQUAL(nstring, hits.Nstring);
+  }
+}
@@ -0,0 +1,230 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include <icetray/I3Module.h>
+#include <icetray/I3Tray.h>
+#include <icetray/I3Units.h>
+#include <dataclasses/I3Vector.h>
+#include <dataclasses/geometry/I3Geometry.h>
+#include <dataclasses/calibration/I3Calibration.h>
+#include <dataclasses/status/I3DetectorStatus.h>
+
+#include <boost/function.hpp>
+
+TEST_GROUP(I3GCDAuditor);
+
+namespace {
+
+  const OMKey dom_a(21, 2);
+  const OMKey dom_b(21, 3);
+
+  // the frames the source sends, each after running its action
+  std::vector<std::pair<I3FramePtr, boost::function<void ()> > > frames_in;
+
+  // keeps the errors logged while the auditor runs
+  class ErrorCollector : public I3Logger {
+  public:
+    std::vector<std::string> errors;
+
+    void Log(I3LogLevel level, const std::string&, const std::string&, int,
+             const std::string&, const std::string& message)
+    {
+      if (level >= I3LOG_ERROR)
+        errors.push_back(message);
+    }
+  };
+
+  bool Mentions(const std::vector<std::string>& errors, const OMKey& key)
+  {
+    for (const std::string& error : errors)
+      if (error.find(key.str()) != std::string::npos)
+        return true;
+    return false;
+  }
+
+  // G, C and D objects of a few DOMs that pass every check
+  void MakeGCD(I3GeometryPtr& geometry, I3CalibrationPtr& calibration,
+               I3DetectorStatusPtr& status)
+  {
+    geometry = I3GeometryPtr(new I3Geometry);
+    calibration = I3CalibrationPtr(new I3Calibration);
+    status = I3DetectorStatusPtr(new I3DetectorStatus);
+
+    for (unsigned om = 1; om <= 4; om++) {
+      const OMKey key(21, om);
+
+      I3OMGeo& omgeo = geometry->omgeo[key];
+      omgeo.omtype = I3OMGeo::IceCube;
+      omgeo.position = I3Position(0, 0, -17.*om);
+
+      I3DOMStatus& domStatus = status->domStatus[key];
+      domStatus.statusATWDa = I3DOMStatus::On;
+      domStatus.statusATWDb = I3DOMStatus::Off;
+      domStatus.pmtHV = 1200.*I3Units::V;
+      domStatus.dacTriggerBias0 = 850;
+      domStatus.speThreshold = 560;
+      domStatus.fePedestal = 2130;
+
+      I3DOMCalibration& cal = calibration->domCal[key];
+      for (unsigned chan = 0; chan < 3; chan++) {
+        cal.SetATWDBeaconBaseline(0, chan, 130.);
+        cal.SetATWDGain(chan, -16./(1 << (3*chan)));
+        for (unsigned bin = 0; bin < 128; bin++)
+          cal.SetATWDBinCalibSlope(0, chan, bin, -0.002);
+      }
+      cal.SetFADCBeaconBaseline(130.);
+      cal.SetFADCGain(9.);
+      cal.SetRelativeDomEff(1.);
+      cal.SetDomNoiseRate(700.*I3Units::hertz);
+      cal.SetFrontEndImpedance(43.*I3Units::ohm);
+      LinearFit transit;
+      transit.slope = 2000.;
+      transit.intercept = 80.;
+      cal.SetTransitTime(transit);
+      LinearFit hvgain;
+      hvgain.slope = 7.08;
+      hvgain.intercept = -15.2;
+      cal.SetHVGainFit(hvgain);
+      // a linear fit, about 210 MHz
+      QuadraticFit freq;
+      freq.quadFitA = 2.;
+      freq.quadFitB = 0.01;
+      freq.quadFitC = NAN;
+      cal.SetATWDFreqFit(0, freq);
+      // no discriminator calibration, fall back to the DAC settings
+      LinearFit disc;
+      disc.slope = NAN;
+      disc.intercept = NAN;
+      cal.SetPMTDiscCalib(disc);
+    }
+
+    geometry->startTime = calibration->startTime = status->startTime = I3Time(2024, 0);
+    geometry->endTime = calibration->endTime = status->endTime =
+      I3Time(2024, 0) + 100*I3Units::day;
+  }
+
+  void Send(I3Frame::Stream stop, const std::string& name,
+            I3FrameObjectConstPtr object,
+            boost::function<void ()> action = boost::function<void ()>())
+  {
+    I3FramePtr frame(new I3Frame(stop));
+    frame->Put(name, object);
+    if (stop == I3Frame::DetectorStatus)
+      frame->Put("BadDomsList", I3VectorOMKeyPtr(new I3VectorOMKey));
+    frames_in.push_back(std::make_pair(frame, action));
+  }
+
+  // runs the frames through an auditor, and gives whether it threw
+  bool Audit(ErrorCollector& collector)
+  {
+    I3LoggerPtr logger = GetIcetrayLogger();
+    SetIcetrayLogger(I3LoggerPtr(&collector, [](I3Logger*) {}));
+
+    bool thrown = false;
+    try {
+      I3Tray tray;
+      tray.AddModule("GCDAuditorTestSource");
+      tray.AddModule("I3GCDAuditor");
+      tray.Execute();
+    } catch (const std::exception&) {
+      thrown = true;
+    }
+
+    SetIcetrayLogger(logger);
+    return thrown;
+  }
+
+}
+
+class GCDAuditorTestSource : public I3Module
+{
+public:
+  GCDAuditorTestSource(const I3Context& context) : I3Module(context), next_(0)
+  {
+    AddOutBox("OutBox");
+  }
+
+  void Process()
+  {
+    if (next_ == frames_in.size()) {
+      RequestSuspension();
+      return;
+    }
+    if (frames_in[next_].second)
+      frames_in[next_].second();
+    PushFrame(frames_in[next_++].first);
+  }
+
+private:
+  size_t next_;
+};
+
+I3_MODULE(GCDAuditorTestSource);
+
+TEST(full_audit)
+{
+  I3GeometryPtr geometry;
+  I3CalibrationPtr calibration;
+  I3DetectorStatusPtr status;
+  MakeGCD(geometry, calibration, status);
+  calibration->domCal[dom_b].SetRelativeDomEff(NAN);
+
+  frames_in.clear();
+  Send(I3Frame::Geometry, "I3Geometry", geometry);
+  Send(I3Frame::Calibration, "I3Calibration", calibration);
+  Send(I3Frame::DetectorStatus, "I3DetectorStatus", status);
+
+  ErrorCollector collector;
+  ENSURE(Audit(collector), "The first D frame checks every DOM");
+  ENSURE(Mentions(collector.errors, dom_b));
+  ENSURE(!Mentions(collector.errors, dom_a));
+}
+
+TEST(unchanged_frames_are_not_reaudited)
+{
+  I3GeometryPtr geometry;
+  I3CalibrationPtr calibration;
+  I3DetectorStatusPtr status;
+  MakeGCD(geometry, calibration, status);
+
+  // The second D frame carries the same objects. Breaking a DOM behind
+  // the auditor's back shows that it doesn't look at them again.
+  frames_in.clear();
+  Send(I3Frame::Geometry, "I3Geometry", geometry);
+  Send(I3Frame::Calibration, "I3Calibration", calibration);
+  Send(I3Frame::DetectorStatus, "I3DetectorStatus", status);
+  Send(I3Frame::DetectorStatus, "I3DetectorStatus", status,
+       [=]() { calibration->domCal[dom_b].SetRelativeDomEff(NAN); });
+
+  ErrorCollector collector;
+  ENSURE(!Audit(collector));
+  ENSURE(collector.errors.empty());
+}
+
+TEST(only_changed_doms_are_reaudited)
+{
+  I3GeometryPtr geometry;
+  I3CalibrationPtr calibration;
+  I3DetectorStatusPtr status;
+  MakeGCD(geometry, calibration, status);
+
+  // The new detector status gives DOM A an invalid high voltage, while
+  // DOM B is broken in place in the calibration, which did not change.
+  I3DetectorStatusPtr changed(new I3DetectorStatus(*status));
+  changed->domStatus[dom_a].pmtHV = 0.;
+
+  frames_in.clear();
+  Send(I3Frame::Geometry, "I3Geometry", geometry);
+  Send(I3Frame::Calibration, "I3Calibration", calibration);
+  Send(I3Frame::DetectorStatus, "I3DetectorStatus", status);
+  Send(I3Frame::DetectorStatus, "I3DetectorStatus", changed,
+       [=]() { calibration->domCal[dom_b].SetRelativeDomEff(NAN); });
+
+  ErrorCollector collector;
+  ENSURE(Audit(collector), "The changed DOM is flagged");
+  ENSURE(Mentions(collector.errors, dom_a));
+  ENSURE(!Mentions(collector.errors, dom_b), "Unchanged DOMs are not checked again");
+}
@@ -0,0 +1,232 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include <icetray/I3Module.h>
+#include <icetray/I3Tray.h>
+#include <icetray/open.h>
+#include <icetray/I3Units.h>
+#include <dataclasses/I3GCDDelta.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+TEST_GROUP(I3GCDDeltaCodec);
+
+namespace {
+
+  // the G, C, D and P frames to send through the tray, and what reached
+  // the end of it
+  std::vector<I3FramePtr> frames_in;
+  std::vector<I3FramePtr> frames_out;
+
+  I3FramePtr MakeFrame(I3Frame::Stream stop, const std::string& name,
+                       I3FrameObjectConstPtr object)
+  {
+    I3FramePtr frame(new I3Frame(stop));
+    if (object)
+      frame->Put(name, object);
+    return frame;
+  }
+
+  // a frame sequence where every G, C and D object after the first
+  // changes a single DOM
+  void MakeFrames()
+  {
+    I3GeometryPtr geometry(new I3Geometry);
+    I3CalibrationPtr calibration(new I3Calibration);
+    I3DetectorStatusPtr status(new I3DetectorStatus);
+    for (int string = 1; string <= 4; string++) {
+      for (unsigned om = 1; om <= 60; om++) {
+        const OMKey key(string, om);
+        geometry->omgeo[key].position = I3Position(10.*string, 0, -17.*om);
+        calibration->domCal[key].SetRelativeDomEff(1.0);
+        status->domStatus[key].pmtHV = (1200. + om)*I3Units::V;
+      }
+    }
+    status->daqConfigurationName = "sps-IC86-mitigatedHVs-V175";
+
+    frames_in.clear();
+    frames_in.push_back(MakeFrame(I3Frame::Geometry, "I3Geometry", geometry));
+    frames_in.push_back(MakeFrame(I3Frame::Calibration, "I3Calibration", calibration));
+    frames_in.push_back(MakeFrame(I3Frame::DetectorStatus, "I3DetectorStatus", status));
+
+    calibration = I3CalibrationPtr(new I3Calibration(*calibration));
+    calibration->domCal[OMKey(2,30)].SetRelativeDomEff(1.35);
+    frames_in.push_back(MakeFrame(I3Frame::Calibration, "I3Calibration", calibration));
+
+    status = I3DetectorStatusPtr(new I3DetectorStatus(*status));
+    status->domStatus.erase(OMKey(3,12));
+    frames_in.push_back(MakeFrame(I3Frame::DetectorStatus, "I3DetectorStatus", status));
+
+    geometry = I3GeometryPtr(new I3Geometry(*geometry));
+    geometry->omgeo[OMKey(4,60)].position.SetZ(-1000.);
+    frames_in.push_back(MakeFrame(I3Frame::Geometry, "I3Geometry", geometry));
+
+    status = I3DetectorStatusPtr(new I3DetectorStatus(*status));
+    status->domStatus[OMKey(1,1)].pmtHV = 0.;
+    frames_in.push_back(MakeFrame(I3Frame::DetectorStatus, "I3DetectorStatus", status));
+
+    frames_in.push_back(MakeFrame(I3Frame::Physics, "", I3FrameObjectConstPtr()));
+  }
+
+  template <typename T>
+  boost::shared_ptr<const T> LastFull(size_t frame)
+  {
+    for (size_t i = frame + 1; i-- > 0; )
+      if (frames_in[i]->Has(I3DefaultName<T>::value()))
+        return frames_in[i]->Get<boost::shared_ptr<const T> >(I3DefaultName<T>::value());
+    return boost::shared_ptr<const T>();
+  }
+
+  template <typename T>
+  void EnsureSame(const I3Frame& frame, size_t i)
+  {
+    boost::shared_ptr<const T> expected = LastFull<T>(i);
+    boost::shared_ptr<const T> got =
+      frame.Get<boost::shared_ptr<const T> >(I3DefaultName<T>::value());
+    if (!expected) {
+      ENSURE(!got);
+      return;
+    }
+    ENSURE((bool)got, "The full object is restored");
+    ENSURE(T(*got) == T(*expected), "The restored object is the one written");
+  }
+
+  std::vector<I3FramePtr> ReadFrames(const std::string& filename)
+  {
+    std::vector<I3FramePtr> frames;
+    boost::iostreams::filtering_istream ifs;
+    I3::dataio::open(ifs, filename);
+    while (ifs.peek() != EOF) {
+      I3FramePtr frame(new I3Frame);
+      frame->load(ifs);
+      if (frame->GetStop() != I3Frame::TrayInfo)
+        frames.push_back(frame);
+    }
+    return frames;
+  }
+
+}
+
+class GCDDeltaCodecSource : public I3Module
+{
+public:
+  GCDDeltaCodecSource(const I3Context& context) : I3Module(context), next_(0)
+  {
+    AddOutBox("OutBox");
+  }
+
+  void Process()
+  {
+    if (next_ == frames_in.size()) {
+      RequestSuspension();
+      return;
+    }
+    PushFrame(I3FramePtr(new I3Frame(*frames_in[next_++])));
+  }
+
+private:
+  size_t next_;
+};
+
+I3_MODULE(GCDDeltaCodecSource);
+
+class GCDDeltaCodecSink : public I3Module
+{
+public:
+  GCDDeltaCodecSink(const I3Context& context) : I3Module(context)
+  {
+    AddOutBox("OutBox");
+  }
+
+  void Process()
+  {
+    I3FramePtr frame = PopFrame();
+    if (frame->GetStop() != I3Frame::TrayInfo)
+      frames_out.push_back(frame);
+    PushFrame(frame);
+  }
+};
+
+I3_MODULE(GCDDeltaCodecSink);
+
+TEST(round_trip)
+{
+  const std::string filename = "I3GCDDeltaCodecTest.i3";
+  MakeFrames();
+
+  {
+    I3Tray tray;
+    tray.AddModule("GCDDeltaCodecSource");
+    tray.AddModule("I3GCDDeltaEncoder");
+    tray.AddModule("I3Writer")("Filename", filename);
+    tray.Execute();
+  }
+
+  // the file holds deltas for every G, C and D object but the first
+  std::vector<I3FramePtr> written = ReadFrames(filename);
+  ENSURE_EQUAL(written.size(), frames_in.size());
+  const char* expected_keys[] = {
+    "I3Geometry", "I3Calibration", "I3DetectorStatus",
+    "I3CalibrationDelta", "I3DetectorStatusDelta", "I3GeometryDelta",
+    "I3DetectorStatusDelta"};
+  for (size_t i = 0; i < 7; i++) {
+    ENSURE_EQUAL(written[i]->size(), 1u);
+    ENSURE(written[i]->Has(expected_keys[i]), expected_keys[i]);
+  }
+  I3CalibrationDeltaConstPtr delta =
+    written[3]->Get<I3CalibrationDeltaConstPtr>("I3CalibrationDelta");
+  ENSURE((bool)delta);
+  ENSURE_EQUAL(delta->GetDOMKeys().size(), 1u, "Only the changed DOM is stored");
+  ENSURE_EQUAL(delta->GetDOMKeys()[0], OMKey(2,30));
+
+  frames_out.clear();
+  {
+    I3Tray tray;
+    tray.AddModule("I3Reader")("Filename", filename);
+    tray.AddModule("I3GCDDeltaDecoder");
+    tray.AddModule("GCDDeltaCodecSink");
+    tray.Execute();
+  }
+
+  // every frame sees the full objects, as if there were no deltas
+  ENSURE_EQUAL(frames_out.size(), frames_in.size());
+  for (size_t i = 0; i < frames_out.size(); i++) {
+    ENSURE_EQUAL(frames_out[i]->GetStop(), frames_in[i]->GetStop());
+    ENSURE(!frames_out[i]->Has("I3GeometryDelta"));
+    ENSURE(!frames_out[i]->Has("I3CalibrationDelta"));
+    ENSURE(!frames_out[i]->Has("I3DetectorStatusDelta"));
+    EnsureSame<I3Geometry>(*frames_out[i], i);
+    EnsureSame<I3Calibration>(*frames_out[i], i);
+    EnsureSame<I3DetectorStatus>(*frames_out[i], i);
+  }
+  ENSURE_EQUAL(frames_out.back()->Get<I3Geometry>("I3Geometry").omgeo.at(OMKey(4,60)).position.GetZ(),
+               -1000., "The physics frame gets the latest geometry");
+
+  boost::filesystem::remove(filename);
+}
+
+TEST(max_deltas)
+{
+  MakeFrames();
+  frames_out.clear();
+
+  I3Tray tray;
+  tray.AddModule("GCDDeltaCodecSource");
+  tray.AddModule("I3GCDDeltaEncoder")("MaxDeltas", 1);
+  tray.AddModule("GCDDeltaCodecSink");
+  tray.Execute();
+
+  // the three D objects: a base, a delta, and a new base
+  std::vector<bool> full;
+  for (const I3FramePtr& frame : frames_out)
+    if (frame->GetStop() == I3Frame::DetectorStatus)
+      full.push_back(!frame->Has("I3DetectorStatusDelta"));
+  ENSURE_EQUAL(full.size(), 3u);
+  ENSURE(full[0]);
+  ENSURE(!full[1]);
+  ENSURE(full[2]);
+}
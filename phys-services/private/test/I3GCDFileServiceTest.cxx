@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "phys-services/source/I3GCDFileService.h"
+#include "dataclasses/geometry/I3Geometry.h"
+#include "dataclasses/calibration/I3Calibration.h"
+#include "dataclasses/status/I3DetectorStatus.h"
+#include "icetray/I3Frame.h"
+
+namespace {
+
+  const char* gcdfile = "I3GCDFileServiceTest.i3";
+
+  void WriteGCD(const std::string& filename)
+  {
+    std::ofstream out(filename.c_str(), std::ios::binary);
+
+    I3Frame geometry(I3Frame::Geometry);
+    I3GeometryPtr geo(new I3Geometry);
+    geo->omgeo[OMKey(1, 1)].position = I3Position(1, 2, 3);
+    geometry.Put(geo);
+    geometry.save(out);
+
+    I3Frame calibration(I3Frame::Calibration);
+    calibration.Put(I3CalibrationPtr(new I3Calibration));
+    calibration.save(out);
+
+    I3Frame status(I3Frame::DetectorStatus);
+    status.Put(I3DetectorStatusPtr(new I3DetectorStatus));
+    status.save(out);
+  }
+
+}
+
+TEST_GROUP(I3GCDFileService);
+
+TEST(SharedWithinProcess)
+{
+  WriteGCD(gcdfile);
+  {
+    I3GCDFileGeometryService geo1(gcdfile);
+    I3GCDFileGeometryService geo2(gcdfile);
+    I3GCDFileCalibrationService cal(gcdfile);
+    I3GCDFileDetectorStatusService stat(gcdfile);
+
+    I3GeometryConstPtr g = geo1.GetGeometry(I3Time());
+    ENSURE((bool)g);
+    ENSURE_EQUAL(g->omgeo.size(), 1u);
+    ENSURE(g->omgeo.find(OMKey(1, 1))->second.position == I3Position(1, 2, 3));
+    ENSURE(geo2.GetGeometry(I3Time()) == g, "both services hand out the same geometry");
+    ENSURE((bool)cal.GetCalibration(I3Time()));
+    ENSURE((bool)stat.GetDetectorStatus(I3Time()));
+
+    ENSURE(I3GCDFile::Open(gcdfile) == I3GCDFile::Open(gcdfile));
+  }
+  std::remove(gcdfile);
+}
+
+TEST(OnlyObjectsInUseAreKept)
+{
+  WriteGCD(gcdfile);
+  boost::weak_ptr<const I3Geometry> geometry;
+  {
+    I3GCDFileGeometryService geo(gcdfile);
+    geometry = geo.GetGeometry(I3Time());
+    ENSURE(!geometry.expired());
+
+    // the calibration is read on its own, and dropped with its last user
+    boost::weak_ptr<const I3Calibration> calibration =
+      I3GCDFile::Open(gcdfile)->GetCalibration();
+    ENSURE(calibration.expired(), "nothing but the services holds the objects");
+    ENSURE(I3GCDFile::Open(gcdfile)->GetGeometry() == geo.GetGeometry(I3Time()));
+  }
+  ENSURE(geometry.expired(), "the geometry goes away with the last service");
+  std::remove(gcdfile);
+}
+
+TEST(EmptyFile)
+{
+  { std::ofstream out(gcdfile); }
+  I3GCDFileGeometryService geo(gcdfile);
+  ENSURE(!geo.GetGeometry(I3Time()));
+  std::remove(gcdfile);
+}
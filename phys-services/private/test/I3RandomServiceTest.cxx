@@ -12,6 +12,7 @@
 
 #include "phys-services/I3RandomService.h"
 #include "phys-services/I3MTRandomService.h"
+#include "phys-services/I3PhiloxRandomService.h"
 #include "phys-services/I3GSLRandomService.h"
 #include "phys-services/I3SPRNGRandomService.h"
 
@@ -158,6 +159,75 @@ TEST(I3MTRandomServiceTest)
   randomServiceTest::testRandomService<100000,I3MTRandomService>(random2);
 }
 
+TEST(I3PhiloxRandomService)
+{
+  // known answers from the Random123 distribution
+  typedef I3PhiloxEngine::block_type block;
+  ENSURE(I3PhiloxEngine::Philox({{0, 0, 0, 0}}, {{0, 0}}) ==
+         block({{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}));
+  ENSURE(I3PhiloxEngine::Philox({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+                                {{0xffffffff, 0xffffffff}}) ==
+         block({{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}));
+  ENSURE(I3PhiloxEngine::Philox({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}},
+                                {{0xa4093822, 0x299f31d0}}) ==
+         block({{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}));
+
+  I3PhiloxRandomService random1;
+  I3PhiloxRandomService random2(666);
+  randomServiceTest::testRandomService<100000,I3PhiloxRandomService>(random1);
+  randomServiceTest::testRandomService<100000,I3PhiloxRandomService>(random2);
+  randomServiceTest::testStateRestoration(random1);
+  randomServiceTest::testStateRestoration(random2);
+}
+
+TEST(I3PhiloxRandomServiceStreams)
+{
+  I3PhiloxRandomService root(42);
+  I3PhiloxRandomServicePtr a = root.GetStream(1234, 1, "generator");
+  I3PhiloxRandomServicePtr b = root.GetStream(1234, 2, "generator");
+  I3PhiloxRandomServicePtr c = root.GetStream(1234, 1, "propagator");
+
+  // streams depend only on the key, not on what was drawn before
+  root.Uniform();
+  I3PhiloxRandomServicePtr a2 = root.GetStream(1234, 1, "generator");
+  for (int i = 0; i < 1000; i++)
+    ENSURE_EQUAL(a->Integer32(), a2->Integer32(), "same key, same numbers");
+  ENSURE(root.GetStream(1234, 1, "generator")->engine() !=
+         root.GetStream(1234, 1, "generator")->GetStream(0, 0, 0u)->engine());
+
+  randomServiceTest::testIndependence<1000000,I3PhiloxRandomService>(*a, *b);
+  randomServiceTest::testIndependence<1000000,I3PhiloxRandomService>(*a, *c);
+  randomServiceTest::testRandomService<100000,I3PhiloxRandomService>(*c);
+}
+
+TEST(I3PhiloxRandomServiceFill)
+{
+  I3PhiloxRandomService bulk(7), single(7);
+
+  std::vector<double> values(1001);
+  bulk.FillUniform(values.data(), values.size(), -2, 3);
+  for (double v : values)
+    ENSURE_EQUAL(v, single.Uniform(-2, 3), "FillUniform is the same as Uniform");
+  bulk.FillExp(values.data(), values.size(), 2.5);
+  for (double v : values)
+    ENSURE_EQUAL(v, single.Exp(2.5), "FillExp is the same as Exp");
+
+  values.resize(200000);
+  bulk.FillGaus(values.data(), values.size(), 5, 1);
+  randomServiceTest::testMeanStddev(values, 5, 1);
+  bulk.FillUniform(values.data(), values.size());
+  randomServiceTest::testMeanStddev(values, 0.5, sqrt(0.3333 - 0.5 * 0.5));
+  bulk.FillExp(values.data(), values.size(), 1);
+  randomServiceTest::testMeanStddev(values, 1, 1);
+
+  // the base class fills through the single-number functions
+  I3MTRandomService mt1(3), mt2(3);
+  values.resize(100);
+  mt1.FillGaus(values.data(), values.size(), 0, 1);
+  for (double v : values)
+    ENSURE_EQUAL(v, mt2.Gaus(0, 1));
+}
+
 TEST(I3GSLRandomService)
 {
   I3GSLRandomService random1;
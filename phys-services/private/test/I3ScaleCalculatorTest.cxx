@@ -183,6 +183,43 @@ TEST(particleInMuon){
 
 }
 
+TEST(batchMatchesSingle){
+
+  // build up a geometry
+  I3GeometryPtr geo (new I3Geometry (myGeoService ()));
+
+  I3ScaleCalculator scale (geo, I3ScaleCalculator::IC_CUSTOM, I3ScaleCalculator::IT_EMPTY,
+                           custom_stringlist);
+  // a second calculator with the same settings shares the outline
+  I3ScaleCalculator other (geo, I3ScaleCalculator::IC_CUSTOM, I3ScaleCalculator::IT_EMPTY,
+                           custom_stringlist);
+
+  std::vector<I3Particle> parts;
+  for (int i = 0; i < 40; i++) {
+    I3Particle p (i % 3 == 0 ? I3Particle::Cascade : I3Particle::InfiniteTrack);
+    p.SetPos (-600 + 31.*i, 450 - 23.*i, -550 + 27.*i);
+    p.SetDir (0.07*i, 0.15*i);
+    parts.push_back (p);
+  }
+
+  std::vector<double > x, y;
+  double bot, top;
+  scale.CalcOuterStringPositions (x, y, bot, top);
+
+  std::vector<double > scales (scale.ScaleInIce (parts));
+  std::vector<bool > inside (other.VertexIsInside (parts));
+  ENSURE_EQUAL (scales.size (), parts.size ());
+  ENSURE_EQUAL (inside.size (), parts.size ());
+  for (size_t i = 0; i < parts.size (); i++) {
+    ENSURE_EQUAL (scales[i], scale.ScaleInIce (parts[i]));
+    ENSURE_EQUAL (scales[i], other.ScaleInIce (parts[i]));
+    ENSURE_EQUAL (inside[i], scale.VertexIsInside (parts[i]));
+    if (!parts[i].IsCascade ())
+      ENSURE_EQUAL (scales[i], I3Cuts::ContainmentVolumeSize (parts[i], x, y, top, bot));
+  }
+
+}
+
 
 std::vector<int > ic40Strings () {
 
@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include <cmath>
+#include <random>
+#include <set>
+
+#include "phys-services/MultiPMTNeighbourIndex.h"
+
+namespace {
+
+  UpgradeReadout MakeReadout(double time, I3OMGeo::OMType type = I3OMGeo::mDOM)
+  {
+    I3mDOMLaunch launch;
+    launch.SetTime(time);
+    return UpgradeReadout(launch, type);
+  }
+
+  typedef std::set<std::pair<const UpgradeReadout*, const UpgradeReadout*>> PairSet;
+
+  void SortedPair(const UpgradeReadout& a, const UpgradeReadout& b, PairSet& pairs)
+  {
+    pairs.insert(&a < &b ? std::make_pair(&a, &b) : std::make_pair(&b, &a));
+  }
+
+}
+
+TEST_GROUP(MultiPMTNeighbourIndex);
+
+TEST(Neighbours)
+{
+  std::vector<OMKey> pmts;
+  for (unsigned om : {1, 2, 3, 5, 9})
+    for (unsigned pmt = 0; pmt < 3; pmt++)
+      pmts.push_back(OMKey(7, om, pmt));
+  pmts.push_back(OMKey(8, 2, 0));
+
+  MultiPMTNeighbourIndex index(pmts, 2);
+  ENSURE_EQUAL(index.GetNumPMTs(), pmts.size());
+  ENSURE_EQUAL(index.GetNumModules(), 6u);
+  ENSURE_EQUAL(index.GetModule(OMKey(7, 3, 2)), index.GetModule(OMKey(7, 3, 0)));
+  ENSURE_EQUAL(index.GetModule(OMKey(7, 4, 0)), MultiPMTNeighbourIndex::npos);
+
+  // (7,3) sees (7,1), (7,2) and (7,5), but not (7,9) or string 8
+  const size_t module = index.GetModule(OMKey(7, 3, 0));
+  auto neighbours = index.GetNeighbours(module);
+  ENSURE_EQUAL(size_t(neighbours.second - neighbours.first), 3u);
+  for (const uint32_t* n = neighbours.first; n != neighbours.second; n++)
+    ENSURE(index.AreNeighbours(module, *n));
+  ENSURE(!index.AreNeighbours(module, index.GetModule(OMKey(7, 9, 0))));
+  ENSURE(!index.AreNeighbours(index.GetModule(OMKey(7, 2, 0)),
+                              index.GetModule(OMKey(8, 2, 0))));
+  neighbours = index.GetNeighbours(index.GetModule(OMKey(7, 9, 0)));
+  ENSURE(neighbours.first == neighbours.second);
+}
+
+TEST(SweepMatchesAllPairs)
+{
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> time(0, 5000);
+  std::uniform_int_distribution<unsigned> om(1, 20), pmt(0, 23), count(0, 3);
+
+  UpgradeReadoutSeriesMap readouts;
+  for (int string = 1; string <= 3; string++)
+    for (int i = 0; i < 60; i++) {
+      UpgradeReadoutSeries& series = readouts[OMKey(string, om(rng), pmt(rng))];
+      for (unsigned n = count(rng); n > 0; n--)
+        series.push_back(MakeReadout(time(rng)));
+    }
+
+  const unsigned span = 2;
+  const double moduleWindow = 250, pmtWindow = 10;
+  std::vector<OMKey> keys;
+  for (const auto& entry : readouts)
+    keys.push_back(entry.first);
+  MultiPMTNeighbourIndex index(keys, span);
+
+  PairSet swept;
+  index.ForEachCoincidence(readouts, moduleWindow, pmtWindow,
+    [&swept](UpgradeReadout& a, UpgradeReadout& b, bool) { SortedPair(a, b, swept); });
+
+  PairSet expected;
+  for (const auto& first : readouts)
+    for (const auto& second : readouts) {
+      const OMKey& k1 = first.first;
+      const OMKey& k2 = second.first;
+      if (k1 == k2 || k1.GetString() != k2.GetString())
+        continue;
+      const unsigned d = std::abs(int(k1.GetOM()) - int(k2.GetOM()));
+      if (d > span)
+        continue;
+      const double window = d == 0 ? pmtWindow : moduleWindow;
+      for (const UpgradeReadout& a : first.second)
+        for (const UpgradeReadout& b : second.second)
+          if (std::abs(a.GetTime() - b.GetTime()) <= window)
+            SortedPair(a, b, expected);
+    }
+
+  ENSURE(!expected.empty());
+  ENSURE(swept == expected, "the sweep finds exactly the coincident pairs");
+
+  // a negative window turns off the pairs within a module
+  PairSet multiModule;
+  index.ForEachCoincidence(readouts, moduleWindow, -1,
+    [&multiModule](UpgradeReadout& a, UpgradeReadout& b, bool sameModule) {
+      ENSURE(!sameModule);
+      SortedPair(a, b, multiModule);
+    });
+  ENSURE(multiModule.size() < swept.size());
+}
@@ -13,6 +13,7 @@
 
 #include <cmath>
 #include <utility>
+#include <vector>
 #include "dataclasses/physics/I3Particle.h"
 #include "icetray/I3Units.h"
 #include "dataclasses/I3Constants.h"
@@ -335,6 +336,87 @@ namespace I3Calculator
   I3Position InShowerSystem(const I3Position& core, const I3Direction& axis,
                             const I3Position& pos);
 
+  /**
+   * A set of OM positions stored as three contiguous coordinate arrays,
+   * as used by the batched functions below. Build it once per geometry
+   * (or per event, from the hit DOMs) and reuse it for every track.
+   */
+  struct PositionArrays
+  {
+    PositionArrays() {}
+    explicit PositionArrays(const std::vector<I3Position>& positions);
+
+    size_t size() const { return x.size(); }
+    bool empty() const { return x.empty(); }
+    void reserve(size_t n) { x.reserve(n); y.reserve(n); z.reserve(n); }
+    void clear() { x.clear(); y.clear(); z.clear(); }
+    void push_back(const I3Position& pos)
+    {
+      x.push_back(pos.GetX());
+      y.push_back(pos.GetY());
+      z.push_back(pos.GetZ());
+    }
+    I3Position operator[](size_t i) const
+    {
+      return I3Position(x[i], y[i], z[i]);
+    }
+
+    std::vector<double> x, y, z;
+  };
+
+  /**
+   * Batched versions of the functions above for one particle and many OM
+   * positions. The output vectors are resized to positions.size() and
+   * element i holds the result of the scalar function for positions[i].
+   * Everything that depends only on the particle (direction, Cherenkov
+   * angle, start/stop limits) is computed once, and the loops over the
+   * positions are free of branches so that the compiler can vectorize them.
+   */
+  void CherenkovCalc(const I3Particle& track,
+		     const PositionArrays& positions,
+		     std::vector<double>& chtime,
+		     std::vector<double>& chdist,
+		     std::vector<double>& changle,
+		     const double IndexRefG=I3Constants::n_ice_group,
+		     const double IndexRefP=I3Constants::n_ice_phase,
+		     const I3Direction& direction=I3Direction(0.,0.,-1.));
+
+  void CherenkovTime(const I3Particle& particle,
+		     const PositionArrays& positions,
+		     std::vector<double>& chtime,
+		     const double IndexRefG=I3Constants::n_ice_group,
+		     const double IndexRefP=I3Constants::n_ice_phase);
+
+  /**
+   * Time residuals of hits at the given positions, hittimes[i] being the
+   * time of a hit at positions[i].
+   */
+  void TimeResidual(const I3Particle& particle,
+		    const PositionArrays& positions,
+		    const std::vector<double>& hittimes,
+		    std::vector<double>& residuals,
+		    const double IndexRefG=I3Constants::n_ice_group,
+		    const double IndexRefP=I3Constants::n_ice_phase);
+
+  void ClosestApproachDistance(const I3Particle& particle,
+			       const PositionArrays& positions,
+			       std::vector<double>& apdist);
+
+  void DistanceAlongTrack(const I3Particle& track,
+			  const PositionArrays& positions,
+			  std::vector<double>& dist);
+
+  /**
+   * Batched CherenkovTime() for many particles and a single OM position,
+   * e.g. for scanning hypotheses in a fit: chtime[i] is the Cherenkov time
+   * of particles[i] at the given position.
+   */
+  void CherenkovTime(const std::vector<I3Particle>& particles,
+		     const I3Position& position,
+		     std::vector<double>& chtime,
+		     const double IndexRefG=I3Constants::n_ice_group,
+		     const double IndexRefP=I3Constants::n_ice_phase);
+
 };
 
 #endif
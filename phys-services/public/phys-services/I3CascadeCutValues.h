@@ -17,6 +17,7 @@ class OMKey;
 class I3Particle;
 class I3RecoPulse;
 class I3Geometry;
+namespace I3Cuts { struct EventHits; }
 
 
 /**
@@ -49,6 +50,12 @@ class I3CascadeCutValues : public I3CutValuesBase
                    const double& begTWindow = I3Constants::dt_window_l,
                    const double& endTWindow = I3Constants::dt_window_h) override;
 
+    /// Calculate from a pulse map that has already been flattened, see I3Cuts::EventHits
+    void Calculate(const I3Particle& vertex,
+                   const I3Cuts::EventHits& hits,
+                   const double& begTWindow = I3Constants::dt_window_l,
+                   const double& endTWindow = I3Constants::dt_window_h);
+
   virtual ~I3CascadeCutValues();
 
   std::ostream& Print(std::ostream&) const override;
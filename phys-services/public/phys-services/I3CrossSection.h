@@ -15,7 +15,9 @@
 #define I3CROSSSECTION_H
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <boost/shared_ptr.hpp>
 #include <photospline/splinetable.h>
@@ -59,7 +61,8 @@ class I3CrossSection
             : crossSection_{std::make_shared<splinetable_t>()},
             totalCrossSection_{std::make_shared<splinetable_t>()},
             Q2Min_{0.},
-            targetMass_{0.}
+            targetMass_{0.},
+            finalStateTables_{std::make_shared<FinalStateTableCache>()}
         {};
 
         /**
@@ -128,6 +131,37 @@ class I3CrossSection
                                         boost::shared_ptr<I3RandomService> random) const;
 
 
+        /**
+         * Sample one final state for each of many energies.
+         *
+         * For DIS this runs the same Metropolis-Hastings chain as
+         * sampleFinalState(), but proposes from a tabulated inverse CDF of
+         * the differential cross section at the nearest energy bin instead
+         * of uniformly in log10(x) and log10(y). The proposals of a chain do
+         * not depend on its state, so they are drawn in blocks with
+         * I3RandomService::FillUniform() and the spline is evaluated on all
+         * of them at once. The tables are built on first use of each energy
+         * bin and shared between copies.
+         *
+         * The chain still converges to the spline, but it does not consume
+         * random numbers in the same order as sampleFinalState(), so the
+         * two do not give the same final states for the same seed.
+         *
+         * @param[in] energies
+         *     The energies of the incoming neutrinos in GeV
+         * @param[in] scatteredType
+         *     The type of the outgoing lepton
+         * @param[in] random
+         *     A pseudo-random number generator
+         *
+         * @return
+         *     The sampled final states, in the order of energies
+         */
+        std::vector<finalStateRecord> sampleFinalStates(
+            const std::vector<double>& energies,
+            I3Particle::ParticleType scatteredType,
+            boost::shared_ptr<I3RandomService> random) const;
+
         // the GR sampler just returns X=1
         finalStateRecord sampleFinalState_GR(double energy,
                                         I3Particle::ParticleType scatteredType,
@@ -224,6 +258,34 @@ class I3CrossSection
         double getMaximumEnergy() const;
 
     private:
+        /**
+         * Weights of a grid of cells in log10(x) and log10(y), proportional
+         * to x*y times the differential cross section at the cell centers
+         * with a small floor, so that every cell can be proposed.
+         */
+        struct FinalStateTable
+        {
+            double logXMin, logYMin, binWidthX, binWidthY;
+            size_t binsY;
+            std::vector<double> weights;
+            /// running sum of weights
+            std::vector<double> cdf;
+        };
+
+        struct FinalStateTableCache
+        {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<const FinalStateTable>> tables;
+        };
+
+        /// The proposal table of the energy bin nearest to log10(energy)
+        const FinalStateTable& getFinalStateTable(double logEnergy) const;
+
+        void sampleFinalStates_DIS(const std::vector<double>& energies,
+                                   I3Particle::ParticleType scatteredType,
+                                   I3RandomService& random,
+                                   std::vector<finalStateRecord>& states) const;
+
         /// Total cross section spline
         std::shared_ptr<splinetable_t> crossSection_;
         /// Doubly-differential cross section spline
@@ -235,6 +297,8 @@ class I3CrossSection
         ///The interaction type, related to dimensionality of the
         // 1:CC, 2:NC, 3:GR
         int interaction_;
+        ///Proposal tables of the DIS sampler, by energy bin
+        std::shared_ptr<FinalStateTableCache> finalStateTables_;
 };
 
 #endif // I3CROSSSECTION_H
@@ -18,6 +18,7 @@ class OMKey;
 class I3Particle;
 class I3RecoPulse;
 class I3Geometry;
+namespace I3Cuts { struct EventHits; }
 
 /**
  * @brief A class to store the basic hit information from the event
@@ -49,6 +50,12 @@ class I3CutValues : public I3CutValuesBase
                  const double& begTWindow = I3Constants::dt_window_l,
                  const double& endTWindow = I3Constants::dt_window_h) override;
 
+  /// Calculate from a pulse map that has already been flattened, see I3Cuts::EventHits
+  void Calculate(const I3Particle& track,
+                 const I3Cuts::EventHits& hits,
+                 const double& begTWindow = I3Constants::dt_window_l,
+                 const double& endTWindow = I3Constants::dt_window_h);
+
   virtual ~I3CutValues();
 
   std::ostream& Print(std::ostream&) const override;
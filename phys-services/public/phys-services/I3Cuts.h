@@ -6,6 +6,8 @@
 #define I3CUTS_H
 
 #include "dataclasses/I3Constants.h"
+#include "dataclasses/I3Position.h"
+#include "phys-services/I3Calculator.h"
 #include <vector>
 
 template <typename Key, typename Value> struct I3Map;
@@ -69,7 +71,8 @@ namespace I3Cuts
    *                distributed along that track.
    *
    *
-   * @todo Think about making the code more efficient...
+   * If cuts are needed for several fits of the same event, build an
+   * EventHits once and use the overload below.
    */
 
   void CutsCalc(const I3Particle& track,
@@ -110,7 +113,8 @@ namespace I3Cuts
    * @param Nearly -- The Nearly cut parameter: number of early hits.
    * @param Nlate -- The Nlate cut parameter: number of late hits.
    *
-   * @todo Think about making the code more efficient...
+   * If cuts are needed for several fits of the same event, build an
+   * EventHits once and use the overload below.
    */
 
   void CascadeCutsCalc(const I3Particle& vertex,
@@ -135,6 +139,63 @@ namespace I3Cuts
   I3Position COG(const I3Geometry& geometry,
 		 const I3Map< OMKey, std::vector< I3RecoPulse > >& pulsemap);
 
+  /**
+   * The parts of the cut calculation that depend only on the event: the
+   * pulses of all DOMs found in the geometry, flattened into arrays, and
+   * the fit-independent cut parameters (Nchan, Nhit, N_1hit, Nstring and
+   * the COG). Build it once per event and pass it to CutsCalc() or
+   * CascadeCutsCalc() for every fit; each of those is then a single pass
+   * over the pulse arrays, without map or geometry lookups.
+   */
+  struct EventHits
+  {
+    EventHits(const I3Geometry& geometry,
+	      const I3Map< OMKey, std::vector< I3RecoPulse > >& pulsemap);
+
+    /// Position of the DOM of every pulse, one entry per pulse
+    I3Calculator::PositionArrays positions;
+    /// Time of every pulse, aligned with positions
+    std::vector<double> times;
+
+    int Nchan;
+    int Nhit;
+    int N_1hit;
+    int Nstring;
+    I3Position cog;
+  };
+
+  /**
+   * Same as the CutsCalc() above, for a pulse map that has already been
+   * turned into an EventHits.
+   */
+  void CutsCalc(const I3Particle& track,
+		const EventHits& hits,
+		const double t1,
+		const double t2,
+		int& Nchan,
+		int& Nhit,
+		int& Nstring,
+		int& Ndir,
+		double& Ldir,
+		double& Sdir,
+		double& Sall);
+
+  /**
+   * Same as the CascadeCutsCalc() above, for a pulse map that has already
+   * been turned into an EventHits.
+   */
+  void CascadeCutsCalc(const I3Particle& vertex,
+		       const EventHits& hits,
+		       const double t1,
+		       const double t2,
+		       int& Nchan,
+		       int& Nhit,
+		       int& N_1hit,
+		       int& Nstring,
+		       int& Ndir,
+		       int& Nearly,
+		       int& Nlate);
+
   /**
    * A convenience function that calls CutsCalc() and returns the total
    * number of channels (hit OMs) in the event.  If you are interested in
@@ -345,6 +406,28 @@ namespace I3Cuts
 				 double xprime, double yprime);  // "the point"
 
 
+  /**
+   * The outline of a detector for ContainmentVolumeSize() and
+   * ContainmentAreaSize(): the corners (in order), their center of mass
+   * and the angle of every corner around it. These only depend on the
+   * detector, so build the polygon once and use it for every track.
+   */
+  struct ContainmentPolygon
+  {
+    ContainmentPolygon();
+    ContainmentPolygon(const std::vector<double>& x, const std::vector<double>& y);
+
+    std::vector<double> x;
+    std::vector<double> y;
+    /// center of mass (NAN for fewer than three corners)
+    double xcm, ycm;
+    /// angle of each corner around the center of mass
+    std::vector<double> angles;
+
+    /// Whether (xp, yp) is inside the polygon (crossing number test)
+    bool IsInside(double xp, double yp) const;
+  };
+
   /**
    * Computes the size of the "containment volume of closest approach",
    * Analogous to "CylinderSize", above, but for a general shape
@@ -371,6 +454,25 @@ namespace I3Cuts
 			     std::vector<double> y,
 			     double z);
 
+  /**
+   * ContainmentVolumeSize() and ContainmentAreaSize() for a prebuilt
+   * outline, and for many tracks at once.
+   */
+  double ContainmentVolumeSize(const I3Particle& track,
+			       const ContainmentPolygon& polygon,
+			       double zhigh,
+			       double zlow);
+  std::vector<double> ContainmentVolumeSize(const std::vector<I3Particle>& tracks,
+					    const ContainmentPolygon& polygon,
+					    double zhigh,
+					    double zlow);
+  double ContainmentAreaSize(const I3Particle& track,
+			     const ContainmentPolygon& polygon,
+			     double z);
+  std::vector<double> ContainmentAreaSize(const std::vector<I3Particle>& tracks,
+					  const ContainmentPolygon& polygon,
+					  double z);
+
 
 }
 
@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef I3PHILOXRANDOMSERVICE_H
+#define I3PHILOXRANDOMSERVICE_H
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <string>
+
+#include "icetray/I3Logging.h"
+#include "icetray/I3ServiceFactory.h"
+#include "phys-services/I3StdRandomEngine.h"
+
+/**
+ * @class I3PhiloxEngine
+ * @brief The Philox4x32-10 counter-based random bit generator
+ *
+ * Philox (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3",
+ * SC11) computes the n-th block of four 32-bit words directly from n and
+ * a key, so the state is just the key, a stream number and a position.
+ * Streams with different keys or stream numbers are independent, and
+ * jumping to any position is free.
+ *
+ * The 128-bit counter of a block is (position/4 as 64 bits, stream as 64
+ * bits). This class satisfies the C++ UniformRandomBitGenerator
+ * requirements.
+ */
+class I3PhiloxEngine
+{
+ public:
+  typedef uint32_t result_type;
+  typedef std::array<uint32_t, 4> block_type;
+  typedef std::array<uint32_t, 2> key_type;
+
+  I3PhiloxEngine() : key_{{0, 0}}, stream_{{0, 0}}, position_(0) {}
+  I3PhiloxEngine(const key_type& key, const key_type& stream)
+    : key_(key), stream_(stream), position_(0) {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  result_type operator()()
+  {
+    if ((position_ & 3) == 0)
+      buffer_ = Block(position_ >> 2);
+    return buffer_[position_++ & 3];
+  }
+
+  /// A double in [0,1) from the next two words, with 53 random bits
+  double Canonical()
+  {
+    const uint64_t hi = (*this)();
+    const uint64_t lo = (*this)();
+    return double(((hi << 32) | lo) >> 11) * 0x1p-53;
+  }
+
+  /// Skip n words
+  void discard(uint64_t n)
+  {
+    Seek(position_ + n);
+  }
+
+  /// Jump to the n-th word of the stream
+  void Seek(uint64_t n)
+  {
+    position_ = n;
+    if ((position_ & 3) != 0)
+      buffer_ = Block(position_ >> 2);
+  }
+
+  const key_type& GetKey() const { return key_; }
+  const key_type& GetStream() const { return stream_; }
+  uint64_t GetPosition() const { return position_; }
+
+  /// The Philox4x32-10 bijection of counter under key
+  static block_type Philox(block_type counter, key_type key);
+
+  bool operator==(const I3PhiloxEngine& other) const
+  {
+    return key_ == other.key_ && stream_ == other.stream_ && position_ == other.position_;
+  }
+  bool operator!=(const I3PhiloxEngine& other) const { return !(*this == other); }
+
+ private:
+  block_type Block(uint64_t index) const
+  {
+    return Philox({{uint32_t(index), uint32_t(index >> 32), stream_[0], stream_[1]}}, key_);
+  }
+
+  key_type key_;
+  key_type stream_;
+  uint64_t position_;
+  block_type buffer_;
+};
+
+std::ostream& operator<<(std::ostream& os, const I3PhiloxEngine& engine);
+std::istream& operator>>(std::istream& is, I3PhiloxEngine& engine);
+
+class I3PhiloxRandomService;
+I3_POINTER_TYPEDEFS(I3PhiloxRandomService);
+
+/**
+ * @class I3PhiloxRandomService
+ * @brief An implementation of the I3RandomService interface using the
+ * counter-based Philox4x32-10 generator
+ *
+ * Independent generators are derived from a seed and a (run, event,
+ * module) key with GetStream(). Each event and module can thus have its
+ * own generator, and the numbers it gets do not depend on the order in
+ * which events are processed or on the number of threads. Derived streams
+ * are themselves seeded by Philox, so they are as independent as streams
+ * with different seeds.
+ *
+ * Uniform, Gaus, Exp, Integer and Integer32 and the Fill functions are
+ * computed here and give the same numbers on every platform. Binomial and
+ * Poisson use the standard library distributions, whose algorithms are
+ * implementation defined.
+ *
+ * The state (key, stream and position) can be saved and restored as an
+ * I3String.
+ */
+class I3PhiloxRandomService : public I3StdRandomEngine<I3PhiloxRandomService>
+{
+ public:
+  /**
+   * The root stream of a seed
+   */
+  explicit I3PhiloxRandomService(uint64_t seed = 0);
+
+  virtual ~I3PhiloxRandomService();
+
+  /**
+   * An independent generator for the given key, derived from the key and
+   * stream of this one. The state of this generator is not changed.
+   */
+  I3PhiloxRandomServicePtr GetStream(uint32_t run, uint32_t event, uint32_t module) const;
+
+  /**
+   * Same as above, with the module identified by name
+   */
+  I3PhiloxRandomServicePtr GetStream(uint32_t run, uint32_t event, const std::string& module) const;
+
+  virtual unsigned int Integer(unsigned int imax);
+  virtual uint32_t Integer32();
+  virtual double Uniform(double x = 1);
+  virtual double Uniform(double x1, double x2);
+  virtual double Exp(double tau);
+
+  /**
+   * A Gaussian number from the Box-Muller transform of two uniform
+   * numbers. FillGaus() uses both numbers of each transform, so it
+   * draws half as many uniform numbers as repeated calls of Gaus().
+   */
+  virtual double Gaus(double mean, double stddev);
+
+  virtual void FillUniform(double* out, size_t n, double x1=0, double x2=1);
+  virtual void FillGaus(double* out, size_t n, double mean, double stddev);
+  virtual void FillExp(double* out, size_t n, double tau);
+
+  /**
+   * Get all information necessary to restore the internal
+   * state of the generator.
+   */
+  virtual I3FrameObjectPtr GetState() const;
+
+  /**
+   * Restore the internal state of the generator
+   */
+  virtual void RestoreState(I3FrameObjectConstPtr state);
+
+ private:
+  explicit I3PhiloxRandomService(const I3PhiloxEngine& engine);
+
+  I3PhiloxEngine engine_;
+ public:
+  I3PhiloxEngine& engine() { return engine_; }
+  const I3PhiloxEngine& engine() const { return engine_; }
+
+  SET_LOGGER("I3PhiloxRandomService");
+};
+
+// Service Factory
+
+class I3Context;
+/**
+ * @class I3PhiloxRandomServiceFactory
+ * @brief This class installs a I3PhiloxRandomService in the context
+ *
+ * I3PhiloxRandomService takes two parameters: <VAR>Seed</VAR>,
+ * <VAR>InstallServiceAs</VAR>.
+ */
+class I3PhiloxRandomServiceFactory : public I3ServiceFactory
+{
+ public:
+  I3PhiloxRandomServiceFactory(const I3Context& context);
+  virtual ~I3PhiloxRandomServiceFactory();
+
+  virtual bool InstallService(I3Context& services);
+
+  virtual void Configure();
+
+ private:
+  I3PhiloxRandomServiceFactory
+    (const I3PhiloxRandomServiceFactory& rhs); // stop default
+  I3PhiloxRandomServiceFactory operator=
+    (const I3PhiloxRandomServiceFactory& rhs); // stop default
+
+  /// seed of the root stream
+  uint64_t seed_;
+  /// name with which to install this service in the context
+  std::string installServiceAs_;
+  /// pointer to the random service
+  I3RandomServicePtr random_;
+
+  SET_LOGGER("I3PhiloxRandomServiceFactory");
+};
+
+#endif // I3PHILOXRANDOMSERVICE_H
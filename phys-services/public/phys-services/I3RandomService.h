@@ -101,6 +101,26 @@ class I3RandomService {
    */
   virtual double Gaus(double mean,double stddev);
 
+  /**
+   * fill an array with doubles drawn from a uniform distribution [x1,x2)
+   *
+   * The Fill functions draw many numbers with one (virtual) call. The
+   * defaults call the single-number functions in a loop; generators that
+   * can do better override them.
+   */
+  virtual void FillUniform(double* out, size_t n, double x1=0, double x2=1);
+
+  /**
+   * fill an array with doubles drawn from a Gaussian distribution with
+   * given mean and standard deviation
+   */
+  virtual void FillGaus(double* out, size_t n, double mean, double stddev);
+
+  /**
+   * fill an array with numbers from an Exponential distribution
+   */
+  virtual void FillExp(double* out, size_t n, double tau);
+
   /**
    * get all information necessary to restore the internal
    * state of the generator
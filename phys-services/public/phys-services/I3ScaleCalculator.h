@@ -15,6 +15,9 @@
 #ifndef I3_SCALE_CALCULATOR_H_INCLUDED
 #define I3_SCALE_CALCULATOR_H_INCLUDED
 
+#include <memory>
+#include <vector>
+
 #include "icetray/I3Logging.h"
 #include "dataclasses/physics/I3Particle.h"
 #include "dataclasses/geometry/I3Geometry.h"
@@ -23,6 +26,10 @@
  * @brief The Scale object can calculate containment and scaling,
  * knowing the geometry of the detector and using phys-service functions
  *
+ * The outline of the detector (the positions of the boundary strings and
+ * stations) is computed on first use and shared between all calculators
+ * built for the same geometry object and settings, so making a new
+ * calculator for every event costs no more than keeping one.
  */
 
 class I3ScaleCalculator {
@@ -74,17 +81,34 @@ class I3ScaleCalculator {
 
   bool VertexIsInside (const I3Particle &part) const;
 
+  /**
+   * The same as above, for many particles at once
+   */
+  std::vector<double> ScaleInIce (const std::vector<I3Particle> &parts) const;
+  std::vector<double> ScaleIceTop (const std::vector<I3Particle> &parts) const;
+  std::vector<bool> VertexIsInside (const std::vector<I3Particle> &parts) const;
+
  private:
+  struct Outline;
+
+  /// The cached outline of the in-ice detector, computed on first use
+  const Outline& GetInIceOutline () const;
+  /// The cached outline of IceTop, computed on first use
+  const Outline& GetIceTopOutline () const;
+
+  void ComputeOuterStringPositions (std::vector<double > &x,
+                                    std::vector<double > &y,
+                                    double &zMin,
+                                    double &zMax) const;
+  void ComputeOuterStationPositions (std::vector<double > &x,
+                                     std::vector<double > &y,
+                                     double &z) const;
 
   IceCubeConfig GuessIceCubeConfig () const;
   IceTopConfig GuessIceTopConfig () const;
 
-  double ScaleInIceMuon (I3Particle part) const;
-  double ScaleInIceCascade (I3Particle part, bool areaonly) const;
-
-  bool IsInside (double xp, double yp,
-                const std::vector<double > &x,
-                const std::vector<double > &y) const;
+  double ScaleInIceMuon (const I3Particle &part, const Outline &outline) const;
+  double ScaleInIceCascade (const I3Particle &part, bool areaonly, const Outline &outline) const;
 
   I3GeometryConstPtr geo_;
   IceCubeConfig iceConf_;
@@ -93,6 +117,7 @@ class I3ScaleCalculator {
   std::vector<int> listOfBoundarySurfaceStations_;
   int topDOMid_;
   int bottomDOMid_;
+  std::shared_ptr<Outline> outline_;
 };
 
 
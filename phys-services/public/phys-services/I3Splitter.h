@@ -9,7 +9,9 @@
 
 #include <icetray/I3Configuration.h>
 #include <icetray/I3Frame.h>
+#include <icetray/OMKey.h>
 #include <string>
+#include <vector>
 
 /**
  * @brief This class is meant to be a mix-in base for modules that split
@@ -23,8 +25,26 @@ class I3Splitter
 		I3Splitter(const I3Configuration& config);
 		~I3Splitter();
 
+		/**
+		 * Make the next physics frame for a DAQ frame. The new frame
+		 * shares the objects of the DAQ frame by reference; only the
+		 * I3EventHeader is replaced.
+		 */
 		I3FramePtr GetNextSubEvent(I3FramePtr daq);
 
+		/**
+		 * Put the pulses of the map `source' with times in
+		 * [tmin, tmax] on the DOMs in `doms' (all DOMs if empty)
+		 * into a sub-event as an I3RecoPulseSeriesMapMask named
+		 * `name'. The mask refers to the DAQ-level map, so the
+		 * selected pulses are only copied out when a module asks
+		 * the frame for the map.
+		 */
+		static void PutSubEventPulses(I3Frame& subevent,
+		    const std::string& name, const std::string& source,
+		    double tmin, double tmax,
+		    const std::vector<OMKey>& doms = std::vector<OMKey>());
+
 	private:
 		I3FramePtr last_daq;
 		const I3Configuration& config_;
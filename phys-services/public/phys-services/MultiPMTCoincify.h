@@ -23,6 +23,7 @@
 #include "dataclasses/physics/UpgradeReadout.h"
 #include "dataclasses/physics/detail/UpgradeLCFlags.h"
 #include "dataclasses/physics/detail/I3XDOMLaunch.h"
+#include "phys-services/MultiPMTNeighbourIndex.h"
 
 /// \class: MultiPMTCoincify
 ///
@@ -38,6 +39,7 @@ public:
   ~MultiPMTCoincify();
   void Configure();
   void Coincify(UpgradeReadoutSeriesMap& launchMap);
+  void Coincify(UpgradeReadoutSeriesMap& launchMap, const MultiPMTNeighbourIndex& neighbours);
   void DAQ(I3FramePtr frame);
   void Finish();
 
@@ -50,6 +52,9 @@ public:
   UpgradeLCFlags lcTypes_;
   bool reset_;
 
+  MultiPMTNeighbourIndex neighbours_;
+  I3GeometryConstPtr neighboursGeometry_;
+
   SET_LOGGER("MultiPMTCoincify");
 };
 
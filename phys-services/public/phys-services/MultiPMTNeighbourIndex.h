@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef MULTIPMT_NEIGHBOURINDEX_H_INCLUDED
+#define MULTIPMT_NEIGHBOURINDEX_H_INCLUDED
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "icetray/OMKey.h"
+#include "dataclasses/ModuleKey.h"
+#include "dataclasses/geometry/I3Geometry.h"
+#include "dataclasses/geometry/I3OMKeyIndex.h"
+#include "dataclasses/physics/UpgradeReadout.h"
+
+/// \class: MultiPMTNeighbourIndex
+///
+/// \brief Which PMTs of a detector can be in local coincidence.
+///
+/// Every PMT is assigned its module, and every module the modules on the
+/// same string whose OM numbers are at most Span away. The index only
+/// depends on the geometry and the span, so it is meant to be built once
+/// per Geometry frame and then used for every event.
+///
+/// ForEachCoincidence() finds the coincident readouts of an event with a
+/// sweep over its readouts in time order, string by string, so its cost
+/// grows with the number of readouts and not with the number of pairs of
+/// PMTs.
+///
+class MultiPMTNeighbourIndex{
+public:
+  /// Returned by GetModule() for PMTs that are not part of the index
+  static const size_t npos = I3OMKeyIndex::npos;
+
+  MultiPMTNeighbourIndex();
+  MultiPMTNeighbourIndex(const I3OMGeoMap& omgeo, unsigned int moduleSpan);
+  /// Index an arbitrary set of PMTs. Duplicates are removed.
+  MultiPMTNeighbourIndex(const std::vector<OMKey>& pmts, unsigned int moduleSpan);
+
+  unsigned int GetSpan() const { return span_; }
+
+  size_t GetNumPMTs() const { return pmts_.size(); }
+  size_t GetNumModules() const { return modules_.size(); }
+
+  const I3OMKeyIndex& GetPMTs() const { return pmts_; }
+  const ModuleKey& GetModuleKey(size_t module) const { return modules_[module]; }
+
+  /// Dense index of the module of a PMT, or npos
+  size_t GetModule(const OMKey& pmt) const {
+    const size_t index = pmts_.GetIndex(pmt);
+    return index == npos ? npos : pmtModule_[index];
+  }
+  size_t GetModuleOfPMT(size_t pmt) const { return pmtModule_[pmt]; }
+
+  /// The other modules within the span of a module, in OMKey order
+  std::pair<const uint32_t*, const uint32_t*> GetNeighbours(size_t module) const {
+    return std::make_pair(neighbours_.data() + neighbourOffsets_[module],
+                          neighbours_.data() + neighbourOffsets_[module+1]);
+  }
+
+  /// Whether two different modules are within the span of each other
+  bool AreNeighbours(size_t a, size_t b) const {
+    const ModuleKey& ka = modules_[a];
+    const ModuleKey& kb = modules_[b];
+    const unsigned int d = ka.GetOM() > kb.GetOM() ? ka.GetOM() - kb.GetOM() : kb.GetOM() - ka.GetOM();
+    return a != b && ka.GetString() == kb.GetString() && d <= span_;
+  }
+
+  /// Whether every key of a readout map is part of the index
+  bool Covers(const UpgradeReadoutSeriesMap& readouts) const;
+
+  /**
+   * Call f(a, b, sameModule) once for every pair of readouts a, b that are
+   * on different PMTs of the same module and at most pmtWindow apart, or
+   * on neighbouring modules and at most moduleWindow apart. A negative
+   * window disables that kind of pair. Readouts on PMTs missing from the
+   * index are ignored.
+   */
+  template <typename Function>
+  void ForEachCoincidence(UpgradeReadoutSeriesMap& readouts,
+                          double moduleWindow, double pmtWindow, Function f) const;
+
+private:
+  void Build(const std::vector<OMKey>& pmts);
+
+  unsigned int span_;
+  I3OMKeyIndex pmts_;
+  std::vector<uint32_t> pmtModule_;
+  std::vector<ModuleKey> modules_;
+  std::vector<uint32_t> neighbourOffsets_;
+  std::vector<uint32_t> neighbours_;
+
+  struct Hit{
+    int string;
+    double time;
+    uint32_t pmt;
+    uint32_t module;
+    UpgradeReadout* readout;
+  };
+};
+
+template <typename Function>
+void MultiPMTNeighbourIndex::ForEachCoincidence(UpgradeReadoutSeriesMap& readouts,
+                                                double moduleWindow, double pmtWindow,
+                                                Function f) const
+{
+  std::vector<Hit> hits;
+  for(UpgradeReadoutSeriesMap::value_type& entry : readouts){
+    const size_t pmt = pmts_.GetIndex(entry.first);
+    if(pmt == npos)
+      continue;
+    const uint32_t module = pmtModule_[pmt];
+    for(UpgradeReadout& readout : entry.second)
+      hits.push_back(Hit{modules_[module].GetString(), readout.GetTime(),
+                         uint32_t(pmt), module, &readout});
+  }
+  std::sort(hits.begin(), hits.end(), [](const Hit& a, const Hit& b){
+      return a.string < b.string || (a.string == b.string && a.time < b.time);
+    });
+
+  // Sweep each string in time order, keeping the readouts that are still
+  // within the wider of the two windows of the current one.
+  const double window = std::max(moduleWindow, pmtWindow);
+  size_t first = 0;
+  for(size_t i = 0; i < hits.size(); i++){
+    const Hit& hit = hits[i];
+    while(first < i && (hits[first].string != hit.string || hit.time - hits[first].time > window))
+      first++;
+    for(size_t j = first; j < i; j++){
+      const Hit& other = hits[j];
+      if(other.pmt == hit.pmt)
+        continue;
+      const double dt = hit.time - other.time;
+      if(other.module == hit.module){
+        if(dt <= pmtWindow)
+          f(*other.readout, *hit.readout, true);
+      }else if(dt <= moduleWindow && AreNeighbours(other.module, hit.module)){
+        f(*other.readout, *hit.readout, false);
+      }
+    }
+  }
+}
+
+#endif
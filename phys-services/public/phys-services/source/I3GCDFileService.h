@@ -14,11 +14,61 @@
 
 #include <string>
 #include <fstream>
+#include <mutex>
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <icetray/I3Frame.h>
 #include <interfaces/I3GeometryService.h>
 #include <interfaces/I3CalibrationService.h>
 #include <interfaces/I3DetectorStatusService.h>
 
+class I3GCDFile;
+I3_POINTER_TYPEDEFS(I3GCDFile);
+
+/**
+ * @brief The geometry, calibration and detector status of a GCD file,
+ * shared within a process
+ *
+ * Open() hands out the same I3GCDFile to every caller that asks for the
+ * same file, identified by its canonical path, size and modification time.
+ * Each object is read from the file and deserialized the first time it is
+ * asked for, and every caller gets the same I3Geometry, I3Calibration and
+ * I3DetectorStatus for as long as any of them holds on to it. The frames
+ * and their serialized blobs are dropped as soon as the object is read,
+ * so a service only keeps the object it serves. The first frame of each
+ * stop is used.
+ */
+class I3GCDFile
+{
+ public:
+  static I3GCDFilePtr Open(const std::string& filename);
+
+  I3GeometryConstPtr GetGeometry();
+  I3CalibrationConstPtr GetCalibration();
+  I3DetectorStatusConstPtr GetDetectorStatus();
+
+  const std::string& GetFilename() const { return filename_; }
+
+ private:
+  explicit I3GCDFile(const std::string& filename);
+
+  // whether none of the objects is in use anymore
+  bool expired() const;
+
+  template <class T>
+  boost::shared_ptr<const T> Get(boost::weak_ptr<const T>& object,
+                                 I3Frame::Stream stop);
+
+  std::string filename_;
+  // reading the file and deserializing must not happen concurrently
+  std::mutex mutex_;
+  boost::weak_ptr<const I3Geometry> geometry_;
+  boost::weak_ptr<const I3Calibration> calibration_;
+  boost::weak_ptr<const I3DetectorStatus> status_;
+
+  SET_LOGGER("I3GCDFile");
+};
+
 /**
  * @brief A I3GeometryOrigin which reads the geometry from a GCD File
  */
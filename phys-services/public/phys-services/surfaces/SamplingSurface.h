@@ -49,6 +49,23 @@ public:
 	  * @returns the projected area along the chosen zenith angle
 	  */
 	virtual double SampleImpactRay(I3Position &pos, I3Direction &dir, I3RandomService &rng, double cosMin=0, double cosMax=1) const;
+
+	 /**
+	  * Sample many impact points and directions from an isotropic flux
+	  *
+	  * The rays are the same as those of n consecutive calls to
+	  * SampleImpactRay() with the same random number generator.
+	  *
+	  * @param[out] pos    Impact points, resized to n
+	  * @param[out] dir    Directions, resized to n
+	  * @param[in]  n      Number of rays to sample
+	  * @param[in]  rng    Random number generator
+	  * @param[in]  cosMin cosine of the maximum zenith angle to consider
+	  * @param[in]  cosMax cosine of the minimum zenith angle to consider
+	  * @returns the projected area along each of the chosen directions
+	  */
+	virtual std::vector<double> SampleImpactRays(std::vector<I3Position> &pos, std::vector<I3Direction> &dir,
+	    size_t n, I3RandomService &rng, double cosMin=0, double cosMax=1) const;
 private:
 	friend class icecube::serialization::access;
 	template <typename Archive>
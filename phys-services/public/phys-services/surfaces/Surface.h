@@ -17,6 +17,8 @@
 #include <icetray/I3FrameObject.h>
 #include <icetray/serialization.h>
 
+#include <vector>
+
 class I3Direction;
 class I3Position;
 
@@ -42,6 +44,19 @@ public:
 	 *          "behind" the origin.
 	 */
 	virtual std::pair<double, double> GetIntersection(const I3Position &p, const I3Direction &dir) const = 0;
+	/**
+	 * Find the intersections of many rays with the surface
+	 *
+	 * The result is the same as calling GetIntersection() for every ray,
+	 * but implementations can share the work that does not depend on the
+	 * ray.
+	 *
+	 * @param[in] p   The origins of the rays
+	 * @param[in] dir The directions of the rays, one for every origin
+	 * @returns a pair of distances for every ray, as for GetIntersection()
+	 */
+	virtual std::vector<std::pair<double, double> >
+	GetIntersections(const std::vector<I3Position> &p, const std::vector<I3Direction> &dir) const;
 	std::pair<double, double> no_intersection() const
 	{
 		return std::make_pair(NAN, NAN);
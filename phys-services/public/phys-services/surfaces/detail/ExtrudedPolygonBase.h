@@ -13,6 +13,8 @@
 #ifndef I3SURFACES_EXTRUDEDPOLYGONBASE_H_INCLUDED
 #define I3SURFACES_EXTRUDEDPOLYGONBASE_H_INCLUDED
 
+#include <algorithm>
+#include <limits>
 #include <numeric>
 #include <set>
 
@@ -299,53 +301,94 @@ public:
 
 	I3Position SampleImpactPosition(const I3Direction &dir, I3RandomService &rng) const
 	{
-		// first, pick which face it's going to hit
-		double area = 0;
-		double height = GetLength();
 		std::vector<double> prob;
-		std::pair<double, double> x_range(std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity());
-		std::pair<double, double> y_range(std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity());
+		return SampleImpactPosition(dir, rng, prob);
+	}
 
-		for (const polygon::side &sidey : sides_) {
-			double inner = sidey.normal*dir;
-			if (inner < 0)
-				area += -inner*sidey.length*height;
-			prob.push_back(area);
-			// Find the bounding box of the cap
-			if (sidey.origin.x < x_range.first)
-				x_range.first = sidey.origin.x;
-			if (sidey.origin.x > x_range.second)
-				x_range.second = sidey.origin.x;
-			if (sidey.origin.y < y_range.first)
-				y_range.first = sidey.origin.y;
-			if (sidey.origin.y > y_range.second)
-				y_range.second = sidey.origin.y;
+	/// @brief Intersect many rays at once
+	///
+	/// Same as GetIntersection() for every ray. Rays that miss the bounding
+	/// box of the prism are rejected without looking at the sides, and the
+	/// sides are read from a flat table.
+	std::vector<std::pair<double, double> >
+	GetIntersections(const std::vector<I3Position> &p, const std::vector<I3Direction> &dir) const override
+	{
+		if (p.size() != dir.size())
+			log_fatal("Got %zu positions but %zu directions", p.size(), dir.size());
+
+		std::vector<std::pair<double, double> > intersections(p.size());
+		const size_t nsides = side_table_.x.size();
+		const double *sx = side_table_.x.data();
+		const double *sy = side_table_.y.data();
+		const double *svx = side_table_.vx.data();
+		const double *svy = side_table_.vy.data();
+
+		for (size_t i = 0; i < p.size(); i++) {
+			const double px = p[i].GetX(), py = p[i].GetY(), pz = p[i].GetZ();
+			const double dx = dir[i].GetX(), dy = dir[i].GetY(), dz = dir[i].GetZ();
+			if ((dx == 0 && dy == 0) || dz == 0) {
+				// axis-parallel rays take the special cases of the scalar version
+				intersections[i] = ExtrudedPolygonBase::GetIntersection(p[i], dir[i]);
+				continue;
+			}
+			if (MissesBoundingBox(px, py, pz, dx, dy, dz)) {
+				intersections[i] = Surface::no_intersection();
+				continue;
+			}
+
+			// distances to the sides, as in GetDistanceToHull()
+			std::pair<double, double> sides = Surface::no_intersection();
+			const double rho = std::hypot(dx, dy);
+			for (size_t j = 0; j < nsides; j++) {
+				const double x = sx[j] - px;
+				const double y = sy[j] - py;
+				const double alpha = (dx*y - dy*x) / (dy*svx[j] - dx*svy[j]);
+				if ((alpha >= 0.) && (alpha < 1.)) {
+					const double ix = x + alpha*svx[j];
+					const double iy = y + alpha*svy[j];
+					const double beta = std::copysign(std::hypot(ix, iy), ix*dx + iy*dy) / rho;
+					if (!(beta >= sides.first))
+						sides.first = beta;
+					if (!(beta <= sides.second))
+						sides.second = beta;
+				}
+			}
+			const std::pair<double, double> caps = make_ordered_pair(
+			    (z_range_.first-pz)/dz, (z_range_.second-pz)/dz);
+
+			if (caps.first >= sides.second || caps.second <= sides.first)
+				intersections[i] = Surface::no_intersection();
+			else
+				intersections[i] = std::make_pair(std::max(sides.first, caps.first), std::min(sides.second, caps.second));
 		}
-		area += std::abs(dir.GetZ())*cap_area_;
-		prob.push_back(area);
-		std::vector<double>::iterator target =
-		    std::lower_bound(prob.begin(), prob.end(), rng.Uniform(0, area));
-		if (target == boost::prior(prob.end())) {
-			// top or bottom face
-			// triangulation would be more efficient here, but also more complicated
-			I3Position pos(NAN,NAN,dir.GetZ() > 0 ? z_range_.first : z_range_.second);
+
+		return intersections;
+	}
+
+	/// @brief Sample many impact rays at once
+	///
+	/// Same as consecutive calls to SampleImpactRay(), but the maximum area
+	/// and the buffers for the choice of face are set up only once.
+	std::vector<double> SampleImpactRays(std::vector<I3Position> &pos, std::vector<I3Direction> &dir,
+	    size_t n, I3RandomService &rng, double cosMin=0, double cosMax=1) const override
+	{
+		pos.resize(n);
+		dir.resize(n);
+		std::vector<double> area(n);
+		std::vector<double> prob;
+		prob.reserve(sides_.size()+1);
+		const double maxarea = GetMaximumArea();
+		for (size_t i = 0; i < n; i++) {
+			// as in SamplingSurface::SampleDirection()
 			do {
-				pos.SetX(rng.Uniform(x_range.first, x_range.second));
-				pos.SetY(rng.Uniform(y_range.first, y_range.second));
-			} while (!PointInHull(pos));
-			return pos;
-		} else {
-			// side face
-			std::vector<polygon::side>::const_iterator sidey =
-			    sides_.begin() + std::distance(prob.begin(), target);
-			double horizontal = rng.Uniform();
-			double vertical = rng.Uniform();
-			return I3Position(
-			    sidey->origin.x + horizontal*sidey->vector.x,
-			    sidey->origin.y + horizontal*sidey->vector.y,
-			    z_range_.first + vertical*height
-			);
+				dir[i] = I3Direction(acos(rng.Uniform(cosMin, cosMax)),
+				    rng.Uniform(0, 2*M_PI));
+			} while (rng.Uniform(0, maxarea) > GetArea(dir[i]));
+			pos[i] = SampleImpactPosition(dir[i], rng, prob);
+			area[i] = GetArea(dir[i]);
 		}
+
+		return area;
 	}
 
 	std::vector<double> GetX() const
@@ -394,6 +437,13 @@ private:
 	std::vector<polygon::side3D> all_sides_;
 	std::vector<I3Position> corners_;
 	std::pair<double, double> z_range_;
+	// bounding box of the caps
+	std::pair<double, double> x_range_;
+	std::pair<double, double> y_range_;
+	// origins and vectors of sides_, one array per component
+	struct {
+		std::vector<double> x, y, vx, vy;
+	} side_table_;
 	double cap_area_;
 	I3Direction unit_vec_z = I3Direction(0., 0., 1.);
 
@@ -409,12 +459,26 @@ private:
 		bottom_sides_.clear();
 		all_sides_.clear();
 		corners_.clear();
+		x_range_ = std::make_pair(std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity());
+		y_range_ = x_range_;
+		side_table_.x.clear();
+		side_table_.y.clear();
+		side_table_.vx.clear();
+		side_table_.vy.clear();
 		for (std::vector<vec2>::const_iterator p = hull.begin(); p != hull.end(); p++) {
 			std::vector<vec2>::const_iterator np = boost::next(p);
 			if (np == hull.end())
 				np = hull.begin();
 
 			sides_.push_back(side(*p, *np));
+			side_table_.x.push_back(sides_.back().origin.x);
+			side_table_.y.push_back(sides_.back().origin.y);
+			side_table_.vx.push_back(sides_.back().vector.x);
+			side_table_.vy.push_back(sides_.back().vector.y);
+			x_range_.first = std::min(x_range_.first, p->x);
+			x_range_.second = std::max(x_range_.second, p->x);
+			y_range_.first = std::min(y_range_.first, p->y);
+			y_range_.second = std::max(y_range_.second, p->y);
 			bottom_sides_.push_back(side3D(I3Position(p->x, p->y, zrange.first), I3Position(np->x, np->y, zrange.first)));
 			all_sides_.push_back(side3D(I3Position(p->x, p->y, zrange.first), I3Position(np->x, np->y, zrange.first)));
 			all_sides_.push_back(side3D(I3Position(p->x, p->y, zrange.second), I3Position(np->x, np->y, zrange.second)));
@@ -480,6 +544,72 @@ private:
 		return hull_from_I3Geometry(i3geo);
 	}
 
+	I3Position SampleImpactPosition(const I3Direction &dir, I3RandomService &rng, std::vector<double> &prob) const
+	{
+		// first, pick which face it's going to hit
+		double area = 0;
+		double height = GetLength();
+		prob.clear();
+
+		for (const polygon::side &sidey : sides_) {
+			double inner = sidey.normal*dir;
+			if (inner < 0)
+				area += -inner*sidey.length*height;
+			prob.push_back(area);
+		}
+		area += std::abs(dir.GetZ())*cap_area_;
+		prob.push_back(area);
+		std::vector<double>::iterator target =
+		    std::lower_bound(prob.begin(), prob.end(), rng.Uniform(0, area));
+		if (target == boost::prior(prob.end())) {
+			// top or bottom face
+			// triangulation would be more efficient here, but also more complicated
+			I3Position pos(NAN,NAN,dir.GetZ() > 0 ? z_range_.first : z_range_.second);
+			do {
+				pos.SetX(rng.Uniform(x_range_.first, x_range_.second));
+				pos.SetY(rng.Uniform(y_range_.first, y_range_.second));
+			} while (!PointInHull(pos));
+			return pos;
+		} else {
+			// side face
+			std::vector<polygon::side>::const_iterator sidey =
+			    sides_.begin() + std::distance(prob.begin(), target);
+			double horizontal = rng.Uniform();
+			double vertical = rng.Uniform();
+			return I3Position(
+			    sidey->origin.x + horizontal*sidey->vector.x,
+			    sidey->origin.y + horizontal*sidey->vector.y,
+			    z_range_.first + vertical*height
+			);
+		}
+	}
+
+	/// @brief Slab test against the bounding box of the prism
+	///
+	/// Only says yes if the ray is clearly outside; rays that graze the box
+	/// are left to the exact calculation.
+	bool MissesBoundingBox(double px, double py, double pz, double dx, double dy, double dz) const
+	{
+		double tmin = -std::numeric_limits<double>::infinity();
+		double tmax = std::numeric_limits<double>::infinity();
+		const double lo[3] = {x_range_.first, y_range_.first, z_range_.first};
+		const double hi[3] = {x_range_.second, y_range_.second, z_range_.second};
+		const double o[3] = {px, py, pz};
+		const double d[3] = {dx, dy, dz};
+		for (int axis = 0; axis < 3; axis++) {
+			if (d[axis] == 0) {
+				if (o[axis] < lo[axis] || o[axis] > hi[axis])
+					return true;
+				continue;
+			}
+			const double t1 = (lo[axis]-o[axis])/d[axis];
+			const double t2 = (hi[axis]-o[axis])/d[axis];
+			tmin = std::max(tmin, std::min(t1, t2));
+			tmax = std::min(tmax, std::max(t1, t2));
+		}
+		return tmin > tmax + 1e-9*(1 + std::abs(tmin) + std::abs(tmax));
+	}
+
 	/// @brief Get distances to the infinite horizontal planes that define the
 	///        top and bottom of the surface
 	///
@@ -51,6 +51,33 @@ class ExtrudedPolygonTest(unittest.TestCase):
             self.assertEqual(intersection.first, -1.5)
             self.assertEqual(intersection.second, -0.5)
     
+    def testIntersections(self):
+        pos = [I3Position(x, y, z) for x in (-2, 0.1, 2) for y in (-1, 0.2, 3) for z in (-2, 0.3, 2)]
+        dirs = [I3Direction(x, y, z) for x, y, z in zip((1, -1, 0.3), (0.5, 1, -0.7), (-0.2, 0.4, 1))]
+        pos, dirs = zip(*[(p, d) for p in pos for d in dirs + [I3Direction(0, 0, 1), I3Direction(1, 0, 0)]])
+
+        batch = self.surface.intersections(pos, dirs)
+        self.assertEqual(len(batch), len(pos))
+        for p, d, isect in zip(pos, dirs, batch):
+            single = self.surface.intersection(p, d)
+            for a, b in ((isect.first, single.first), (isect.second, single.second)):
+                if b != b:
+                    self.assertTrue(a != a)
+                else:
+                    self.assertEqual(a, b)
+
+    def testSampleImpactRays(self):
+        from icecube.phys_services import I3GSLRandomService
+
+        rays = self.surface.sample_impact_rays(I3GSLRandomService(1), 50, -1, 1)
+        rng = I3GSLRandomService(1)
+        for pos, dir, area in zip(*rays):
+            single = self.surface.sample_impact_ray(rng, -1, 1)
+            self.assertEqual(pos, single[0])
+            self.assertAlmostEqual(dir.zenith, single[1].zenith)
+            self.assertAlmostEqual(dir.azimuth, single[1].azimuth)
+            self.assertAlmostEqual(area, self.surface.area(dir))
+
     def testClosestApproach(self):
         # check that for intersecting trajectories the function returns nan ofr the closest approach
 
@@ -43,6 +43,11 @@ class DecomposerTestModule(icetray.I3Module):
             assert omgeo[k].omtype == orgeo[k].omtype
             odict[k.string].add(k.om)
 
+        index = frame['I3OMKeyIndex']
+        assert len(index) == len(orgeo)
+        for i, k in enumerate(orgeo.keys()):
+            assert index.get_index(k) == i
+
         modgeo = frame['I3ModuleGeoMap']
         udict = defaultdict(list)
         sdict = defaultdict(list)
@@ -74,7 +79,7 @@ tray = I3Tray()
 tray.Add('I3Reader',
          Filenamelist=[str(_) for _ in TESTGCD.glob('*.i3.*')])
 tray.Add('Delete',
-         keys=['I3ModuleGeoMap', 'I3ExtraModuleGeoMap', 'I3OMGeoMap', 'I3StationGeoMap', 'StartTime', 'Subdetectors', 'EndTime', 'BedrockZ', 'DepthAtZ0'])
+         keys=['I3ModuleGeoMap', 'I3ExtraModuleGeoMap', 'I3OMGeoMap', 'I3OMKeyIndex', 'I3StationGeoMap', 'StartTime', 'Subdetectors', 'EndTime', 'BedrockZ', 'DepthAtZ0'])
 tray.Add('I3GeometryDecomposer')
 tray.Add(DecomposerTestModule)
 tray.Execute()
@@ -25,7 +25,8 @@ boost::shared_ptr<I3BroadcastTableService> tuple_init(bp::tuple clients) {
 
 void register_I3BroadcastTableService() {
    bp::class_<I3BroadcastTableService,
-      boost::shared_ptr<I3BroadcastTableService>, bp::bases<I3TableService> >
+      boost::shared_ptr<I3BroadcastTableService>, bp::bases<I3TableService>,
+      boost::noncopyable>
       ("I3BroadcastTableService", bp::no_init)
       .def("__init__",bp::make_constructor(&tuple_init))
       ;
@@ -17,7 +17,8 @@ namespace bp = boost::python;
 void register_I3CSVTableService() {
     bp::class_<I3CSVTableService,
                boost::shared_ptr<I3CSVTableService>,
-               bp::bases<I3TableService> >
+               bp::bases<I3TableService>,
+               boost::noncopyable>
                ("I3CSVTableService",
                 bp::init<const std::string>(bp::args("folder_name")))
                ;
@@ -19,13 +19,20 @@ namespace bp = boost::python;
 
 void register_I3HDFTableService() {
 
-   typedef bp::init<const std::string&, int, char> ctor;
-   typedef bp::init<I3::dataio::shared_filehandle, int, char> fh_ctor;
+   typedef bp::init<const std::string&, int, char, const std::string&,
+      size_t, size_t, unsigned> ctor;
+   typedef bp::init<I3::dataio::shared_filehandle, int, char,
+      const std::string&, size_t, size_t, unsigned> fh_ctor;
    bp::class_<I3HDFTableService,
-      boost::shared_ptr<I3HDFTableService>, bp::bases<I3TableService> >
+      boost::shared_ptr<I3HDFTableService>, bp::bases<I3TableService>,
+      boost::noncopyable>
       ("I3HDFTableService", ctor((bp::args("filename"),
-          bp::arg("compression_level")=1, bp::arg("mode")='w')))
+          bp::arg("compression_level")=1, bp::arg("mode")='w',
+          bp::arg("filter")="deflate", bp::arg("chunk_bytes")=0,
+          bp::arg("cache_bytes")=0, bp::arg("threads")=0)))
       .def(fh_ctor((bp::args("filehandle"),
-          bp::arg("compression_level")=1, bp::arg("mode")='w')))
+          bp::arg("compression_level")=1, bp::arg("mode")='w',
+          bp::arg("filter")="deflate", bp::arg("chunk_bytes")=0,
+          bp::arg("cache_bytes")=0, bp::arg("threads")=0)))
       ;
 }
@@ -21,8 +21,11 @@ void register_I3ParquetTableService() {
 
    bp::class_<I3ParquetTableService,
             boost::shared_ptr<I3ParquetTableService>,
-            bp::bases<I3TableService>>
+            bp::bases<I3TableService>,
+            boost::noncopyable>
             ("I3ParquetTableService",
-            bp::init<std::string, std::string>(bp::args("folder_path", "compression")))
+            bp::init<std::string, std::string, size_t, size_t>(
+                (bp::arg("folder_path"), bp::arg("compression")="uncompressed",
+                 bp::arg("row_group_size")=100000, bp::arg("row_group_bytes")=64 << 20)))
             ;
 }
@@ -20,7 +20,8 @@ void register_I3ROOTTableService() {
   typedef bp::init<I3::dataio::shared_filehandle,const std::string&,
     int,const std::string&> fh_ctor;
   bp::class_<I3ROOTTableService, 
-    boost::shared_ptr<I3ROOTTableService>, bp::bases<I3TableService> >
+    boost::shared_ptr<I3ROOTTableService>, bp::bases<I3TableService>,
+    boost::noncopyable>
     ("I3ROOTTableService",ctor((bp::args("filename"), bp::arg("master")="MasterTree",
         bp::arg("compression_level")=1, bp::arg("mode")="RECREATE")))
     .def(fh_ctor((bp::args("filehandle"), bp::arg("master")="MasterTree",
@@ -21,8 +21,10 @@ void register_I3SQLiteTableService() {
 
    bp::class_<I3SQLiteTableService,
              boost::shared_ptr<I3SQLiteTableService>,
-             bp::bases<I3TableService>>
+             bp::bases<I3TableService>,
+             boost::noncopyable>
              ("I3SQLiteTableService",
-              bp::init<std::string>(bp::args("path")))
+              bp::init<std::string, size_t>((bp::arg("path"),
+                  bp::arg("rows_per_transaction")=1000000)))
              ;
 }
@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <tableio/I3TableColumns.h>
+#include "type_helpers.h"
+#include "const_ptr_helpers.h"
+
+namespace bp = boost::python;
+
+// ==================================================================
+// = A numpy array that shares the memory of a column, one row per  =
+// = element (or per line, for array fields)                        =
+// ==================================================================
+static size_t field_index(I3TableColumns& self, const std::string& field) {
+    size_t index = self.GetDescription()->GetFieldColumn(field);
+    if (index >= self.GetDescription()->GetNumberOfFields()) {
+        PyErr_SetString(PyExc_KeyError,field.c_str());
+        bp::throw_error_already_set();
+    }
+    return index;
+}
+
+static std::string numpy_code(const I3Datatype& dtype) {
+    // numpy calls bools '?', where the array module calls them 'o'
+    return std::string(1, dtype.kind == I3Datatype::Bool ? '?' : PyArrayTypecode_from_I3Datatype(dtype));
+}
+
+// The buffer behind the numpy array of a column. It holds a reference to
+// the Python object of the columns, so that the column memory lives as
+// long as any array that shares it.
+struct ColumnBuffer {
+    PyObject_HEAD
+    PyObject* owner;
+    void* data;
+    Py_ssize_t size;
+};
+
+static void ColumnBuffer_dealloc(PyObject* self) {
+    Py_XDECREF(reinterpret_cast<ColumnBuffer*>(self)->owner);
+    Py_TYPE(self)->tp_free(self);
+}
+
+static int ColumnBuffer_getbuffer(PyObject* self, Py_buffer* view, int flags) {
+    ColumnBuffer* buffer = reinterpret_cast<ColumnBuffer*>(self);
+    return PyBuffer_FillInfo(view, self, buffer->data, buffer->size, 0, flags);
+}
+
+static PyBufferProcs ColumnBuffer_as_buffer = { ColumnBuffer_getbuffer, NULL };
+static PyTypeObject ColumnBuffer_Type = { PyVarObject_HEAD_INIT(NULL, 0) };
+
+static bp::object column_buffer(bp::object owner, void* data, size_t size) {
+    ColumnBuffer* buffer = PyObject_New(ColumnBuffer, &ColumnBuffer_Type);
+    if (!buffer)
+        bp::throw_error_already_set();
+    Py_INCREF(owner.ptr());
+    buffer->owner = owner.ptr();
+    buffer->data = data;
+    buffer->size = size;
+    return bp::object(bp::handle<>(reinterpret_cast<PyObject*>(buffer)));
+}
+
+// Columns handed to FillColumns are closed when it returns: the arrays it
+// got become read-only, and the columns can't be used any more.
+static void check_open(bp::object self) {
+    if (bp::extract<bool>(self.attr("__dict__").attr("get")("_closed", false))) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "The columns can only be used until FillColumns returns");
+        bp::throw_error_already_set();
+    }
+}
+
+static void close_columns(bp::object self) {
+    bp::object attributes = self.attr("__dict__");
+    bp::object arrays = attributes.attr("get")("_arrays", bp::list());
+    for (bp::ssize_t i = 0; i < bp::len(arrays); i++) {
+        bp::object array = arrays[i]();
+        if (!array.is_none())
+            array.attr("flags").attr("writeable") = false;
+    }
+    attributes["_arrays"] = bp::list();
+    attributes["_closed"] = true;
+}
+
+static bp::object getitem(bp::object self, const std::string& field) {
+    check_open(self);
+    I3TableColumns& columns = bp::extract<I3TableColumns&>(self);
+    I3TableRowDescriptionConstPtr desc = columns.GetDescription();
+    size_t index = field_index(columns, field);
+
+    const I3Datatype& dtype = desc->GetFieldTypes().at(index);
+    std::string code = numpy_code(dtype);
+    bp::object numpy = bp::import("numpy");
+
+    // a copy of the elements of each row
+    if (desc->IsVariableLength(index)) {
+        bp::list rows;
+        for (size_t r = 0; r < columns.GetNumberOfRows(); r++) {
+            size_t n;
+            const char* elements = static_cast<const char*>(columns.GetVariableLength(index, r, n));
+            bp::object array = numpy.attr("empty")(n, code);
+            if (n > 0) {
+                bp::object view(bp::handle<>(PyMemoryView_FromMemory(
+                    const_cast<char*>(elements), n*dtype.size, PyBUF_READ)));
+                array = numpy.attr("frombuffer")(view, code).attr("copy")();
+            }
+            rows.append(array);
+        }
+        return rows;
+    }
+
+    size_t array_length = desc->GetFieldArrayLengths().at(index);
+    bp::tuple shape = (array_length > 1) ?
+        bp::make_tuple(columns.GetNumberOfRows(), array_length) :
+        bp::make_tuple(columns.GetNumberOfRows());
+
+    if (columns.GetNumberOfRows() == 0)
+        return numpy.attr("empty")(shape, code);
+
+    // the columns can't be resized from Python, so the memory stays put
+    bp::object buffer = column_buffer(self, columns.GetPointerToColumn(index),
+        columns.GetNumberOfRows()*desc->GetFieldSizes().at(index));
+    bp::object array = numpy.attr("ndarray")(shape, code, buffer);
+    // weak references, since the arrays keep the columns alive
+    self.attr("__dict__").attr("setdefault")("_arrays", bp::list()).attr("append")(
+        bp::import("weakref").attr("ref")(array));
+    return array;
+}
+
+static void set_variable_length(bp::object self, const std::string& field,
+                                size_t row, bp::object values) {
+    check_open(self);
+    I3TableColumns& columns = bp::extract<I3TableColumns&>(self);
+    size_t index = field_index(columns, field);
+    const I3Datatype& dtype = columns.GetDescription()->GetFieldTypes().at(index);
+    bp::object array = bp::import("numpy").attr("ascontiguousarray")(values, numpy_code(dtype));
+    Py_buffer view;
+    if (PyObject_GetBuffer(array.ptr(), &view, PyBUF_SIMPLE) != 0)
+        bp::throw_error_already_set();
+    memcpy(columns.AddVariableLength(index, row, view.len/dtype.size), view.buf, view.len);
+    PyBuffer_Release(&view);
+}
+
+static bp::list keys(I3TableColumns& self) {
+    bp::list fields;
+    for (const std::string& field : self.GetDescription()->GetFieldNames())
+        fields.append(field);
+    return fields;
+}
+
+void register_I3TableColumns() {
+
+   ColumnBuffer_Type.tp_name = "tableio.I3TableColumns.ColumnBuffer";
+   ColumnBuffer_Type.tp_basicsize = sizeof(ColumnBuffer);
+   ColumnBuffer_Type.tp_dealloc = ColumnBuffer_dealloc;
+   ColumnBuffer_Type.tp_as_buffer = &ColumnBuffer_as_buffer;
+   ColumnBuffer_Type.tp_flags = Py_TPFLAGS_DEFAULT;
+   if (PyType_Ready(&ColumnBuffer_Type) < 0)
+      bp::throw_error_already_set();
+
+   bp::class_<I3TableColumns,
+      boost::shared_ptr<I3TableColumns>, boost::noncopyable >
+      ("I3TableColumns",
+"\n\
+Column-major buffers for a batch of table rows, as handed to the FillColumns \n\
+method of a Python converter. The columns already hold the rows of all the   \n\
+objects, zeroed and in order, and each column can be read and written as a   \n\
+numpy array that shares its memory::                                         \n\
+                                                                             \n\
+   columns['value'][:] = [obj.value for obj in objects]                      \n\
+                                                                             \n\
+Array fields give 2-d arrays with one line per row. Once FillColumns returns,\n\
+the arrays become read-only and the columns can't be used any more.          \n\
+Variable-length fields give a list with a copy of the elements of each row,  \n\
+and are filled with set_variable_length().                                   \n\
+",\
+      bp::init<I3TableRowDescriptionConstPtr, size_t>((bp::arg("description"), bp::arg("nrows")=0)))
+   .add_property("description", &I3TableColumns::GetDescription)
+   .def("__len__", &I3TableColumns::GetNumberOfRows)
+   .def("__getitem__", getitem)
+   .def("set_variable_length", set_variable_length, bp::args("field", "row", "values"),
+        "Set the elements of a variable-length field in the given row")
+   .def("_close", close_columns)
+   .def("keys", keys)
+   ;
+
+   // register implicit conversions for const pointers
+   utils::register_const_ptr<I3TableColumns>();
+}
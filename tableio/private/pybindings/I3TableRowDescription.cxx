@@ -58,8 +58,8 @@ docstring : str                                                               \n
    how it was calculated).                                                    \n\
 array_size : int                                                              \n\
    The number of elements in the field. If this is 1 (default), then the field\n\
-   is a scalar. Otherwise, the field will store a fixed-length vector         \n\
-   quantity.                                                                  \n\
+   is a scalar. If it is 0, each row holds its own number of elements.        \n\
+   Otherwise, the field will store a fixed-length vector quantity.            \n\
 "))
    ;
 
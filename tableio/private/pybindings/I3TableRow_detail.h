@@ -88,6 +88,17 @@ void throw_unless_fits(size_t array_size, size_t field_size) {
          I3Datatype vec_dtype = I3DatatypeFromNativeType<T>();
          throw_unless_match(vec_dtype,dtype);
 
+         // variable-length fields take any number of elements
+         if (desc->IsVariableLength(index)) {
+             size_t start = all ? 0 : self.GetCurrentRow();
+             size_t stop = all ? self.GetNumberOfRows() : start+1;
+             for (size_t i = start; i < stop; i++) {
+                 T* block = static_cast<T*>(self.AddVariableLength(index,i,v.size()));
+                 std::copy(v.begin(),v.end(),block);
+             }
+             return;
+         }
+
          // check for an overflow
          throw_unless_fits(v.size(), desc->GetFieldArrayLengths().at(index));
 
@@ -147,7 +158,8 @@ void throw_unless_fits(size_t array_size, size_t field_size) {
             // = Copy the buffer (an array in native representation)
             //   directly into the memory chunk                      =
             // =======================================================
-            throw_unless_fits(static_cast<size_t>(view.len)/(dtype.size),array_length);
+            if (array_length > 0)
+                throw_unless_fits(static_cast<size_t>(view.len)/(dtype.size),array_length);
 
             size_t start,stop,i;
             void* pointy;
@@ -159,7 +171,10 @@ void throw_unless_fits(size_t array_size, size_t field_size) {
                 stop = start+1;
             }
             for (i = start; i < stop; i++) {
-                pointy = self.GetPointerToField(index,i);
+                if (array_length == 0)
+                    pointy = self.AddVariableLength(index,i,view.len/dtype.size);
+                else
+                    pointy = self.GetPointerToField(index,i);
                 memcpy(pointy,view.buf,view.len);
             }
         }
@@ -211,7 +226,12 @@ struct get_list {
         bp::list l;
         I3TableRowDescriptionConstPtr desc = self.GetDescription();
         size_t length = desc->GetFieldArrayLengths().at(index);
-        T* block = self.GetPointer<T>(index);
+        const T* block;
+        if (length == 0) {
+            block = self.GetVariableLength<T>(index,length);
+        } else {
+            block = self.GetPointer<T>(index);
+        }
         for (size_t i=0; i<length; i++) l.append(block[i]);
         result = l;
     };
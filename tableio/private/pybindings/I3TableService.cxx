@@ -25,6 +25,12 @@ struct I3TableServiceWrapper : I3TableService, bp::wrapper<I3TableService> {
         virtual void CloseFile() {
             this->get_override("CloseFile")();
         };
+        // tables implemented in Python can't be written without the GIL
+        virtual void SetBackgroundWriting(size_t queueLength) {
+            if (queueLength > 0)
+                log_fatal("Table services implemented in Python can't write in the background.");
+        };
+        SET_LOGGER("I3TableService");
    };
 
 void register_I3TableService() {
@@ -37,6 +43,9 @@ void register_I3TableService() {
     .def("GetTable",&I3TableServiceWrapper::GetTable)
     .def("CloseFile",&I3TableServiceWrapper::CloseFile)
     .def("Finish",&I3TableServiceWrapper::Finish)
+    .def("SetBackgroundWriting",&I3TableService::SetBackgroundWriting,
+         "Write tables on a background thread that keeps up to queueLength "
+         "batches of rows in flight. 0 writes on the calling thread.")
 
     ;
 }
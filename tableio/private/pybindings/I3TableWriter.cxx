@@ -26,6 +26,7 @@ void register_I3TableWriter() {
 		.def("add_object", (void (I3TableWriter::*)(const std::string, I3TableWriter::TableSpec)) &I3TableWriter::AddObject)
 		.def("add_type", (void (I3TableWriter::*)(I3TableWriter::TypeSpec, I3TableWriter::TableSpec)) &I3TableWriter::AddType)
 		.def("convert", (void (I3TableWriter::*)(I3FramePtr)) &I3TableWriter::Convert)
+		.def("set_batch_size", &I3TableWriter::SetBatchSize, bp::args("batch_size"))
 		.def("finish", &I3TableWriter::Finish)
 	;
 
@@ -37,10 +37,11 @@ class I3RecoPulseSeriesMapMaskConverter : public I3ConverterImplementation<I3Rec
 {
 public:
     // Again here, different constructors for different argument combinations (both, neither, one, the other)
-    I3RecoPulseSeriesMapMaskConverter() : base_() {};
-    I3RecoPulseSeriesMapMaskConverter(bool b, std::string btp) : base_(b, btp) {};
-    I3RecoPulseSeriesMapMaskConverter(bool b) : base_(b) {};
-    I3RecoPulseSeriesMapMaskConverter(std::string btp) : base_(btp) {};
+    I3RecoPulseSeriesMapMaskConverter() : base_(), variableLength_(false) {};
+    I3RecoPulseSeriesMapMaskConverter(bool b, std::string btp, bool vl) : base_(b, btp, vl), variableLength_(vl) {};
+    I3RecoPulseSeriesMapMaskConverter(bool b, std::string btp) : base_(b, btp), variableLength_(false) {};
+    I3RecoPulseSeriesMapMaskConverter(bool b) : base_(b), variableLength_(false) {};
+    I3RecoPulseSeriesMapMaskConverter(std::string btp) : base_(btp), variableLength_(false) {};
     I3TableRowDescriptionPtr CreateDescription(const I3RecoPulseSeriesMapMask& m)
     {
         I3RecoPulseSeriesMap mappy;
@@ -48,7 +49,13 @@ public:
     }
     size_t GetNumberOfRows(const I3RecoPulseSeriesMapMask &mask)
     {
-        return mask.GetSum();
+        if (!variableLength_)
+            return mask.GetSum();
+        // one row per DOM with selected pulses
+        size_t nrows = 0;
+        for (const boost::dynamic_bitset<uint8_t>& bits : mask.GetBits())
+            nrows += bits.any();
+        return nrows;
     }
     size_t FillRows(const I3RecoPulseSeriesMapMask &mask, I3TableRowPtr rows)
     {
@@ -58,6 +65,7 @@ public:
 private:
     typedef I3MapOMKeyVectorConverter<convert::I3RecoPulse, I3RecoPulseSeriesMap> Base;
     Base base_;
+    bool variableLength_;
 };
 
 void register_dataclasses_converters() {
@@ -70,8 +78,12 @@ void register_dataclasses_converters() {
     typedef I3MapOMKeyVectorConverter< convert::I3DOMLaunch > I3DOMLaunchSeriesMapConverter;
     I3_MAP_CONVERTER_EXPORT_DEFAULT(I3DOMLaunchSeriesMapConverter,"Dumps all DOMLaunches verbatim.");
     typedef I3MapOMKeyVectorConverter< convert::I3RecoPulse > I3RecoPulseSeriesMapConverter;
-    I3_MAP_CONVERTER_EXPORT_DEFAULT(I3RecoPulseSeriesMapConverter,"Dumps all RecoPulses verbatim.");
-    I3_MAP_CONVERTER_EXPORT_DEFAULT(I3RecoPulseSeriesMapMaskConverter,"Applies the mask, then dumps the resulting RecoPulses verbatim.");
+    I3_MAP_CONVERTER_EXPORT_DEFAULT(I3RecoPulseSeriesMapConverter,"Dumps all RecoPulses verbatim.")
+        .def(bp::init<bool, std::string, bool>(bp::args("bookGeometry","bookToParticle","variableLength")))
+        ;
+    I3_MAP_CONVERTER_EXPORT_DEFAULT(I3RecoPulseSeriesMapMaskConverter,"Applies the mask, then dumps the resulting RecoPulses verbatim.")
+        .def(bp::init<bool, std::string, bool>(bp::args("bookGeometry","bookToParticle","variableLength")))
+        ;
     typedef I3MapOMKeyVectorConverter< convert::I3RecoHit > I3RecoHitSeriesMapConverter;
     I3_MAP_CONVERTER_EXPORT_DEFAULT(I3RecoHitSeriesMapConverter,"Dumps all RecoHits verbatim.");
     typedef I3MapOMKeyVectorConverter< convert::I3MCHit > I3MCHitSeriesMapConverter;
@@ -275,7 +287,7 @@ void register_dataclasses_converters() {
 								bp::bases<I3Converter>,
 								boost::noncopyable >("I3WaveformSeriesMapConverter",
 										     "Dumps a single I3WaveformSeriesMap (good for IceTop people not interested in FADC)",
-										     bp::init< bool, bool >((bp::arg("calibrate")=false, bp::arg("bookGeometry")=false))),
+										     bp::init< bool, bool, bool >((bp::arg("calibrate")=false, bp::arg("bookGeometry")=false, bp::arg("variableLength")=false))),
 						     true);
 
     //I3AntennaDataMapConverter
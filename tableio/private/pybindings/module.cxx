@@ -45,9 +45,9 @@ namespace bp = boost::python;
 #endif
 
 #define REGISTER_THESE_THINGS \
-   (I3TableRowDescription)(I3TableRow)(I3Converter)(I3TableService)     \
-   (I3TableWriter)(I3TableTranscriber)(I3ConverterBundle)(I3Datatype)   \
-   (I3Table)(I3BroadcastTableService)(I3CSVTableService)                \
+   (I3TableRowDescription)(I3TableRow)(I3TableColumns)(I3Converter)     \
+   (I3TableService)(I3TableWriter)(I3TableTranscriber)(I3ConverterBundle)\
+   (I3Datatype)(I3Table)(I3BroadcastTableService)(I3CSVTableService)    \
     REGISTER_ROOT_DEPENDENT                                             \
     REGISTER_HDF5_DEPENDENT                                             \
     REGISTER_SQLITE3_DEPENDENT                                          \
@@ -25,3 +25,19 @@ I3TableRowDescriptionConstPtr I3Converter::GetDescription() {
 }
 
 /******************************************************************************/
+
+size_t I3Converter::ConvertColumns(const std::vector<I3FrameObjectConstPtr>& objects,
+                                   I3TableColumns& columns,
+                                   const std::vector<I3FramePtr>& frames) {
+    size_t nrows = 0;
+    for (size_t i = 0, start = 0; i < objects.size(); ++i) {
+        I3TableRowPtr rows(new I3TableRow(columns.GetDescription(),
+                                          GetNumberOfRows(objects[i])));
+        nrows += Convert(objects[i], rows, frames.empty() ? I3FramePtr() : frames.at(i));
+        columns.SetRows(start, *rows);
+        start += rows->GetNumberOfRows();
+    }
+    return nrows;
+}
+
+/******************************************************************************/
@@ -11,10 +11,16 @@
 
 #include "tableio/I3Table.h"
 #include "tableio/I3TableRow.h"
+#include "tableio/I3TableRowPool.h"
+#include "tableio/I3TableColumns.h"
 #include "tableio/I3TableRowDescription.h"
 #include "tableio/I3TableService.h"
 #include "tableio/I3Converter.h"
 
+#include <cstring>
+
+#include <boost/make_shared.hpp>
+
 /******************************************************************************/
 
 I3Table::I3Table(I3TableService& service,
@@ -84,13 +90,88 @@ void I3Table::AddRow(I3EventHeaderConstPtr header, I3TableRowConstPtr row) {
         log_fatal("(%s) Converter reported %zu rows for a single-row object! Multi-row objects must be marked by their converters.",name_.c_str(),nrows);
     }
 
+    PadBefore(header);
+    QueueRows(row);
+    EventWritten(header, nrows);
+}
+
+/******************************************************************************/
+
+void I3Table::AddColumns(const std::vector<I3EventHeaderConstPtr>& headers,
+                         const std::vector<size_t>& nrows,
+                         const I3TableColumns& columns) {
+    if (headers.size() != nrows.size()) {
+        log_fatal("(%s) Got %zu headers for %zu events.",name_.c_str(),headers.size(),nrows.size());
+    }
+
+    // the caller reuses its columns for the next batch
+    boost::shared_ptr<const I3TableColumns> queued;
+    if (service_.WritesInBackground())
+        queued = boost::make_shared<const I3TableColumns>(columns);
+
+    size_t start = 0;
+    for (size_t i = 0; i < headers.size(); ++i) {
+        if ((nrows[i] != 1) && (!description_->GetIsMultiRow())) {
+            log_fatal("(%s) Converter reported %zu rows for a single-row object! Multi-row objects must be marked by their converters.",name_.c_str(),nrows[i]);
+        }
+        if (start + nrows[i] > columns.GetNumberOfRows()) {
+            log_fatal("(%s) Events span %zu rows, but only %zu were converted.",name_.c_str(),start+nrows[i],columns.GetNumberOfRows());
+        }
+
+        PadBefore(headers[i]);
+        if (queued) {
+            const size_t first = start, n = nrows[i];
+            service_.RunWrite([this, queued, first, n]{ WriteColumns(*queued, first, n); });
+        } else {
+            WriteColumns(columns, start, nrows[i]);
+        }
+        EventWritten(headers[i], nrows[i]);
+        start += nrows[i];
+    }
+}
+
+/******************************************************************************/
+
+void I3Table::AddColumns(I3EventHeaderConstPtr header, I3TableColumnsConstPtr columns,
+                         size_t start, size_t nrows) {
+    if ((nrows != 1) && (!description_->GetIsMultiRow())) {
+        log_fatal("(%s) Converter reported %zu rows for a single-row object! Multi-row objects must be marked by their converters.",name_.c_str(),nrows);
+    }
+    if (start + nrows > columns->GetNumberOfRows()) {
+        log_fatal("(%s) Event spans rows [%zu,%zu), but only %zu were converted.",name_.c_str(),start,start+nrows,columns->GetNumberOfRows());
+    }
+
+    PadBefore(header);
+    // the columns are shared, not copied, with the writer thread
+    if (service_.WritesInBackground())
+        service_.RunWrite([this, columns, start, nrows]{ WriteColumns(*columns, start, nrows); });
+    else
+        WriteColumns(*columns, start, nrows);
+    EventWritten(header, nrows);
+}
+
+/******************************************************************************/
+
+void I3Table::WriteColumns(const I3TableColumns& columns, size_t start, size_t nrows) {
+    WriteRows(columns.GetRows(start, nrows));
+}
+
+/******************************************************************************/
+
+void I3Table::QueueRows(I3TableRowConstPtr rows) {
+    service_.RunWrite([this, rows]{ WriteRows(rows); });
+}
+
+/******************************************************************************/
+
+void I3Table::PadBefore(I3EventHeaderConstPtr header) {
     I3TableRowConstPtr padding;
     if (DoPadding() && header) {
         padding = service_.GetPaddingRows(lastHeader_, header, description_);
         if (padding) {
             log_trace("(%s) Writing %zu padding rows",name_.c_str(),padding->GetNumberOfRows());
 	    for (size_t r = 0; r < padding->GetNumberOfRows(); ++r) {
-	      WriteRows(padding->GetSingleRow(r));
+	      QueueRows(padding->GetSingleRow(r));
 	    }
             nrowsWithPadding_ += padding->GetNumberOfRows();
         }
@@ -99,34 +180,36 @@ void I3Table::AddRow(I3EventHeaderConstPtr header, I3TableRowConstPtr row) {
     if (indexTable_) {
         assert(header);
         padding = service_.GetPaddingRows(lastHeader_, header, service_.GetIndexDescription());
-        if (padding) indexTable_->WriteRows(padding);
+        if (padding) indexTable_->QueueRows(padding);
     }
+}
 
-    WriteRows(row);
+/******************************************************************************/
 
+void I3Table::EventWritten(I3EventHeaderConstPtr header, size_t nrows) {
     if (indexTable_) {
       assert(header);
-      I3TableRowPtr index_row = I3TableRowPtr(new I3TableRow(service_.GetIndexDescription(),1));
+      I3TableRowPtr index_row = indexTable_->CreateRow(1);
       index_row->Set<uint32_t>("Run",header->GetRunID());
       index_row->Set<uint32_t>("Event",header->GetEventID());
       index_row->Set<bool>("exists",true);
       index_row->Set<tableio_size_t>("start",static_cast<tableio_size_t>(nrowsWithPadding_));
-      index_row->Set<tableio_size_t>("stop",static_cast<tableio_size_t>(nrowsWithPadding_+row->GetNumberOfRows()));
+      index_row->Set<tableio_size_t>("stop",static_cast<tableio_size_t>(nrowsWithPadding_+nrows));
       log_trace("(%s) Writing row to index table. start: %zu end: %zu",
-                name_.c_str(),nrowsWithPadding_,nrowsWithPadding_+row->GetNumberOfRows());
+                name_.c_str(),nrowsWithPadding_,nrowsWithPadding_+nrows);
 
-      indexTable_->WriteRows(index_row);
+      indexTable_->QueueRows(index_row);
     }
 
     nevents_++;
-    nrows_ += row->GetNumberOfRows();
-    nrowsWithPadding_ += row->GetNumberOfRows();
+    nrows_ += nrows;
+    nrowsWithPadding_ += nrows;
     log_debug("(%s) nevents = %zu, nrows = %zu, nrowsWithPadding = %zu", name_.c_str(),
               nevents_, nrows_, nrowsWithPadding_);
 
     if (header){
       lastHeader_ = I3EventHeaderConstPtr(new I3EventHeader(*header));
-      service_.HeaderWritten(lastHeader_,row->GetNumberOfRows());
+      service_.HeaderWritten(lastHeader_,nrows);
     }
 }
 
@@ -146,7 +229,7 @@ void I3Table::Align() {
         if (padding) {
             log_trace("(%s) Finalizing alignment with %zu padding rows",name_.c_str(),padding->GetNumberOfRows());
             for (size_t r = 0; r < padding->GetNumberOfRows(); ++r) {
-              WriteRows(padding->GetSingleRow(r));
+              QueueRows(padding->GetSingleRow(r));
             }
             nrowsWithPadding_ += padding->GetNumberOfRows();
         }
@@ -155,12 +238,13 @@ void I3Table::Align() {
     // always pad the index table if it exists, since the index is always single row
     if (indexTable_) {
         padding = service_.GetPaddingRows(lastHeader_, I3EventHeaderConstPtr(), service_.GetIndexDescription());
-        if (padding) indexTable_->WriteRows(padding);
-        indexTable_->Flush();
+        if (padding) indexTable_->QueueRows(padding);
+        I3TablePtr index = indexTable_;
+        service_.RunWrite([index]{ index->Flush(); });
     }
 
     lastHeader_ = service_.GetLastHeader();
-    Flush();
+    service_.RunWrite([this]{ Flush(); });
 }
 
 /******************************************************************************/
@@ -178,6 +262,73 @@ I3TableRowConstPtr I3Table::GetRowForEvent(size_t index) const {
 
 /******************************************************************************/
 
+I3TableColumnsPtr I3Table::ReadColumns(const std::vector<std::string>& fields,
+                                       size_t firstEvent, size_t endEvent) const {
+    // project the description onto the requested fields
+    std::vector<size_t> fieldIndices;
+    I3TableRowDescriptionPtr projected(new I3TableRowDescription());
+    projected->SetIsMultiRow(description_->GetIsMultiRow());
+    const size_t nfields = fields.empty() ? description_->GetNumberOfFields() : fields.size();
+    for (size_t i = 0; i < nfields; i++) {
+        size_t index = fields.empty() ? i : description_->GetFieldColumn(fields[i]);
+        if (index >= description_->GetNumberOfFields())
+            log_fatal("(%s) Tried to read unknown field '%s'", name_.c_str(), fields[i].c_str());
+        fieldIndices.push_back(index);
+        projected->AddField(description_->GetFieldNames().at(index),
+                            description_->GetFieldTypes().at(index),
+                            description_->GetFieldUnits().at(index),
+                            description_->GetFieldDocStrings().at(index),
+                            description_->GetFieldArrayLengths().at(index));
+    }
+
+    I3TableColumnsPtr columns(new I3TableColumns(projected));
+    if (firstEvent < endEvent)
+        ReadEvents(*columns, fieldIndices, firstEvent, endEvent);
+    return columns;
+}
+
+/******************************************************************************/
+
+void I3Table::ReadEvents(I3TableColumns& columns, const std::vector<size_t>& fieldIndices,
+                         size_t firstEvent, size_t endEvent) const {
+    // events are stored in order, so their rows are contiguous
+    size_t start = GetRangeForEvent(firstEvent).first;
+    size_t stop = GetRangeForEvent(endEvent-1).second;
+    if (stop < start)
+        log_fatal("(%s) Events [%zu,%zu) are not in the table", name_.c_str(), firstEvent, endEvent);
+    columns.AddRows(stop - start);
+    ReadFields(columns, fieldIndices, start, stop - start);
+}
+
+/******************************************************************************/
+
+void I3Table::ReadFields(I3TableColumns& columns, const std::vector<size_t>& fieldIndices,
+                         size_t start, size_t nrows) const {
+    if (nrows == 0)
+        return;
+    I3TableRowConstPtr rows = ReadRows(start, nrows);
+    if (!rows)
+        log_fatal("(%s) Couldn't read rows %zu--%zu", name_.c_str(), start, start+nrows);
+    const std::vector<size_t>& sizes = description_->GetFieldSizes();
+    for (size_t i = 0; i < fieldIndices.size(); i++) {
+        const size_t size = sizes[fieldIndices[i]];
+        if (description_->IsVariableLength(fieldIndices[i])) {
+            const size_t typesize = description_->GetFieldTypeSizes()[fieldIndices[i]];
+            for (size_t r = 0; r < nrows; r++) {
+                size_t n;
+                void const* elements = rows->GetVariableLength(fieldIndices[i], r, n);
+                memcpy(columns.AddVariableLength(i, r, n), elements, n*typesize);
+            }
+            continue;
+        }
+        char* column = static_cast<char*>(columns.GetPointerToColumn(i));
+        for (size_t r = 0; r < nrows; r++)
+            memcpy(column + r*size, rows->GetPointerToField(fieldIndices[i], r), size);
+    }
+}
+
+/******************************************************************************/
+
 std::pair<size_t,size_t> I3Table::GetRangeForEvent(size_t index) const {
     log_fatal("This table is write-only.");
     return std::pair<size_t,size_t>();
@@ -214,7 +365,10 @@ std::string I3Table::GetName() const {
 /******************************************************************************/
 
 I3TableRowPtr I3Table::CreateRow(size_t nrows) {
-    return I3TableRowPtr( new I3TableRow(description_, nrows) );
+    // tables that are read back only get their description later
+    if (!rowPool_)
+        rowPool_ = I3TableRowPoolPtr(new I3TableRowPool(description_));
+    return rowPool_->GetRows(nrows);
 }
 
 /******************************************************************************/
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <cstring>
+
+#include "tableio/I3TableColumns.h"
+#include "tableio/I3TableRow.h"
+
+/******************************************************************************/
+
+I3TableColumns::I3TableColumns(I3TableRowDescriptionConstPtr description,
+                               size_t nrows) :
+    description_(description),
+    columns_(description->GetNumberOfFields()),
+    values_(description->GetNumberOfFields()),
+    nrows_(0)
+{
+    AddRows(nrows);
+}
+
+/******************************************************************************/
+
+size_t I3TableColumns::AddRows(size_t nrows) {
+    const size_t start = nrows_;
+    const std::vector<size_t>& sizes = description_->GetFieldSizes();
+    nrows_ += nrows;
+    // std::vector grows geometrically and zeroes the new elements
+    for (size_t i = 0; i < columns_.size(); ++i)
+        columns_[i].resize(nrows_*sizes[i]);
+    return start;
+}
+
+/******************************************************************************/
+
+void I3TableColumns::reserve(size_t nrows) {
+    const std::vector<size_t>& sizes = description_->GetFieldSizes();
+    for (size_t i = 0; i < columns_.size(); ++i)
+        columns_[i].reserve(nrows*sizes[i]);
+}
+
+/******************************************************************************/
+
+void I3TableColumns::clear() {
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        columns_[i].clear();
+        values_[i].clear();
+    }
+    nrows_ = 0;
+}
+
+/******************************************************************************/
+
+size_t I3TableColumns::GetIndex(const std::string& fieldName) const {
+    size_t index = description_->GetFieldColumn(fieldName);
+    if (index >= description_->GetNumberOfFields())
+        log_fatal("Tried to get unknown column '%s'", fieldName.c_str());
+    return index;
+}
+
+/******************************************************************************/
+
+void* I3TableColumns::GetPointerToColumn(size_t index) {
+    return columns_.at(index).data();
+}
+
+void const* I3TableColumns::GetPointerToColumn(size_t index) const {
+    return columns_.at(index).data();
+}
+
+/******************************************************************************/
+
+void* I3TableColumns::AddVariableLength(size_t index, size_t row, size_t n) {
+    if (!description_->IsVariableLength(index))
+        log_fatal("Field '%s' does not have a variable length",
+                  description_->GetFieldNames().at(index).c_str());
+    if (row >= nrows_)
+        log_fatal("Row %zu is not in [0,%zu)", row, nrows_);
+    const size_t typesize = description_->GetFieldTypeSizes()[index];
+    std::vector<char>& values = values_[index];
+    I3VariableLengthSlot& slot = static_cast<I3VariableLengthSlot*>(GetPointerToColumn(index))[row];
+    slot.offset = values.size()/typesize;
+    slot.length = n;
+    values.resize(values.size() + n*typesize);
+    return values.data() + slot.offset*typesize;
+}
+
+void const* I3TableColumns::GetVariableLength(size_t index, size_t row, size_t& n) const {
+    if (!description_->IsVariableLength(index))
+        log_fatal("Field '%s' does not have a variable length",
+                  description_->GetFieldNames().at(index).c_str());
+    if (row >= nrows_)
+        log_fatal("Row %zu is not in [0,%zu)", row, nrows_);
+    const I3VariableLengthSlot& slot =
+        static_cast<const I3VariableLengthSlot*>(GetPointerToColumn(index))[row];
+    n = slot.length;
+    return values_[index].data() + slot.offset*description_->GetFieldTypeSizes()[index];
+}
+
+/******************************************************************************/
+
+void I3TableColumns::append(const I3TableRow& rows) {
+    SetRows(AddRows(rows.GetNumberOfRows()), rows);
+}
+
+/******************************************************************************/
+
+void I3TableColumns::SetRows(size_t start, const I3TableRow& rows) {
+    if (rows.GetDescription()->GetTotalByteSize() != description_->GetTotalByteSize())
+        log_fatal("Can't set rows with a different description.");
+    if (start + rows.GetNumberOfRows() > nrows_)
+        log_fatal("Rows [%zu,%zu) are not in [0,%zu)", start, start + rows.GetNumberOfRows(), nrows_);
+    const std::vector<size_t>& sizes = description_->GetFieldSizes();
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        char* column = columns_[i].data() + start*sizes[i];
+        if (description_->IsVariableLength(i)) {
+            const size_t typesize = description_->GetFieldTypeSizes()[i];
+            for (size_t r = 0; r < rows.GetNumberOfRows(); ++r) {
+                size_t n;
+                void const* elements = rows.GetVariableLength(i, r, n);
+                memcpy(AddVariableLength(i, start + r, n), elements, n*typesize);
+            }
+            continue;
+        }
+        for (size_t r = 0; r < rows.GetNumberOfRows(); ++r)
+            memcpy(column + r*sizes[i], rows.GetPointerToField(i, r), sizes[i]);
+    }
+}
+
+/******************************************************************************/
+
+void I3TableColumns::Broadcast(const I3TableRow& row, size_t start, size_t nrows,
+                               size_t firstField, size_t endField) {
+    if (start + nrows > nrows_)
+        log_fatal("Rows [%zu,%zu) are not in [0,%zu)", start, start + nrows, nrows_);
+    const std::vector<size_t>& sizes = description_->GetFieldSizes();
+    for (size_t i = firstField; i < endField; ++i) {
+        if (description_->IsVariableLength(i))
+            log_fatal("Can't broadcast the variable-length field '%s'",
+                      description_->GetFieldNames().at(i).c_str());
+        void const* value = row.GetPointerToField(i, row.GetCurrentRow());
+        char* column = columns_.at(i).data() + start*sizes[i];
+        for (size_t r = 0; r < nrows; ++r)
+            memcpy(column + r*sizes[i], value, sizes[i]);
+    }
+}
+
+/******************************************************************************/
+
+I3TableRowPtr I3TableColumns::GetRows(size_t start, size_t nrows) const {
+    if (start + nrows > nrows_)
+        log_fatal("Rows [%zu,%zu) are not in [0,%zu)", start, start + nrows, nrows_);
+    I3TableRowPtr rows(new I3TableRow(description_, nrows));
+    const std::vector<size_t>& sizes = description_->GetFieldSizes();
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        if (description_->IsVariableLength(i)) {
+            const size_t typesize = description_->GetFieldTypeSizes()[i];
+            for (size_t r = 0; r < nrows; ++r) {
+                size_t n;
+                void const* elements = GetVariableLength(i, start + r, n);
+                memcpy(rows->AddVariableLength(i, r, n), elements, n*typesize);
+            }
+            continue;
+        }
+        const char* column = columns_[i].data() + start*sizes[i];
+        for (size_t r = 0; r < nrows; ++r)
+            memcpy(rows->GetPointerToField(i, r), column + r*sizes[i], sizes[i]);
+    }
+    return rows;
+}
+
+/******************************************************************************/
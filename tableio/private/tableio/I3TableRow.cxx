@@ -9,7 +9,9 @@
  * @author Eike Middell <eike.middell@desy.de> Last changed by: $LastChangedBy$
  */
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 #include "tableio/I3TableRow.h"
 
@@ -22,6 +24,10 @@ void I3TableRow::init() {
 
     // initialize memory block with zeros
     memset(data_, 0, I3MEMORYCHUNK_SIZE*totalChunkSize);
+
+    // the elements of variable-length fields live outside the rows
+    if (description_->HasVariableLengthFields())
+        values_.resize(description_->GetNumberOfFields());
 }
 
 /******************************************************************************/
@@ -88,6 +94,13 @@ void I3TableRow::erase(size_t nrows) {
     memset( &data_[(nrows_-nrows) * description_->GetTotalChunkSize()], 0, doomed_block_size );
     // decrement the container size
     nrows_ -= nrows;
+
+    // drop the elements of the erased rows
+    if (!values_.empty()) {
+        std::vector<std::vector<char> > old(values_.size());
+        old.swap(values_);
+        CopyVariableLength(old, 0, nrows_);
+    }
 }
 
 /******************************************************************************/
@@ -101,7 +114,10 @@ void I3TableRow::append(const I3TableRow& rhs) {
     }
     memcpy( &data_[index], rhs.GetPointer(), bytes_to_write);
 
+    const size_t first = nrows_;
     nrows_ = required_rows;
+    if (!values_.empty())
+        CopyVariableLength(rhs.values_, first, rhs.GetNumberOfRows());
 }
 
 /******************************************************************************/
@@ -117,6 +133,7 @@ I3TableRow::I3TableRow(const I3TableRow& rhs) {
     size_t totalByteSize = nrows_*rhs.GetDescription()->GetTotalByteSize();
     data_ = new I3MemoryChunk[totalChunkSize];
     memcpy( data_, rhs.GetPointer(), totalByteSize );
+    values_ = rhs.values_;
 }
 
 /******************************************************************************/
@@ -134,6 +151,10 @@ I3TableRow::I3TableRow(const I3TableRow& rhs, size_t start, size_t stop) {
     size_t totalByteSize = nrows_*rhs.GetDescription()->GetTotalByteSize();
     data_ = new I3MemoryChunk[totalChunkSize];
     memcpy( data_, rhs.GetPointerToRow(start), totalByteSize );
+    if (!rhs.values_.empty()) {
+        values_.resize(rhs.values_.size());
+        CopyVariableLength(rhs.values_, 0, nrows_);
+    }
 }
 
 
@@ -154,6 +175,7 @@ I3TableRow& I3TableRow::operator=(const I3TableRow& rhs) {
     nrows_ = rhs.GetNumberOfRows();
     capacity_ = nrows_;
     currentRow_ = 0;
+    values_ = rhs.values_;
     return *this;
 }
 
@@ -185,6 +207,56 @@ void* I3TableRow::GetPointerToField(size_t index, size_t row) {
 
 /******************************************************************************/
 
+size_t I3TableRow::GetVariableLengthIndex(const std::string& fieldName) const {
+    size_t index = description_->GetFieldColumn(fieldName);
+    if (index >= description_->GetNumberOfFields())
+        log_fatal("Tried to get unknown field '%s'",fieldName.c_str());
+    return index;
+}
+
+void* I3TableRow::AddVariableLength(size_t index, size_t row, size_t n) {
+    if (!description_->IsVariableLength(index))
+        log_fatal("Field '%s' does not have a variable length",
+                  description_->GetFieldNames().at(index).c_str());
+    const size_t typesize = description_->GetFieldTypeSizes()[index];
+    std::vector<char>& values = values_[index];
+    I3VariableLengthSlot* slot = static_cast<I3VariableLengthSlot*>(GetPointerToField(index, row));
+    slot->offset = values.size()/typesize;
+    slot->length = n;
+    values.resize(values.size() + n*typesize);
+    return values.data() + slot->offset*typesize;
+}
+
+void const* I3TableRow::GetVariableLength(size_t index, size_t row, size_t& n) const {
+    if (!description_->IsVariableLength(index))
+        log_fatal("Field '%s' does not have a variable length",
+                  description_->GetFieldNames().at(index).c_str());
+    const I3VariableLengthSlot* slot =
+        static_cast<const I3VariableLengthSlot*>(GetPointerToField(index, row));
+    n = slot->length;
+    return values_[index].data() + slot->offset*description_->GetFieldTypeSizes()[index];
+}
+
+// The slots of the rows still point into the buffers they were copied from
+void I3TableRow::CopyVariableLength(const std::vector<std::vector<char> >& from,
+                                    size_t first, size_t nrows) {
+    const std::vector<size_t>& typeSizes = description_->GetFieldTypeSizes();
+    for (size_t i = 0; i < values_.size(); i++) {
+        if (!description_->IsVariableLength(i))
+            continue;
+        const size_t typesize = typeSizes[i];
+        std::vector<char>& values = values_[i];
+        for (size_t row = first; row < first + nrows; row++) {
+            I3VariableLengthSlot* slot = static_cast<I3VariableLengthSlot*>(GetPointerToField(i, row));
+            const char* elements = from.at(i).data() + slot->offset*typesize;
+            slot->offset = values.size()/typesize;
+            values.insert(values.end(), elements, elements + slot->length*typesize);
+        }
+    }
+}
+
+/******************************************************************************/
+
 I3TableRowDescriptionConstPtr I3TableRow::GetDescription() const {
     return description_;
 }
@@ -203,10 +275,28 @@ void I3TableRow::SetNumberOfRows(size_t nrows) {
     if (nrows_ == nrows)
         return;
 
+    reset(nrows);
+}
+
+/******************************************************************************/
+
+void I3TableRow::reset(size_t nrows) {
+    i3_assert(description_);
+
+    if (nrows > capacity_) {
+        // grow geometrically, so that a recycled buffer settles at the
+        // largest size it is asked for
+        delete[] data_;
+        capacity_ = std::max(nrows, 2*capacity_);
+        init();
+    } else {
+        memset(data_, 0, nrows*description_->GetTotalByteSize());
+    }
+    for (size_t i = 0; i < values_.size(); i++)
+        values_[i].clear();
     nrows_ = nrows;
     currentRow_ = 0;
-    delete[] data_;
-    init();
+    enums_are_ints_ = false;
 }
 
 /******************************************************************************/
@@ -228,6 +318,8 @@ size_t I3TableRow::GetCurrentRow() const {
 I3TableRowPtr I3TableRow::GetSingleRow(size_t row) const {
     I3TableRowPtr result(new I3TableRow(description_, 1));
     memcpy(result->data_, &data_[row*description_->GetTotalChunkSize()], description_->GetTotalByteSize());
+    if (!values_.empty())
+        result->CopyVariableLength(values_, 0, 1);
     return result;
 }
 
@@ -10,6 +10,7 @@
  */
 
 #include "tableio/I3TableRowDescription.h"
+#include <algorithm>
 #include <numeric>
 
 /******************************************************************************/
@@ -70,6 +71,17 @@ size_t I3TableRowDescription::GetFieldColumn(const std::string& fieldName) const
 
 /******************************************************************************/
 
+bool I3TableRowDescription::IsVariableLength(size_t index) const {
+    return fieldArrayLengths_.at(index) == 0;
+}
+
+bool I3TableRowDescription::HasVariableLengthFields() const {
+    return std::find(fieldArrayLengths_.begin(), fieldArrayLengths_.end(), 0u)
+        != fieldArrayLengths_.end();
+}
+
+/******************************************************************************/
+
 bool I3TableRowDescription::CanBeFilledInto(I3TableRowDescriptionConstPtr other) const {
     size_t nfields = GetNumberOfFields();
     bool compatible = true;
@@ -145,6 +157,14 @@ AlignOffset(size_t offset, size_t size)
 		return (offset + align) & ~(align-1);
 }
 
+// The slots of variable-length fields hold 64-bit integers, whatever
+// the type of their elements
+static size_t
+FieldAlignment(size_t typesize, size_t arrayLength)
+{
+	return arrayLength == 0 ? sizeof(uint64_t) : typesize;
+}
+
 /******************************************************************************/
 
 void I3TableRowDescription::AddField(const std::string& name, I3Datatype type,
@@ -153,7 +173,7 @@ void I3TableRowDescription::AddField(const std::string& name, I3Datatype type,
 
     size_t byteOffset=0;
     if (fieldByteOffsets_.size() > 0) {
-        byteOffset = AlignOffset(GetNextOffset(), type.size);
+        byteOffset = AlignOffset(GetNextOffset(), FieldAlignment(type.size, arrayLength));
     }
     size_t nfields = fieldNameToIndex_.size();
     fieldNames_.push_back(name);
@@ -169,7 +189,7 @@ void I3TableRowDescription::AddField(const std::string& name, I3Datatype type,
 
     fieldTypeSizes_.push_back(type.size);
     fieldArrayLengths_.push_back(arrayLength);
-    fieldSizes_.push_back(type.size*arrayLength);
+    fieldSizes_.push_back(arrayLength == 0 ? sizeof(I3VariableLengthSlot) : type.size*arrayLength);
     fieldByteOffsets_.push_back(byteOffset);
     fieldUnits_.push_back(unit);
     fieldDocStrings_.push_back(doc);
@@ -211,7 +231,8 @@ I3TableRowDescription& operator<<(I3TableRowDescription& lhs,
 	size_t typesize = rhs.fieldTypeSizes_.at(i);
 	size_t byteOffset = 0;
         if (lhs.GetNumberOfFields() > 0)
-          byteOffset = AlignOffset(lhs.GetNextOffset(), typesize);
+          byteOffset = AlignOffset(lhs.GetNextOffset(),
+                                   FieldAlignment(typesize, rhs.fieldArrayLengths_.at(i)));
 
         lhs.isMultiRow_ = (lhs.isMultiRow_ || rhs.isMultiRow_);
 
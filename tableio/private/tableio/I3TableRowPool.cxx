@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "tableio/I3TableRowPool.h"
+#include "tableio/I3TableRow.h"
+
+/******************************************************************************/
+
+// the deleter of the rows handed out by the pool
+struct I3TableRowPool::Recycler {
+    boost::weak_ptr<I3TableRowPool> pool;
+
+    void operator()(I3TableRow* rows) const {
+        if (I3TableRowPoolPtr p = pool.lock())
+            p->Release(rows);
+        else
+            delete rows;
+    }
+};
+
+/******************************************************************************/
+
+I3TableRowPool::I3TableRowPool(I3TableRowDescriptionConstPtr description,
+                               size_t maxSize) :
+    description_(description),
+    maxSize_(maxSize)
+{
+    free_.reserve(maxSize_);
+}
+
+/******************************************************************************/
+
+I3TableRowPool::~I3TableRowPool() {
+    for (size_t i = 0; i < free_.size(); ++i)
+        delete free_[i];
+}
+
+/******************************************************************************/
+
+I3TableRowPtr I3TableRowPool::GetRows(size_t nrows) {
+    I3TableRow* rows = NULL;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            rows = free_.back();
+            free_.pop_back();
+        }
+    }
+    if (rows)
+        rows->reset(nrows);
+    else
+        rows = new I3TableRow(description_, nrows);
+
+    Recycler recycler;
+    recycler.pool = shared_from_this();
+    return I3TableRowPtr(rows, recycler);
+}
+
+/******************************************************************************/
+
+void I3TableRowPool::Release(I3TableRow* rows) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.size() < maxSize_) {
+            free_.push_back(rows);
+            return;
+        }
+    }
+    delete rows;
+}
+
+/******************************************************************************/
+
+size_t I3TableRowPool::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return free_.size();
+}
+
+/******************************************************************************/
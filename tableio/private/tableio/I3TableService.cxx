@@ -15,7 +15,8 @@
 
 /******************************************************************************/
 
-I3TableService::I3TableService()  {
+I3TableService::I3TableService() :
+    maxQueueLength_(0), writing_(false), stopWriter_(false) {
     // Set up a semi-sensible default
     SetIndexConverter(I3ConverterPtr(new I3IndexColumnsGenerator));
 }
@@ -43,6 +44,8 @@ I3TablePtr I3TableService::GetTable(std::string name,
        table = it->second;
     } else if (description) {
        // create table if description is not NULL
+      // backends are not touched from two threads at once
+      WaitForWrites();
       table = CreateTable(name,description);
       tables_[name] = table;
     }
@@ -191,6 +194,125 @@ I3TableRowConstPtr I3TableService::GetPaddingRows(I3EventHeaderConstPtr lastHead
 
 /******************************************************************************/
 
+void I3TableService::SetBackgroundWriting(size_t queueLength) {
+    if (queueLength == 0) {
+        StopWriter();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        maxQueueLength_ = queueLength;
+    }
+    writeQueued_.notify_all();
+    if (!writer_.joinable()) {
+        stopWriter_ = false;
+        writer_ = std::thread([this]{ WriterLoop(); });
+    }
+}
+
+/******************************************************************************/
+
+bool I3TableService::WritesInBackground() const {
+    return writer_.joinable();
+}
+
+/******************************************************************************/
+
+void I3TableService::RunWrite(const std::function<void()>& write) {
+    if (!writer_.joinable()) {
+        write();
+        return;
+    }
+    std::unique_lock<std::mutex> lock(writeMutex_);
+    writeDone_.wait(lock, [this]{ return writeQueue_.size() < maxQueueLength_ || writeError_; });
+    RethrowWriteError();
+    writeQueue_.push_back(write);
+    writeQueued_.notify_one();
+}
+
+/******************************************************************************/
+
+void I3TableService::WaitForWrites() {
+    if (!writer_.joinable())
+        return;
+    std::unique_lock<std::mutex> lock(writeMutex_);
+    writeDone_.wait(lock, [this]{ return (writeQueue_.empty() && !writing_) || writeError_; });
+    RethrowWriteError();
+}
+
+/******************************************************************************/
+
+// must be called with writeMutex_ held
+void I3TableService::RethrowWriteError() {
+    if (writeError_) {
+        // report the error once, and drop the writes that depended on it
+        std::exception_ptr error = writeError_;
+        writeError_ = std::exception_ptr();
+        writeQueue_.clear();
+        std::rethrow_exception(error);
+    }
+}
+
+/******************************************************************************/
+
+void I3TableService::WriterLoop() {
+    std::unique_lock<std::mutex> lock(writeMutex_);
+    while (true) {
+        writeQueued_.wait(lock, [this]{ return stopWriter_ || !writeQueue_.empty(); });
+        if (writeQueue_.empty())
+            break;
+        std::function<void()> write = std::move(writeQueue_.front());
+        writeQueue_.pop_front();
+        writing_ = true;
+        lock.unlock();
+        // the queue has room again
+        writeDone_.notify_all();
+        std::exception_ptr error;
+        try {
+            write();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+        writing_ = false;
+        if (error) {
+            writeError_ = error;
+            writeQueue_.clear();
+        }
+        writeDone_.notify_all();
+    }
+}
+
+/******************************************************************************/
+
+void I3TableService::StopWriter() {
+    if (!writer_.joinable())
+        return;
+    {
+        // the writer finishes the queue before it stops
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        stopWriter_ = true;
+    }
+    writeQueued_.notify_all();
+    writer_.join();
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    RethrowWriteError();
+}
+
+/******************************************************************************/
+
+void I3TableService::JoinWriter() {
+    try {
+        StopWriter();
+    } catch (const std::exception& e) {
+        log_error("A background table write failed: %s", e.what());
+    } catch (...) {
+        log_error("A background table write failed.");
+    }
+}
+
+/******************************************************************************/
+
 void I3TableService::Finish() {
     bool finished = true;
     std::map<std::string, I3TablePtr>::iterator table_it = tables_.begin();
@@ -200,21 +322,39 @@ void I3TableService::Finish() {
             finished = false;
             break;
         } else {
-            table_it->second->Flush();
+            I3TablePtr table = table_it->second;
+            RunWrite([table]{ table->Flush(); });
         }
         log_debug("In Finish, about to do a final align on %s", table_it->second->GetName().c_str());
         table_it->second->Align();
     }
+    WaitForWrites();
     tables_.clear();
 
     /* Only close the file if all the tables are disconnected. */
     if (finished) {
         tables_.clear();
+        StopWriter();
         CloseFile();
     }
 }
 
 I3TableService::~I3TableService() {
+    // the backend is gone, so whatever is still queued can't be written
+    if (writer_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            if (!writeQueue_.empty())
+                log_error("Dropping %zu table writes. Table services that write in the "
+                          "background must call JoinWriter() in their destructor.",
+                          writeQueue_.size());
+            writeQueue_.clear();
+            stopWriter_ = true;
+        }
+        writeQueued_.notify_all();
+        writer_.join();
+    }
+
     std::map<std::string, I3TablePtr>::iterator table_it = tables_.begin();
 
     for ( ; table_it != tables_.end(); ++table_it) {
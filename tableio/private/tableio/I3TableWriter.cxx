@@ -17,6 +17,8 @@
 #include "tableio/converter/I3IndexColumnsGenerator.h"
 #include <icetray/name_of.h>
 
+#include <algorithm>
+
 #include <boost/foreach.hpp>
 #include <boost/make_shared.hpp>
 
@@ -35,7 +37,7 @@ inline I3FrameObjectConstPtr GetFrameObject(I3FramePtr frame, std::string name)
 /******************************************************************************/
 
 I3TableWriter::I3TableWriter(I3TableServicePtr service, std::vector<I3ConverterMillPtr>& converters,
-    std::vector<std::string>& streams) : streams_(streams) {
+    std::vector<std::string>& streams) : streams_(streams), batchSize_(1) {
     service_ = service;
     boost::shared_ptr<I3IndexColumnsGenerator> indexer =
         boost::make_shared<I3IndexColumnsGenerator>(streams_);
@@ -53,6 +55,13 @@ I3TableWriter::~I3TableWriter() {};
 
 /******************************************************************************/
 
+void I3TableWriter::SetBatchSize(size_t batchSize) {
+    FlushBatch();
+    batchSize_ = std::max(batchSize, size_t(1));
+}
+
+/******************************************************************************/
+
 template <typename T>
 std::string name_of(const boost::shared_ptr<T> obj) {
     return icetray::name_of(typeid(*(obj.get())));
@@ -60,43 +69,58 @@ std::string name_of(const boost::shared_ptr<T> obj) {
 
 /******************************************************************************/
 
-// Search the converter cache for a converter that says it can handle obj
-// raise an error and if more than one answers the call (there can be only one highlander)
+// Objects created in Python may be instances of Python subclasses, which
+// share the C++ type with their base, so their type says nothing about what
+// converters and isinstance() think of them.
+inline bool TypeDecidesConversion(I3FrameObjectConstPtr obj)
+{
+    return !boost::get_deleter<boost::python::converter::shared_ptr_deleter>(obj);
+}
+
+/******************************************************************************/
+
+// Get a converter for obj, asking the converter cache only once per type
 I3ConverterPtr I3TableWriter::FindConverter(I3FrameObjectConstPtr obj) {
-    I3ConverterPtr converter_ptr;
-    std::vector<I3ConverterMillPtr>::const_iterator it_conv;
-    // Look for an exact match
-    log_trace("Searching for an exact conversion");
-    for(it_conv = converterCache_.begin(); it_conv != converterCache_.end(); it_conv++) {
-        I3ConverterPtr conv = (*(*it_conv))();
-        log_trace("Asking converter '%s' what it thinks of '%s'",name_of(conv).c_str(),name_of(obj).c_str());
-        bool match = conv->CanConvert(obj)==I3Converter::ExactConversion;
-        if (match && (converter_ptr != NULL)) {
-            log_fatal("Ambiguity in the converter registry. Converters '%s' and '%s' both want to handle '%s'",
-                        name_of(converter_ptr).c_str(),name_of(conv).c_str(),name_of(obj).c_str());
-        } else if (match) {
-            log_trace("Converter '%s' can exactly convert '%s'",name_of(conv).c_str(),name_of(obj).c_str());
-            converter_ptr = conv;
-        }
+    if (!TypeDecidesConversion(obj)) {
+        I3ConverterMillPtr mill = FindConverterMill(obj);
+        return mill ? (*mill)() : I3ConverterPtr();
     }
-    // If we found a direct match, return it.
-    if(converter_ptr)
-        return converter_ptr;
-    // Otherwise, look for an inexact match
-    log_trace("Searching for an inexact conversion");
-    for(it_conv = converterCache_.begin(); it_conv != converterCache_.end(); it_conv++) {
-        I3ConverterPtr conv = (*(*it_conv))();
-        log_trace("Asking converter '%s' what it thinks of '%s'",name_of(conv).c_str(),name_of(obj).c_str());
-        bool match = conv->CanConvert(obj)==I3Converter::InexactConversion;
-        if (match && (converter_ptr != NULL)) {
-            log_fatal("Ambiguity in the converter registry. Converters '%s' and '%s' both want to handle '%s'",
-                      name_of(converter_ptr).c_str(),name_of(conv).c_str(),name_of(obj).c_str());
-        } else if (match) {
-            log_trace("Converter '%s' can inexactly convert '%s'",name_of(conv).c_str(),name_of(obj).c_str());
-            converter_ptr = conv;
+    const std::type_index type(typeid(*obj));
+    std::unordered_map<std::type_index, I3ConverterMillPtr>::iterator mill_it =
+        converterMills_.find(type);
+    if (mill_it == converterMills_.end())
+        mill_it = converterMills_.insert(std::make_pair(type, FindConverterMill(obj))).first;
+    if (!mill_it->second)
+        return I3ConverterPtr();
+    // every table gets its own converter
+    return (*mill_it->second)();
+}
+
+/******************************************************************************/
+
+// Search the converter cache for a converter that says it can handle obj
+// raise an error and if more than one answers the call (there can be only one highlander)
+I3ConverterMillPtr I3TableWriter::FindConverterMill(I3FrameObjectConstPtr obj) {
+    const I3Converter::ConvertState states[2] =
+        {I3Converter::ExactConversion, I3Converter::InexactConversion};
+    for (int i = 0; i < 2; i++) {
+        log_trace("Searching for an %s conversion", i == 0 ? "exact" : "inexact");
+        I3ConverterMillPtr mill_ptr;
+        std::vector<I3ConverterMillPtr>::const_iterator it_conv;
+        for(it_conv = converterCache_.begin(); it_conv != converterCache_.end(); it_conv++) {
+            bool match = (*it_conv)->CanConvert(obj)==states[i];
+            if (match && (mill_ptr != NULL)) {
+                log_fatal("Ambiguity in the converter registry. Converters '%s' and '%s' both want to handle '%s'",
+                          name_of((*mill_ptr)()).c_str(),name_of((**it_conv)()).c_str(),name_of(obj).c_str());
+            } else if (match) {
+                mill_ptr = *it_conv;
+            }
         }
+        // If we found a match, return it.
+        if (mill_ptr)
+            return mill_ptr;
     }
-    return converter_ptr;
+    return I3ConverterMillPtr();
 }
 
 /******************************************************************************/
@@ -188,6 +212,10 @@ bool I3TableWriter::AddObject(std::string name, std::string tableName, I3Frame::
        TableBundle bundle;
        bundle.converter = converter;
        bundle.table = table;
+       if (table->PrefersColumns())
+           bundle.columns = I3TableColumnsPtr(new I3TableColumns(table->GetDescription()));
+       bundle.indexRow = table->CreateRow(1);
+       bundle.batchRows = 0;
 
       tlist_it->second.push_back(bundle);
    }
@@ -211,6 +239,7 @@ void I3TableWriter::AddObject(std::string objName, TableSpec spec) {
 /******************************************************************************/
 
 void I3TableWriter::AddType(TypeSpec type, TableSpec spec) {
+	typeMatches_.clear();
 	typespec_map::iterator t_it = wantedTypes_.find(type);
 	if (t_it == wantedTypes_.end()) {
 		wantedTypes_[type] = std::vector<TableSpec>(1,spec);
@@ -233,6 +262,56 @@ void I3TableWriter::Setup() {
 
 /******************************************************************************/
 
+// The entries of wantedTypes_ that want obj, checked once per type
+std::vector<I3TableWriter::typespec_map::const_iterator>
+I3TableWriter::GetTypeMatches(I3FrameObjectConstPtr obj) {
+    const bool cacheable = TypeDecidesConversion(obj);
+    const std::type_index type(typeid(*obj));
+    if (cacheable) {
+        std::unordered_map<std::type_index, std::vector<typespec_map::const_iterator> >::const_iterator
+            cached = typeMatches_.find(type);
+        if (cached != typeMatches_.end())
+            return cached->second;
+    }
+
+    std::vector<typespec_map::const_iterator> matches;
+    typespec_map::const_iterator typelist_it;
+    for (typelist_it = wantedTypes_.begin(); typelist_it != wantedTypes_.end(); ++typelist_it) {
+        log_trace("Checking type of '%s'",name_of(obj).c_str());
+        if (typelist_it->first.check(obj))
+            matches.push_back(typelist_it);
+    }
+    if (cacheable)
+        typeMatches_[type] = matches;
+    return matches;
+}
+
+/******************************************************************************/
+
+// Get the object for a booked key, turning it into an I3RecoPulseSeriesMap
+// if that is what the frame would do. Whether it has to be turned is only
+// worked out again when the type of the object changes.
+I3FrameObjectConstPtr I3TableWriter::GetObject(I3FramePtr frame, ObjectPlan& plan) {
+    const std::string& objName = plan.tables->first;
+    I3FrameObjectConstPtr object = frame->Get<I3FrameObjectConstPtr>(objName);
+    if (!object)
+        return object;
+
+    const std::type_index type(typeid(*object));
+    if (type != plan.type) {
+        I3FrameObjectConstPtr pulses = GetFrameObject(frame, objName);
+        plan.type = type;
+        plan.asPulses = (pulses != object);
+        return pulses;
+    } else if (plan.asPulses) {
+        return frame->Get<I3RecoPulseSeriesMapConstPtr>(objName);
+    } else {
+        return object;
+    }
+}
+
+/******************************************************************************/
+
 const std::string I3TableWriter::GetTypeName(I3FramePtr frame, const std::string& key) {
 	std::string typeName;
 	try {
@@ -288,7 +367,6 @@ void I3TableWriter::Convert(I3FramePtr frame) {
   }
 
     tablespec_map::iterator vlist_it;
-    typespec_map::iterator typelist_it;
     std::vector<TableSpec>::iterator v_it;
     std::vector<std::string>::const_iterator k_it;
     std::map<std::string, std::vector<TableBundle> >::iterator tlist_it;
@@ -370,18 +448,17 @@ void I3TableWriter::Convert(I3FramePtr frame) {
             continue;
          }
 
-         // for every type in wantedTypes_ ...
-         for (typelist_it = wantedTypes_.begin(); typelist_it != wantedTypes_.end(); ++typelist_it) {
-             const TypeSpec& typeSpec = typelist_it->first;
-
-             log_trace("Checking type of '%s'",objName.c_str());
-             if ( typeSpec.check(object) ) {
-                selected = true;
-                for (v_it = typelist_it->second.begin(); v_it != typelist_it->second.end(); v_it++) {
-                  AddObject(objName, v_it->tableName, frame_stop, v_it->converter, object);
+         // for every type in wantedTypes_ that wants the object ...
+         if (object) {
+            const std::vector<typespec_map::const_iterator> matches = GetTypeMatches(object);
+            selected = !matches.empty();
+            BOOST_FOREACH(typespec_map::const_iterator typelist_it, matches) {
+                std::vector<TableSpec>::const_iterator spec_it;
+                for (spec_it = typelist_it->second.begin(); spec_it != typelist_it->second.end(); spec_it++) {
+                  AddObject(objName, spec_it->tableName, frame_stop, spec_it->converter, object);
                 }
-             } // if (typeName == objTypeName)
-         } // for (typelist_it
+            }
+         }
 
          if (!selected) {
              uselessKeys_.insert(objName);
@@ -390,8 +467,32 @@ void I3TableWriter::Convert(I3FramePtr frame) {
        } // for (k_it
     } // if wantedTypes_.size() > 0
 
+    // one plan per booked key, in the order of tables_
+    if (plans_.size() != tables_.size()) {
+        plans_.clear();
+        for(tlist_it = tables_.begin(); tlist_it != tables_.end(); ++tlist_it) {
+            plans_.push_back(ObjectPlan());
+            plans_.back().tables = tlist_it;
+        }
+    }
+
+    // physics frames are batched, everything else is converted right away,
+    // after the frames before it
+    const bool batched = (batchSize_ > 1) && (frame_stop == I3Frame::Physics);
+    if (batched) {
+        batch_.push_back(BatchedFrame());
+        batch_.back().frame = frame;
+        batch_.back().header = header;
+    } else {
+        FlushBatch();
+    }
+
     // now walk through tables_ and convert what is there
-    for(tlist_it = tables_.begin(); tlist_it != tables_.end(); ++tlist_it) {
+    BOOST_FOREACH(ObjectPlan& plan, plans_) {
+        tlist_it = plan.tables;
+        // the object is fetched once for all its tables
+        I3FrameObjectConstPtr obj;
+        bool fetched = false;
         for(t_it = tlist_it->second.begin(); t_it!= tlist_it->second.end(); ++t_it) {
 
             const std::string& objName = tlist_it->first;
@@ -409,9 +510,12 @@ void I3TableWriter::Convert(I3FramePtr frame) {
                       bundle.table->GetDescription()->GetNumberOfFields(),
                       bundle.table->GetDescription()->GetFieldNames().at(0).c_str(),
                       bundle.table->GetDescription()->GetFieldNames().at(bundle.table->GetDescription()->GetNumberOfFields()-1).c_str());
-            I3FrameObjectConstPtr obj = GetFrameObject(frame, objName);
+            if (!fetched) {
+                obj = GetObject(frame, plan);
+                fetched = true;
+            }
             if (!obj)
-                continue;
+                break;
 
             try {
                 nrows = bundle.converter->GetNumberOfRows(obj);
@@ -423,7 +527,41 @@ void I3TableWriter::Convert(I3FramePtr frame) {
 
             // ask the converter how many rows he will write
             // skip the object if there is nothing to be written
-            if (nrows != 0) {
+            if (nrows != 0 && batched) {
+
+                // keep the object until the batch is converted
+                t_it->batchObjects.push_back(obj);
+                t_it->batchFrames.push_back(frame);
+                t_it->batchRows += nrows;
+                BatchedObject batchedObject;
+                batchedObject.tables = tlist_it;
+                batchedObject.bundle = t_it - tlist_it->second.begin();
+                batchedObject.nrows = nrows;
+                batch_.back().objects.push_back(batchedObject);
+
+            } else if (nrows != 0 && bundle.columns) {
+
+                // column-oriented tables get the rows column by column
+                bundle.columns->clear();
+                bundle.columns->AddRows(nrows);
+                size_t rowsWritten = bundle.converter->ConvertColumns(
+                    std::vector<I3FrameObjectConstPtr>(1, obj), *bundle.columns,
+                    std::vector<I3FramePtr>(1, frame));
+                i3_assert(rowsWritten == nrows);
+
+                if (frame_stop==I3Frame::Physics){
+                  // the table index columns are the same for all rows
+                  I3TableRow& index = *bundle.indexRow;
+                  ticConverter_->Convert(header, bundle.indexRow, frame);
+                  index.Set<bool>("exists", true);
+                  bundle.columns->Broadcast(index, 0, nrows, 0,
+                      ticConverter_->GetDescription()->GetNumberOfFields());
+                }
+
+                bundle.table->AddColumns(std::vector<I3EventHeaderConstPtr>(1, header),
+                                         std::vector<size_t>(1, nrows), *bundle.columns);
+
+            } else if (nrows != 0) {
 
                 // with this information the table can create the rows
                 I3TableRowPtr rows = bundle.table->CreateRow(nrows);
@@ -449,12 +587,65 @@ void I3TableWriter::Convert(I3FramePtr frame) {
         } // for t_it
     } // for tlist_it
 
+    if (batch_.size() >= batchSize_)
+        FlushBatch();
+}
+
+/******************************************************************************/
+
+void I3TableWriter::FlushBatch() {
+    if (batch_.empty())
+        return;
+
+    // convert the objects of each table with one call, into columns of
+    // their own that can be handed to the writer thread as they are
+    std::map<const TableBundle*, I3TableColumnsPtr> converted;
+    std::map<std::string, std::vector<TableBundle> >::iterator tlist_it;
+    for (tlist_it = tables_.begin(); tlist_it != tables_.end(); ++tlist_it) {
+        BOOST_FOREACH(TableBundle& bundle, tlist_it->second) {
+            if (bundle.batchObjects.empty())
+                continue;
+            I3TableColumnsPtr columns(new I3TableColumns(bundle.table->GetDescription(),
+                                                         bundle.batchRows));
+            size_t rowsWritten = bundle.converter->ConvertColumns(
+                bundle.batchObjects, *columns, bundle.batchFrames);
+            i3_assert(rowsWritten == bundle.batchRows);
+            converted[&bundle] = columns;
+            bundle.batchObjects.clear();
+            bundle.batchFrames.clear();
+            bundle.batchRows = 0;
+        }
+    }
 
+    // hand the rows to the tables frame by frame, so that they see the
+    // events in the same order as without the batch and pad the same way
+    std::map<const TableBundle*, size_t> start;
+    const size_t nIndexFields = ticConverter_->GetDescription()->GetNumberOfFields();
+    BOOST_FOREACH(BatchedFrame& batched, batch_) {
+        BOOST_FOREACH(BatchedObject& object, batched.objects) {
+            TableBundle& bundle = object.tables->second.at(object.bundle);
+            I3TableColumnsPtr& columns = converted[&bundle];
+            size_t& first = start[&bundle];
+            i3_assert(first + object.nrows <= columns->GetNumberOfRows());
+
+            // the table index columns are the same for all rows
+            I3TableRow& index = *bundle.indexRow;
+            ticConverter_->Convert(batched.header, bundle.indexRow, batched.frame);
+            index.Set<bool>("exists", true);
+            columns->Broadcast(index, first, object.nrows, 0, nIndexFields);
+
+            bundle.table->AddColumns(batched.header, columns, first, object.nrows);
+            first += object.nrows;
+        }
+    }
+    batch_.clear();
 }
 
 /******************************************************************************/
 
 void I3TableWriter::Finish() {
+    FlushBatch();
+
     // disconnect from all tables
     std::map<std::string, std::vector<TableBundle> >::iterator list_it;
     std::vector<TableBundle>::iterator it;
@@ -463,6 +654,7 @@ void I3TableWriter::Finish() {
             DisconnectTable(it->table);
         }
     }
+    plans_.clear();
     tables_.clear();
 
     if (ignoredStreams_.size() > 0) {
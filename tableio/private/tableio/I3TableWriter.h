@@ -17,6 +17,9 @@
 
 #include <string>
 #include <set>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "tableio/I3Converter.h"
 #include "tableio/detail/I3ConverterMill.h"
@@ -24,6 +27,7 @@
 
 I3_FORWARD_DECLARATION(I3TableService);
 I3_FORWARD_DECLARATION(I3Table);
+I3_FORWARD_DECLARATION(I3EventHeader);
 
 class I3TableWriter {
     public:
@@ -81,6 +85,9 @@ class I3TableWriter {
         void Setup();
 
         void Convert(I3FramePtr frame);
+        // convert the objects of up to this many physics frames together,
+        // with one ConvertColumns call per table
+        void SetBatchSize(size_t batchSize);
 
         void Finish();
 
@@ -97,6 +104,14 @@ class I3TableWriter {
         struct TableBundle {
             I3ConverterPtr converter;
             I3TablePtr table;
+            // reused conversion buffer for tables that prefer columns
+            I3TableColumnsPtr columns;
+            // reused row for the index columns of each batch
+            I3TableRowPtr indexRow;
+            // objects waiting in the batch, their frames and their rows
+            std::vector<I3FrameObjectConstPtr> batchObjects;
+            std::vector<I3FramePtr> batchFrames;
+            size_t batchRows;
         };
 
 
@@ -107,7 +122,7 @@ class I3TableWriter {
         std::vector<std::string> streams_;
         std::set<std::string> ignoredStreams_;
         // keys that have been examined and found useless
-        std::set<std::string> uselessKeys_;
+        std::unordered_set<std::string> uselessKeys_;
 
         typedef std::map<std::string, std::vector<TableSpec> > tablespec_map;
         typedef std::map<TypeSpec, std::vector<TableSpec> > typespec_map;
@@ -115,11 +130,43 @@ class I3TableWriter {
         tablespec_map wantedNames_;
         typespec_map wantedTypes_;
 
+        // converter mill for each frame object type, or NULL if none can
+        // convert it
+        std::unordered_map<std::type_index, I3ConverterMillPtr> converterMills_;
+        // entries of wantedTypes_ that match each frame object type
+        std::unordered_map<std::type_index,
+            std::vector<typespec_map::const_iterator> > typeMatches_;
+
+        // how to get the object for a booked key out of the frame
+        struct ObjectPlan {
+            std::map<std::string, std::vector<TableBundle> >::iterator tables;
+            // type of the object in the frame the last time it was seen
+            std::type_index type;
+            // whether it has to be turned into an I3RecoPulseSeriesMap
+            bool asPulses;
+            ObjectPlan() : type(typeid(void)), asPulses(false) {}
+        };
+        std::vector<ObjectPlan> plans_;
+
         std::map<std::string,std::string> objNameToTableName_;
         std::map<std::string,std::string> typeNameToConverterName_;
         I3FrameConstPtr currentFrame_;
         I3ConverterPtr ticConverter_;
 
+        // an object waiting in the batch, with the number of rows it will fill
+        struct BatchedObject {
+            std::map<std::string, std::vector<TableBundle> >::iterator tables;
+            size_t bundle;
+            size_t nrows;
+        };
+        struct BatchedFrame {
+            I3FramePtr frame;
+            I3EventHeaderConstPtr header;
+            std::vector<BatchedObject> objects;
+        };
+        size_t batchSize_;
+        std::vector<BatchedFrame> batch_;
+
     private:
         I3TableWriter();
         I3TableWriter(const I3TableWriter& rhs);
@@ -127,6 +174,10 @@ class I3TableWriter {
         const std::string GetTypeName(I3FramePtr, const std::string&);
 
         I3ConverterPtr FindConverter(I3FrameObjectConstPtr obj);
+        I3ConverterMillPtr FindConverterMill(I3FrameObjectConstPtr obj);
+        std::vector<typespec_map::const_iterator> GetTypeMatches(I3FrameObjectConstPtr obj);
+        I3FrameObjectConstPtr GetObject(I3FramePtr frame, ObjectPlan& plan);
+        void FlushBatch();
 
         friend struct I3TableWriterTestAccess;
 
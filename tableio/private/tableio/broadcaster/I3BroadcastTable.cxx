@@ -27,6 +27,32 @@ void I3BroadcastTable::AddRow(I3EventHeaderConstPtr header, I3TableRowConstPtr r
     }
 };
 
+void I3BroadcastTable::AddColumns(const std::vector<I3EventHeaderConstPtr>& headers,
+                                  const std::vector<size_t>& nrows,
+                                  const I3TableColumns& columns) {
+    std::vector<I3TablePtr>::iterator iter;
+    for(iter = clients_.begin(); iter != clients_.end(); ++iter ) {
+        (*iter)->AddColumns(headers,nrows,columns);
+    }
+};
+
+void I3BroadcastTable::AddColumns(I3EventHeaderConstPtr header, I3TableColumnsConstPtr columns,
+                                  size_t start, size_t nrows) {
+    std::vector<I3TablePtr>::iterator iter;
+    for(iter = clients_.begin(); iter != clients_.end(); ++iter ) {
+        (*iter)->AddColumns(header,columns,start,nrows);
+    }
+};
+
+bool I3BroadcastTable::PrefersColumns() const {
+    std::vector<I3TablePtr>::const_iterator iter;
+    for(iter = clients_.begin(); iter != clients_.end(); ++iter ) {
+        if ((*iter)->PrefersColumns())
+            return true;
+    }
+    return false;
+};
+
 void I3BroadcastTable::Align() {
     std::vector<I3TablePtr>::iterator iter;
     for(iter = clients_.begin(); iter != clients_.end(); ++iter ) {
@@ -21,7 +21,13 @@ class I3BroadcastTable : public I3Table {
         I3BroadcastTable(I3TableService& service, std::string name,
             I3TableRowDescriptionConstPtr description, std::vector<I3TablePtr>& clients);
         virtual void AddRow(I3EventHeaderConstPtr header, I3TableRowConstPtr row);
+        virtual void AddColumns(const std::vector<I3EventHeaderConstPtr>& headers,
+                                const std::vector<size_t>& nrows,
+                                const I3TableColumns& columns);
+        virtual void AddColumns(I3EventHeaderConstPtr header, I3TableColumnsConstPtr columns,
+                                size_t start, size_t nrows);
         virtual void Align();
+        virtual bool PrefersColumns() const;
 
     private:
         void WriteRows(I3TableRowConstPtr rows);
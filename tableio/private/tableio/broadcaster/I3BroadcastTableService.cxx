@@ -34,6 +34,12 @@ void I3BroadcastTableService::SetIndexConverter(I3ConverterPtr gen)
 		client->SetIndexConverter(gen);
 }
 
+void I3BroadcastTableService::SetBackgroundWriting(size_t queueLength)
+{
+	BOOST_FOREACH(I3TableServicePtr client, clients_)
+		client->SetBackgroundWriting(queueLength);
+}
+
 void I3BroadcastTableService::CloseFile() {
     std::vector<I3TableServicePtr>::iterator iter;
     for(iter = clients_.begin(); iter != clients_.end(); ++iter) {
@@ -18,6 +18,8 @@ class I3BroadcastTableService : public I3TableService {
     public:
         I3BroadcastTableService(const std::vector<I3TableServicePtr>& clients);
         void SetIndexConverter(I3ConverterPtr gen);
+        // each client writes in its own thread
+        void SetBackgroundWriting(size_t queueLength);
     protected:
         virtual I3TablePtr CreateTable(const std::string& tableName,
                                        I3TableRowDescriptionConstPtr description);
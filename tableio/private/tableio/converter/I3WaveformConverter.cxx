@@ -10,7 +10,6 @@
  */
 
 #include "tableio/converter/I3WaveformConverter.h"
-#include "dataclasses/I3DOMFunctions.h"
 #include "dataclasses/physics/I3Waveform.h"
 #include "dataclasses/calibration/I3Calibration.h"
 #include "dataclasses/status/I3DetectorStatus.h"
@@ -103,8 +102,11 @@ size_t I3WaveformConverter::FillRows(const I3WaveformSeriesMap& atwdWaveformMap,
     }
 
 
-    const std::map<OMKey,I3DOMCalibration> &domcalmap = calibration->domCal;
-    const std::map<OMKey,I3DOMStatus> &domstatusmap   = detectorstatus->domStatus;
+    if (calibration != calibration_ || detectorstatus != detectorStatus_) {
+        compiledCalibration_.Compile(*calibration, *detectorstatus);
+        calibration_ = calibration;
+        detectorStatus_ = detectorstatus;
+    }
 
     I3Map<OMKey, std::vector<I3Waveform> >::const_iterator iter;
 
@@ -117,9 +119,10 @@ size_t I3WaveformConverter::FillRows(const I3WaveformSeriesMap& atwdWaveformMap,
         rows->SetCurrentRow(currentRow);
 
         OMKey key = iter->first;
-        const I3DOMCalibration &domcal = domcalmap.find(key)->second;
-        const I3DOMStatus &domstatus   = domstatusmap.find(key)->second;
-        const double GI(SPEMean(domstatus,domcal)*domcal.GetFrontEndImpedance());
+        const size_t dom = compiledCalibration_.GetIndex(key);
+        const double GI(dom == I3CompiledCalibration::npos ? NAN :
+                        compiledCalibration_.GetSPEMean(dom)*
+                        compiledCalibration_.GetFrontEndImpedance(dom));
 
         if( std::isnan(GI) ){
             log_info("OM (%d,%d) has an invalid gain. Skipping the OM.",
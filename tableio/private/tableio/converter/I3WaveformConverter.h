@@ -14,6 +14,7 @@
 
 #include "tableio/I3Converter.h"
 #include "dataclasses/physics/I3Waveform.h"
+#include "dataclasses/calibration/I3CompiledCalibration.h"
 
 class I3WaveformConverter : public I3ConverterImplementation<I3WaveformSeriesMap > {
 public:
@@ -27,6 +28,11 @@ private:
     std::string atwdName_;
     std::string fadcName_;
     bool calibrate_;
+
+    // derived gains, recompiled whenever a new C or D frame arrives
+    I3CalibrationConstPtr calibration_;
+    I3DetectorStatusConstPtr detectorStatus_;
+    I3CompiledCalibration compiledCalibration_;
 };
 
 #endif // TABLEIO_I3WAVEFORMCONVERTER_H_INCLUDED
@@ -11,7 +11,6 @@
 
 #include "tableio/converter/I3WaveformSeriesMapConverter.h"
 
-#include <dataclasses/I3DOMFunctions.h>
 #include <dataclasses/physics/I3Waveform.h>
 #include <dataclasses/calibration/I3Calibration.h>
 #include <dataclasses/geometry/I3Geometry.h>
@@ -21,6 +20,8 @@
 
 #include <boost/foreach.hpp>
 
+#include <algorithm>
+
 
 namespace {
 
@@ -41,9 +42,10 @@ namespace {
 
 /******************************************************************************/
 
-I3WaveformSeriesMapConverter::I3WaveformSeriesMapConverter(bool calibrate, bool bookGeometry)
+I3WaveformSeriesMapConverter::I3WaveformSeriesMapConverter(bool calibrate, bool bookGeometry,
+							   bool variableLength)
   : I3ConverterImplementation<I3WaveformSeriesMap>(),
-    calibrate_(calibrate), bookGeometry_(bookGeometry)
+    calibrate_(calibrate), bookGeometry_(bookGeometry), variableLength_(variableLength)
 {}
 
 /******************************************************************************/
@@ -62,7 +64,7 @@ I3TableRowDescriptionPtr I3WaveformSeriesMapConverter::CreateDescription(const I
   }
 
   size_t wfSize(getWaveformLength(waveforms));
-  if (wfSize == 0)
+  if (wfSize == 0 && !variableLength_)
     log_error("Got some zero length waveforms.");
 
   desc->isMultiRow_ = true;
@@ -79,7 +81,10 @@ I3TableRowDescriptionPtr I3WaveformSeriesMapConverter::CreateDescription(const I
   desc->AddField<double>("t0", "ns", "start time of waveform");
   desc->AddField<double>("dt", "ns", "width of waveform bins");
   desc->AddField<uint16_t>("nbins", "", "number of waveform bins");
-  desc->AddField<double>("wf", unit, doc, wfSize);
+  if (variableLength_)
+    desc->AddVariableLengthField<double>("wf", unit, doc);
+  else
+    desc->AddField<double>("wf", unit, doc, wfSize);
 
   return desc;
 }
@@ -104,6 +109,11 @@ size_t I3WaveformSeriesMapConverter::FillRows(const I3WaveformSeriesMap& wavefor
       log_fatal("%s: couldn't find calibration information in current frame!",
 		__PRETTY_FUNCTION__);
     }
+    if (calibration != calibration_ || detectorstatus != detectorStatus_) {
+      compiledCalibration_.Compile(*calibration, *detectorstatus);
+      calibration_ = calibration;
+      detectorStatus_ = detectorstatus;
+    }
   }
 
   I3GeometryConstPtr geometry;
@@ -122,7 +132,8 @@ size_t I3WaveformSeriesMapConverter::FillRows(const I3WaveformSeriesMap& wavefor
 
   const size_t startRow = rows->GetCurrentRow();
   const I3TableRowDescription &desc = *rows->GetDescription();
-  const size_t wfsize = desc.GetFieldArrayLengths()[desc.GetFieldColumn("wf")];
+  const size_t wfindex = desc.GetFieldColumn("wf");
+  const size_t wfsize = desc.GetFieldArrayLengths()[wfindex];
 
   size_t currentRow;
   for (iter = waveforms.begin(), currentRow = rows->GetCurrentRow();
@@ -138,9 +149,10 @@ size_t I3WaveformSeriesMapConverter::FillRows(const I3WaveformSeriesMap& wavefor
       bool ok = true;
 
       if (calibrate_) {
-	const I3DOMCalibration &domcal = calibration->domCal.find(key)->second;
-	const I3DOMStatus &domstatus   = detectorstatus->domStatus.find(key)->second;
-	GI = SPEMean(domstatus,domcal)*domcal.GetFrontEndImpedance();
+	const size_t dom = compiledCalibration_.GetIndex(key);
+	if (dom != I3CompiledCalibration::npos)
+	  GI = compiledCalibration_.GetSPEMean(dom)*
+	    compiledCalibration_.GetFrontEndImpedance(dom);
 
 	if ( std::isnan(GI) ) {
 	  log_info("OM (%d,%d) has an invalid gain. Skipping the OM.",
@@ -181,19 +193,29 @@ size_t I3WaveformSeriesMapConverter::FillRows(const I3WaveformSeriesMap& wavefor
 
       double VoltToNPE = wf.GetBinWidth()/GI;
       std::vector<double>::const_iterator wfiter;
-      double* buffer = rows->GetPointer<double>("wf");
+      // fixed-size fields are as long as the first waveform,
+      // variable-length ones take every bin
+      double* buffer;
+      size_t nbins;
+      if (variableLength_) {
+	nbins = readout.size();
+	buffer = static_cast<double*>(rows->AddVariableLength(wfindex, rows->GetCurrentRow(), nbins));
+      } else {
+	nbins = std::min(readout.size(), wfsize);
+	buffer = rows->GetPointer<double>("wf");
+      }
       unsigned i = 0;
 
       if (calibrate_) {
 	for (wfiter = readout.begin();
-	     i < wfsize && wfiter != readout.end();
+	     i < nbins && wfiter != readout.end();
 	     ++i, ++wfiter++)
 	  {
 	    buffer[i] = (*wfiter)*VoltToNPE;
 	  }
       } else {
 	for (wfiter = readout.begin();
-	     i < wfsize && wfiter != readout.end();
+	     i < nbins && wfiter != readout.end();
 	     ++i, ++wfiter++)
 	  {
 	    buffer[i] = *wfiter/I3Units::mV;
@@ -14,10 +14,12 @@
 
 #include "tableio/I3Converter.h"
 #include "dataclasses/physics/I3Waveform.h"
+#include "dataclasses/calibration/I3CompiledCalibration.h"
 
 class I3WaveformSeriesMapConverter : public I3ConverterImplementation< I3WaveformSeriesMap > {
 public:
-    I3WaveformSeriesMapConverter(bool calibrate = false, bool bookGeometry = false);
+    I3WaveformSeriesMapConverter(bool calibrate = false, bool bookGeometry = false,
+                                 bool variableLength = false);
 
 private:
     I3TableRowDescriptionPtr CreateDescription(const I3WaveformSeriesMap& waveforms);
@@ -26,6 +28,14 @@ private:
 
     bool calibrate_;
     bool bookGeometry_;
+    // book the waveforms in a variable-length field instead of
+    // truncating them to the length of the first one
+    bool variableLength_;
+
+    // derived gains, recompiled whenever a new C or D frame arrives
+    I3CalibrationConstPtr calibration_;
+    I3DetectorStatusConstPtr detectorStatus_;
+    I3CompiledCalibration compiledCalibration_;
 };
 
 #endif // TABLEIO_I3WAVEFORMCONVERTER_H_INCLUDED
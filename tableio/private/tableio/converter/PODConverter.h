@@ -31,6 +31,15 @@ class PODConverter : public I3ConverterImplementation<FrmObj> {
             rows->Set<TableType>("value", object.value);
             return 1;
         }
+
+        size_t FillColumns(const std::vector<const FrmObj*>& objects,
+                           const std::vector<I3FramePtr>& frames,
+                           I3TableColumns& columns) {
+            TableType* value = columns.GetColumn<TableType>("value");
+            for (size_t i = 0; i < objects.size(); ++i)
+                value[i] = objects[i]->value;
+            return objects.size();
+        }
 };
 
 char PODConverter_NoUnit[] = "";
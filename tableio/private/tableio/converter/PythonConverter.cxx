@@ -4,6 +4,9 @@
 
 #include <icetray/I3FrameObject.h>
 
+#include <icetray/python/gil_holder.hpp>
+
+#include <tableio/I3TableColumns.h>
 #include <tableio/converter/PythonConverter.h>
 #include <boost/python.hpp>
 
@@ -105,6 +108,33 @@ size_t PythonConverter::FillRows(const I3FrameObjectConstPtr object, I3TableRowP
 	}
 }
 
+size_t PythonConverter::ConvertColumns(const std::vector<I3FrameObjectConstPtr>& objects,
+                                       I3TableColumns& columns,
+                                       const std::vector<I3FramePtr>& frames) {
+	log_trace("%s",__PRETTY_FUNCTION__);
+	// one trip into the interpreter for the whole batch
+	bp::detail::gil_holder gil;
+	if (bp::override fillcolumns = this->get_override("FillColumns")) {
+		bp::list pyobjects;
+		for (const I3FrameObjectConstPtr& object : objects)
+			pyobjects.append(boost::const_pointer_cast<I3FrameObject>(object));
+		// Python fills columns of its own, which the numpy arrays it gets
+		// keep alive for as long as it holds on to them. They are closed
+		// when FillColumns returns, and copied over.
+		I3TableColumnsPtr batch(new I3TableColumns(columns.GetDescription(),
+		                                           columns.GetNumberOfRows()));
+		bp::object pybatch(batch);
+		size_t nrows = fillcolumns(pyobjects, pybatch);
+		pybatch.attr("_close")();
+		if (nrows != batch->GetNumberOfRows())
+			log_fatal("FillColumns(frame_objects,columns) returned %zu, but the objects have %zu rows.",
+			          nrows, batch->GetNumberOfRows());
+		columns = *batch;
+		return nrows;
+	} else {
+		return I3Converter::ConvertColumns(objects, columns, frames);
+	}
+}
 
 size_t PythonConverter::Convert(const I3FrameObject& object,
                              I3TableRowPtr rows,
@@ -39,6 +39,12 @@ struct PythonConverter : I3Converter, boost::python::wrapper<I3Converter>
 
     size_t FillRows(const I3FrameObjectConstPtr object, I3TableRowPtr rows);
 
+    // hand the whole batch to FillColumns(objects,columns) if the Python
+    // class defines it, and convert object by object otherwise
+    size_t ConvertColumns(const std::vector<I3FrameObjectConstPtr>& objects,
+                          I3TableColumns& columns,
+                          const std::vector<I3FramePtr>& frames=std::vector<I3FramePtr>());
+
     ConvertState CanConvert(I3FrameObjectConstPtr object);
     ConvertState CanConvert(I3FrameObjectPtr object);
 
@@ -21,7 +21,7 @@ I3ConverterMill::I3ConverterMill(boost::python::object callable)
 		throw std::runtime_error("Couldn't instantiate converter!");
 }
 
-bool
+I3Converter::ConvertState
 I3ConverterMill::CanConvert(I3FrameObjectConstPtr object)
 {
 	return thneed_->CanConvert(object);
@@ -19,7 +19,7 @@
 class I3ConverterMill {
 public:
 	I3ConverterMill(boost::python::object);
-	bool CanConvert(I3FrameObjectConstPtr);
+	I3Converter::ConvertState CanConvert(I3FrameObjectConstPtr);
 	I3ConverterPtr operator()();
 private:
 	boost::python::object callable_;
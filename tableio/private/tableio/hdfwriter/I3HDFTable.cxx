@@ -10,10 +10,14 @@
  */
 
 #include <assert.h>
+#include <future>
+
+#include <zlib.h>
 
 #include "I3HDFTable.h"
 #include "tableio/I3Converter.h"
 #include "tableio/I3TableRow.h"
+#include "tableio/I3TableColumns.h"
 #include "tableio/I3TableRowDescription.h"
 
 #include "H5Tpublic.h"
@@ -26,6 +30,7 @@
 
 #include "H5Dpublic.h"
 #include "H5Gpublic.h"
+#include "H5Zpublic.h"
 
 // customize table creation
 #include "hdf5_opt.h"
@@ -36,7 +41,8 @@
 I3HDFTable::I3HDFTable(I3TableService& service, const std::string& name,
                        hid_t fileId, I3TablePtr index_table) :
     I3Table(service, name, I3TableRowDescriptionPtr()),
-    fileId_(fileId) {
+    fileId_(fileId), datasetId_(-1), typeId_(-1), nrowsOnDisk_(0),
+    directChunks_(false), nrowsDirect_(0) {
       indexTable_ = index_table;
       if (indexTable_) nevents_ = indexTable_->GetNumberOfRows();
       else nevents_ = 0;
@@ -50,12 +56,13 @@ I3HDFTable::I3HDFTable(I3TableService& service, const std::string& name,
 // If a description is provided, create the corresponding table
 I3HDFTable::I3HDFTable(I3TableService& service, const std::string& name,
                        I3TableRowDescriptionConstPtr description,
-                       hid_t fileId, int compress, I3TablePtr index_table) :
+                       hid_t fileId, const WriteOptions& options, I3TablePtr index_table) :
     I3Table(service, name, description),
-    fileId_(fileId) {
+    fileId_(fileId), options_(options), datasetId_(-1), typeId_(-1), nrowsOnDisk_(0),
+    directChunks_(false), nrowsDirect_(0) {
       indexTable_ = index_table;
       CalculateChunkSize();
-      CreateTable(compress);
+      CreateTable();
       CreateCache();
 }
 
@@ -63,7 +70,14 @@ I3HDFTable::I3HDFTable(I3TableService& service, const std::string& name,
 
 void I3HDFTable::CreateCache() {
     writeCache_ = I3TableRowPtr(new I3TableRow(description_,0));
-    writeCache_->reserve(CHUNKTIMES*chunkSize_);
+    writeCache_->reserve(GetChunksPerWrite()*chunkSize_);
+}
+
+/******************************************************************************/
+
+// Each compression thread gets CHUNKTIMES chunks per write
+size_t I3HDFTable::GetChunksPerWrite() const {
+    return CHUNKTIMES*std::max(options_.threads, 1u);
 }
 
 
@@ -80,10 +94,11 @@ void I3HDFTable::CalculateChunkSize() {
     for (it = fieldI3Datatypes.begin(), as_it = fieldArrayLengths.begin();
          it != fieldI3Datatypes.end();
          it++, as_it++)
-      byteSize += (it->size)*(*as_it);
+      byteSize += (*as_it == 0) ? sizeof(hvl_t) : (it->size)*(*as_it);
     if (byteSize == 0)
       log_fatal("Cowardly refusing to divide by zero!");
-    chunkSize_ = size_t(CHUNKSIZE_BYTES)/byteSize;
+    size_t chunkBytes = options_.chunkBytes > 0 ? options_.chunkBytes : size_t(CHUNKSIZE_BYTES);
+    chunkSize_ = std::max(chunkBytes/byteSize, size_t(1));
     log_trace("%s Chunk shape is %zu",log_label().c_str(),chunkSize_);
 }
 
@@ -133,7 +148,11 @@ hid_t I3HDFTable::GetHDFType(const I3Datatype& dtype, const size_t arrayLength)
             log_fatal("I don't know what do with datatype %d.",dtype.kind);
             break;
     }
-    if (arrayLength > 1) {
+    if (arrayLength == 0) {
+        hid_t vlen_tid = H5Tvlen_create(hdftype);
+        H5Tclose(hdftype);
+        hdftype = vlen_tid;
+    } else if (arrayLength > 1) {
         hsize_t rank = 1;
         std::vector<hsize_t> dims(1, arrayLength);
         hid_t array_tid = H5Tarray_create(hdftype, rank, &dims.front(), NULL);
@@ -188,6 +207,13 @@ I3Datatype I3HDFTable::GetI3Datatype(hid_t hdftype, size_t* arrayLength ) {
             else
               log_fatal("Cowardly refusing to work with a NULL pointer");
             break;
+        case H5T_VLEN:
+            dtype = GetI3Datatype(H5Tget_super(hdftype),NULL);
+            if(arrayLength != NULL)
+              *arrayLength = 0;
+            else
+              log_fatal("Cowardly refusing to work with a NULL pointer");
+            break;
         default:
             log_fatal("Unknown HDF type class %d.",(int)H5Tget_class(hdftype));
             break;
@@ -197,8 +223,212 @@ I3Datatype I3HDFTable::GetI3Datatype(hid_t hdftype, size_t* arrayLength ) {
 
 /******************************************************************************/
 
+// map a filter name onto its HDF5 filter id
+H5Z_filter_t I3HDFTable::GetFilterId(const std::string& filter) {
+    if (filter == "deflate")
+        return H5Z_FILTER_DEFLATE;
+    else if (filter == "lz4")
+        return I3_H5Z_FILTER_LZ4;
+    else if (filter == "zstd")
+        return I3_H5Z_FILTER_ZSTD;
+    log_fatal("Unknown compression filter '%s'. Use 'deflate', 'lz4' or 'zstd'.",
+              filter.c_str());
+    return H5Z_FILTER_ERROR;
+}
+
+/******************************************************************************/
+
+// set up the filter pipeline of a new table
+hid_t I3HDFTable::CreateFilters() {
+    if (options_.compress <= 0)
+        return H5P_DEFAULT;
+    hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+    if (plist < 0 || H5Pset_shuffle(plist) < 0)
+        log_fatal("(%s) Couldn't set up the shuffle filter", name_.c_str());
+    H5Z_filter_t filter = GetFilterId(options_.filter);
+    herr_t status;
+    if (filter == H5Z_FILTER_DEFLATE) {
+        status = H5Pset_deflate(plist, options_.compress);
+    } else {
+        // the lz4 plugin takes a block size, leave it at its default
+        unsigned level = options_.compress;
+        status = H5Pset_filter(plist, filter, H5Z_FLAG_MANDATORY,
+                               filter == I3_H5Z_FILTER_ZSTD ? 1 : 0, &level);
+    }
+    if (status < 0)
+        log_fatal("(%s) Couldn't set up the %s filter", name_.c_str(), options_.filter.c_str());
+    return plist;
+}
+
+/******************************************************************************/
+
+// build the in-memory compound type matching the rows of the description
+hid_t I3HDFTable::CreateMemoryType() const {
+    hid_t type = H5Tcreate(H5T_COMPOUND, description_->GetTotalByteSize());
+    const std::vector<std::string>& names = description_->GetFieldNames();
+    const std::vector<size_t>& offsets = description_->GetFieldByteOffsets();
+    const std::vector<I3Datatype>& types = description_->GetFieldTypes();
+    const std::vector<size_t>& arrayLengths = description_->GetFieldArrayLengths();
+    for (size_t i = 0; i < names.size(); i++) {
+        hid_t field = GetHDFType(types[i], arrayLengths[i]);
+        H5Tinsert(type, names[i].c_str(), offsets[i], field);
+        H5Tclose(field);
+    }
+    return type;
+}
+
+/******************************************************************************/
+
+// open the dataset for writing, with a chunk cache sized for appending
+void I3HDFTable::OpenDataset() {
+    hid_t dapl = H5Pcreate(H5P_DATASET_ACCESS);
+    size_t nslots, nbytes;
+    double w0;
+    H5Pget_chunk_cache(dapl, &nslots, &nbytes, &w0);
+    if (options_.cacheBytes > 0)
+        nbytes = options_.cacheBytes;
+    // chunks are only ever appended, so a full chunk can go first
+    H5Pset_chunk_cache(dapl, nslots, nbytes, 1.0);
+    datasetId_ = H5Dopen2(fileId_, name_.c_str(), dapl);
+    H5Pclose(dapl);
+    if (datasetId_ < 0)
+        log_fatal("(%s) Couldn't open the table for writing", name_.c_str());
+
+    typeId_ = CreateMemoryType();
+    hid_t space = H5Dget_space(datasetId_);
+    hsize_t dims;
+    H5Sget_simple_extent_dims(space, &dims, NULL);
+    H5Sclose(space);
+    nrowsOnDisk_ = dims;
+
+    // chunks can only be compressed here if the rows are laid out on disk
+    // the way they are in memory and deflate is the only codec. The
+    // elements of variable-length fields go to the heap, not the chunks.
+    hid_t fileType = H5Dget_type(datasetId_);
+    directChunks_ = options_.threads > 0 && options_.compress > 0
+        && GetFilterId(options_.filter) == H5Z_FILTER_DEFLATE
+        && !description_->HasVariableLengthFields()
+        && H5Tequal(fileType, typeId_) > 0;
+    H5Tclose(fileType);
+}
+
+/******************************************************************************/
+
+void I3HDFTable::CloseDataset() {
+    if (datasetId_ < 0)
+        return;
+    H5Tclose(typeId_);
+    H5Dclose(datasetId_);
+    datasetId_ = typeId_ = -1;
+}
+
+/******************************************************************************/
+
+namespace {
+
+// the shuffle and deflate filters, as HDF5 applies them to a chunk
+std::vector<Bytef> compress_chunk(const char* chunk, size_t nrows, size_t rowsize, int level) {
+    const size_t nbytes = nrows*rowsize;
+    std::vector<char> shuffled(nbytes);
+    for (size_t byte = 0; byte < rowsize; byte++)
+        for (size_t row = 0; row < nrows; row++)
+            shuffled[byte*nrows + row] = chunk[row*rowsize + byte];
+    uLongf size = compressBound(nbytes);
+    std::vector<Bytef> compressed(size);
+    if (compress2(&compressed.front(), &size, reinterpret_cast<const Bytef*>(&shuffled.front()),
+                  nbytes, level) != Z_OK)
+        throw std::runtime_error("zlib failed to compress a chunk");
+    compressed.resize(size);
+    return compressed;
+}
+
+// HDF5 hands over the elements of variable-length fields as hvl_t,
+// which takes the place of the slot in the row
+static_assert(sizeof(hvl_t) == sizeof(I3VariableLengthSlot), "hvl_t has to fit into a slot");
+
+// copy the first nrows rows, pointing variable-length fields at their elements
+const char* slots_to_hvl(const I3TableRow& rows, size_t nrows, std::vector<char>& buffer) {
+    const I3TableRowDescription& desc = *rows.GetDescription();
+    const size_t rowsize = desc.GetTotalByteSize();
+    const char* data = static_cast<const char*>(rows.GetPointer());
+    buffer.assign(data, data + nrows*rowsize);
+    for (size_t i = 0; i < desc.GetNumberOfFields(); i++) {
+        if (!desc.IsVariableLength(i))
+            continue;
+        for (size_t row = 0; row < nrows; row++) {
+            hvl_t vl;
+            vl.p = const_cast<void*>(rows.GetVariableLength(i, row, vl.len));
+            memcpy(&buffer[row*rowsize + desc.GetFieldByteOffsets()[i]], &vl, sizeof(vl));
+        }
+    }
+    return &buffer.front();
+}
+
+// move the elements HDF5 read for variable-length fields into the rows
+void hvl_to_slots(I3TableRow& rows) {
+    const I3TableRowDescription& desc = *rows.GetDescription();
+    for (size_t i = 0; i < desc.GetNumberOfFields(); i++) {
+        if (!desc.IsVariableLength(i))
+            continue;
+        const size_t typesize = desc.GetFieldTypeSizes()[i];
+        for (size_t row = 0; row < rows.GetNumberOfRows(); row++) {
+            hvl_t vl;
+            memcpy(&vl, rows.GetPointerToField(i, row), sizeof(vl));
+            if (vl.len > 0)
+                memcpy(rows.AddVariableLength(i, row, vl.len), vl.p, vl.len*typesize);
+            else
+                rows.AddVariableLength(i, row, 0);
+            H5free_memory(vl.p);
+        }
+    }
+}
+
+}
+
+// compress whole chunks on the worker threads and write them to the file
+// as they are, bypassing the filter pipeline. Returns the number of rows written.
+size_t I3HDFTable::WriteChunks(const char* buffer, size_t nchunks) {
+    if (nchunks == 0)
+        return 0;
+    const size_t rowsize = description_->GetTotalByteSize();
+    const size_t chunkBytes = chunkSize_*rowsize;
+    const unsigned nthreads = std::min<size_t>(options_.threads, nchunks);
+    const int level = options_.compress;
+    std::vector<std::vector<Bytef> > compressed(nchunks);
+    std::vector<std::future<void> > workers;
+    for (unsigned t = 0; t < nthreads; t++) {
+        workers.push_back(std::async(std::launch::async, [&, t]() {
+            for (size_t i = t; i < nchunks; i += nthreads)
+                compressed[i] = compress_chunk(buffer + i*chunkBytes, chunkSize_, rowsize, level);
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); t++)
+        workers[t].get();
+
+    hsize_t extent = nrowsOnDisk_ + nchunks*chunkSize_;
+    if (H5Dset_extent(datasetId_, &extent) < 0)
+        log_fatal("(%s) Couldn't extend the table to %zu rows", name_.c_str(), size_t(extent));
+    for (size_t i = 0; i < nchunks; i++) {
+        hsize_t offset = nrowsOnDisk_ + i*chunkSize_;
+#if (H5_VERS_MAJOR > 1) || (H5_VERS_MAJOR == 1 && H5_VERS_MINOR > 10) || (H5_VERS_MAJOR == 1 && H5_VERS_MINOR == 10 && H5_VERS_RELEASE >= 2)
+        herr_t status = H5Dwrite_chunk(datasetId_, H5P_DEFAULT, 0, &offset,
+                                       compressed[i].size(), &compressed[i].front());
+#else
+        herr_t status = H5DOwrite_chunk(datasetId_, H5P_DEFAULT, 0, &offset,
+                                        compressed[i].size(), &compressed[i].front());
+#endif
+        if (status < 0)
+            log_fatal("(%s) Couldn't write the chunk at row %zu", name_.c_str(), size_t(offset));
+    }
+    nrowsOnDisk_ += nchunks*chunkSize_;
+    nrowsDirect_ += nchunks*chunkSize_;
+    return nchunks*chunkSize_;
+}
+
+/******************************************************************************/
+
 // create a table based on the TableRowDescription
-void I3HDFTable::CreateTable(int& compress) {
+void I3HDFTable::CreateTable() {
 
     const size_t structSize = description_->GetTotalByteSize();
     const unsigned nfields = description_->GetNumberOfFields();
@@ -226,6 +456,7 @@ void I3HDFTable::CreateTable(int& compress) {
     }
     const char** fieldNames = static_cast<const char**>(&fieldNameVector.front());
 
+    hid_t filters = CreateFilters();
     herr_t status =
         I3H5TBmake_table("",                // table title
                        fileId_,             // hdf5 file opened by writer service
@@ -238,8 +469,10 @@ void I3HDFTable::CreateTable(int& compress) {
                        fieldTypes,          // field types
                        (hsize_t)chunkSize_, // write data in chunks of ...
                        NULL,                // fill data to be written at creation
-                       compress,            // compression level
+                       filters,             // filter pipeline
                        NULL);               // data to be written at creation
+    if (filters != H5P_DEFAULT)
+        H5Pclose(filters);
     if (status < 0) {
         log_fatal("Couln't create table");
     }
@@ -395,7 +628,9 @@ std::string I3HDFTable::ReadAttributeString(hid_t fileID, std::string& where, st
 
 /******************************************************************************/
 
-I3HDFTable::~I3HDFTable() {}
+I3HDFTable::~I3HDFTable() {
+    CloseDataset();
+}
 
 /******************************************************************************/
 
@@ -410,31 +645,50 @@ void I3HDFTable::WriteRows(I3TableRowConstPtr rows) {
     // only write if buffer is larger than a chunk
     size_t chunks = writeCache_->GetNumberOfRows()/chunkSize_;
     // log_trace("%s Write cache contains %zu rows (%zu %zu-row chunks)",log_label().c_str(),writeCache_->GetNumberOfRows(),chunks,chunkSize_);
-    if (chunks >= CHUNKTIMES) Flush(chunks*chunkSize_);
+    if (chunks >= GetChunksPerWrite()) Flush(chunks*chunkSize_);
 }
 
+// Flush() writes everything that is left and releases the dataset;
+// the next write opens it again
 void I3HDFTable::Flush(size_t nrows) {
     log_trace("%s Flushing %zu rows from %zu-row cache",log_label().c_str(),nrows,writeCache_->GetNumberOfRows());
+    const bool flushAll = (nrows == 0);
     if (nrows == 0) nrows = writeCache_->GetNumberOfRows();
-    if (nrows == 0) return;
+    if (nrows == 0) {
+        CloseDataset();
+        return;
+    }
+    if (datasetId_ < 0) OpenDataset();
 
     const size_t rowsize = description_->GetTotalByteSize();
-    const size_t* fieldOffsets = &(description_->GetFieldByteOffsets().front());
-    const size_t* fieldSizes   = &(description_->GetFieldSizes().front());
-    const void* buffer = writeCache_->GetPointer();
-    herr_t status =
-        H5TBappend_records(fileId_,        // file
-                           name_.c_str(),  // data set name
-                           nrows,	       // number of the records in buffer
-                           rowsize,        // size of records in buffer
-                           fieldOffsets,   // struct offsets
-                           fieldSizes, 	   // size of the fields
-                           buffer);		   // data to write
-    if (status < 0) {
-        log_fatal("failed to append rows to table.");
-    } else {
-        writeCache_->erase(nrows);
+    const char* buffer = static_cast<const char*>(writeCache_->GetPointer());
+    std::vector<char> hvlBuffer;
+    if (description_->HasVariableLengthFields())
+        buffer = slots_to_hvl(*writeCache_, nrows, hvlBuffer);
+    size_t written = 0;
+    if (directChunks_ && nrowsOnDisk_ % chunkSize_ == 0)
+        written = WriteChunks(buffer, nrows/chunkSize_);
+
+    if (written < nrows) {
+        hsize_t start = nrowsOnDisk_;
+        hsize_t count = nrows - written;
+        hsize_t extent = start + count;
+        herr_t status = H5Dset_extent(datasetId_, &extent);
+        hid_t fileSpace = H5Dget_space(datasetId_);
+        hid_t memSpace = H5Screate_simple(1, &count, NULL);
+        if (status >= 0)
+            status = H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, &start, NULL, &count, NULL);
+        if (status >= 0)
+            status = H5Dwrite(datasetId_, typeId_, memSpace, fileSpace, H5P_DEFAULT,
+                              buffer + written*rowsize);
+        H5Sclose(memSpace);
+        H5Sclose(fileSpace);
+        if (status < 0)
+            log_fatal("failed to append rows to table.");
+        nrowsOnDisk_ += count;
     }
+    writeCache_->erase(nrows);
+    if (flushAll) CloseDataset();
 }
 
 I3TableRowPtr I3HDFTable::ReadRowsFromTable(size_t start, size_t nrows) const {
@@ -462,10 +716,46 @@ I3TableRowPtr I3HDFTable::ReadRowsFromTable(size_t start, size_t nrows) const {
        log_error("(%s) error reading rows %zu--%zu",name_.c_str(),start,start+nrows);
        return I3TableRowPtr();
    } else {
+       if (description_->HasVariableLengthFields())
+           hvl_to_slots(*rows);
        return rows;
    }
 }
 
+// read each field on its own, straight into its column
+void I3HDFTable::ReadFields(I3TableColumns& columns, const std::vector<size_t>& fieldIndices,
+                            size_t start, size_t nrows) const {
+    if (nrows == 0)
+        return;
+    // variable-length fields come with their elements, which are read row by row
+    for (size_t i = 0; i < fieldIndices.size(); i++) {
+        if (description_->IsVariableLength(fieldIndices[i])) {
+            I3Table::ReadFields(columns, fieldIndices, start, nrows);
+            return;
+        }
+    }
+    const std::vector<size_t>& sizes = description_->GetFieldSizes();
+    for (size_t i = 0; i < fieldIndices.size(); i++) {
+        int field = fieldIndices[i];
+        size_t size = sizes[field];
+        size_t offset = 0;
+        herr_t status =
+            H5TBread_fields_index(fileId_,       // file
+                                  name_.c_str(), // data set name
+                                  1,             // number of fields to read
+                                  &field,        // index of the field
+                                  start,         // index at which to start reading
+                                  nrows,         // number of records to read
+                                  size,          // size of one element of the column
+                                  &offset,       // offset of the field in the element
+                                  &size,         // size of the field
+                                  columns.GetPointerToColumn(i)); // where to write data
+        if (status < 0)
+            log_fatal("(%s) error reading field '%s' of rows %zu--%zu",name_.c_str(),
+                      description_->GetFieldNames()[field].c_str(),start,start+nrows);
+    }
+}
+
 I3TableRowConstPtr I3HDFTable::ReadRows(size_t start, size_t nrows) const {
     if (start < readCacheExtent_.first || start+nrows > readCacheExtent_.second ) {
         size_t nrows_remaining = std::min(CHUNKTIMES*chunkSize_,nrowsWithPadding_-start);
@@ -12,11 +12,14 @@
 #ifndef	I3HDFTABLE_H_INCLUDED
 #define I3HDFTABLE_H_INCLUDED
 
+#include <string>
+
 #include "icetray/I3Logging.h"
 #include "tableio/I3Table.h"
 #include "tableio/I3Datatype.h"
 
 #include "H5Ipublic.h"
+#include "H5Zpublic.h"
 
 I3_FORWARD_DECLARATION(I3TableService);
 I3_FORWARD_DECLARATION(I3TableRowDescription);
@@ -24,9 +27,28 @@ I3_FORWARD_DECLARATION(I3TableRow);
 
 class I3HDFTable : public I3Table {
     public:
+        // how new tables are laid out and compressed
+        struct WriteOptions {
+            // compression level, 0 turns the filters off
+            int compress;
+            // "deflate", or "lz4" or "zstd" if the HDF5 filter plugin is
+            // available. All of them run after the shuffle filter.
+            std::string filter;
+            // size of a chunk, 0 for CHUNKSIZE_BYTES
+            size_t chunkBytes;
+            // size of the chunk cache of each dataset, 0 for the HDF5 default
+            size_t cacheBytes;
+            // threads compressing deflate chunks before writing them
+            // directly, 0 to let HDF5 compress them
+            unsigned threads;
+
+            WriteOptions(int compress_=1) : compress(compress_), filter("deflate"),
+                chunkBytes(0), cacheBytes(0), threads(0) {}
+        };
+
         I3HDFTable(I3TableService& service, const std::string& name,
                    I3TableRowDescriptionConstPtr description,
-                   hid_t fileid, int compress, I3TablePtr index = I3TablePtr());
+                   hid_t fileid, const WriteOptions& options, I3TablePtr index = I3TablePtr());
 
         I3HDFTable(I3TableService& service, const std::string& name,
                    hid_t fileId, I3TablePtr index = I3TablePtr());
@@ -34,15 +56,22 @@ class I3HDFTable : public I3Table {
         static std::string ReadAttributeString(hid_t fileID, std::string& where, std::string attribute);
         static hid_t GetHDFType(const I3Datatype& dtype, const size_t arrayLength);
         static I3Datatype GetI3Datatype(hid_t dtype, size_t* arrayLength);
+        static H5Z_filter_t GetFilterId(const std::string& filter);
 
         virtual I3TableRowConstPtr ReadRows(size_t start, size_t nrows) const;
 
         virtual void Flush(const size_t nrows = 0);
 
+        // the number of rows that were compressed here and written as
+        // whole chunks, bypassing the HDF5 filter pipeline
+        size_t GetNumberOfDirectRows() const { return nrowsDirect_; }
+
     protected:
         virtual void WriteRows(I3TableRowConstPtr row);
+        virtual void ReadFields(I3TableColumns& columns, const std::vector<size_t>& fieldIndices,
+                                size_t start, size_t nrows) const;
         virtual std::pair<size_t,size_t> GetRangeForEvent(size_t index) const;
-        void CreateTable(int& compress);
+        void CreateTable();
         void CreateDescription();
         hid_t fileId_;
 
@@ -51,8 +80,21 @@ class I3HDFTable : public I3Table {
         mutable I3TableRowPtr readCache_;
         mutable std::pair<size_t,size_t> readCacheExtent_;
         size_t chunkSize_;
+        WriteOptions options_;
+        // the open dataset and its type while writing
+        hid_t datasetId_;
+        hid_t typeId_;
+        size_t nrowsOnDisk_;
         void CreateCache();
         void CalculateChunkSize();
+        bool directChunks_;
+        size_t nrowsDirect_;
+        size_t GetChunksPerWrite() const;
+        hid_t CreateFilters();
+        hid_t CreateMemoryType() const;
+        void OpenDataset();
+        void CloseDataset();
+        size_t WriteChunks(const char* buffer, size_t nchunks);
         I3TableRowPtr ReadRowsFromTable(size_t start, size_t nrows) const;
         std::string log_label();
 
@@ -63,6 +105,9 @@ class I3HDFTable : public I3Table {
 // Data will be written in chunks of this size (64 kB)
 // see http://www.pytables.org/docs/manual/ch05.html
 #define CHUNKSIZE_BYTES 65535
-// Buffer this many chunks before writing
+// Buffer this many chunks before writing (per compression thread)
 #define CHUNKTIMES 2
+// HDF5 filter plugins registered with The HDF Group
+#define I3_H5Z_FILTER_LZ4 32004
+#define I3_H5Z_FILTER_ZSTD 32015
 #endif
@@ -26,15 +26,28 @@
 #include "H5Gpublic.h"
 #include "H5Fpublic.h"
 #include "H5Ppublic.h"
+#include "H5Zpublic.h"
 
 /******************************************************************************/
 
 void
-I3HDFTableService::init(I3::dataio::shared_filehandle filename, int compress, char mode)
+I3HDFTableService::init(I3::dataio::shared_filehandle filename, int compress, char mode,
+                        const std::string& filter, size_t chunkBytes,
+                        size_t cacheBytes, unsigned threads)
 {
     if (!(filename_ = filename))
         log_fatal("NULL file handle!");
     compress_ = compress;
+    filter_ = filter;
+    chunkBytes_ = chunkBytes;
+    cacheBytes_ = cacheBytes;
+    threads_ = threads;
+    // lz4 and zstd are only there if their plugins can be found
+    if (compress_ > 0 && H5Zfilter_avail(I3HDFTable::GetFilterId(filter_)) <= 0) {
+        log_warn("The HDF5 %s filter plugin is not available (check HDF5_PLUGIN_PATH). "
+                 "Falling back to deflate.", filter_.c_str());
+        filter_ = "deflate";
+    }
     fileOpen_ = false;
     if ( mode == 'w') {
     fileId_ =  H5Fcreate(filename_->c_str(),
@@ -122,7 +135,9 @@ void I3HDFTableService::FindTables() {
 
 /******************************************************************************/
 
-I3HDFTableService::~I3HDFTableService() {};
+I3HDFTableService::~I3HDFTableService() {
+   JoinWriter();
+};
 
 /******************************************************************************/
 
@@ -137,14 +152,19 @@ I3TablePtr I3HDFTableService::CreateTable(const std::string& tableName,
        << "rather than Keys=[\""<<tableName<<"\"]";
        throw std::invalid_argument(oss.str().c_str());
     }
+    I3HDFTable::WriteOptions options(compress_);
+    options.filter = filter_;
+    options.chunkBytes = chunkBytes_;
+    options.cacheBytes = cacheBytes_;
+    options.threads = threads_;
     I3TablePtr index_table;
     if (description->GetUseIndex()){
       I3TableRowDescriptionConstPtr index_desc = GetIndexDescription();
       index_table = I3TablePtr(new I3HDFTable(*this, tableName,
-                                              index_desc, indexGroupId_, compress_));
+                                              index_desc, indexGroupId_, options));
     }
     I3TablePtr table(new I3HDFTable(*this, tableName,
-                                    description, fileId_, compress_, index_table));
+                                    description, fileId_, options, index_table));
     return table;
 };
 
@@ -23,13 +23,21 @@
 
 class I3HDFTableService : public I3TableService {
     public:
-        I3HDFTableService(I3::dataio::shared_filehandle filename, int compress=1, char mode='w')
+        // filter is "deflate", "lz4" or "zstd". chunkBytes and cacheBytes
+        // size the chunks and the per-table chunk cache (0 for the
+        // defaults), threads compresses deflate chunks in parallel.
+        I3HDFTableService(I3::dataio::shared_filehandle filename, int compress=1, char mode='w',
+                          const std::string& filter="deflate", size_t chunkBytes=0,
+                          size_t cacheBytes=0, unsigned threads=0)
         {
-            init(filename, compress, mode);
+            init(filename, compress, mode, filter, chunkBytes, cacheBytes, threads);
         }
-        I3HDFTableService(const std::string& filename, int compress=1, char mode='w')
+        I3HDFTableService(const std::string& filename, int compress=1, char mode='w',
+                          const std::string& filter="deflate", size_t chunkBytes=0,
+                          size_t cacheBytes=0, unsigned threads=0)
         {
-            init(boost::make_shared<I3::dataio::filehandle>(filename), compress, mode);
+            init(boost::make_shared<I3::dataio::filehandle>(filename), compress, mode,
+                 filter, chunkBytes, cacheBytes, threads);
         }
         I3HDFTableService(const std::string& filename, char mode)
         {
@@ -43,7 +51,9 @@ class I3HDFTableService : public I3TableService {
         virtual void CloseFile();
 
     private:
-        void init(I3::dataio::shared_filehandle filename, int compress, char mode);
+        void init(I3::dataio::shared_filehandle filename, int compress, char mode,
+                  const std::string& filter="deflate", size_t chunkBytes=0,
+                  size_t cacheBytes=0, unsigned threads=0);
         void FindTables();
 
         hid_t fileId_;
@@ -51,6 +61,10 @@ class I3HDFTableService : public I3TableService {
         hid_t indexGroupId_;
         I3::dataio::shared_filehandle filename_;
         int compress_;
+        std::string filter_;
+        size_t chunkBytes_;
+        size_t cacheBytes_;
+        unsigned threads_;
         bool fileOpen_;
 
     SET_LOGGER("I3HDFTableService");
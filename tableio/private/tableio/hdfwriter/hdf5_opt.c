@@ -24,6 +24,8 @@
  * (Jakob van Santen <vansanten@wisc.edu>)
  * - Pass compression level directly, rather than defaulting to 6 (which calls deflate_slow)
  * - Turn on shuffle filter by default when compression is enabled
+ * - Take the filters from a dataset creation property list prepared by the
+ *   caller instead of a deflate level
  *-------------------------------------------------------------------------
  */
 
@@ -41,7 +43,7 @@ herr_t I3H5TBmake_table( const char *table_title,
                        const hid_t *field_types,
                        hsize_t chunk_size,
                        void *fill_data,
-                       int compress,
+                       hid_t filter_plist,
                        const void *buf )
 {
 
@@ -77,7 +79,12 @@ herr_t I3H5TBmake_table( const char *table_title,
         return -1;
 
     /* modify dataset creation properties, i.e. enable chunking  */
-    plist_id = H5Pcreate(H5P_DATASET_CREATE);
+    if (filter_plist == H5P_DEFAULT)
+        plist_id = H5Pcreate(H5P_DATASET_CREATE);
+    else
+        plist_id = H5Pcopy(filter_plist);
+    if (plist_id < 0)
+        return -1;
     if (H5Pset_chunk(plist_id, 1, dims_chunk) < 0)
         return -1;
 
@@ -88,19 +95,6 @@ herr_t I3H5TBmake_table( const char *table_title,
             return -1;
     }
 
-    /*
-    dataset creation property list is modified to use
-    GZIP compression with the compression effort set to the value passed by the user
-    with the shuffle filter
-    */
-    if (compress)
-    {
-        if ( H5Pset_shuffle( plist_id ) < 0 )
-             return -1;
-        if ( H5Pset_deflate( plist_id, compress ) < 0)
-            return -1;
-    }
-
     /* create the dataset. */
     if ((did = H5Dcreate(loc_id, dset_name, mem_type_id, sid, plist_id)) < 0)
         goto out;
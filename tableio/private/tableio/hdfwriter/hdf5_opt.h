@@ -27,7 +27,7 @@ herr_t I3H5TBmake_table( const char *table_title,
                        const hid_t *field_types,
                        hsize_t chunk_size,
                        void *fill_data,
-                       int compress,
+                       hid_t filter_plist,
                        const void *buf );
 
 #ifdef __cplusplus
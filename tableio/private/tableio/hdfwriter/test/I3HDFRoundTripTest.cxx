@@ -16,6 +16,7 @@
 #include <boost/filesystem.hpp>
 
 #include <tableio//I3TableRow.h>
+#include <tableio/I3TableColumns.h>
 #include <tableio/I3TableRowDescription.h>
 #include <tableio/hdfwriter/I3HDFTableService.h>
 #include <tableio/hdfwriter/I3HDFTable.h>
@@ -169,3 +170,125 @@ TEST(resurrection) {
 
    boost::filesystem::remove(filename);
 }
+
+namespace {
+
+// write nevents single-row events, reopen the file and read them back
+I3TableRowPtr write_and_read(const std::string& filename, I3HDFTableService* service,
+                             I3TableRowDescriptionConstPtr desc, size_t nevents,
+                             size_t* directRows = NULL) {
+   I3TableServicePtr writer_service(service);
+   I3TablePtr table = writer_service->GetTable("values",desc);
+   for (size_t i=0; i<nevents; i++) {
+      I3EventHeaderPtr header(new I3EventHeader());
+      header->SetEventID(i);
+      I3TableRowPtr row = table->CreateRow(1);
+      row->Set<double>("double",0.5*i);
+      row->Set<int>("int",int(i % 7));
+      row->GetPointer<short>("vector")[i % 3] = short(i);
+      table->AddRow(header,row);
+   }
+   writer_service->Finish();
+   if (directRows)
+      *directRows = static_cast<I3HDFTable&>(*table).GetNumberOfDirectRows();
+
+   I3TableServicePtr reader_service(new I3HDFTableService(filename,1,'r'));
+   I3TablePtr zombie_table = reader_service->GetTable("values",I3TableRowDescriptionPtr());
+   ENSURE( zombie_table != NULL, "The table made it to disk");
+   ENSURE_EQUAL( zombie_table->GetNumberOfRows(), nevents, "Every row made it to disk");
+   I3TableRowPtr rows = boost::const_pointer_cast<I3TableRow>(
+      ((I3HDFTable*)(zombie_table.get()))->ReadRows(0,nevents));
+
+   // the same rows, one field at a time
+   std::vector<std::string> fields(1,"int");
+   fields.push_back("double");
+   I3TableColumnsConstPtr columns = zombie_table->ReadColumns(fields,1,nevents);
+   ENSURE_EQUAL( columns->GetNumberOfRows(), nevents-1, "Columns are read for the requested events");
+   for (size_t i=1; i<nevents; i++) {
+      rows->SetCurrentRow(i);
+      ENSURE_EQUAL( columns->GetColumn<int>("int")[i-1], rows->Get<int>("int"), "Read column is equal to read row");
+      ENSURE_EQUAL( columns->GetColumn<double>(1)[i-1], rows->Get<double>("double"), "Read column is equal to read row");
+   }
+   reader_service->Finish();
+   boost::filesystem::remove(filename);
+   return rows;
+}
+
+}
+
+TEST(compressed_chunks) {
+   I3TableRowDescriptionPtr desc(new I3TableRowDescription());
+   desc->AddField<double>("double","","doc");
+   desc->AddField<int>("int","","doc");
+   desc->AddField<short>("vector","","doc",3);
+   const size_t nevents = 5003;
+   // rows per 1000-byte chunk
+   const size_t chunkSize = 1000/(8+4+3*2);
+   size_t filteredRows, directRows;
+
+   // HDF5 compresses every chunk
+   I3TableRowPtr filtered = write_and_read("I3HDFRoundTripTest_filtered.hd5",
+      new I3HDFTableService("I3HDFRoundTripTest_filtered.hd5",6,'w',"deflate",1000),
+      desc, nevents, &filteredRows);
+   ENSURE_EQUAL( filteredRows, 0u, "Without threads no chunk bypasses the filters");
+   // chunks are compressed on 3 threads and written directly, except
+   // for the last, partial one
+   I3TableRowPtr direct = write_and_read("I3HDFRoundTripTest_direct.hd5",
+      new I3HDFTableService("I3HDFRoundTripTest_direct.hd5",6,'w',"deflate",1000,1<<20,3),
+      desc, nevents, &directRows);
+   ENSURE_EQUAL( directRows, nevents - nevents % chunkSize, "Every whole chunk is written directly");
+
+   for (size_t i=0; i<nevents; i+=101) {
+      direct->SetCurrentRow(i);
+      ENSURE_EQUAL( direct->Get<double>("double"), 0.5*i, "Read double is equal to set double.");
+      ENSURE_EQUAL( direct->Get<int>("int"), int(i % 7), "Read int is equal to set int.");
+      ENSURE_EQUAL( direct->GetPointer<short>("vector")[i % 3], short(i), "Read vector is equal to set vector.");
+   }
+   ENSURE( memcmp(filtered->GetPointer(),direct->GetPointer(),nevents*desc->GetTotalByteSize()) == 0,
+      "Directly written chunks read back the same as filtered ones");
+}
+
+TEST(variable_length) {
+   const std::string filename("I3HDFRoundTripTest_vlen.hd5");
+   I3TableRowDescriptionPtr desc(new I3TableRowDescription());
+   desc->AddField<int>("int","","doc");
+   desc->AddVariableLengthField<double>("wf","mV","doc");
+   const size_t nevents = 3001;
+
+   // asking for threads falls back to the filter pipeline
+   I3TableServicePtr writer_service(new I3HDFTableService(filename,6,'w',"deflate",1000,1<<20,3));
+   I3TablePtr table = writer_service->GetTable("values",desc);
+   for (size_t i=0; i<nevents; i++) {
+      I3EventHeaderPtr header(new I3EventHeader());
+      header->SetEventID(i);
+      I3TableRowPtr row = table->CreateRow(1);
+      std::vector<double> wf(i % 5, 0.5*i);
+      row->Set<int>("int",int(i));
+      row->SetVariableLength("wf",wf.data(),wf.size());
+      table->AddRow(header,row);
+   }
+   writer_service->Finish();
+
+   I3TableServicePtr reader_service(new I3HDFTableService(filename,1,'r'));
+   I3TablePtr zombie_table = reader_service->GetTable("values",I3TableRowDescriptionPtr());
+   ENSURE( zombie_table != NULL, "The table made it to disk");
+   ENSURE( zombie_table->GetDescription()->IsVariableLength(1), "The field is read back as variable-length");
+   I3TableRowPtr rows = boost::const_pointer_cast<I3TableRow>(
+      ((I3HDFTable*)(zombie_table.get()))->ReadRows(0,nevents));
+   I3TableColumnsConstPtr columns = zombie_table->ReadColumns(std::vector<std::string>(1,"wf"),0,nevents);
+   for (size_t i=0; i<nevents; i++) {
+      size_t n, nc;
+      rows->SetCurrentRow(i);
+      const double* wf = rows->GetVariableLength<double>("wf",n);
+      const double* wfc = static_cast<const double*>(columns->GetVariableLength(0,i,nc));
+      ENSURE_EQUAL( rows->Get<int>("int"), int(i), "Read int is equal to set int.");
+      ENSURE_EQUAL( n, i % 5, "Every row has its own length");
+      ENSURE_EQUAL( nc, n, "Read column is equal to read row");
+      if (n > 0) {
+         ENSURE_EQUAL( wf[n-1], 0.5*i, "Read elements are equal to set elements.");
+         ENSURE_EQUAL( wfc[n-1], 0.5*i, "Read column is equal to read row");
+      }
+   }
+   reader_service->Finish();
+   boost::filesystem::remove(filename);
+}
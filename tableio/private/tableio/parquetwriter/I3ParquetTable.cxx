@@ -13,14 +13,20 @@
 
 #include <string>
 #include <cstdint>
+#include <algorithm>
 
 #include <arrow/api.h>
 #include <arrow/io/file.h>
+#include <parquet/arrow/reader.h>
 #include <parquet/arrow/writer.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+#include <parquet/statistics.h>
 #include <boost/filesystem.hpp>
 
 #include <tableio/I3Table.h>
 #include <tableio/I3TableRow.h>
+#include <tableio/I3TableColumns.h>
 #include <tableio/I3TableService.h>
 
 #include "I3ParquetTable.h"
@@ -32,13 +38,19 @@ I3ParquetTable::I3ParquetTable(I3TableService &service,
                                std::string tableName,
                                I3TableRowDescriptionConstPtr description,
                                boost::filesystem::path folder_path,
-                               parquet::Compression::type compression = parquet::Compression::UNCOMPRESSED)
+                               parquet::Compression::type compression,
+                               size_t row_group_size,
+                               size_t row_group_bytes)
                                : I3Table(service,
                                          tableName,
                                          description)
 {
     folder_path_ = folder_path;
     compression_ = compression;
+    row_group_size_ = row_group_size;
+    row_group_bytes_ = row_group_bytes;
+    buffered_rows_ = 0;
+    buffered_bytes_ = 0;
     file_path_ = folder_path_ / (name_ + ".parquet" + get_compression_file_ending(compression_));
 
     num_fields_ = description_->GetFieldNames().size();
@@ -51,19 +63,128 @@ I3ParquetTable::I3ParquetTable(I3TableService &service,
     CreateTable();
 }
 
+I3ParquetTable::I3ParquetTable(I3TableService &service,
+                               std::string tableName,
+                               boost::filesystem::path file_path)
+                               : I3Table(service,
+                                         tableName,
+                                         I3TableRowDescriptionPtr())
+{
+    folder_path_ = file_path.parent_path();
+    file_path_ = file_path;
+    compression_ = parquet::Compression::UNCOMPRESSED;
+    row_group_size_ = 0;
+    row_group_bytes_ = 0;
+    buffered_rows_ = 0;
+    buffered_bytes_ = 0;
+    event_no_ = 0;
+    skip_fields_ = 0;
+
+    std::shared_ptr<arrow::io::ReadableFile> file;
+    PARQUET_ASSIGN_OR_THROW(file, arrow::io::ReadableFile::Open(file_path_.string()));
+    PARQUET_ASSIGN_OR_THROW(reader_, parquet::arrow::OpenFile(file, arrow::default_memory_pool()));
+    ReadDescription();
+    num_fields_ = description_->GetNumberOfFields();
+}
+
 I3ParquetTable::~I3ParquetTable()
 {
-    // create arrays from the builders
-    std::vector<std::shared_ptr<arrow::Array>> arrays = get_arrays(array_builders_);
-    // open parquet file
-    std::shared_ptr<arrow::io::FileOutputStream> out_file;
-    PARQUET_ASSIGN_OR_THROW(out_file, arrow::io::FileOutputStream::Open(file_path_.string()));
+    // files that are read have nothing to write
+    if (!writer_)
+        {return;}
 
-    // write the arrays to the parquet file
-    write_table(out_file, schema_, arrays, compression_);
+    // write the remaining rows, then the file footer
+    if (buffered_rows_ > 0)
+        {FlushRowGroup();}
+    PARQUET_THROW_NOT_OK(writer_->Close());
 
     // close parquet file
-    PARQUET_THROW_NOT_OK(out_file->Close());
+    PARQUET_THROW_NOT_OK(out_file_->Close());
+}
+
+void I3ParquetTable::ReadDescription()
+{
+    std::shared_ptr<arrow::Schema> schema;
+    PARQUET_THROW_NOT_OK(reader_->GetSchema(&schema));
+    const int event_no_index = schema->GetFieldIndex("event_no");
+    if (event_no_index != schema->num_fields() - 1)
+        {log_fatal("%s has no event_no column after the fields.", file_path_.c_str());}
+
+    // every field has to be a single column, so that the indices of the
+    // fields are those of their columns
+    I3TableRowDescriptionPtr description(new I3TableRowDescription());
+    std::pair<std::vector<std::string>, std::vector<std::shared_ptr<arrow::DataType>>> fields = get_fields(schema);
+    for (size_t i = 0; i < fields.first.size(); i++) {
+        std::shared_ptr<arrow::DataType> type = fields.second[i];
+        size_t array_length = 1;
+        if (type->id() == arrow::Type::LIST) {
+            // list columns are variable-length fields
+            type = std::static_pointer_cast<arrow::ListType>(type)->value_type();
+            array_length = 0;
+        }
+        I3Datatype i3type;
+        switch (type->id()) {
+            case arrow::Type::FLOAT: i3type = I3DatatypeFromNativeType<float>(); break;
+            case arrow::Type::DOUBLE: i3type = I3DatatypeFromNativeType<double>(); break;
+            case arrow::Type::INT8: i3type = I3DatatypeFromNativeType<int8_t>(); break;
+            case arrow::Type::INT16: i3type = I3DatatypeFromNativeType<int16_t>(); break;
+            case arrow::Type::INT32: i3type = I3DatatypeFromNativeType<int32_t>(); break;
+            case arrow::Type::INT64: i3type = I3DatatypeFromNativeType<int64_t>(); break;
+            case arrow::Type::UINT8: i3type = I3DatatypeFromNativeType<uint8_t>(); break;
+            case arrow::Type::UINT16: i3type = I3DatatypeFromNativeType<uint16_t>(); break;
+            case arrow::Type::UINT32: i3type = I3DatatypeFromNativeType<uint32_t>(); break;
+            case arrow::Type::UINT64: i3type = I3DatatypeFromNativeType<uint64_t>(); break;
+            case arrow::Type::BOOL: i3type = I3DatatypeFromNativeType<bool>(); break;
+            default:
+                log_fatal("Can't read arrow type '%s' (file: '%s', field: '%s').", fields.second[i]->ToString().c_str(), file_path_.c_str(), fields.first[i].c_str());
+        }
+        description->AddField(fields.first[i], i3type, "", "", array_length);
+    }
+    description_ = description;
+
+    // the rows of an event are never split between row groups, so the
+    // event_no range of each row group tells where to find an event
+    std::shared_ptr<parquet::FileMetaData> metadata = reader_->parquet_reader()->metadata();
+    nrows_ = metadata->num_rows();
+    nevents_ = 0;
+    for (int n = 0; n < reader_->num_row_groups(); n++) {
+        std::shared_ptr<parquet::Statistics> statistics = metadata->RowGroup(n)->ColumnChunk(event_no_index)->statistics();
+        uint64_t first, last;
+        if (statistics && statistics->HasMinMax()) {
+            // uint64 columns are stored as int64 that are ordered as unsigned
+            std::shared_ptr<parquet::Int64Statistics> event_nos = std::static_pointer_cast<parquet::Int64Statistics>(statistics);
+            first = static_cast<uint64_t>(event_nos->min());
+            last = static_cast<uint64_t>(event_nos->max());
+        }
+        else {
+            std::shared_ptr<arrow::Table> table;
+            PARQUET_THROW_NOT_OK(reader_->ReadRowGroup(n, {event_no_index}, &table));
+            PARQUET_ASSIGN_OR_THROW(table, table->CombineChunks());
+            std::shared_ptr<arrow::UInt64Array> event_nos = std::static_pointer_cast<arrow::UInt64Array>(table->column(0)->chunk(0));
+            first = event_nos->Value(0);
+            last = event_nos->Value(event_nos->length() - 1);
+        }
+        row_group_events_.push_back(std::make_pair(first, last));
+        nevents_ = std::max<size_t>(nevents_, last + 1);
+    }
+}
+
+void I3ParquetTable::FlushRowGroup()
+{
+    // create arrays from the builders, which are reset and can be filled again
+    std::vector<std::shared_ptr<arrow::Array>> arrays = get_arrays(array_builders_);
+    std::shared_ptr<arrow::Table> table = arrow::Table::Make(schema_, arrays);
+    PARQUET_THROW_NOT_OK(writer_->WriteTable(*table, table->num_rows()));
+
+    buffered_rows_ = 0;
+    buffered_bytes_ = 0;
+
+    // the next row group will be about as large as this one
+    if (row_group_size_ > 0) {
+        for (std::shared_ptr<arrow::ArrayBuilder> &array_builder : array_builders_) {
+            PARQUET_THROW_NOT_OK(array_builder->Reserve(row_group_size_));
+        }
+    }
 }
 
 void I3ParquetTable::CreateTable()
@@ -87,6 +208,12 @@ void I3ParquetTable::CreateTable()
         log_fatal("For some I3Datatypes no corresponding SQLite arrow::DataType was found.");
     }
 
+    // variable-length fields become list columns
+    for (size_t i = 0; i < field_types.size(); i++) {
+        if (description_->IsVariableLength(i))
+            {field_types[i] = arrow::list(field_types[i]);}
+    }
+
     // skip first skip_fields_ fields
     field_names.erase(field_names.begin(), field_names.begin()+skip_fields_);
     field_types.erase(field_types.begin(), field_types.begin()+skip_fields_);
@@ -94,10 +221,22 @@ void I3ParquetTable::CreateTable()
     // create arrow schema and array builders
     array_builders_ = get_array_builders(field_types);
     schema_ = get_schema(field_names, field_types);
+
+    // open parquet file, row groups are written to it as they fill up
+    PARQUET_ASSIGN_OR_THROW(out_file_, arrow::io::FileOutputStream::Open(file_path_.string()));
+    writer_ = open_writer(out_file_, schema_, compression_);
 }
 
 void I3ParquetTable::WriteRows(I3TableRowConstPtr row)
 {
+    // list columns are only built from columns
+    if (description_->HasVariableLengthFields()) {
+        I3TableColumns columns(description_);
+        columns.append(*row);
+        WriteColumns(columns, 0, columns.GetNumberOfRows());
+        return;
+    }
+
     I3TableRowPtr rows = boost::const_pointer_cast<I3TableRow>(row);
     rows->SetEnumsAreInts(true);
     I3Datatype type;
@@ -168,7 +307,236 @@ void I3ParquetTable::WriteRows(I3TableRowConstPtr row)
         PARQUET_THROW_NOT_OK(std::static_pointer_cast<arrow::UInt64Builder>(array_builders_[num_fields_-skip_fields_])->Append(event_no_));
     }
     rows->SetEnumsAreInts(false);
+    EventWritten(rows->GetNumberOfRows());
+}
+
+namespace {
+
+template <typename Builder, typename T>
+void append_column(const std::shared_ptr<arrow::ArrayBuilder> &array_builder,
+                   const I3TableColumns &columns, size_t index, size_t start, size_t nrows)
+{
+    // like WriteRows, only the first element of array fields is written
+    const size_t length = columns.GetDescription()->GetFieldArrayLengths()[index];
+    if (length == 0) {
+        // a list of all elements for variable-length fields
+        arrow::ListBuilder* list_builder = static_cast<arrow::ListBuilder*>(array_builder.get());
+        Builder* builder = static_cast<Builder*>(list_builder->value_builder());
+        for (size_t n = 0; n < nrows; n++) {
+            size_t nelements;
+            const T* elements = static_cast<const T*>(columns.GetVariableLength(index, start + n, nelements));
+            PARQUET_THROW_NOT_OK(list_builder->Append());
+            PARQUET_THROW_NOT_OK(builder->AppendValues(elements, nelements));
+        }
+        return;
+    }
+    const T* values = static_cast<const T*>(columns.GetPointerToColumn(index)) + start*length;
+    Builder* builder = static_cast<Builder*>(array_builder.get());
+    if (length == 1) {
+        PARQUET_THROW_NOT_OK(builder->AppendValues(values, nrows));
+    }
+    else {
+        for (size_t n = 0; n < nrows; n++) {
+            PARQUET_THROW_NOT_OK(builder->Append(values[n*length]));
+        }
+    }
+}
+
+}
+
+namespace {
+
+template <typename Array, typename T>
+void read_column(const std::shared_ptr<arrow::Array> &array, I3TableColumns &columns,
+                 size_t index, size_t start, int64_t offset, size_t nrows)
+{
+    if (columns.GetDescription()->IsVariableLength(index)) {
+        const arrow::ListArray &lists = static_cast<const arrow::ListArray&>(*array);
+        const Array &values = static_cast<const Array&>(*lists.values());
+        for (size_t n = 0; n < nrows; n++) {
+            const int64_t row = offset + n;
+            T* elements = static_cast<T*>(columns.AddVariableLength(index, start + n, lists.value_length(row)));
+            for (int64_t k = 0; k < lists.value_length(row); k++) {
+                elements[k] = values.Value(lists.value_offset(row) + k);
+            }
+        }
+        return;
+    }
+    const Array &values = static_cast<const Array&>(*array);
+    T* column = static_cast<T*>(columns.GetPointerToColumn(index)) + start;
+    for (size_t n = 0; n < nrows; n++) {
+        column[n] = values.Value(offset + n);
+    }
+}
+
+}
+
+void I3ParquetTable::ReadEvents(I3TableColumns& columns, const std::vector<size_t>& fieldIndices,
+                                size_t firstEvent, size_t endEvent) const
+{
+    if (!reader_)
+        {log_fatal("(%s) Only tables of files opened with mode 'r' can be read.", name_.c_str());}
+
+    std::vector<int> row_groups;
+    for (size_t n = 0; n < row_group_events_.size(); n++) {
+        if (row_group_events_[n].second >= firstEvent && row_group_events_[n].first < endEvent)
+            {row_groups.push_back(n);}
+    }
+    if (row_groups.empty())
+        {return;}
+
+    // the fields are the columns in front of event_no, so their indices are
+    // those of the description
+    std::vector<int> column_indices(fieldIndices.begin(), fieldIndices.end());
+    column_indices.push_back(num_fields_);
+    std::shared_ptr<arrow::Table> table;
+    PARQUET_THROW_NOT_OK(reader_->ReadRowGroups(row_groups, column_indices, &table));
+    PARQUET_ASSIGN_OR_THROW(table, table->CombineChunks());
+
+    // the first and last row groups can hold events on either side of the range
+    std::shared_ptr<arrow::UInt64Array> event_nos = std::static_pointer_cast<arrow::UInt64Array>(table->column(fieldIndices.size())->chunk(0));
+    int64_t begin = 0;
+    int64_t end = table->num_rows();
+    while (begin < end && event_nos->Value(begin) < firstEvent)
+        {begin++;}
+    while (end > begin && event_nos->Value(end - 1) >= endEvent)
+        {end--;}
+    const size_t start = columns.AddRows(end - begin);
+
+    I3Datatype type;
+    for (size_t i = 0; i < fieldIndices.size(); i++) {
+        const std::shared_ptr<arrow::Array> &array = table->column(i)->chunk(0);
+        type = description_->GetFieldTypes()[fieldIndices[i]];
+        switch (type.kind) {
+            case I3Datatype::TypeClass::Float:
+                if (type.size == 4)
+                    {read_column<arrow::FloatArray, float>(array, columns, i, start, begin, end - begin);}
+                else
+                    {read_column<arrow::DoubleArray, double>(array, columns, i, start, begin, end - begin);}
+                break;
+            case I3Datatype::TypeClass::Int:
+                if (type.is_signed) {
+                    switch (type.size) {
+                        case 1:
+                            read_column<arrow::Int8Array, int8_t>(array, columns, i, start, begin, end - begin);
+                            break;
+                        case 2:
+                            read_column<arrow::Int16Array, int16_t>(array, columns, i, start, begin, end - begin);
+                            break;
+                        case 4:
+                            read_column<arrow::Int32Array, int32_t>(array, columns, i, start, begin, end - begin);
+                            break;
+                        default:
+                            read_column<arrow::Int64Array, int64_t>(array, columns, i, start, begin, end - begin);
+                    }
+                }
+                else {
+                    switch (type.size) {
+                        case 1:
+                            read_column<arrow::UInt8Array, uint8_t>(array, columns, i, start, begin, end - begin);
+                            break;
+                        case 2:
+                            read_column<arrow::UInt16Array, uint16_t>(array, columns, i, start, begin, end - begin);
+                            break;
+                        case 4:
+                            read_column<arrow::UInt32Array, uint32_t>(array, columns, i, start, begin, end - begin);
+                            break;
+                        default:
+                            read_column<arrow::UInt64Array, uint64_t>(array, columns, i, start, begin, end - begin);
+                    }
+                }
+                break;
+            default:
+                // bools are stored as one byte each
+                read_column<arrow::BooleanArray, uint8_t>(array, columns, i, start, begin, end - begin);
+        }
+    }
+}
+
+void I3ParquetTable::WriteColumns(const I3TableColumns& columns, size_t start, size_t nrows)
+{
+    I3Datatype type;
+    // append whole columns
+    for (size_t i = skip_fields_; i < num_fields_; i++) {
+        const std::shared_ptr<arrow::ArrayBuilder> &array_builder = array_builders_[i-skip_fields_];
+        type = description_->GetFieldTypes()[i];
+        switch (type.kind) {
+            case I3Datatype::TypeClass::Float:
+                switch (type.size) {
+                    case 4:
+                        append_column<arrow::FloatBuilder, float>(array_builder, columns, i, start, nrows);
+                        break;
+                    case 8:
+                        append_column<arrow::DoubleBuilder, double>(array_builder, columns, i, start, nrows);
+                        break;
+                    default:
+                        log_fatal("Can't handle floating points of size '%li' (field: '%s').", type.size, description_->GetFieldNames()[i].c_str());
+                }
+                break;
+            case I3Datatype::TypeClass::Int:
+            case I3Datatype::TypeClass::Enum:
+                if (type.is_signed) {
+                    switch (type.size) {
+                        case 1:
+                            append_column<arrow::Int8Builder, int8_t>(array_builder, columns, i, start, nrows);
+                            break;
+                        case 2:
+                            append_column<arrow::Int16Builder, int16_t>(array_builder, columns, i, start, nrows);
+                            break;
+                        case 4:
+                            append_column<arrow::Int32Builder, int32_t>(array_builder, columns, i, start, nrows);
+                            break;
+                        case 8:
+                            append_column<arrow::Int64Builder, int64_t>(array_builder, columns, i, start, nrows);
+                            break;
+                        default:
+                            log_fatal("Can't handle signed integers of size '%li' (field: '%s').", type.size, description_->GetFieldNames()[i].c_str());
+                    }
+                }
+                else {
+                    switch (type.size) {
+                        case 1:
+                            append_column<arrow::UInt8Builder, uint8_t>(array_builder, columns, i, start, nrows);
+                            break;
+                        case 2:
+                            append_column<arrow::UInt16Builder, uint16_t>(array_builder, columns, i, start, nrows);
+                            break;
+                        case 4:
+                            append_column<arrow::UInt32Builder, uint32_t>(array_builder, columns, i, start, nrows);
+                            break;
+                        case 8:
+                            append_column<arrow::UInt64Builder, uint64_t>(array_builder, columns, i, start, nrows);
+                            break;
+                        default:
+                            log_fatal("Can't handle unsigned integers of size '%li' (field: '%s').", type.size, description_->GetFieldNames()[i].c_str());
+                    }
+                }
+                break;
+            case I3Datatype::TypeClass::Bool:
+                // bools are stored as one byte each
+                append_column<arrow::BooleanBuilder, uint8_t>(array_builder, columns, i, start, nrows);
+                break;
+            default:
+                log_fatal("Can't handle type: '%s' (field: '%s').", type.AsString().c_str(), description_->GetFieldNames()[i].c_str());
+        }
+    }
+    std::shared_ptr<arrow::UInt64Builder> event_no_builder = std::static_pointer_cast<arrow::UInt64Builder>(array_builders_[num_fields_-skip_fields_]);
+    for (size_t n = 0; n < nrows; n++) {
+        PARQUET_THROW_NOT_OK(event_no_builder->Append(event_no_));
+    }
+    EventWritten(nrows);
+}
+
+void I3ParquetTable::EventWritten(size_t nrows)
+{
+    buffered_rows_ += nrows;
+    buffered_bytes_ += nrows*description_->GetTotalByteSize();
     event_no_++;
+
+    // flush between events, so that the rows of an event share a row group
+    if ((row_group_size_ > 0 && buffered_rows_ >= row_group_size_) ||
+        (row_group_bytes_ > 0 && buffered_bytes_ >= row_group_bytes_))
+        {FlushRowGroup();}
 }
 
 std::shared_ptr<arrow::DataType> I3ParquetTable::GetArrowType(const I3Datatype &type) const
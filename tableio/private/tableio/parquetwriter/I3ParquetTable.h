@@ -20,11 +20,13 @@
 
 #include <arrow/api.h>
 #include <arrow/io/file.h>
+#include <parquet/arrow/reader.h>
 #include <parquet/arrow/writer.h>
 #include <boost/filesystem.hpp>
 
 #include <tableio/I3Table.h>
 #include <tableio/I3TableRow.h>
+#include <tableio/I3TableColumns.h>
 #include <tableio/I3TableService.h>
 
 I3_FORWARD_DECLARATION(I3TableService);
@@ -40,24 +42,58 @@ public:
                    std::string tableName,
                    I3TableRowDescriptionConstPtr description,
                    boost::filesystem::path folder_path,
-                   parquet::Compression::type compression);
+                   parquet::Compression::type compression,
+                   size_t row_group_size = 0,
+                   size_t row_group_bytes = 0);
+
+    // read the existing table in file_path
+    I3ParquetTable(I3TableService &service,
+                   std::string tableName,
+                   boost::filesystem::path file_path);
 
     virtual ~I3ParquetTable();
 
+    virtual bool PrefersColumns() const { return true; }
+
 protected:
     virtual void WriteRows(I3TableRowConstPtr row);
+    virtual void WriteColumns(const I3TableColumns& columns, size_t start, size_t nrows);
+
+    // read the row groups that hold the events, and only the columns of the fields
+    virtual void ReadEvents(I3TableColumns& columns, const std::vector<size_t>& fieldIndices,
+                            size_t firstEvent, size_t endEvent) const;
 
     void CreateTable();
 
+    // describe the columns of the file, except event_no, and find the
+    // events in each row group
+    void ReadDescription();
+
+    // write the buffered rows to the file as one row group
+    void FlushRowGroup();
+
+    // count the rows of an event and flush a row group if one is full
+    void EventWritten(size_t nrows);
+
 private:
     boost::filesystem::path folder_path_;
     boost::filesystem::path file_path_;
     parquet::Compression::type compression_;
     std::vector<std::shared_ptr<arrow::ArrayBuilder>> array_builders_;
     std::shared_ptr<arrow::Schema> schema_;
+    std::shared_ptr<arrow::io::FileOutputStream> out_file_;
+    std::shared_ptr<parquet::arrow::FileWriter> writer_;
     size_t num_fields_;
     size_t event_no_;
     uint8_t skip_fields_;
+    // flush a row group after this many rows or bytes (0: no limit)
+    size_t row_group_size_;
+    size_t row_group_bytes_;
+    size_t buffered_rows_;
+    size_t buffered_bytes_;
+    // the first and last event_no of each row group of a file that is read
+    std::shared_ptr<parquet::arrow::FileReader> reader_;
+    std::vector<std::pair<uint64_t, uint64_t>> row_group_events_;
 
     std::shared_ptr<arrow::DataType> GetArrowType(const I3Datatype &type) const;
 
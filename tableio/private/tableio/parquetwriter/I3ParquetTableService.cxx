@@ -30,21 +30,46 @@
 
 
 I3ParquetTableService::I3ParquetTableService(boost::filesystem::path folder_path,
-                                             std::string compression = "uncompressed")
+                                             std::string compression,
+                                             size_t row_group_size,
+                                             size_t row_group_bytes,
+                                             char mode)
                                              : I3TableService()
 {
     folder_path_ = folder_path;
-    boost::filesystem::create_directory(folder_path_);
     compression_ = get_compression_type(compression);
+    row_group_size_ = row_group_size;
+    row_group_bytes_ = row_group_bytes;
+    if (mode == 'w')
+        {boost::filesystem::create_directory(folder_path_);}
+    else if (mode == 'r')
+        {FindTables();}
+    else
+        {log_fatal("Unsupported file mode '%c'", mode);}
 }
 
 I3ParquetTableService::~I3ParquetTableService()
-{}
+{
+    JoinWriter();
+}
+
+void I3ParquetTableService::FindTables()
+{
+    // tables are written to <name>.parquet, with the ending of the compression
+    for (const boost::filesystem::directory_entry &entry : boost::filesystem::directory_iterator(folder_path_)) {
+        const std::string file_name = entry.path().filename().string();
+        const size_t ending = file_name.find(".parquet");
+        if (ending == std::string::npos || !boost::filesystem::is_regular_file(entry.path()))
+            {continue;}
+        const std::string table_name = file_name.substr(0, ending);
+        tables_[table_name] = I3TablePtr(new I3ParquetTable(*this, table_name, entry.path()));
+    }
+}
 
 I3TablePtr I3ParquetTableService::CreateTable(const std::string &tableName,
                                               I3TableRowDescriptionConstPtr description)
 {
-    return I3TablePtr(new I3ParquetTable(*this, tableName, description, folder_path_, compression_));
+    return I3TablePtr(new I3ParquetTable(*this, tableName, description, folder_path_, compression_, row_group_size_, row_group_bytes_));
 }
 
 void I3ParquetTableService::CloseFile()
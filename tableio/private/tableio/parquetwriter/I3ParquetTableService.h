@@ -33,8 +33,18 @@
 class I3ParquetTableService : public I3TableService {
 
 public:
+    /**
+     * Tables are written in row groups of at most row_group_size rows or
+     * about row_group_bytes bytes, whichever fills up first (0: no limit).
+     * With both limits at 0 each table is a single row group written when
+     * the file is closed. With mode 'r' the tables of the files in
+     * folder_path can be read with ReadColumns.
+     */
     I3ParquetTableService(boost::filesystem::path folder_path,
-                          std::string compression);
+                          std::string compression = "uncompressed",
+                          size_t row_group_size = 100000,
+                          size_t row_group_bytes = 64 << 20,
+                          char mode = 'w');
 
     virtual ~I3ParquetTableService();
 
@@ -44,9 +54,16 @@ protected:
 
     virtual void CloseFile();
 
+    // open a table for every parquet file in the folder
+    void FindTables();
+
 private:
     boost::filesystem::path folder_path_;
     parquet::Compression::type compression_;
+    size_t row_group_size_;
+    size_t row_group_bytes_;
+
+SET_LOGGER("I3ParquetTableService");
 };
 
 
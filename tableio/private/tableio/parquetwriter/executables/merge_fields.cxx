@@ -17,6 +17,8 @@
 #include <vector>
 #include <map>
 #include <unordered_set>
+#include <future>
+#include <thread>
 
 #include <arrow/api.h>
 #include <arrow/io/file.h>
@@ -42,7 +44,8 @@ po::variables_map parse_command_line_arguments(int argc, char* argv[]) {
         ("help,h", "Show this help message and exit.")
         ("out_path,o", po::value<std::string>()->required(), "The path of the output parquet file.")
         ("parquet_paths,i", po::value<std::vector<std::string>>()->multitoken()->default_value({}, "{}"), "The paths of the parquet files to be merged.")
-        ("compression,c", po::value<std::string>()->default_value("uncompressed"), "The compression type to use for the out file.");;
+        ("compression,c", po::value<std::string>()->default_value("uncompressed"), "The compression type to use for the out file.")
+        ("threads,j", po::value<size_t>()->default_value(std::max(std::thread::hardware_concurrency(), 1u)), "The number of threads reading the parquet files.");
     // parse options
     po::variables_map vm;
     try {
@@ -79,6 +82,7 @@ int main(int argc, char* argv[]) {
     boost::filesystem::path out_path = vm["out_path"].as<std::string>();
     std::vector<boost::filesystem::path> parquet_paths = convert_vec_type<boost::filesystem::path>(vm["parquet_paths"].as<std::vector<std::string>>());
     parquet::Compression::type compression = get_compression_type(vm["compression"].as<std::string>());
+    size_t num_threads = std::max(vm["threads"].as<size_t>(), size_t(1));
 
     // if parquet_paths is empty prompt for them
     if (parquet_paths.empty()) {
@@ -200,29 +204,48 @@ int main(int argc, char* argv[]) {
     std::shared_ptr<parquet::arrow::FileWriter> out_writer;
     PARQUET_ASSIGN_OR_THROW(out_writer, parquet::arrow::FileWriter::Open(*merged_schema, arrow::default_memory_pool(), out_file, writer_props_builder.build(), arrow_writer_props_builder.build()));
 
+    // open every file once and keep its reader for all row groups
+    std::vector<std::shared_ptr<arrow::io::ReadableFile>> files(parquet_paths.size());
+    std::vector<std::shared_ptr<parquet::arrow::FileReader>> readers(parquet_paths.size());
+    for (size_t j = 0; j < parquet_paths.size(); j++) {
+        PARQUET_ASSIGN_OR_THROW(files[j], arrow::io::ReadableFile::Open(parquet_paths[j].string()));
+        PARQUET_ASSIGN_OR_THROW(readers[j], parquet::arrow::OpenFile(files[j], arrow::default_memory_pool()));
+    }
+    num_threads = std::min(num_threads, parquet_paths.size());
+
     // loop over all row groups
+    std::vector<std::shared_ptr<arrow::Table>> tables(parquet_paths.size());
+    std::vector<std::future<void>> workers;
     std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
-    std::shared_ptr<arrow::Table> table;
     std::vector<std::shared_ptr<arrow::ChunkedArray>> merged_columns;
     std::vector<std::shared_ptr<arrow::ChunkedArray>> event_no_columns;
     std::shared_ptr<arrow::Table> merged_table;
     for (size_t n = 0; n < num_row_groups; n++) {
 
-        // loop over all files and merge their respective row groups
-        for (boost::filesystem::path parquet_path : parquet_paths) {
-            PARQUET_ASSIGN_OR_THROW(file, arrow::io::ReadableFile::Open(parquet_path.string()));
-            PARQUET_ASSIGN_OR_THROW(reader, parquet::arrow::OpenFile(file, arrow::default_memory_pool()));
+        // read the row group of all files in parallel, every reader is only used by one thread
+        for (size_t t = 0; t < num_threads; t++) {
+            workers.push_back(std::async(std::launch::async, [&, t]() {
+                for (size_t j = t; j < readers.size(); j += num_threads) {
+                    PARQUET_THROW_NOT_OK(readers[j]->RowGroup(n)->ReadTable(&tables[j]));
+                }
+            }));
+        }
+        for (std::future<void> &worker : workers) {
+            worker.get();
+        }
+        workers.clear();
 
-            // read the row group
-            PARQUET_THROW_NOT_OK(reader->RowGroup(n)->ReadTable(&table));
-            columns = table->columns();
+        // merge the columns of the files' row groups
+        for (size_t j = 0; j < parquet_paths.size(); j++) {
+            columns = tables[j]->columns();
 
             // save the event_no column
-            event_no_columns.push_back(columns[event_no_idcs_map[parquet_path]]);
+            event_no_columns.push_back(columns[event_no_idcs_map[parquet_paths[j]]]);
 
             // delete the event_no column and insert into merged columns
-            columns.erase(columns.begin() + event_no_idcs_map[parquet_path]);
+            columns.erase(columns.begin() + event_no_idcs_map[parquet_paths[j]]);
             merged_columns.insert(merged_columns.end(), columns.begin(), columns.end());
+            tables[j].reset();
         }
 
         // check that the row groups all have the same number of rows
@@ -242,8 +265,13 @@ int main(int argc, char* argv[]) {
         merged_table = arrow::Table::Make(merged_schema, merged_columns);
         PARQUET_THROW_NOT_OK(out_writer->WriteTable(*merged_table, merged_table->num_rows()));
 
-        reader.reset();
-        PARQUET_THROW_NOT_OK(file->Close());
+        merged_columns.clear();
+        event_no_columns.clear();
+    }
+
+    for (size_t j = 0; j < parquet_paths.size(); j++) {
+        readers[j].reset();
+        PARQUET_THROW_NOT_OK(files[j]->Close());
     }
 
     merged_schema.reset();
@@ -243,18 +243,29 @@ std::string get_compression_file_ending(const parquet::Compression::type &compre
 
 
 inline
-void write_table(const std::shared_ptr<arrow::io::FileOutputStream> &out_file, const std::shared_ptr<arrow::Schema> &schema, const std::vector<std::shared_ptr<arrow::Array>> &arrays, const parquet::Compression::type &compression) {
-    // write an arrow table to a parquet file
-
-    // create arrow table
-    std::shared_ptr<arrow::Table> table = arrow::Table::Make(schema, arrays);
+std::shared_ptr<parquet::arrow::FileWriter> open_writer(const std::shared_ptr<arrow::io::FileOutputStream> &out_file, const std::shared_ptr<arrow::Schema> &schema, const parquet::Compression::type &compression) {
+    // open a parquet writer that writes column statistics, so that readers can skip row groups
 
-    // set parquet writer and writer properties
     parquet::WriterProperties::Builder writer_props_builder;
     writer_props_builder.compression(compression);
+    writer_props_builder.enable_statistics();
     parquet::ArrowWriterProperties::Builder arrow_writer_props_builder;
     std::shared_ptr<parquet::arrow::FileWriter> writer;
     PARQUET_ASSIGN_OR_THROW(writer, parquet::arrow::FileWriter::Open(*schema, arrow::default_memory_pool(), out_file, writer_props_builder.build(), arrow_writer_props_builder.build()));
+
+    return writer;
+}
+
+
+inline
+void write_table(const std::shared_ptr<arrow::io::FileOutputStream> &out_file, const std::shared_ptr<arrow::Schema> &schema, const std::vector<std::shared_ptr<arrow::Array>> &arrays, const parquet::Compression::type &compression) {
+    // write an arrow table to a parquet file
+
+    // create arrow table
+    std::shared_ptr<arrow::Table> table = arrow::Table::Make(schema, arrays);
+
+    // open parquet writer
+    std::shared_ptr<parquet::arrow::FileWriter> writer = open_writer(out_file, schema, compression);
     // write the table to the parquet file and close writer
     PARQUET_THROW_NOT_OK(writer->WriteTable(*table, table->num_rows()));
     PARQUET_THROW_NOT_OK(writer->Close());
@@ -369,11 +380,7 @@ std::pair<std::shared_ptr<arrow::io::FileOutputStream>, std::shared_ptr<parquet:
     // open append file
     std::shared_ptr<arrow::io::FileOutputStream> file_append;
     PARQUET_ASSIGN_OR_THROW(file_append, arrow::io::FileOutputStream::Open(path));
-    parquet::WriterProperties::Builder writer_props_builder;
-    writer_props_builder.compression(compression);
-    parquet::ArrowWriterProperties::Builder arrow_writer_props_builder;
-    std::shared_ptr<parquet::arrow::FileWriter> writer;
-    PARQUET_ASSIGN_OR_THROW(writer, parquet::arrow::FileWriter::Open(*schema, arrow::default_memory_pool(), file_append, writer_props_builder.build(), arrow_writer_props_builder.build()));
+    std::shared_ptr<parquet::arrow::FileWriter> writer = open_writer(file_append, schema, compression);
 
     // loop over all row groups in the copied file and insert into the append file
     std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
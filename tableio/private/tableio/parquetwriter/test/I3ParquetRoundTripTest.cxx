@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2025 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <parquet/arrow/reader.h>
+#include <boost/filesystem.hpp>
+
+#include <tableio/I3TableRow.h>
+#include <tableio/I3TableColumns.h>
+#include <tableio/I3TableRowDescription.h>
+#include <tableio/parquetwriter/I3ParquetTableService.h>
+
+#include <dataclasses/physics/I3EventHeader.h>
+
+TEST_GROUP(I3ParquetRoundTripTests);
+
+namespace {
+
+// 1-3 rows per event, with 0-3 charges each
+size_t nrows(size_t event) { return 1 + event % 3; }
+size_t ncharges(size_t event, size_t row) { return (event + row) % 4; }
+float charge(size_t event, size_t row, size_t n) { return event + 0.25*row + 0.01*n; }
+
+// the pulses of nevents events, in row groups of 50 rows
+void write(const boost::filesystem::path& folder, size_t nevents) {
+   // small row groups, so that lists span several of them
+   I3ParquetTableService service(folder, "uncompressed", 50);
+   I3TableRowDescriptionPtr desc(new I3TableRowDescription(*service.GetIndexDescription()));
+   desc->AddField<int32_t>("row","","doc");
+   desc->AddVariableLengthField<float>("charge","PE","doc");
+   desc->SetIsMultiRow(true);
+   I3TablePtr table = service.GetTable("pulses",desc);
+
+   for (size_t i=0; i<nevents; i++) {
+      I3EventHeaderPtr header(new I3EventHeader());
+      header->SetEventID(i);
+      I3TableRowPtr rows = table->CreateRow(nrows(i));
+      for (size_t r=0; r<nrows(i); r++) {
+         rows->SetCurrentRow(r);
+         rows->Set<int32_t>("row",int32_t(r));
+         std::vector<float> charges;
+         for (size_t n=0; n<ncharges(i,r); n++)
+            charges.push_back(charge(i,r,n));
+         rows->SetVariableLength("charge",charges.data(),charges.size());
+      }
+      // write the odd events through columns and the even ones as rows
+      if (i % 2) {
+         I3TableColumnsPtr columns(new I3TableColumns(desc));
+         columns->append(*rows);
+         table->AddColumns(header,columns,0,nrows(i));
+      } else {
+         table->AddRow(header,rows);
+      }
+   }
+   service.Finish();
+}
+
+}
+
+TEST(variable_length) {
+   const boost::filesystem::path folder("I3ParquetRoundTripTest");
+   const size_t nevents = 200;
+   boost::filesystem::remove_all(folder);
+   write(folder,nevents);
+
+   std::shared_ptr<arrow::io::ReadableFile> file;
+   std::unique_ptr<parquet::arrow::FileReader> reader;
+   std::shared_ptr<arrow::Table> table;
+   PARQUET_ASSIGN_OR_THROW(file, arrow::io::ReadableFile::Open((folder / "pulses.parquet").string()));
+   PARQUET_ASSIGN_OR_THROW(reader, parquet::arrow::OpenFile(file, arrow::default_memory_pool()));
+   ENSURE( reader->num_row_groups() > 1, "The rows are written in several row groups" );
+   PARQUET_THROW_NOT_OK(reader->ReadTable(&table));
+   PARQUET_ASSIGN_OR_THROW(table, table->CombineChunks());
+
+   std::shared_ptr<arrow::Field> field = table->schema()->GetFieldByName("charge");
+   ENSURE( field != nullptr, "The variable-length field is a column" );
+   ENSURE( field->type()->Equals(arrow::list(arrow::float32())), "It is a list of its type" );
+
+   std::shared_ptr<arrow::ListArray> charges =
+      std::static_pointer_cast<arrow::ListArray>(table->GetColumnByName("charge")->chunk(0));
+   std::shared_ptr<arrow::FloatArray> values =
+      std::static_pointer_cast<arrow::FloatArray>(charges->values());
+   std::shared_ptr<arrow::Int32Array> row =
+      std::static_pointer_cast<arrow::Int32Array>(table->GetColumnByName("row")->chunk(0));
+   std::shared_ptr<arrow::UInt64Array> event_no =
+      std::static_pointer_cast<arrow::UInt64Array>(table->GetColumnByName("event_no")->chunk(0));
+
+   int64_t n = 0;
+   for (size_t i=0; i<nevents; i++) {
+      for (size_t r=0; r<nrows(i); r++, n++) {
+         ENSURE( n < table->num_rows(), "Every row made it to disk" );
+         ENSURE_EQUAL( event_no->Value(n), uint64_t(i), "Rows carry the number of their event" );
+         ENSURE_EQUAL( row->Value(n), int32_t(r) );
+         ENSURE_EQUAL( size_t(charges->value_length(n)), ncharges(i,r), "Every row has its own length" );
+         for (size_t k=0; k<ncharges(i,r); k++)
+            ENSURE_EQUAL( values->Value(charges->value_offset(n) + k), charge(i,r,k),
+                          "Read elements are equal to set elements" );
+      }
+   }
+   ENSURE_EQUAL( table->num_rows(), n, "No rows are added" );
+   boost::filesystem::remove_all(folder);
+}
+
+TEST(read_columns) {
+   const boost::filesystem::path folder("I3ParquetRoundTripTest_read");
+   const size_t nevents = 200;
+   boost::filesystem::remove_all(folder);
+   write(folder,nevents);
+
+   I3ParquetTableService service(folder, "uncompressed", 0, 0, 'r');
+   I3TablePtr table = service.GetTable("pulses",I3TableRowDescriptionConstPtr());
+   ENSURE( table != NULL, "The table is found in the folder" );
+   ENSURE_EQUAL( table->GetNumberOfEvents(), nevents );
+
+   // events [60,90) are spread over several row groups
+   std::vector<std::string> fields(1,"charge");
+   fields.push_back("row");
+   I3TableColumnsConstPtr columns = table->ReadColumns(fields,60,90);
+   ENSURE( columns->GetDescription()->IsVariableLength(0), "List columns are variable-length fields" );
+   size_t n = 0;
+   for (size_t i=60; i<90; i++) {
+      for (size_t r=0; r<nrows(i); r++, n++) {
+         ENSURE( n < columns->GetNumberOfRows(), "Every row of the events is read" );
+         ENSURE_EQUAL( columns->GetColumn<int32_t>("row")[n], int32_t(r) );
+         size_t ncharge;
+         const float* charges = static_cast<const float*>(columns->GetVariableLength(0,n,ncharge));
+         ENSURE_EQUAL( ncharge, ncharges(i,r), "Every row has its own length" );
+         for (size_t k=0; k<ncharge; k++)
+            ENSURE_EQUAL( charges[k], charge(i,r,k), "Read elements are equal to written elements" );
+      }
+   }
+   ENSURE_EQUAL( columns->GetNumberOfRows(), n, "Rows of other events are left out" );
+   ENSURE_EQUAL( table->ReadColumns(fields,nevents,nevents+10)->GetNumberOfRows(), 0u );
+
+   service.Finish();
+   boost::filesystem::remove_all(folder);
+}
@@ -23,6 +23,10 @@ class TBranch;
 class TTree;
 
 
+// the ROOT type code of a leaf holding the given type
+char I3DatatypeToROOTType(const I3Datatype &type);
+
+
 class I3ROOTBranchWrapperData : public I3ROOTBranchWrapper {
 public:
   I3ROOTBranchWrapperData();
@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "I3ROOTBranchWrapperVariableLength.h"
+#include "I3ROOTBranchWrapperData.h"
+
+#include <icetray/I3Logging.h>
+#include <tableio/I3Datatype.h>
+#include <tableio/I3TableRow.h>
+
+#include <TBranch.h>
+#include <TTree.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+
+I3ROOTBranchWrapperVariableLength::I3ROOTBranchWrapperVariableLength(TTree *tree,
+								     const I3Datatype &type,
+								     const std::string &branchname,
+								     const std::string &docstring,
+								     unsigned int index,
+								     const I3ROOTBranchWrapperConstPtr &counter)
+  : I3ROOTBranchWrapper(tree, index, 0, (bool)counter),
+    datasize_(type.size), rootCharArrayHack_(false), rootCharArrayIsSigned_(true),
+    count_(0), data_(type.size), lengths_(1), lengthBranch_(0)
+{
+  // the number of elements in the event, as an Int_t leaf so that
+  // ROOT and uproot read <name>[n<name>] as a variable-length array
+  std::string countname = "n" + branchname;
+  TBranch *countbranch = tree->Branch(countname.c_str(), &count_,
+				      (countname + "/I").c_str());
+  countbranch->SetTitle(("Number of elements of " + branchname).c_str());
+
+  // the number of elements in each row
+  if (multirow_) {
+    std::string lengthname = branchname + "_length";
+    std::string lengthdescription = lengthname + "[" + counter->Branch()->GetName() + "]/I";
+    lengthBranch_ = tree->Branch(lengthname.c_str(), &lengths_[0],
+				 lengthdescription.c_str());
+    lengthBranch_->SetTitle(("Number of elements of " + branchname + " in each row").c_str());
+  }
+
+  // arrays of bytes are booked as shorts, see I3ROOTBranchWrapperData
+  char typechar = I3DatatypeToROOTType(type);
+  if (typechar == 'B' || typechar == 'b') {
+    rootCharArrayHack_ = true;
+    rootCharArrayIsSigned_ = (typechar == 'B');
+    typechar = rootCharArrayIsSigned_ ? 'S' : 's';
+    datasize_ = sizeof(int16_t);
+    data_.resize(datasize_);
+  }
+
+  std::string leafdescription = branchname + "[" + countname + "]/" + typechar;
+  TBranch *branch = tree->Branch(branchname.c_str(), &data_[0],
+				 leafdescription.c_str());
+  branch->SetTitle(docstring.c_str());
+  SetBranch(branch);
+}
+
+I3ROOTBranchWrapperVariableLength::~I3ROOTBranchWrapperVariableLength() {}
+
+void I3ROOTBranchWrapperVariableLength::Fill(const I3TableRowConstPtr &data)
+{
+  const size_t nrows = data->GetNumberOfRows();
+  if (multirow_ && lengths_.size() < nrows) {
+    lengths_.resize(nrows);
+    lengthBranch_->SetAddress(&lengths_[0]);
+  }
+
+  size_t count = 0;
+  for (size_t row = 0; row < nrows; ++row) {
+    size_t n;
+    data->GetVariableLength(index_, row, n);
+    if (multirow_)
+      lengths_[row] = n;
+    count += n;
+  }
+  if (count > size_t(std::numeric_limits<Int_t>::max()))
+    log_fatal("(%s) %zu elements don't fit into a ROOT variable-length array.",
+	      branch_->GetName(), count);
+
+  // make sure we have enough room to store all elements
+  if (count*datasize_ > data_.size()) {
+    data_.resize(count*datasize_);
+    branch_->SetAddress(&data_[0]);
+  }
+
+  // copy the elements of all rows back to back
+  char *destination = &data_[0];
+  for (size_t row = 0; row < nrows; ++row) {
+    size_t n;
+    const void *source = data->GetVariableLength(index_, row, n);
+    if (!rootCharArrayHack_)
+      memcpy(destination, source, n*datasize_);
+    else if (rootCharArrayIsSigned_)
+      RootCharArrayHackFillData<int8_t, int16_t>(source, n, destination);
+    else
+      RootCharArrayHackFillData<uint8_t, uint16_t>(source, n, destination);
+    destination += n*datasize_;
+  }
+  count_ = count;
+}
+
+template <typename Source, typename Destination>
+void I3ROOTBranchWrapperVariableLength::RootCharArrayHackFillData(const void *source, size_t n,
+								   char *destination)
+{
+  const Source *values = static_cast<const Source*>(source);
+  std::copy(values, values + n, reinterpret_cast<Destination*>(destination));
+}
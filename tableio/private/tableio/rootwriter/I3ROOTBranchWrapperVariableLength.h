@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef ROOTWRITER_I3ROOTBRANCHWRAPPERVARIABLELENGTH_H_INCLUDED
+#define ROOTWRITER_I3ROOTBRANCHWRAPPERVARIABLELENGTH_H_INCLUDED
+
+#include "I3ROOTBranchWrapper.h"
+#include <icetray/I3PointerTypedefs.h>
+
+#include <string>
+#include <vector>
+
+#include <Rtypes.h>
+
+
+I3_FORWARD_DECLARATION(I3TableRow);
+
+struct I3Datatype;
+class TBranch;
+class TTree;
+
+
+/**
+ * Books a variable-length field as a standard ROOT variable-length array:
+ * an Int_t leaf n<name> with the number of elements, and <name>[n<name>]
+ * with the elements of all rows of the event back to back. In multi-row
+ * tables, <name>_length[Count_<table>] holds the number of elements of
+ * each row.
+ */
+class I3ROOTBranchWrapperVariableLength : public I3ROOTBranchWrapper {
+public:
+  I3ROOTBranchWrapperVariableLength(TTree *tree, const I3Datatype &type,
+				    const std::string &branchname,
+				    const std::string &docstring, unsigned int index,
+				    const I3ROOTBranchWrapperConstPtr &counter = I3ROOTBranchWrapperConstPtr());
+  virtual ~I3ROOTBranchWrapperVariableLength();
+
+  void Fill(const I3TableRowConstPtr &data);
+
+private:
+  size_t datasize_;
+  bool rootCharArrayHack_;
+  bool rootCharArrayIsSigned_;
+  Int_t count_;
+  std::vector<char> data_;
+  std::vector<Int_t> lengths_;
+  TBranch *lengthBranch_;
+
+  template <typename Source, typename Destination>
+  void RootCharArrayHackFillData(const void *source, size_t n, char *destination);
+};
+
+I3_POINTER_TYPEDEFS(I3ROOTBranchWrapperVariableLength);
+
+#endif // ROOTWRITER_I3ROOTBRANCHWRAPPERVARIABLELENGTH_H_INCLUDED
@@ -8,6 +8,7 @@
 #include "I3ROOTTable.h"
 #include "I3ROOTBranchWrapperData.h"
 #include "I3ROOTBranchWrapperEnum.h"
+#include "I3ROOTBranchWrapperVariableLength.h"
 #include <tableio/I3TableRow.h>
 #include <tableio/I3TableRowDescription.h>
 
@@ -41,6 +42,13 @@ I3ROOTTable::I3ROOTTable(I3TableService& service, const std::string& name,
     size_t arrayLength = description->GetFieldArrayLengths().at(field);
     std::string docstring = description->GetFieldDocStrings().at(field);
 
+    if (description->IsVariableLength(field)) {
+      I3ROOTBranchWrapperPtr branchwrapper(new I3ROOTBranchWrapperVariableLength(tree_,
+					   datatype, branchname, docstring, field, counter_));
+      branches_.push_back(branchwrapper);
+      continue;
+    }
+
     I3ROOTBranchWrapperPtr branchwrapper(new I3ROOTBranchWrapperData(tree_, datatype,
 					 branchname, docstring, field,
 					 arrayLength, counter_));
@@ -54,7 +54,9 @@ I3ROOTTableService::init(I3::dataio::shared_filehandle filename, const std::stri
   open_ = true;
 }
 
-I3ROOTTableService::~I3ROOTTableService() {}
+I3ROOTTableService::~I3ROOTTableService() {
+  JoinWriter();
+}
 
 void I3ROOTTableService::setMaxTreeSize(long long int maxSize)
 {
@@ -9,6 +9,7 @@
 #include <I3Test.h>
 #include <limits.h>
 #include <boost/filesystem.hpp>
+#include <vector>
 
 #include <tableio/I3TableRow.h>
 #include <tableio/I3TableRowDescription.h>
@@ -166,3 +167,71 @@ TEST(resurrection) {
 
   boost::filesystem::remove(filename);
 }
+
+TEST(variable_length) {
+  const char *filename = "I3ROOTRoundTripTestVariableLength.root";
+  const char *treename = "ragged";
+  const char *field_name = "charge";
+  const char *count_name = "ncharge";
+  const char *length_name = "charge_length";
+  const size_t lengths[] = {2, 0, 3};
+  const size_t nrows = 3;
+
+  I3TableServicePtr writer_service = I3TableServicePtr(new I3ROOTTableService(filename));
+
+  I3TableRowDescriptionPtr desc = I3TableRowDescriptionPtr(new I3TableRowDescription());
+  desc->SetIsMultiRow(true);
+  desc->AddVariableLengthField<float>(field_name, "PE", "Charges of the row");
+
+  I3TablePtr table = writer_service->GetTable(treename,desc);
+
+  I3TableRowPtr rows = table->CreateRow(nrows);
+  size_t i, j, k;
+  for (i=0; i<nrows; i++) {
+    std::vector<float> charges;
+    for (j=0; j<lengths[i]; j++) charges.push_back(10*i + j);
+    rows->SetCurrentRow(i);
+    rows->SetVariableLength<float>(field_name, charges.data(), charges.size());
+  }
+  I3EventHeaderConstPtr fake_header = I3EventHeaderConstPtr(new I3EventHeader());
+  table->AddRow(fake_header,rows);
+
+  writer_service->Finish();
+
+  TFile file(filename);
+  TTree *tree = dynamic_cast<TTree*>(file.Get(treename));
+  ENSURE( tree != NULL );
+  ENSURE_EQUAL( tree->GetEntries(), 1, "The tree has exactly one entry (as written)" );
+
+  // a standard leaflist: an Int_t count leaf and field[n<field>]
+  TLeaf *countLeaf = tree->GetLeaf(count_name);
+  ENSURE( countLeaf != NULL, "Count leaf should exist" );
+  ENSURE_EQUAL( std::string(countLeaf->GetTypeName()), std::string("Int_t") );
+  TLeaf *fieldLeaf = tree->GetLeaf(field_name);
+  ENSURE( fieldLeaf != NULL, "Field leaf should exist" );
+  ENSURE( fieldLeaf->GetLeafCount() != NULL, "The field is a variable-length array" );
+  ENSURE_EQUAL( std::string(fieldLeaf->GetLeafCount()->GetName()), std::string(count_name) );
+  ENSURE_EQUAL( std::string(fieldLeaf->GetTypeName()), std::string("Float_t") );
+
+  Int_t countVariable;
+  uint64_t rowsVariable;
+  Int_t lengthVariable[nrows];
+  float fieldVariable[5];
+  tree->SetBranchAddress(count_name, &countVariable);
+  tree->SetBranchAddress("Count_ragged", &rowsVariable);
+  tree->SetBranchAddress(length_name, lengthVariable);
+  tree->SetBranchAddress(field_name, fieldVariable);
+  tree->GetEntry(0);
+
+  ENSURE_EQUAL( countVariable, Int_t(5), "The elements of all rows are counted" );
+  ENSURE_EQUAL( rowsVariable, uint64_t(nrows) );
+  for (i=0, k=0; i<nrows; i++) {
+    ENSURE_EQUAL( lengthVariable[i], Int_t(lengths[i]), "Row lengths match" );
+    for (j=0; j<lengths[i]; j++, k++)
+      ENSURE_EQUAL( fieldVariable[k], float(10*i + j), "Elements match" );
+  }
+
+  file.Close();
+
+  boost::filesystem::remove(filename);
+}
@@ -13,28 +13,38 @@
 
 #include <string>
 #include <cstdint>
+#include <algorithm>
 
 #include <sqlite3.h>
 #include <boost/filesystem.hpp>
 
 #include <tableio/I3Table.h>
 #include <tableio/I3TableRow.h>
+#include <tableio/I3TableColumns.h>
 #include <tableio/I3TableService.h>
 
 #include "I3SQLiteTable.h"
+#include "I3SQLiteTableService.h"
 #include "sqlite_utils.h"
 
 
+// insert at most this many rows with one statement
+static const size_t MAX_ROWS_PER_INSERT = 256;
 
-I3SQLiteTable::I3SQLiteTable(I3TableService &service,
+
+
+I3SQLiteTable::I3SQLiteTable(I3SQLiteTableService &service,
                              std::string tableName,
                              I3TableRowDescriptionConstPtr description,
-                             boost::filesystem::path path)
+                             sqlite3 *database)
                              : I3Table(service,
                                        tableName,
-                                       description)
+                                       description),
+                               sqlite_service_(service)
 {
-    db_path_ = path;
+    database_ = database;
+    bulk_insertion_stmt_ = nullptr;
+    insertion_stmt_ = nullptr;
     num_fields_ = description_->GetFieldNames().size();
     event_no_ = 0;
     if (tableName == "I3EventHeader")
@@ -43,22 +53,49 @@ I3SQLiteTable::I3SQLiteTable(I3TableService &service,
         {skip_cols_ = 5;}
 
     CreateTable();
+    buffer_ = I3TableRowPtr(new I3TableRow(description_, 0));
+    buffer_->reserve(rows_per_insert_);
+}
+
+
+I3SQLiteTable::I3SQLiteTable(I3SQLiteTableService &service,
+                             std::string tableName,
+                             sqlite3 *database)
+                             : I3Table(service,
+                                       tableName,
+                                       I3TableRowDescriptionPtr()),
+                               sqlite_service_(service)
+{
+    database_ = database;
+    bulk_insertion_stmt_ = nullptr;
+    insertion_stmt_ = nullptr;
+    rows_per_insert_ = 0;
+    event_no_ = 0;
+    skip_cols_ = 0;
+
+    ReadDescription();
+    num_fields_ = description_->GetNumberOfFields();
+    nevents_ = get_event_no_offset(database_, name_);
+
+    std::string sql_command = "SELECT COUNT(*) FROM \"" + name_ + "\";";
+    sqlite3_stmt *count_stmt;
+    CHECK_SQLITE3(sqlite3_prepare_v2(database_, sql_command.c_str(), -1, &count_stmt, nullptr), database_);
+    if (make_step(count_stmt))
+        {nrows_ = sqlite3_column_int64(count_stmt, 0);}
+    CHECK_SQLITE3(sqlite3_finalize(count_stmt), database_);
 }
 
 
 I3SQLiteTable::~I3SQLiteTable()
 {
-    // close the database
-    CHECK_SQLITE3(sqlite3_finalize(insertion_stmt_), database_);
-    CHECK_SQLITE3(sqlite3_close(database_), database_);
+    // the service closes the database once all statements are finalized
+    sqlite3_finalize(bulk_insertion_stmt_);
+    sqlite3_finalize(insertion_stmt_);
 }
 
 
 void I3SQLiteTable::CreateTable()
 {
-    // open database
-    CHECK_SQLITE3(sqlite3_open(db_path_.c_str(), &database_), database_);
-
     // get sqlite names and types of columns
     std::vector<std::string> sqlite_names = description_->GetFieldNames();
     std::vector<std::string> sqlite_types;
@@ -73,6 +110,10 @@ void I3SQLiteTable::CreateTable()
             log_warn("Can't handle type: '%s' (field: '%s').", description_->GetFieldTypes()[i].AsString().c_str(), description_->GetFieldNames()[i].c_str());
             all_types_fine = false;
         }
+        if (description_->IsVariableLength(i)) {
+            log_warn("Can't handle variable-length fields (field: '%s').", description_->GetFieldNames()[i].c_str());
+            all_types_fine = false;
+        }
     }
     if (!all_types_fine) {
         log_fatal("For some I3Datatypes no corresponding SQLite DataType was found.");
@@ -82,91 +123,191 @@ void I3SQLiteTable::CreateTable()
     sqlite_names.erase(sqlite_names.begin(), sqlite_names.begin() + skip_cols_);
     sqlite_types.erase(sqlite_types.begin(), sqlite_types.begin() + skip_cols_);
 
-    // create table
-    create_table(database_, name_, sqlite_names, sqlite_types);
+    // create table, the service indexes it once it is filled
+    create_table(database_, name_, sqlite_names, sqlite_types, false);
 
-    // prepare insertion statement
+    // prepare insertion statements, for as many rows at once as SQLite
+    // allows parameters
+    size_t params_per_row = num_fields_ - skip_cols_ + 1;
+    size_t max_params = sqlite3_limit(database_, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+    rows_per_insert_ = std::max(std::min(MAX_ROWS_PER_INSERT, max_params/params_per_row), size_t(1));
     insertion_stmt_ = get_insertion_statement(database_, name_);
+    if (rows_per_insert_ > 1)
+        {bulk_insertion_stmt_ = get_insertion_statement(database_, name_, rows_per_insert_);}
 }
 
 
-void I3SQLiteTable::WriteRows(I3TableRowConstPtr row)
+void I3SQLiteTable::ReadDescription()
 {
-    I3TableRowPtr rows = boost::const_pointer_cast<I3TableRow>(row);
-    rows->SetEnumsAreInts(true);
-    I3Datatype type;
-    // insert data
-    sqlite3_exec(database_, "BEGIN TRANSACTION;", 0, 0, nullptr);
-    for (size_t n = 0; n < rows->GetNumberOfRows(); n++) {
-        rows->SetCurrentRow(n);
-        for (size_t i = skip_cols_; i < num_fields_; i++) {
-            type = description_->GetFieldTypes()[i];
-            switch (type.kind) {
+    // the columns come back as the widest type of their SQLite type
+    std::pair<std::vector<std::string>, std::vector<std::string>> sqlite_columns = get_columns(database_, name_);
+    I3TableRowDescriptionPtr description(new I3TableRowDescription());
+    for (size_t i = 0; i < sqlite_columns.first.size(); i++) {
+        const std::string &column_name = sqlite_columns.first[i];
+        const std::string &column_type = sqlite_columns.second[i];
+        if (column_type == "DOUBLE")
+            {description->AddField<double>(column_name, "", "");}
+        else if (column_type == "INTEGER")
+            {description->AddField<int64_t>(column_name, "", "");}
+        else if (column_type == "BOOLEAN")
+            {description->AddField<bool>(column_name, "", "");}
+        else
+            {log_fatal("Can't read SQLite type '%s' (table: '%s', column: '%s').", column_type.c_str(), name_.c_str(), column_name.c_str());}
+    }
+    description_ = description;
+}
+
+
+void I3SQLiteTable::ReadEvents(I3TableColumns& columns, const std::vector<size_t>& fieldIndices,
+                               size_t firstEvent, size_t endEvent) const
+{
+    // the description of a table that is written still has the index
+    // columns, which are not in the database
+    if (buffer_)
+        {log_fatal("(%s) Only tables of databases opened with mode 'r' can be read.", name_.c_str());}
+    sqlite3 *database = database_;
+
+    // a range scan on the event_no index, in the order the rows were inserted
+    std::string sql_command = "SELECT ";
+    for (size_t index : fieldIndices) {
+        sql_command += "\"" + description_->GetFieldNames()[index] + "\", ";
+    }
+    sql_command += "\"event_no\" FROM \"" + name_ + "\" WHERE \"event_no\" BETWEEN ? AND ? ORDER BY \"event_no\", rowid;";
+    sqlite3_stmt *stmt;
+    CHECK_SQLITE3(sqlite3_prepare_v2(database, sql_command.c_str(), -1, &stmt, nullptr), database);
+    CHECK_SQLITE3(sqlite3_bind_int64(stmt, 1, firstEvent), database);
+    CHECK_SQLITE3(sqlite3_bind_int64(stmt, 2, endEvent - 1), database);
+
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        const size_t row = columns.AddRows(1);
+        for (size_t i = 0; i < fieldIndices.size(); i++) {
+            void *value = static_cast<char*>(columns.GetPointerToColumn(i)) + row*description_->GetFieldSizes()[fieldIndices[i]];
+            switch (description_->GetFieldTypes()[fieldIndices[i]].kind) {
                 case I3Datatype::TypeClass::Float:
-                    switch (type.size) {
-                        case 4:
-                            CHECK_SQLITE3(sqlite3_bind_double(insertion_stmt_, i+1-skip_cols_, *(rows->GetPointer<float>(i))), database_);
-                            break;
-                        case 8:
-                            CHECK_SQLITE3(sqlite3_bind_double(insertion_stmt_, i+1-skip_cols_, *(rows->GetPointer<double>(i))), database_);
-                            break;
-                        default:
-                            log_fatal("Can't handle floating points of size '%li' (field: '%s').", type.size, description_->GetFieldNames()[i].c_str());
-                    }
-                    break;
-                case I3Datatype::TypeClass::Int:
-                case I3Datatype::TypeClass::Enum:
-                    if (type.is_signed) {
-                        switch (type.size) {
-                            case 1:
-                                CHECK_SQLITE3(sqlite3_bind_int64(insertion_stmt_, i+1-skip_cols_, *(rows->GetPointer<int8_t>(i))), database_);
-                                break;
-                            case 2:
-                                CHECK_SQLITE3(sqlite3_bind_int64(insertion_stmt_, i+1-skip_cols_, *(rows->GetPointer<int16_t>(i))), database_);
-                                break;
-                            case 4:
-                                CHECK_SQLITE3(sqlite3_bind_int64(insertion_stmt_, i+1-skip_cols_, *(rows->GetPointer<int32_t>(i))), database_);
-                                break;
-                            case 8:
-                                CHECK_SQLITE3(sqlite3_bind_int64(insertion_stmt_, i+1-skip_cols_, *(rows->GetPointer<int64_t>(i))), database_);
-                                break;
-                            default:
-                                log_fatal("Can't handle signed integers of size '%li' (field: '%s').", type.size, description_->GetFieldNames()[i].c_str());
-                        }
-                    }
-                    else {
-                        switch (type.size) {
-                            case 1:
-                                CHECK_SQLITE3(sqlite3_bind_int64(insertion_stmt_, i+1-skip_cols_, *(rows->GetPointer<uint8_t>(i))), database_);
-                                break;
-                            case 2:
-                                CHECK_SQLITE3(sqlite3_bind_int64(insertion_stmt_, i+1-skip_cols_, *(rows->GetPointer<uint16_t>(i))), database_);
-                                break;
-                            case 4:
-                                CHECK_SQLITE3(sqlite3_bind_int64(insertion_stmt_, i+1-skip_cols_, *(rows->GetPointer<uint32_t>(i))), database_);
-                                break;
-                            case 8:
-                                CHECK_SQLITE3(sqlite3_bind_int64(insertion_stmt_, i+1-skip_cols_, *(rows->GetPointer<uint64_t>(i))), database_);
-                                break;
-                            default:
-                                log_fatal("Can't handle unsigned integers of size '%li' (field: '%s').", type.size, description_->GetFieldNames()[i].c_str());
-                        }
-                    }
+                    *static_cast<double*>(value) = sqlite3_column_double(stmt, i);
                     break;
                 case I3Datatype::TypeClass::Bool:
-                    CHECK_SQLITE3(sqlite3_bind_int64(insertion_stmt_, i+1-skip_cols_, *(rows->GetPointer<bool>(i))), database_);
+                    *static_cast<bool*>(value) = sqlite3_column_int64(stmt, i);
                     break;
                 default:
-                    log_fatal("Can't handle type: '%s' (field: '%s').", type.AsString().c_str(), description_->GetFieldNames()[i].c_str());
+                    *static_cast<int64_t*>(value) = sqlite3_column_int64(stmt, i);
             }
         }
-        CHECK_SQLITE3(sqlite3_bind_int64(insertion_stmt_, num_fields_+1-skip_cols_, event_no_), database_);
-        CHECK_SQLITE3(sqlite3_step(insertion_stmt_), database_);
-        CHECK_SQLITE3(sqlite3_reset(insertion_stmt_), database_);
     }
-    CHECK_SQLITE3(sqlite3_exec(database_, "COMMIT;", 0, 0, nullptr), database_);
-    rows->SetEnumsAreInts(false);
+    sqlite3_finalize(stmt);
+    CHECK_SQLITE3(rc, database);
+}
+
+
+void I3SQLiteTable::WriteRows(I3TableRowConstPtr row)
+{
+    // buffer the rows until there are enough for a bulk insert
+    buffer_->append(*row);
+    buffer_event_nos_.insert(buffer_event_nos_.end(), row->GetNumberOfRows(), event_no_);
     event_no_++;
+
+    size_t inserted = 0;
+    while (buffer_->GetNumberOfRows() - inserted >= rows_per_insert_) {
+        InsertRows(rows_per_insert_ > 1 ? bulk_insertion_stmt_ : insertion_stmt_, inserted, rows_per_insert_);
+        inserted += rows_per_insert_;
+    }
+    buffer_->erase(inserted);
+    buffer_event_nos_.erase(buffer_event_nos_.begin(), buffer_event_nos_.begin() + inserted);
+}
+
+
+void I3SQLiteTable::Flush(const size_t nrows)
+{
+    // tables that are read have nothing to insert
+    if (!buffer_)
+        {return;}
+    // insert the rest one by one
+    for (size_t n = 0; n < buffer_->GetNumberOfRows(); n++) {
+        InsertRows(insertion_stmt_, n, 1);
+    }
+    buffer_->erase(buffer_->GetNumberOfRows());
+    buffer_event_nos_.clear();
+}
+
+
+void I3SQLiteTable::InsertRows(sqlite3_stmt *stmt, size_t start, size_t num_rows)
+{
+    const size_t params_per_row = num_fields_ - skip_cols_ + 1;
+    for (size_t n = 0; n < num_rows; n++) {
+        const int first_param = n*params_per_row + 1;
+        for (size_t i = skip_cols_; i < num_fields_; i++) {
+            BindField(stmt, first_param + i - skip_cols_, i, buffer_->GetPointerToField(i, start + n));
+        }
+        CHECK_SQLITE3(sqlite3_bind_int64(stmt, first_param + params_per_row - 1, buffer_event_nos_[start + n]), database_);
+    }
+    CHECK_SQLITE3(sqlite3_step(stmt), database_);
+    CHECK_SQLITE3(sqlite3_reset(stmt), database_);
+    sqlite_service_.RowsInserted(num_rows);
+}
+
+
+void I3SQLiteTable::BindField(sqlite3_stmt *stmt, int param, size_t field, const void *value)
+{
+    const I3Datatype &type = description_->GetFieldTypes()[field];
+    switch (type.kind) {
+        case I3Datatype::TypeClass::Float:
+            switch (type.size) {
+                case 4:
+                    CHECK_SQLITE3(sqlite3_bind_double(stmt, param, *static_cast<const float*>(value)), database_);
+                    break;
+                case 8:
+                    CHECK_SQLITE3(sqlite3_bind_double(stmt, param, *static_cast<const double*>(value)), database_);
+                    break;
+                default:
+                    log_fatal("Can't handle floating points of size '%li' (field: '%s').", type.size, description_->GetFieldNames()[field].c_str());
+            }
+            break;
+        case I3Datatype::TypeClass::Int:
+        case I3Datatype::TypeClass::Enum:
+            if (type.is_signed) {
+                switch (type.size) {
+                    case 1:
+                        CHECK_SQLITE3(sqlite3_bind_int64(stmt, param, *static_cast<const int8_t*>(value)), database_);
+                        break;
+                    case 2:
+                        CHECK_SQLITE3(sqlite3_bind_int64(stmt, param, *static_cast<const int16_t*>(value)), database_);
+                        break;
+                    case 4:
+                        CHECK_SQLITE3(sqlite3_bind_int64(stmt, param, *static_cast<const int32_t*>(value)), database_);
+                        break;
+                    case 8:
+                        CHECK_SQLITE3(sqlite3_bind_int64(stmt, param, *static_cast<const int64_t*>(value)), database_);
+                        break;
+                    default:
+                        log_fatal("Can't handle signed integers of size '%li' (field: '%s').", type.size, description_->GetFieldNames()[field].c_str());
+                }
+            }
+            else {
+                switch (type.size) {
+                    case 1:
+                        CHECK_SQLITE3(sqlite3_bind_int64(stmt, param, *static_cast<const uint8_t*>(value)), database_);
+                        break;
+                    case 2:
+                        CHECK_SQLITE3(sqlite3_bind_int64(stmt, param, *static_cast<const uint16_t*>(value)), database_);
+                        break;
+                    case 4:
+                        CHECK_SQLITE3(sqlite3_bind_int64(stmt, param, *static_cast<const uint32_t*>(value)), database_);
+                        break;
+                    case 8:
+                        CHECK_SQLITE3(sqlite3_bind_int64(stmt, param, *static_cast<const uint64_t*>(value)), database_);
+                        break;
+                    default:
+                        log_fatal("Can't handle unsigned integers of size '%li' (field: '%s').", type.size, description_->GetFieldNames()[field].c_str());
+                }
+            }
+            break;
+        case I3Datatype::TypeClass::Bool:
+            CHECK_SQLITE3(sqlite3_bind_int64(stmt, param, *static_cast<const bool*>(value)), database_);
+            break;
+        default:
+            log_fatal("Can't handle type: '%s' (field: '%s').", type.AsString().c_str(), description_->GetFieldNames()[field].c_str());
+    }
 }
 
 
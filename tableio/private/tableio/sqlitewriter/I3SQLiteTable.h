@@ -17,6 +17,7 @@
 
 #include <string>
 #include <cstdint>
+#include <vector>
 
 #include <sqlite3.h>
 #include <boost/filesystem.hpp>
@@ -29,31 +30,60 @@ I3_FORWARD_DECLARATION(I3TableService);
 I3_FORWARD_DECLARATION(I3TableRowDescription);
 I3_FORWARD_DECLARATION(I3TableRow);
 
+class I3SQLiteTableService;
+
 
 
 class I3SQLiteTable : public I3Table {
 
 public:
-    I3SQLiteTable(I3TableService &service,
+    // rows are inserted into the service's database, in the service's transaction
+    I3SQLiteTable(I3SQLiteTableService &service,
                   std::string tableName,
                   I3TableRowDescriptionConstPtr description,
-                  boost::filesystem::path path);
+                  sqlite3 *database);
+
+    // read the existing table tableName from the database
+    I3SQLiteTable(I3SQLiteTableService &service,
+                  std::string tableName,
+                  sqlite3 *database);
 
     virtual ~I3SQLiteTable();
 
+    // insert all buffered rows
+    virtual void Flush(const size_t nrows = 0);
+
 protected:
     virtual void WriteRows(I3TableRowConstPtr row);
 
+    // select the rows of the events with event_no BETWEEN firstEvent AND endEvent-1
+    virtual void ReadEvents(I3TableColumns& columns, const std::vector<size_t>& fieldIndices,
+                            size_t firstEvent, size_t endEvent) const;
+
     void CreateTable();
 
+    // describe the columns of the table on disk, except event_no
+    void ReadDescription();
+
 private:
-    boost::filesystem::path db_path_;
+    I3SQLiteTableService &sqlite_service_;
     sqlite3 *database_;
+    // inserts rows_per_insert_ rows at once
+    sqlite3_stmt *bulk_insertion_stmt_;
     sqlite3_stmt *insertion_stmt_;
+    size_t rows_per_insert_;
     size_t num_fields_;
     size_t event_no_;
     uint8_t skip_cols_;
 
+    // rows waiting for a full bulk insert, and their event_nos
+    I3TableRowPtr buffer_;
+    std::vector<size_t> buffer_event_nos_;
+
+    // bind and insert the buffered rows [start,start+num_rows)
+    void InsertRows(sqlite3_stmt *stmt, size_t start, size_t num_rows);
+    void BindField(sqlite3_stmt *stmt, int param, size_t field, const void *value);
+
     std::string GetSQLiteType(const I3Datatype &type) const;
 
 SET_LOGGER("I3SQLiteTable");
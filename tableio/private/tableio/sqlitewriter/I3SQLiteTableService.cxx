@@ -23,25 +23,98 @@
 
 #include "I3SQLiteTable.h"
 #include "I3SQLiteTableService.h"
+#include "sqlite_utils.h"
 
 
 
-I3SQLiteTableService::I3SQLiteTableService(boost::filesystem::path path)
+I3SQLiteTableService::I3SQLiteTableService(boost::filesystem::path path, size_t rowsPerTransaction,
+                                           char mode)
                                            : I3TableService()
 {
     path_ = path;
+    rows_per_transaction_ = rowsPerTransaction;
+    rows_in_transaction_ = 0;
+
+    if (mode == 'w') {
+        // open database, and only make it durable when it is closed
+        read_only_ = false;
+        CHECK_SQLITE3(sqlite3_open(path_.c_str(), &database_), database_);
+        CHECK_SQLITE3(sqlite3_exec(database_, "PRAGMA journal_mode=WAL; PRAGMA synchronous=OFF; BEGIN TRANSACTION;", 0, 0, nullptr), database_);
+    }
+    else if (mode == 'r') {
+        read_only_ = true;
+        CHECK_SQLITE3(sqlite3_open_v2(path_.c_str(), &database_, SQLITE_OPEN_READONLY, nullptr), database_);
+        FindTables();
+    }
+    else {
+        log_fatal("Unsupported file mode '%c'", mode);
+    }
 }
 
 I3SQLiteTableService::~I3SQLiteTableService()
-{}
+{
+    JoinWriter();
+    if (database_ && read_only_) {
+        CloseFile();
+    }
+    else if (database_) {
+        // Finish() never ran, but the database should still be indexed and
+        // left in one file
+        log_warn("%s was not closed with Finish(), rows that were still buffered are lost.",
+                 path_.c_str());
+        try {
+            CloseFile();
+        } catch (const std::exception& e) {
+            log_error("Couldn't close %s: %s", path_.c_str(), e.what());
+        }
+    }
+}
+
+void I3SQLiteTableService::FindTables()
+{
+    for (const std::string &table_name : get_tables(database_)) {
+        if (table_has_event_no(database_, table_name))
+            {tables_[table_name] = I3TablePtr(new I3SQLiteTable(*this, table_name, database_));}
+    }
+}
 
 I3TablePtr I3SQLiteTableService::CreateTable(const std::string &tableName,
                                              I3TableRowDescriptionConstPtr description)
 {
-    return I3TablePtr(new I3SQLiteTable(*this, tableName, description, path_));
+    table_names_.push_back(tableName);
+    return I3TablePtr(new I3SQLiteTable(*this, tableName, description, database_));
+}
+
+void I3SQLiteTableService::RowsInserted(size_t num_rows)
+{
+    rows_in_transaction_ += num_rows;
+    if (rows_per_transaction_ > 0 && rows_in_transaction_ >= rows_per_transaction_) {
+        CHECK_SQLITE3(sqlite3_exec(database_, "COMMIT; BEGIN TRANSACTION;", 0, 0, nullptr), database_);
+        rows_in_transaction_ = 0;
+    }
 }
 
 void I3SQLiteTableService::CloseFile()
-{}
+{
+    if (!database_)
+        {return;}
+    if (read_only_) {
+        CHECK_SQLITE3(sqlite3_close_v2(database_), database_);
+        database_ = nullptr;
+        return;
+    }
+    CHECK_SQLITE3(sqlite3_exec(database_, "COMMIT;", 0, 0, nullptr), database_);
 
+    // indexing the complete tables is faster than updating the indexes on every insert
+    CHECK_SQLITE3(sqlite3_exec(database_, "BEGIN TRANSACTION;", 0, 0, nullptr), database_);
+    for (std::string table_name : table_names_) {
+        create_event_no_index(database_, table_name);
+    }
+    CHECK_SQLITE3(sqlite3_exec(database_, "COMMIT;", 0, 0, nullptr), database_);
 
+    // leave a single file behind, like the rollback journal did
+    CHECK_SQLITE3(sqlite3_exec(database_, "PRAGMA synchronous=FULL; PRAGMA journal_mode=DELETE;", 0, 0, nullptr), database_);
+    // tables that are still around finalize their statements later
+    CHECK_SQLITE3(sqlite3_close_v2(database_), database_);
+    database_ = nullptr;
+}
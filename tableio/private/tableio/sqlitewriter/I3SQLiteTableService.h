@@ -16,6 +16,7 @@
 
 #include <string>
 #include <cstdint>
+#include <vector>
 
 #include <sqlite3.h>
 #include <boost/filesystem.hpp>
@@ -31,18 +32,37 @@
 class I3SQLiteTableService : public I3TableService {
 
 public:
-    I3SQLiteTableService(boost::filesystem::path path);
+    // All tables share one connection and one transaction, which is
+    // committed every rowsPerTransaction rows. The database is in WAL mode
+    // without syncing while it is written, and the event_no indexes are
+    // created when it is closed. With mode 'r' the database is opened
+    // read-only, and its tables can be read with ReadColumns.
+    I3SQLiteTableService(boost::filesystem::path path, size_t rowsPerTransaction = 1000000,
+                         char mode = 'w');
 
     virtual ~I3SQLiteTableService();
 
+    // count inserted rows, committing the transaction when it is long enough
+    void RowsInserted(size_t num_rows);
+
 protected:
     virtual I3TablePtr CreateTable(const std::string &tableName,
                                    I3TableRowDescriptionConstPtr description);
 
     virtual void CloseFile();
 
+    // open a table for every table of the database that has an event_no
+    void FindTables();
+
 private:
     boost::filesystem::path path_;
+    sqlite3 *database_;
+    bool read_only_;
+    size_t rows_per_transaction_;
+    size_t rows_in_transaction_;
+    std::vector<std::string> table_names_;
+
+SET_LOGGER("I3SQLiteTableService");
 };
 
 
@@ -204,24 +204,34 @@ int main(int argc, char* argv[]) {
         all_column_names.insert(all_column_names.end(), column_names_map[table].begin(), column_names_map[table].end());
         all_column_types.insert(all_column_types.end(), column_types_map[table].begin(), column_types_map[table].end());
     }
-    // create merged table
-    create_table(database, merged_name, all_column_names, all_column_types);
+    // create merged table, and its index once it is filled
+    create_table(database, merged_name, all_column_names, all_column_types, false);
     sqlite3_stmt* insertion_stmt = get_insertion_statement(database, merged_name);
     size_t column_count = sqlite3_bind_parameter_count(insertion_stmt);
 
+    // look up where each column of each table is bound only once
+    std::map<std::string, std::vector<int>> bind_indices_map;
+    for (std::string table : tables) {
+        for (std::string column_name : column_names_map[table]) {
+            bind_indices_map[table].push_back(get_index(all_column_names, column_name)+1);
+        }
+    }
+
     // loop over all rows in all tables and insert them into the new merged table
     CHECK_SQLITE3(sqlite3_exec(database, "BEGIN TRANSACTION;", 0, 0, nullptr), database);
 
     size_t row_no = 0;
-    std::vector<size_t> event_nos;
+    std::vector<int64_t> event_nos;
     while (make_and_validate_step(query_stmts)) {
         row_no++;
         for (std::string table : tables) {
-            for (size_t i = 0; i < column_names_map[table].size(); i++) {
-                // bind value directly into the insertion statement
-                CHECK_SQLITE3(sqlite3_bind_text(insertion_stmt, get_index(all_column_names, column_names_map[table][i])+1, sqlite3_read(query_stmts[table], i), -1, SQLITE_TRANSIENT), database);
+            sqlite3_stmt* query_stmt = query_stmts[table];
+            const std::vector<int> &bind_indices = bind_indices_map[table];
+            for (size_t i = 0; i < bind_indices.size(); i++) {
+                // bind the value as it is stored, without converting it to text and back
+                CHECK_SQLITE3(sqlite3_bind_value(insertion_stmt, bind_indices[i], sqlite3_column_value(query_stmt, i)), database);
             }
-            event_nos.push_back(std::atoi(sqlite3_read(query_stmts[table], column_names_map[table].size())));
+            event_nos.push_back(sqlite3_column_int64(query_stmt, bind_indices.size()));
         }
         if (!all_elems_equal(event_nos)) {
             std::cerr << "Error: At row " << row_no << " the specified tables' event_nos don't match up, so they cannot be merged." << std::endl;
@@ -234,6 +244,7 @@ int main(int argc, char* argv[]) {
     }
 
     CHECK_SQLITE3(sqlite3_exec(database, "COMMIT;", 0, 0, nullptr), database);
+    create_event_no_index(database, merged_name);
 
     for (std::string table : tables) {
         CHECK_SQLITE3(sqlite3_finalize(query_stmts[table]), database);
@@ -208,22 +208,35 @@ std::pair<std::vector<std::string>, std::vector<std::string>> get_columns(sqlite
 
 
 inline
-void create_table(sqlite3* &database, std::string table_name, const std::vector<std::string> &column_names, const std::vector<std::string> &column_types) {
+void create_event_no_index(sqlite3* &database, std::string table_name) {
+    // create the index on the event_no column of a table
+
+    std::string sql_command = "CREATE INDEX \"event_no_" + table_name + "\" ON \"" + table_name +"\" (\"event_no\");";
+
+    CHECK_SQLITE3(sqlite3_exec(database, sql_command.c_str(), 0, 0, nullptr), database);
+}
+
+
+inline
+void create_table(sqlite3* &database, std::string table_name, const std::vector<std::string> &column_names, const std::vector<std::string> &column_types, bool with_index = true) {
     // create a new table in the database (add event_no to specified columns)
+    // without the index, if it is cheaper to create it once the table is filled
 
     std::string sql_command = "CREATE TABLE \"" + table_name + "\"(";
     for (size_t i = 0; i < column_names.size(); i++) {
         sql_command += "\"" + column_names[i] + "\" " + column_types[i] + ", ";
     }
-    sql_command += "\"event_no\" INTEGER NOT NULL); CREATE INDEX \"event_no_" + table_name + "\" ON \"" + table_name +"\" (\"event_no\");";
+    sql_command += "\"event_no\" INTEGER NOT NULL);";
 
     CHECK_SQLITE3(sqlite3_exec(database, sql_command.c_str(), 0, 0, nullptr), database);
+    if (with_index)
+        {create_event_no_index(database, table_name);}
 }
 
 
 inline
-sqlite3_stmt* get_insertion_statement(sqlite3* &database, std::string table_name) {
-    // prepare insertion statement
+sqlite3_stmt* get_insertion_statement(sqlite3* &database, std::string table_name, size_t num_rows = 1) {
+    // prepare insertion statement for num_rows rows at once
 
     std::vector<std::string> column_names = get_columns(database, table_name).first;
 
@@ -231,11 +244,15 @@ sqlite3_stmt* get_insertion_statement(sqlite3* &database, std::string table_name
     for (std::string column_name : column_names) {
         sql_command += "\"" + column_name + "\", ";
     }
-    sql_command += "\"event_no\") VALUES (";
-    for (size_t i = 0; i < column_names.size(); i++) {
-        sql_command += "?, ";
+    sql_command += "\"event_no\") VALUES ";
+    for (size_t n = 0; n < num_rows; n++) {
+        sql_command += (n == 0) ? "(" : ", (";
+        for (size_t i = 0; i < column_names.size(); i++) {
+            sql_command += "?, ";
+        }
+        sql_command += "?)";
     }
-    sql_command += "?);";
+    sql_command += ";";
 
     sqlite3_stmt* sql_stmt;
     CHECK_SQLITE3(sqlite3_prepare_v2(database, sql_command.c_str(), -1, &sql_stmt, nullptr), database);
@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: 2025 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include <string>
+#include <vector>
+
+#include <sqlite3.h>
+#include <boost/filesystem.hpp>
+
+#include <tableio/I3TableRow.h>
+#include <tableio/I3TableColumns.h>
+#include <tableio/I3TableRowDescription.h>
+#include <tableio/sqlitewriter/I3SQLiteTableService.h>
+
+#include <dataclasses/physics/I3EventHeader.h>
+
+TEST_GROUP(I3SQLiteRoundTripTests);
+
+namespace {
+
+// the first column of every row of a query
+std::vector<std::string> query(sqlite3* database, const std::string& sql) {
+   std::vector<std::string> values;
+   sqlite3_stmt* stmt;
+   ENSURE_EQUAL( sqlite3_prepare_v2(database, sql.c_str(), -1, &stmt, nullptr), SQLITE_OK, sql);
+   while (sqlite3_step(stmt) == SQLITE_ROW)
+      values.push_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+   sqlite3_finalize(stmt);
+   return values;
+}
+
+std::vector<int64_t> query_ints(sqlite3* database, const std::string& sql) {
+   std::vector<int64_t> values;
+   for (const std::string& value : query(database, sql))
+      values.push_back(std::stoll(value));
+   return values;
+}
+
+// "multi" has 2 rows per event and "single" 1, so that both fill
+// several bulk inserts and leave a partial batch
+void write(I3TableService& service, size_t nevents) {
+   I3TableRowDescriptionPtr multi_desc(new I3TableRowDescription(*service.GetIndexDescription()));
+   multi_desc->AddField<int32_t>("value","","doc");
+   multi_desc->SetIsMultiRow(true);
+   I3TableRowDescriptionPtr single_desc(new I3TableRowDescription(*service.GetIndexDescription()));
+   single_desc->AddField<int32_t>("value","","doc");
+
+   I3TablePtr multi = service.GetTable("multi",multi_desc);
+   I3TablePtr single = service.GetTable("single",single_desc);
+   for (size_t i=0; i<nevents; i++) {
+      I3EventHeaderPtr header(new I3EventHeader());
+      header->SetEventID(i);
+      I3TableRowPtr rows = multi->CreateRow(2);
+      for (size_t r=0; r<2; r++) {
+         rows->SetCurrentRow(r);
+         rows->Set<int32_t>("value",int32_t(10*i + r));
+      }
+      multi->AddRow(header,rows);
+      I3TableRowPtr row = single->CreateRow(1);
+      row->Set<int32_t>("value",-int32_t(i));
+      single->AddRow(header,row);
+   }
+}
+
+}
+
+TEST(bulk_inserts) {
+   const std::string filename("I3SQLiteRoundTripTest.db");
+   const size_t nevents = 300;
+   boost::filesystem::remove(filename);
+   {
+      // commit a few times on the way
+      I3SQLiteTableService service(filename,100);
+      write(service,nevents);
+      service.Finish();
+   }
+
+   sqlite3* database;
+   ENSURE_EQUAL( sqlite3_open(filename.c_str(),&database), SQLITE_OK );
+   ENSURE_EQUAL( query_ints(database,"SELECT COUNT(*) FROM \"multi\";")[0], int64_t(2*nevents),
+                 "Every bulk-inserted and leftover row made it to disk");
+   ENSURE_EQUAL( query_ints(database,"SELECT COUNT(*) FROM \"single\";")[0], int64_t(nevents) );
+
+   std::vector<int64_t> values = query_ints(database,"SELECT value FROM \"multi\" ORDER BY rowid;");
+   std::vector<int64_t> event_nos = query_ints(database,"SELECT event_no FROM \"multi\" ORDER BY rowid;");
+   for (size_t n=0; n<2*nevents; n++) {
+      ENSURE_EQUAL( values[n], int64_t(10*(n/2) + n%2), "Rows are inserted in order");
+      ENSURE_EQUAL( event_nos[n], int64_t(n/2), "Rows carry the number of their event");
+   }
+   values = query_ints(database,"SELECT value FROM \"single\" ORDER BY rowid;");
+   event_nos = query_ints(database,"SELECT event_no FROM \"single\" ORDER BY rowid;");
+   for (size_t n=0; n<nevents; n++) {
+      ENSURE_EQUAL( values[n], -int64_t(n) );
+      ENSURE_EQUAL( event_nos[n], int64_t(n) );
+   }
+
+   std::vector<std::string> indexes = query(database,
+      "SELECT name FROM sqlite_master WHERE type='index' ORDER BY name;");
+   ENSURE_EQUAL( indexes.size(), 2u, "Both tables are indexed when the file is closed");
+   ENSURE_EQUAL( indexes[0], std::string("event_no_multi") );
+   ENSURE_EQUAL( indexes[1], std::string("event_no_single") );
+   ENSURE_EQUAL( query(database,"PRAGMA journal_mode;")[0], std::string("delete"),
+                 "The database is left in rollback journal mode");
+   sqlite3_close(database);
+   ENSURE( !boost::filesystem::exists(filename + "-wal"), "No write-ahead log is left behind");
+   boost::filesystem::remove(filename);
+}
+
+TEST(close_without_finish) {
+   const std::string filename("I3SQLiteRoundTripTest_unfinished.db");
+   boost::filesystem::remove(filename);
+   {
+      I3SQLiteTableService service(filename);
+      write(service,300);
+   }
+
+   sqlite3* database;
+   ENSURE_EQUAL( sqlite3_open(filename.c_str(),&database), SQLITE_OK );
+   ENSURE( query_ints(database,"SELECT COUNT(*) FROM \"multi\";")[0] > 0,
+           "The rows inserted so far are committed");
+   ENSURE_EQUAL( query(database,
+      "SELECT name FROM sqlite_master WHERE type='index' ORDER BY name;").size(), 2u,
+      "The tables are indexed even without Finish()");
+   ENSURE_EQUAL( query(database,"PRAGMA journal_mode;")[0], std::string("delete") );
+   sqlite3_close(database);
+   ENSURE( !boost::filesystem::exists(filename + "-wal") );
+   boost::filesystem::remove(filename);
+}
+
+TEST(read_columns) {
+   const std::string filename("I3SQLiteRoundTripTest_read.db");
+   const size_t nevents = 300;
+   boost::filesystem::remove(filename);
+   {
+      I3SQLiteTableService service(filename,100);
+      write(service,nevents);
+      service.Finish();
+   }
+
+   I3SQLiteTableService service(filename,0,'r');
+   I3TablePtr multi = service.GetTable("multi",I3TableRowDescriptionConstPtr());
+   I3TablePtr single = service.GetTable("single",I3TableRowDescriptionConstPtr());
+   ENSURE( multi != NULL, "The tables are found in the database" );
+   ENSURE( single != NULL );
+   ENSURE_EQUAL( multi->GetNumberOfEvents(), nevents );
+   ENSURE_EQUAL( multi->GetNumberOfRows(), 2*nevents );
+
+   // all rows of the events [120,130)
+   std::vector<std::string> fields(1,"value");
+   I3TableColumnsConstPtr columns = multi->ReadColumns(fields,120,130);
+   ENSURE_EQUAL( columns->GetNumberOfRows(), 20u, "Both rows of each event are read" );
+   ENSURE_EQUAL( columns->GetDescription()->GetNumberOfFields(), 1u, "Only the requested field is read" );
+   const int64_t* values = columns->GetColumn<int64_t>("value");
+   for (size_t n=0; n<20; n++)
+      ENSURE_EQUAL( values[n], int64_t(10*(120 + n/2) + n%2), "Rows are read in the order they were written" );
+
+   // an empty list reads every column
+   columns = single->ReadColumns(std::vector<std::string>(),nevents-5,nevents+5);
+   ENSURE_EQUAL( columns->GetNumberOfRows(), 5u, "Events that are not in the table have no rows" );
+   for (size_t n=0; n<5; n++)
+      ENSURE_EQUAL( columns->GetColumn<int64_t>("value")[n], -int64_t(nevents-5+n) );
+   ENSURE_EQUAL( single->ReadColumns(fields,7,7)->GetNumberOfRows(), 0u );
+
+   service.Finish();
+   boost::filesystem::remove(filename);
+}
@@ -77,6 +77,9 @@ void I3CSVTable::CreateTable() {
     const std::vector<size_t>& arrayLengths = description_->GetFieldArrayLengths();
     const std::vector<I3Datatype>& dtypes = description_->GetFieldTypes();
 
+    if (description_->HasVariableLengthFields())
+        log_fatal("(%s) CSV tables can't hold variable-length fields.", name_.c_str());
+
     for (name_it = names.begin(), unit_it = units.begin(), size_it = arrayLengths.begin();
          name_it != names.end();
          name_it++, unit_it++, size_it++) {
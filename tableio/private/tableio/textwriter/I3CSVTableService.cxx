@@ -43,5 +43,7 @@ void I3CSVTableService::CloseFile() {
 
 }
 
-I3CSVTableService::~I3CSVTableService() {}
+I3CSVTableService::~I3CSVTableService() {
+    JoinWriter();
+}
 
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2025 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include "tableio/I3Converter.h"
+#include "tableio/converter/dataclasses_map_converters.h"
+
+#include "dataclasses/physics/I3RecoPulse.h"
+
+typedef I3MapOMKeyVectorConverter<convert::I3RecoPulse> I3RecoPulseSeriesMapConverter;
+
+TEST_GROUP(I3RecoPulseSeriesMapConverterTests);
+
+namespace {
+
+// three DOMs with 2, 0 and 3 pulses
+I3RecoPulseSeriesMapPtr make_pulses() {
+    I3RecoPulseSeriesMapPtr pulses(new I3RecoPulseSeriesMap());
+    const size_t npulses[] = {2, 0, 3};
+    for (unsigned om=1; om<=3; om++) {
+        I3RecoPulseSeries& series = (*pulses)[OMKey(21,om)];
+        for (size_t i=0; i<npulses[om-1]; i++) {
+            I3RecoPulse pulse;
+            pulse.SetTime(100.*om + i);
+            pulse.SetWidth(2.);
+            pulse.SetCharge(0.5*(i+1));
+            series.push_back(pulse);
+        }
+    }
+    return pulses;
+}
+
+// books the charge only when it is above 1 PE
+struct BrightCharge {
+    typedef I3RecoPulse booked_type;
+    void AddFields(I3TableRowDescriptionPtr desc, const booked_type& = booked_type()) {
+        desc->AddField<double>("charge", "PE", "charge of bright pulses");
+    }
+    void FillSingleRow(const booked_type& pulse, I3TableRowPtr row) {
+        if (pulse.GetCharge() > 1)
+            row->Set<double>("charge", pulse.GetCharge());
+    }
+};
+
+}
+
+TEST(one_row_per_pulse) {
+    I3ConverterPtr converter(new I3RecoPulseSeriesMapConverter);
+    I3RecoPulseSeriesMapPtr pulses = make_pulses();
+    ENSURE_EQUAL( converter->GetNumberOfRows(pulses), size_t(5), "Every pulse gets a row" );
+
+    I3TableRowDescriptionConstPtr desc = converter->GetDescription(pulses);
+    ENSURE( desc->GetFieldColumn("vector_index") < desc->GetNumberOfFields() );
+    ENSURE( !desc->HasVariableLengthFields() );
+
+    I3TableRowPtr rows(new I3TableRow(desc,converter->GetNumberOfRows(pulses)));
+    ENSURE_EQUAL( converter->Convert(pulses, rows, I3FramePtr()), size_t(5) );
+    rows->SetCurrentRow(4);
+    ENSURE_EQUAL( rows->Get<uint32_t>("om"), uint32_t(3) );
+    ENSURE_EQUAL( rows->Get<tableio_size_t>("vector_index"), tableio_size_t(2) );
+    ENSURE_EQUAL( rows->Get<double>("time"), 302. );
+}
+
+TEST(one_row_per_dom) {
+    I3ConverterPtr converter(new I3RecoPulseSeriesMapConverter(false, "", true));
+    I3RecoPulseSeriesMapPtr pulses = make_pulses();
+    ENSURE_EQUAL( converter->GetNumberOfRows(pulses), size_t(2), "DOMs without pulses get no row" );
+
+    I3TableRowDescriptionConstPtr desc = converter->GetDescription(pulses);
+    ENSURE( desc->HasVariableLengthFields() );
+    ENSURE_EQUAL( desc->GetFieldColumn("vector_index"), desc->GetNumberOfFields(),
+                  "There is no index in the vector" );
+    ENSURE_EQUAL( desc->GetFieldArrayLengths()[desc->GetFieldColumn("charge")], size_t(0),
+                  "The pulse fields are variable-length" );
+    ENSURE_EQUAL( desc->GetFieldUnits()[desc->GetFieldColumn("time")], std::string("ns") );
+
+    I3TableRowPtr rows(new I3TableRow(desc,converter->GetNumberOfRows(pulses)));
+    ENSURE_EQUAL( converter->Convert(pulses, rows, I3FramePtr()), size_t(2) );
+
+    const unsigned oms[] = {1, 3};
+    for (size_t r=0; r<2; r++) {
+        rows->SetCurrentRow(r);
+        ENSURE_EQUAL( rows->Get<int32_t>("string"), int32_t(21) );
+        ENSURE_EQUAL( rows->Get<uint32_t>("om"), uint32_t(oms[r]) );
+
+        const I3RecoPulseSeries& series = pulses->at(OMKey(21,oms[r]));
+        size_t n;
+        const double* time = rows->GetVariableLength<double>("time", n);
+        ENSURE_EQUAL( n, series.size(), "Every pulse of the DOM is in its row" );
+        const double* width = rows->GetVariableLength<double>("width", n);
+        ENSURE_EQUAL( n, series.size() );
+        const double* charge = rows->GetVariableLength<double>("charge", n);
+        ENSURE_EQUAL( n, series.size() );
+        for (size_t i=0; i<n; i++) {
+            ENSURE_EQUAL( time[i], series[i].GetTime() );
+            ENSURE_EQUAL( width[i], series[i].GetWidth() );
+            ENSURE_EQUAL( charge[i], double(series[i].GetCharge()) );
+        }
+    }
+}
+
+TEST(unset_fields_are_zero) {
+    I3ConverterPtr converter(new I3MapOMKeyVectorConverter<BrightCharge>(false, "", true));
+
+    // first an event with bright pulses, then one with only dim pulses
+    I3RecoPulseSeriesMapPtr bright = make_pulses();
+    for (I3RecoPulse& pulse : bright->at(OMKey(21,3)))
+        pulse.SetCharge(4.);
+    I3RecoPulseSeriesMapPtr dim = make_pulses();
+    for (I3RecoPulseSeriesMap::value_type& dom : *dim)
+        for (I3RecoPulse& pulse : dom.second)
+            pulse.SetCharge(0.5);
+
+    I3TableRowDescriptionConstPtr desc = converter->GetDescription(bright);
+    I3TableRowPtr rows(new I3TableRow(desc,converter->GetNumberOfRows(bright)));
+    ENSURE_EQUAL( converter->Convert(bright, rows, I3FramePtr()), size_t(2) );
+    size_t n;
+    rows->SetCurrentRow(1);
+    const double* charge = rows->GetVariableLength<double>("charge", n);
+    ENSURE_EQUAL( n, size_t(3) );
+    ENSURE_EQUAL( charge[2], 4. );
+
+    rows = I3TableRowPtr(new I3TableRow(desc,converter->GetNumberOfRows(dim)));
+    ENSURE_EQUAL( converter->Convert(dim, rows, I3FramePtr()), size_t(2) );
+    for (size_t r=0; r<2; r++) {
+        rows->SetCurrentRow(r);
+        charge = rows->GetVariableLength<double>("charge", n);
+        for (size_t i=0; i<n; i++)
+            ENSURE_EQUAL( charge[i], 0., "Nothing is left over from the previous event" );
+    }
+}
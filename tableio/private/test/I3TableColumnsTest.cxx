@@ -0,0 +1,269 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include <cstring>
+#include <vector>
+
+#include <dataclasses/I3Double.h>
+#include <dataclasses/physics/I3EventHeader.h>
+#include <tableio/I3Converter.h>
+#include <tableio/I3Table.h>
+#include <tableio/I3TableColumns.h>
+#include <tableio/I3TableRow.h>
+#include <tableio/I3TableRowDescription.h>
+#include <tableio/I3TableService.h>
+
+TEST_GROUP(I3TableColumnsTests);
+
+namespace {
+
+I3TableRowDescriptionPtr make_description() {
+    I3TableRowDescriptionPtr desc(new I3TableRowDescription());
+    desc->AddField<uint32_t>("Event", "", "doc");
+    desc->AddField<double>("value", "", "doc");
+    desc->AddField<bool>("flag", "", "doc");
+    desc->AddField<float>("vector", "", "doc", 3);
+    desc->SetIsMultiRow(true);
+    return desc;
+}
+
+// converts only through FillRows, so ConvertColumns uses the default
+class RowOnlyConverter : public I3ConverterImplementation<I3Double> {
+    private:
+        I3TableRowDescriptionPtr CreateDescription(const I3Double& object) {
+            return make_description();
+        }
+        size_t GetNumberOfRows(const I3Double& object) {
+            return size_t(object.value);
+        }
+        size_t FillRows(const I3Double& object, I3TableRowPtr rows) {
+            for (size_t i = 0; i < rows->GetNumberOfRows(); ++i) {
+                rows->SetCurrentRow(i);
+                rows->Set<double>("value", object.value + i);
+                rows->Set<bool>("flag", i % 2);
+                rows->GetPointer<float>("vector")[2] = i;
+            }
+            return rows->GetNumberOfRows();
+        }
+};
+
+// keeps everything it is asked to write, and reads it back
+class MemoryTable : public I3Table {
+    public:
+        MemoryTable(I3TableService& service, const std::string& name,
+                    I3TableRowDescriptionConstPtr description) :
+            I3Table(service, name, description),
+            rows(new I3TableRow(description, 0)) {}
+        I3TableRowPtr rows;
+        std::vector<std::pair<size_t,size_t> > ranges;
+    protected:
+        void WriteRows(I3TableRowConstPtr row) {
+            ranges.push_back(std::make_pair(rows->GetNumberOfRows(),
+                                            rows->GetNumberOfRows() + row->GetNumberOfRows()));
+            rows->append(*row);
+        }
+        I3TableRowConstPtr ReadRows(size_t start, size_t nrows) const {
+            return I3TableRowPtr(new I3TableRow(*rows, start, start + nrows));
+        }
+        std::pair<size_t,size_t> GetRangeForEvent(size_t index) const {
+            return ranges.at(index);
+        }
+};
+
+class MemoryTableService : public I3TableService {
+    protected:
+        I3TablePtr CreateTable(const std::string& name,
+                               I3TableRowDescriptionConstPtr description) {
+            return I3TablePtr(new MemoryTable(*this, name, description));
+        }
+        void CloseFile() {}
+};
+
+}
+
+TEST(rows_round_trip) {
+    I3TableRowDescriptionPtr desc = make_description();
+    I3TableRow rows(desc, 4);
+    for (size_t i = 0; i < 4; ++i) {
+        rows.SetCurrentRow(i);
+        rows.Set<uint32_t>("Event", 10 + i);
+        rows.Set<double>("value", 0.5*i);
+        rows.Set<bool>("flag", i == 2);
+        rows.GetPointer<float>("vector")[1] = -1.f*i;
+    }
+
+    I3TableColumns columns(desc);
+    columns.append(rows);
+    ENSURE_EQUAL(columns.GetNumberOfRows(), 4u);
+    ENSURE_EQUAL(columns.GetColumn<uint32_t>("Event")[3], 13u);
+    ENSURE_EQUAL(columns.GetColumn<double>(1)[1], 0.5);
+    ENSURE(columns.GetColumn<bool>("flag")[2]);
+    ENSURE(!columns.GetColumn<bool>("flag")[1]);
+    ENSURE_EQUAL(columns.GetColumn<float>("vector")[3*3+1], -3.f, "array fields are contiguous per row");
+
+    I3TableRowPtr back = columns.GetRows(1, 3);
+    ENSURE_EQUAL(back->GetNumberOfRows(), 3u);
+    ENSURE(memcmp(back->GetPointer(), rows.GetPointerToRow(1), 3*desc->GetTotalByteSize()) == 0,
+           "rows survive the round trip through columns");
+
+    bool thrown = false;
+    try { columns.GetColumn<int32_t>("value"); }
+    catch(...) { thrown = true; }
+    ENSURE(thrown, "columns are type-checked");
+
+    columns.clear();
+    ENSURE_EQUAL(columns.GetNumberOfRows(), 0u);
+    ENSURE_EQUAL(columns.AddRows(2), 0u);
+    ENSURE_EQUAL(columns.GetColumn<double>("value")[1], 0., "new rows are zeroed");
+}
+
+TEST(broadcast) {
+    I3TableRowDescriptionPtr desc = make_description();
+    I3TableColumns columns(desc, 3);
+    I3TableRow row(desc);
+    row.Set<uint32_t>("Event", 7);
+    row.Set<double>("value", 1.);
+
+    columns.Broadcast(row, 1, 2, 0, 1);
+    ENSURE_EQUAL(columns.GetColumn<uint32_t>("Event")[0], 0u);
+    ENSURE_EQUAL(columns.GetColumn<uint32_t>("Event")[1], 7u);
+    ENSURE_EQUAL(columns.GetColumn<uint32_t>("Event")[2], 7u);
+    ENSURE_EQUAL(columns.GetColumn<double>("value")[2], 0., "only the given fields are copied");
+}
+
+TEST(default_convert_columns) {
+    I3ConverterPtr converter_ptr(new RowOnlyConverter);
+    I3Converter& converter = *converter_ptr;
+    std::vector<I3FrameObjectConstPtr> objects;
+    objects.push_back(I3DoubleConstPtr(new I3Double(2)));
+    objects.push_back(I3DoubleConstPtr(new I3Double(3)));
+
+    I3TableColumns columns(converter.GetDescription(objects.front()), 5);
+    ENSURE_EQUAL(converter.ConvertColumns(objects, columns), 5u);
+    ENSURE_EQUAL(columns.GetNumberOfRows(), 5u);
+
+    for (size_t i = 0, start = 0; i < objects.size(); ++i) {
+        I3TableRowPtr rows(new I3TableRow(columns.GetDescription(), converter.GetNumberOfRows(objects[i])));
+        converter.Convert(objects[i], rows, I3FramePtr());
+        I3TableRowPtr converted = columns.GetRows(start, rows->GetNumberOfRows());
+        ENSURE(memcmp(converted->GetPointer(), rows->GetPointer(),
+                      rows->GetNumberOfRows()*columns.GetDescription()->GetTotalByteSize()) == 0,
+               "ConvertColumns gives the same rows as Convert");
+        start += rows->GetNumberOfRows();
+    }
+}
+
+TEST(add_columns) {
+    I3TableRowDescriptionPtr desc = make_description();
+    MemoryTableService service;
+    MemoryTable by_row(service, "by_row", desc);
+    MemoryTable by_column(service, "by_column", desc);
+
+    I3TableColumns columns(desc);
+    std::vector<I3EventHeaderConstPtr> headers;
+    std::vector<size_t> nrows;
+    for (unsigned event = 0; event < 3; ++event) {
+        I3EventHeaderPtr header(new I3EventHeader);
+        header->SetEventID(event);
+        I3TableRowPtr rows(new I3TableRow(desc, event + 1));
+        for (size_t i = 0; i < rows->GetNumberOfRows(); ++i) {
+            rows->SetCurrentRow(i);
+            rows->Set<uint32_t>("Event", event);
+            rows->Set<double>("value", i);
+        }
+        by_row.AddRow(header, rows);
+        columns.append(*rows);
+        headers.push_back(header);
+        nrows.push_back(rows->GetNumberOfRows());
+    }
+    by_column.AddColumns(headers, nrows, columns);
+
+    ENSURE_EQUAL(by_column.GetNumberOfEvents(), 3u);
+    ENSURE_EQUAL(by_column.GetNumberOfRows(), 6u);
+    ENSURE_EQUAL(by_column.rows->GetNumberOfRows(), 6u);
+    ENSURE(memcmp(by_column.rows->GetPointer(), by_row.rows->GetPointer(),
+                  6*desc->GetTotalByteSize()) == 0,
+           "AddColumns writes the same rows as AddRow");
+}
+
+TEST(read_columns) {
+    I3TableRowDescriptionPtr desc = make_description();
+    MemoryTableService service;
+    MemoryTable table(service, "table", desc);
+    for (unsigned event = 0; event < 4; ++event) {
+        I3EventHeaderPtr header(new I3EventHeader);
+        header->SetEventID(event);
+        I3TableRowPtr rows(new I3TableRow(desc, event + 1));
+        for (size_t i = 0; i < rows->GetNumberOfRows(); ++i) {
+            rows->SetCurrentRow(i);
+            rows->Set<uint32_t>("Event", event);
+            rows->Set<double>("value", 10*event + i);
+            rows->GetPointer<float>("vector")[1] = i;
+        }
+        table.AddRow(header, rows);
+    }
+
+    std::vector<std::string> fields;
+    fields.push_back("vector");
+    fields.push_back("Event");
+    I3TableColumnsConstPtr columns = table.ReadColumns(fields, 1, 3);
+    ENSURE_EQUAL(columns->GetDescription()->GetNumberOfFields(), 2u, "only the requested fields are read");
+    ENSURE_EQUAL(columns->GetDescription()->GetFieldNames()[0], std::string("vector"));
+    ENSURE_EQUAL(columns->GetNumberOfRows(), 5u, "events 1 and 2 have 2 and 3 rows");
+    const uint32_t* events = columns->GetColumn<uint32_t>("Event");
+    const float* vectors = columns->GetColumn<float>("vector");
+    for (size_t r = 0; r < 5; ++r) {
+        ENSURE_EQUAL(events[r], r < 2 ? 1u : 2u);
+        ENSURE_EQUAL(vectors[3*r+1], float(r < 2 ? r : r - 2));
+    }
+
+    I3TableColumnsConstPtr all = table.ReadColumns(std::vector<std::string>(), 0, 4);
+    ENSURE_EQUAL(all->GetNumberOfRows(), 10u);
+    ENSURE_EQUAL(all->GetColumn<double>("value")[9], 33.);
+    ENSURE_EQUAL(table.ReadColumns(fields, 2, 2)->GetNumberOfRows(), 0u);
+
+    bool thrown = false;
+    try { table.ReadColumns(std::vector<std::string>(1, "nope"), 0, 1); }
+    catch(...) { thrown = true; }
+    ENSURE(thrown, "unknown fields are an error");
+}
+
+TEST(variable_length_columns) {
+    I3TableRowDescriptionPtr desc(new I3TableRowDescription());
+    desc->AddField<uint32_t>("Event", "", "doc");
+    desc->AddVariableLengthField<float>("wf", "", "doc");
+    I3TableRow rows(desc, 3);
+    for (size_t i = 0; i < 3; ++i) {
+        std::vector<float> wf(2*i, 0.5f*i);
+        rows.SetCurrentRow(i);
+        rows.Set<uint32_t>("Event", i);
+        rows.SetVariableLength("wf", wf.data(), wf.size());
+    }
+
+    I3TableColumns columns(desc);
+    columns.append(rows);
+    columns.append(rows);
+    ENSURE_EQUAL(columns.GetNumberOfRows(), 6u);
+    const I3VariableLengthSlot* slots = static_cast<const I3VariableLengthSlot*>(columns.GetPointerToColumn(1));
+    ENSURE_EQUAL(slots[5].offset, 8u, "the values of all rows are back to back");
+    ENSURE_EQUAL(slots[5].length, 4u);
+
+    size_t n;
+    const float* wf = static_cast<const float*>(columns.GetVariableLength(1, 5, n));
+    ENSURE_EQUAL(n, 4u);
+    ENSURE_EQUAL(wf[3], 1.f);
+
+    I3TableRowPtr back = columns.GetRows(4, 2);
+    back->SetCurrentRow(1);
+    wf = back->GetVariableLength<float>("wf", n);
+    ENSURE_EQUAL(n, 4u, "rows survive the round trip through columns");
+    ENSURE_EQUAL(wf[0], 1.f);
+
+    bool thrown = false;
+    try { columns.Broadcast(rows, 0, 1, 0, 2); }
+    catch(...) { thrown = true; }
+    ENSURE(thrown, "variable-length fields can't be broadcast");
+}
@@ -15,6 +15,7 @@
 
 #include <tableio/I3TableRow.h>
 #include <tableio/I3TableRowDescription.h>
+#include <tableio/I3TableRowPool.h>
 
 TEST_GROUP(I3TableRowTests);
 
@@ -182,3 +183,130 @@ TEST(copy_constructor) {
         ENSURE_EQUAL(wf1[i], wf2[i], "array fields equal");
     }
 }
+
+TEST(reset) {
+    I3TableRowDescriptionPtr base_d = I3TableRowDescriptionPtr( new I3TableRowDescription());
+    base_d->AddField<uint32_t>("Run", "", "doc");
+    base_d->AddField<double>("value", "", "doc");
+
+    I3TableRow rows(base_d, 4);
+    rows.SetCurrentRow(3);
+    rows.Set<double>("value", 3.);
+    const void* buffer = rows.GetPointer();
+
+    rows.reset(2);
+    ENSURE_EQUAL(rows.GetNumberOfRows(), 2u);
+    ENSURE_EQUAL(rows.GetCurrentRow(), 0u);
+    ENSURE(rows.GetPointer() == buffer, "smaller sizes keep the buffer");
+    rows.reset(4);
+    rows.SetCurrentRow(3);
+    ENSURE_EQUAL(rows.Get<double>("value"), 0., "rows are zeroed");
+
+    rows.SetNumberOfRows(5);
+    rows.SetCurrentRow(4);
+    rows.Set<double>("value", 4.);
+    ENSURE_EQUAL(rows.Get<double>("value"), 4.);
+}
+
+TEST(pool) {
+    I3TableRowDescriptionPtr base_d = I3TableRowDescriptionPtr( new I3TableRowDescription());
+    base_d->AddField<uint32_t>("Run", "", "doc");
+    I3TableRowPoolPtr pool(new I3TableRowPool(base_d, 1));
+
+    I3TableRowPtr rows = pool->GetRows(3);
+    rows->SetCurrentRow(2);
+    rows->Set<uint32_t>("Run", 7);
+    const void* buffer = rows->GetPointer();
+    I3TableRowPtr kept = rows;
+    rows.reset();
+    ENSURE_EQUAL(pool->size(), 0u, "rows come back only when the last reference is gone");
+    kept.reset();
+    ENSURE_EQUAL(pool->size(), 1u);
+
+    rows = pool->GetRows(2);
+    ENSURE_EQUAL(pool->size(), 0u);
+    ENSURE(rows->GetPointer() == buffer, "released rows are reused");
+    ENSURE_EQUAL(rows->GetNumberOfRows(), 2u);
+    rows->SetCurrentRow(1);
+    ENSURE_EQUAL(rows->Get<uint32_t>("Run"), 0u, "reused rows are zeroed");
+
+    // the pool keeps at most one spare
+    I3TableRowPtr other = pool->GetRows(1);
+    rows.reset();
+    other.reset();
+    ENSURE_EQUAL(pool->size(), 1u);
+
+    // rows may outlive their pool
+    rows = pool->GetRows(1);
+    pool.reset();
+    rows.reset();
+}
+
+TEST(variable_length) {
+    I3TableRowDescriptionPtr desc = I3TableRowDescriptionPtr( new I3TableRowDescription());
+    desc->AddField<uint8_t>("flag", "", "doc");
+    desc->AddVariableLengthField<double>("wf", "mV", "doc");
+    desc->AddField<int32_t>("after", "", "doc");
+    ENSURE(desc->IsVariableLength(1));
+    ENSURE(!desc->IsVariableLength(0));
+    ENSURE(desc->HasVariableLengthFields());
+    ENSURE_EQUAL(desc->GetFieldByteOffsets()[1], 8u, "slots are aligned to 8 bytes");
+    ENSURE_EQUAL(desc->GetFieldSizes()[1], sizeof(I3VariableLengthSlot));
+
+    I3TableRow rows(desc, 3);
+    for (size_t i = 0; i < 3; i++) {
+        std::vector<double> wf(i + 1, double(i));
+        rows.SetCurrentRow(i);
+        rows.SetVariableLength("wf", wf.data(), wf.size());
+        rows.Set<int32_t>("after", i);
+    }
+    // replacing the elements of a row
+    const double two[2] = {5., 6.};
+    rows.SetCurrentRow(0);
+    rows.SetVariableLength("wf", two, 2);
+
+    size_t n;
+    const double* wf = rows.GetVariableLength<double>("wf", n);
+    ENSURE_EQUAL(n, 2u);
+    ENSURE_EQUAL(wf[1], 6.);
+    rows.SetCurrentRow(2);
+    wf = rows.GetVariableLength<double>("wf", n);
+    ENSURE_EQUAL(n, 3u);
+    ENSURE_EQUAL(wf[2], 2.);
+    ENSURE_EQUAL(rows.Get<int32_t>("after"), 2);
+
+    bool thrown = false;
+    try { rows.GetVariableLength<int32_t>("after", n); }
+    catch(...) { thrown = true; }
+    ENSURE(thrown, "fixed-size fields have no elements");
+
+    // copies carry the elements along
+    I3TableRow slice(rows, 1, 3);
+    slice.SetCurrentRow(1);
+    wf = slice.GetVariableLength<double>("wf", n);
+    ENSURE_EQUAL(n, 3u);
+    ENSURE_EQUAL(wf[0], 2.);
+
+    I3TableRowPtr single = rows.GetSingleRow(0);
+    wf = single->GetVariableLength<double>("wf", n);
+    ENSURE_EQUAL(n, 2u);
+    ENSURE_EQUAL(wf[0], 5.);
+
+    I3TableRow appended(desc, 0);
+    appended.append(*single);
+    appended.append(slice);
+    ENSURE_EQUAL(appended.GetNumberOfRows(), 3u);
+    appended.erase(1);
+    appended.SetCurrentRow(0);
+    wf = appended.GetVariableLength<double>("wf", n);
+    ENSURE_EQUAL(n, 2u, "erase keeps the elements of the remaining rows");
+    ENSURE_EQUAL(wf[1], 1.);
+    appended.SetCurrentRow(1);
+    wf = appended.GetVariableLength<double>("wf", n);
+    ENSURE_EQUAL(n, 3u);
+    ENSURE_EQUAL(wf[2], 2.);
+
+    appended.reset(1);
+    appended.GetVariableLength<double>("wf", n);
+    ENSURE_EQUAL(n, 0u, "reset rows are empty");
+}
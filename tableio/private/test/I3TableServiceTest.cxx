@@ -0,0 +1,211 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <I3Test.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include <dataclasses/I3Double.h>
+#include <dataclasses/physics/I3EventHeader.h>
+#include <tableio/I3Converter.h>
+#include <tableio/I3Table.h>
+#include <tableio/I3TableRow.h>
+#include <tableio/I3TableRowDescription.h>
+#include <tableio/I3TableService.h>
+#include <tableio/I3TableWriter.h>
+
+TEST_GROUP(I3TableServiceTests);
+
+namespace {
+
+// keeps everything it is asked to write, and where it was written
+class MemoryTable : public I3Table {
+    public:
+        MemoryTable(I3TableService& service, const std::string& name,
+                    I3TableRowDescriptionConstPtr description, const bool& alive) :
+            I3Table(service, name, description),
+            rows(new I3TableRow(description, 0)), fail(false), alive_(alive) {}
+        I3TableRowPtr rows;
+        std::thread::id writer;
+        bool fail;
+    protected:
+        void WriteRows(I3TableRowConstPtr row) {
+            if (!alive_)
+                throw std::logic_error("write after the service was destroyed");
+            if (fail)
+                throw std::runtime_error("disk full");
+            writer = std::this_thread::get_id();
+            rows->append(*row);
+        }
+    private:
+        const bool& alive_;
+};
+
+class MemoryTableService : public I3TableService {
+    public:
+        ~MemoryTableService() { JoinWriter(); alive = false; }
+        // tables may only write while the backend is still there
+        bool alive = true;
+        bool closed = false;
+        std::map<std::string, I3TablePtr> created;
+    protected:
+        I3TablePtr CreateTable(const std::string& name,
+                               I3TableRowDescriptionConstPtr description) {
+            return created[name] = I3TablePtr(new MemoryTable(*this, name, description, alive));
+        }
+        void CloseFile() { closed = true; }
+};
+
+I3TableRowDescriptionPtr make_description(I3TableService& service) {
+    I3TableRowDescriptionPtr desc(new I3TableRowDescription(*service.GetIndexDescription()));
+    desc->AddField<double>("value", "", "doc");
+    return desc;
+}
+
+// table "a" has every event, table "b" only the odd ones
+void fill(I3TableService& service, I3TablePtr& a, I3TablePtr& b) {
+    I3TableRowDescriptionPtr desc = make_description(service);
+    a = service.GetTable("a", desc);
+    b = service.GetTable("b", desc);
+    for (unsigned event = 0; event < 50; ++event) {
+        I3EventHeaderPtr header(new I3EventHeader);
+        header->SetRunID(1);
+        header->SetEventID(event);
+        I3TablePtr tables[2] = {a, b};
+        for (I3TablePtr table : tables) {
+            if (table == b && event % 2 == 0)
+                continue;
+            I3TableRowPtr row = table->CreateRow(1);
+            row->Set<uint32_t>("Run", 1);
+            row->Set<uint32_t>("Event", event);
+            row->Set<bool>("exists", true);
+            row->Set<double>("value", event);
+            table->AddRow(header, row);
+        }
+    }
+    service.Finish();
+}
+
+class DoubleConverter : public I3ConverterImplementation<I3Double> {
+    private:
+        I3TableRowDescriptionPtr CreateDescription(const I3Double& object) {
+            I3TableRowDescriptionPtr desc(new I3TableRowDescription());
+            desc->AddField<double>("value", "", "doc");
+            return desc;
+        }
+        size_t FillRows(const I3Double& object, I3TableRowPtr rows) {
+            rows->Set<double>("value", object.value);
+            return 1;
+        }
+};
+
+// book "a" in every event and "b" only in the odd ones
+void book(boost::shared_ptr<MemoryTableService> service, size_t batchSize) {
+    std::vector<I3ConverterMillPtr> mills;
+    std::vector<std::string> streams(1, "in_ice");
+    I3TableWriter writer(service, mills, streams);
+    writer.SetBatchSize(batchSize);
+    writer.AddObject("a", I3TableWriter::TableSpec(I3ConverterPtr(new DoubleConverter)));
+    writer.AddObject("b", I3TableWriter::TableSpec(I3ConverterPtr(new DoubleConverter)));
+    for (unsigned event = 0; event < 50; ++event) {
+        I3EventHeaderPtr header(new I3EventHeader);
+        header->SetRunID(1);
+        header->SetEventID(event);
+        header->SetSubEventStream("in_ice");
+        I3FramePtr frame(new I3Frame(I3Frame::Physics));
+        frame->Put("I3EventHeader", header);
+        frame->Put("a", I3DoublePtr(new I3Double(event)));
+        if (event % 2)
+            frame->Put("b", I3DoublePtr(new I3Double(-1.*event)));
+        writer.Convert(frame);
+    }
+    writer.Finish();
+}
+
+}
+
+TEST(background_writes_match) {
+    MemoryTableService sync, background;
+    background.SetBackgroundWriting(4);
+    ENSURE(background.WritesInBackground());
+    ENSURE(!sync.WritesInBackground());
+
+    I3TablePtr sa, sb, ba, bb;
+    fill(sync, sa, sb);
+    fill(background, ba, bb);
+    ENSURE(background.closed, "Finish closes the file after the queue drained");
+
+    const size_t rowsize = sa->GetDescription()->GetTotalByteSize();
+    I3TablePtr expected[2] = {sa, sb};
+    I3TablePtr written[2] = {ba, bb};
+    for (int i = 0; i < 2; ++i) {
+        MemoryTable& e = dynamic_cast<MemoryTable&>(*expected[i]);
+        MemoryTable& w = dynamic_cast<MemoryTable&>(*written[i]);
+        ENSURE_EQUAL(e.rows->GetNumberOfRows(), 50u, "tables are padded");
+        ENSURE_EQUAL(w.rows->GetNumberOfRows(), e.rows->GetNumberOfRows());
+        ENSURE(memcmp(w.rows->GetPointer(), e.rows->GetPointer(), 50*rowsize) == 0,
+               "background writing gives the same rows");
+        ENSURE(e.writer == std::this_thread::get_id());
+        ENSURE(w.writer != std::this_thread::get_id(), "rows are written on another thread");
+    }
+}
+
+TEST(background_errors_are_rethrown) {
+    MemoryTableService service;
+    service.SetBackgroundWriting(2);
+    I3TablePtr table = service.GetTable("a", make_description(service));
+    dynamic_cast<MemoryTable&>(*table).fail = true;
+
+    I3EventHeaderPtr header(new I3EventHeader);
+    table->AddRow(header, table->CreateRow(1));
+    bool thrown = false;
+    try { service.WaitForWrites(); }
+    catch (const std::runtime_error& e) { thrown = (std::string(e.what()) == "disk full"); }
+    ENSURE(thrown, "errors on the writer thread reach the caller");
+
+    // back to writing on this thread
+    dynamic_cast<MemoryTable&>(*table).fail = false;
+    service.SetBackgroundWriting(0);
+    ENSURE(!service.WritesInBackground());
+    table->AddRow(header, table->CreateRow(1));
+    ENSURE_EQUAL(dynamic_cast<MemoryTable&>(*table).writer, std::this_thread::get_id());
+}
+
+TEST(batched_conversion_matches) {
+    boost::shared_ptr<MemoryTableService> single(new MemoryTableService);
+    boost::shared_ptr<MemoryTableService> batched(new MemoryTableService);
+    batched->SetBackgroundWriting(4);
+    book(single, 1);
+    book(batched, 7);
+
+    const char* names[2] = {"a", "b"};
+    for (const char* name : names) {
+        MemoryTable& e = dynamic_cast<MemoryTable&>(*single->created.at(name));
+        MemoryTable& w = dynamic_cast<MemoryTable&>(*batched->created.at(name));
+        const size_t rowsize = e.GetDescription()->GetTotalByteSize();
+        ENSURE_EQUAL(e.rows->GetNumberOfRows(), 50u, "tables are padded");
+        ENSURE_EQUAL(w.rows->GetNumberOfRows(), e.rows->GetNumberOfRows());
+        ENSURE(memcmp(w.rows->GetPointer(), e.rows->GetPointer(), 50*rowsize) == 0,
+               "batches give the same rows, index columns and padding");
+    }
+}
+
+TEST(destruction_runs_queued_writes) {
+    I3TablePtr table;
+    {
+        MemoryTableService service;
+        service.SetBackgroundWriting(4);
+        table = service.GetTable("a", make_description(service));
+        I3EventHeaderPtr header(new I3EventHeader);
+        for (unsigned event = 0; event < 4; ++event) {
+            header->SetEventID(event);
+            table->AddRow(header, table->CreateRow(1));
+        }
+        // destroyed without Finish()
+    }
+    ENSURE_EQUAL(dynamic_cast<MemoryTable&>(*table).rows->GetNumberOfRows(), 4u,
+                 "the writes queued before the destructor ran while the backend was alive");
+}
@@ -154,6 +154,9 @@ TEST(MostSpecificConverterIsSelected){
 	ENSURE(I3TableWriterTestAccess::FindConverter(tw,f)==fconverter);
 	ENSURE(I3TableWriterTestAccess::FindConverter(tw,f2)==fconverter);
 	ENSURE(I3TableWriterTestAccess::FindConverter(tw,b)==bconverter);
+	//the second lookup of each type comes from the dispatch cache
+	ENSURE(I3TableWriterTestAccess::FindConverter(tw,f2)==fconverter);
+	ENSURE(I3TableWriterTestAccess::FindConverter(tw,b)==bconverter);
 
 	namespace fs = boost::filesystem;
 	fs::remove_all("dummy_directory");
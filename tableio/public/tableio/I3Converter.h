@@ -22,6 +22,7 @@
 
 #include "tableio/I3TableRowDescription.h"
 #include "tableio/I3TableRow.h"
+#include "tableio/I3TableColumns.h"
 
 I3_FORWARD_DECLARATION(I3TableWriter);
 
@@ -106,6 +107,26 @@ class I3Converter {
                                      I3TableRowPtr rows,
                                      I3FramePtr frame=I3FramePtr()) = 0;
 
+        /**
+	 * \brief Fill a batch of objects into table columns.
+	 *
+	 * Fills the rows of each object, in order, into columns, which follow
+	 * the description of the table (including its index columns). The
+	 * caller sizes the columns beforehand to hold GetNumberOfRows() zeroed
+	 * rows for each object.
+	 * \param objects The frame objects to be converted
+	 * \param columns The table columns to be filled
+	 * \param frames Optional pointers to the frame of each object, either
+	 *               empty or one per object.
+	 * \returns The number of rows it filled
+	 *
+	 * The default implementation converts each object into an I3TableRow
+	 * and copies it column by column.
+	 */
+        virtual size_t ConvertColumns(const std::vector<I3FrameObjectConstPtr>& objects,
+                                      I3TableColumns& columns,
+                                      const std::vector<I3FramePtr>& frames=std::vector<I3FramePtr>());
+
         enum ConvertState{
             /// Used to indicate that a converter cannot convert a given object
             NoConversion,
@@ -229,6 +250,29 @@ class I3ConverterImplementation : public I3Converter {
             return Convert( *object, rows, frame);
         }
 
+        /**
+	 * \brief Fills a batch of frame objects into the given table columns.
+	 *
+	 * This function calls FillColumns, after the same conversion and lazy
+	 * initialization of the description as Convert.
+	 */
+        size_t ConvertColumns(const std::vector<I3FrameObjectConstPtr>& objects,
+                              I3TableColumns& columns,
+                              const std::vector<I3FramePtr>& frames=std::vector<I3FramePtr>()) {
+            if (objects.empty())
+                return 0;
+            std::vector<const FrmObj*> typedObjects;
+            typedObjects.reserve(objects.size());
+            for (const I3FrameObjectConstPtr& object : objects)
+                typedObjects.push_back(&dynamic_cast<const FrmObj&>(*object));
+
+            // lazy initialization of the description:
+            if (!description_)
+               description_ = CreateDescription(*typedObjects.front());
+
+            return FillColumns(typedObjects, frames, columns);
+        }
+
         /**
 	 * \brief Return an I3TableRowDescription specifying the columns this converter
 	 * will fill.
@@ -278,6 +322,17 @@ class I3ConverterImplementation : public I3Converter {
 	 * This function has to be implemented by the derived converter implementation.
 	 */
         virtual size_t FillRows(const FrmObj& object, I3TableRowPtr rows) = 0;
+        /**
+	 * \brief Fill the rows of a batch of objects into table columns.
+	 *
+	 * The columns already hold GetNumberOfRows() rows for each object. The
+	 * default implementation calls FillRows for each object and copies the
+	 * rows column by column. Override in converters that can write the
+	 * columns directly; currentFrame_ is not set while they do.
+	 */
+        virtual size_t FillColumns(const std::vector<const FrmObj*>& objects,
+                                   const std::vector<I3FramePtr>& frames,
+                                   I3TableColumns& columns);
 };
 
 /******************************************************************************/
@@ -290,6 +345,25 @@ size_t I3ConverterImplementation<FrmObj>::GetNumberOfRows(const FrmObj& object)
 
 /******************************************************************************/
 
+template <class FrmObj>
+size_t I3ConverterImplementation<FrmObj>::FillColumns(const std::vector<const FrmObj*>& objects,
+                                                      const std::vector<I3FramePtr>& frames,
+                                                      I3TableColumns& columns) {
+    size_t nrows = 0;
+    for (size_t i = 0, start = 0; i < objects.size(); ++i) {
+        I3TableRowPtr rows(new I3TableRow(columns.GetDescription(),
+                                          GetNumberOfRows(*objects[i])));
+        currentFrame_ = frames.empty() ? I3FramePtr() : frames.at(i);
+        nrows += FillRows(*objects[i], rows);
+        columns.SetRows(start, *rows);
+        start += rows->GetNumberOfRows();
+    }
+    currentFrame_.reset();
+    return nrows;
+}
+
+/******************************************************************************/
+
 /// A default implementation of CanConvert. Tests whether the pointer matches the
 /// template type, and if that fails tests casting.
 template <class FrmObj>
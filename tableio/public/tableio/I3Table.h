@@ -14,9 +14,12 @@
 
 #include "icetray/I3Logging.h"
 #include <string>
+#include <vector>
 
 I3_FORWARD_DECLARATION(I3TableRowDescription);
 I3_FORWARD_DECLARATION(I3TableRow);
+I3_FORWARD_DECLARATION(I3TableColumns);
+I3_FORWARD_DECLARATION(I3TableRowPool);
 I3_FORWARD_DECLARATION(I3EventHeader);
 I3_FORWARD_DECLARATION(I3TableService);
 
@@ -34,13 +37,31 @@ class I3Table {
         bool IsConnectedToWriter();
         void SetConnectedToWriter(bool connected);
 
+        // get nrows zeroed rows. Their memory is recycled once they have
+        // been written and released.
         I3TableRowPtr CreateRow(size_t nrows);
         virtual void AddRow(I3EventHeaderConstPtr header, I3TableRowConstPtr row);
+        // add a batch of events: nrows[i] consecutive rows of columns for headers[i]
+        virtual void AddColumns(const std::vector<I3EventHeaderConstPtr>& headers,
+                                const std::vector<size_t>& nrows,
+                                const I3TableColumns& columns);
+        // add one event: the rows [start,start+nrows) of columns, which the
+        // caller must not modify afterwards
+        virtual void AddColumns(I3EventHeaderConstPtr header, I3TableColumnsConstPtr columns,
+                                size_t start, size_t nrows);
         virtual void Align();
 
+        // does the table write columns more efficiently than rows?
+        virtual bool PrefersColumns() const { return false; }
+
         // I3TableRowConstPtr GetRowForEvent(unsigned int RunID, unsigned int EventID);
         I3TableRowConstPtr GetRowForEvent(size_t index) const;
 
+        // read the given fields of the rows of events [firstEvent,endEvent)
+        // into one contiguous buffer per field. An empty list reads all fields.
+        I3TableColumnsPtr ReadColumns(const std::vector<std::string>& fields,
+                                      size_t firstEvent, size_t endEvent) const;
+
         std::string GetName() const;
         size_t GetNumberOfEvents() const;
         size_t GetNumberOfRows() const;
@@ -49,7 +70,18 @@ class I3Table {
     protected:
         // to be overridden by derivatives
         virtual void WriteRows(I3TableRowConstPtr row) = 0;
+        // the default implementation copies the rows and calls WriteRows
+        virtual void WriteColumns(const I3TableColumns& columns, size_t start, size_t nrows);
         virtual I3TableRowConstPtr ReadRows(size_t start, size_t nrows) const;
+        // fill columns with the rows [start,start+nrows) of the fields
+        // fieldIndices. The default implementation goes through ReadRows.
+        virtual void ReadFields(I3TableColumns& columns, const std::vector<size_t>& fieldIndices,
+                                size_t start, size_t nrows) const;
+        // add the rows of events [firstEvent,endEvent) to columns, filling
+        // the fields fieldIndices. The default implementation finds the rows
+        // with GetRangeForEvent and fills them with ReadFields.
+        virtual void ReadEvents(I3TableColumns& columns, const std::vector<size_t>& fieldIndices,
+                                size_t firstEvent, size_t endEvent) const;
         virtual std::pair<size_t,size_t> GetRangeForEvent(size_t index) const;
         bool DoPadding();
 
@@ -66,6 +98,7 @@ class I3Table {
         bool tableCreated_;    // the table/tree has been created successfully
 
         I3EventHeaderConstPtr lastHeader_;
+        I3TableRowPoolPtr rowPool_;
 
         enum AlignmentType {
             MultiRow,   // Some objects can span multiple rows
@@ -77,6 +110,14 @@ class I3Table {
     private:
         I3Table();
 
+        // write rows now, or on the service's writer thread
+        void QueueRows(I3TableRowConstPtr rows);
+
+        // write padding rows up to the event of header
+        void PadBefore(I3EventHeaderConstPtr header);
+        // write the index row and update the counters for an event
+        void EventWritten(I3EventHeaderConstPtr header, size_t nrows);
+
     SET_LOGGER("I3Table");
 
 };
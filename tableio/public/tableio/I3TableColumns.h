@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef	I3_TABLECOLUMNS_H_INCLUDED
+#define I3_TABLECOLUMNS_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+#include "icetray/I3Logging.h"
+#include "icetray/I3PointerTypedefs.h"
+
+#include "tableio/I3TableRowDescription.h"
+
+I3_FORWARD_DECLARATION(I3TableRow);
+I3_FORWARD_DECLARATION(I3TableColumns);
+
+/**
+ * \brief Column-major storage for a batch of table rows.
+ *
+ * Every field of the description is kept in its own contiguous buffer of
+ * GetFieldSizes()[index] bytes per row. Converters can fill whole columns
+ * for a batch of objects, and column-oriented backends can take the buffers
+ * as they are instead of unpacking I3TableRows field by field.
+ *
+ * The column of a variable-length field holds an I3VariableLengthSlot per
+ * row, the offsets of the rows into a second buffer with the values of all
+ * rows back to back.
+ */
+class I3TableColumns {
+    public:
+        I3TableColumns(I3TableRowDescriptionConstPtr description, size_t nrows=0);
+
+        I3TableRowDescriptionConstPtr GetDescription() const { return description_; }
+
+        size_t GetNumberOfRows() const { return nrows_; }
+
+        // add nrows zeroed rows at the end, returning the index of the first
+        size_t AddRows(size_t nrows);
+
+        // make room for nrows rows without changing the number of rows
+        void reserve(size_t nrows);
+
+        // remove all rows, keeping the allocated memory for the next batch
+        void clear();
+
+        // get the column of a field, one element per row
+        template<class T>
+        T* GetColumn(size_t index);
+
+        template<class T>
+        T* GetColumn(const std::string& fieldName);
+
+        template<class T>
+        const T* GetColumn(size_t index) const;
+
+        template<class T>
+        const T* GetColumn(const std::string& fieldName) const;
+
+        // get a void pointer to the beginning of a column
+        void* GetPointerToColumn(size_t index);
+        void const* GetPointerToColumn(size_t index) const;
+
+        // make room for the n elements of a variable-length field in the
+        // given row. The pointer is only valid until the next elements are added.
+        void* AddVariableLength(size_t index, size_t row, size_t n);
+
+        // get the elements of a variable-length field in the given row,
+        // and their number
+        void const* GetVariableLength(size_t index, size_t row, size_t& n) const;
+
+        // append all rows, field by field
+        void append(const I3TableRow& rows);
+
+        // copy all rows into the rows [start,start+rows.GetNumberOfRows())
+        void SetRows(size_t start, const I3TableRow& rows);
+
+        // copy the fields [firstField,endField) of the current row of row
+        // into the rows [start,start+nrows)
+        void Broadcast(const I3TableRow& row, size_t start, size_t nrows,
+                       size_t firstField, size_t endField);
+
+        // copy the rows [start,start+nrows) into an I3TableRow
+        I3TableRowPtr GetRows(size_t start, size_t nrows) const;
+
+    private:
+        I3TableColumns();
+
+        size_t GetIndex(const std::string& fieldName) const;
+
+        template<class T>
+        void CheckType(size_t index) const;
+
+        I3TableRowDescriptionConstPtr description_;
+        std::vector<std::vector<char> > columns_;
+        // the elements of each variable-length field
+        std::vector<std::vector<char> > values_;
+        size_t nrows_;
+
+    SET_LOGGER("I3TableColumns");
+};
+
+I3_POINTER_TYPEDEFS( I3TableColumns );
+
+/******************************************************************************/
+
+template<class T>
+void I3TableColumns::CheckType(size_t index) const {
+    I3Datatype requested_dtype = I3DatatypeFromNativeType<T>();
+    const I3Datatype& this_dtype = description_->GetFieldTypes().at(index);
+    if (!this_dtype.CompatibleWith(requested_dtype, false)) {
+        log_fatal("The requested type %s is not compatible with %s, the type of field '%s'.",
+                  requested_dtype.AsString().c_str(), this_dtype.AsString().c_str(),
+                  description_->GetFieldNames().at(index).c_str());
+    }
+}
+
+template<class T>
+T* I3TableColumns::GetColumn(size_t index) {
+    CheckType<T>(index);
+    return reinterpret_cast<T*>(GetPointerToColumn(index));
+}
+
+template<class T>
+T* I3TableColumns::GetColumn(const std::string& fieldName) {
+    return GetColumn<T>(GetIndex(fieldName));
+}
+
+template<class T>
+const T* I3TableColumns::GetColumn(size_t index) const {
+    CheckType<T>(index);
+    return reinterpret_cast<const T*>(GetPointerToColumn(index));
+}
+
+template<class T>
+const T* I3TableColumns::GetColumn(const std::string& fieldName) const {
+    return GetColumn<T>(GetIndex(fieldName));
+}
+
+#endif
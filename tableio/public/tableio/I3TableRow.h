@@ -19,6 +19,9 @@
 #include "tableio/I3TableRowDescription.h"
 #include "tableio/I3MemoryChunk.h"
 
+#include <algorithm>
+#include <vector>
+
 I3_FORWARD_DECLARATION(I3TableRow);
 
 class I3TableRow {
@@ -96,6 +99,29 @@ class I3TableRow {
         // and a non-const version of same
         void* GetPointerToField(size_t index, size_t row);
 
+        // set the elements of a variable-length field in the current row
+        template<class T>
+        void SetVariableLength(const std::string& fieldName, const T* values, size_t n);
+
+        template<class T>
+        void SetVariableLength(size_t index, const T* values, size_t n);
+
+        // get the elements of a variable-length field in the current row
+        template<class T>
+        const T* GetVariableLength(const std::string& fieldName, size_t& n) const;
+
+        template<class T>
+        const T* GetVariableLength(size_t index, size_t& n) const;
+
+        // make room for the n elements of a variable-length field in the
+        // given row, replacing any it had. The pointer is only valid until
+        // the next elements are added.
+        void* AddVariableLength(size_t index, size_t row, size_t n);
+
+        // get a void pointer to the elements of a variable-length field
+        // in the given row, and their number
+        void const* GetVariableLength(size_t index, size_t row, size_t& n) const;
+
 
         I3TableRowDescriptionConstPtr GetDescription() const;
 
@@ -105,6 +131,9 @@ class I3TableRow {
         void SetEnumsAreInts( bool flag ) { enums_are_ints_ = flag; };
 
         void reserve(size_t nrows);
+        // drop all rows and start over with nrows zeroed rows, keeping the
+        // memory if it is large enough
+        void reset(size_t nrows);
         void erase(size_t nrows);
         void append(const I3TableRow& rhs);
 
@@ -126,12 +155,21 @@ class I3TableRow {
         void init();
         void expand(size_t nrows);
 
+        size_t GetVariableLengthIndex(const std::string& fieldName) const;
+
+        // copy the elements of the variable-length fields of nrows rows,
+        // starting at first, out of the given buffers into our own
+        void CopyVariableLength(const std::vector<std::vector<char> >& from,
+                                size_t first, size_t nrows);
+
         I3TableRowDescriptionConstPtr description_;
         size_t nrows_;
         size_t capacity_;
         size_t currentRow_;
         I3MemoryChunk* data_;
         bool enums_are_ints_;
+        // the elements of each variable-length field, empty if there are none
+        std::vector<std::vector<char> > values_;
 
 };
 
@@ -196,6 +234,31 @@ void I3TableRow::SetAll(size_t index, T value) {
 
 /******************************************************************************/
 
+template<class T>
+void I3TableRow::SetVariableLength(const std::string& fieldName, const T* values, size_t n) {
+    SetVariableLength(GetVariableLengthIndex(fieldName), values, n);
+}
+
+template<class T>
+void I3TableRow::SetVariableLength(size_t index, const T* values, size_t n) {
+    CheckType<T>(index);
+    T* elements = static_cast<T*>(AddVariableLength(index, currentRow_, n));
+    std::copy(values, values + n, elements);
+}
+
+template<class T>
+const T* I3TableRow::GetVariableLength(const std::string& fieldName, size_t& n) const {
+    return GetVariableLength<T>(GetVariableLengthIndex(fieldName), n);
+}
+
+template<class T>
+const T* I3TableRow::GetVariableLength(size_t index, size_t& n) const {
+    CheckType<T>(index);
+    return static_cast<const T*>(GetVariableLength(index, currentRow_, n));
+}
+
+/******************************************************************************/
+
 template<class T>
 T I3TableRow::Get(const std::string& fieldName) {
     return *GetPointer<T>(fieldName, currentRow_);
@@ -18,6 +18,7 @@
 
 #include "tableio/I3Datatype.h"
 
+#include <stdint.h>
 #include <string>
 #include <vector>
 #include <boost/unordered_map.hpp>
@@ -37,6 +38,16 @@
 
 /*****************************************************************************/
 
+/**
+ * A variable-length field takes up one of these in each row. The elements
+ * of the field are [offset,offset+length) of the values that the I3TableRow
+ * (or I3TableColumns) keeps for the field.
+ */
+struct I3VariableLengthSlot {
+    uint64_t offset;
+    uint64_t length;
+};
+
 /*****************************************************************************/
 
 
@@ -47,7 +58,7 @@ public:
     I3TableRowDescription();
     virtual ~I3TableRowDescription();
 
-    /* basic AddField */
+    /* basic AddField. An arrayLength of 0 books a variable-length field */
     void AddField(const std::string& name, I3Datatype type,
 		  const std::string& unit, const std::string& doc,
 		  size_t arrayLength);
@@ -75,6 +86,16 @@ public:
     AddField(name, enum_typus, unit, doc, arrayLength);
     }
 
+    /* convenience AddVariableLengthField - a field with a different number
+       of elements in every row, set with I3TableRow::SetVariableLength() */
+    template<class T>
+    void AddVariableLengthField(const std::string& name,
+		  const std::string& unit,
+		  const std::string& doc)
+    {
+      AddField<T>(name, unit, doc, 0);
+    }
+
     bool CanBeFilledInto(boost::shared_ptr<const I3TableRowDescription> other) const;
 
     // getter and setter - remove them? no real encapsulation anyway
@@ -89,6 +110,8 @@ public:
     const std::vector<std::string>& GetFieldDocStrings() const;
 
     size_t GetFieldColumn(const std::string& fieldName) const;
+    bool IsVariableLength(size_t index) const;
+    bool HasVariableLengthFields() const;
     size_t GetTotalByteSize() const;
     size_t GetTotalChunkSize() const;
     size_t GetNumberOfFields() const;
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2024 The IceTray Contributors
+//
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef	I3_TABLEROWPOOL_H_INCLUDED
+#define I3_TABLEROWPOOL_H_INCLUDED
+
+#include <mutex>
+#include <vector>
+
+#include <boost/enable_shared_from_this.hpp>
+
+#include "icetray/I3Logging.h"
+#include "icetray/I3PointerTypedefs.h"
+
+#include "tableio/I3TableRowDescription.h"
+
+I3_FORWARD_DECLARATION(I3TableRow);
+I3_FORWARD_DECLARATION(I3TableRowPool);
+
+/**
+ * \brief Recycles the buffers of I3TableRows with the same description.
+ *
+ * The rows handed out by GetRows() go back to the pool when their last
+ * reference is dropped, wherever that happens (e.g. on a background writer
+ * thread), and the next call to GetRows() reuses them instead of allocating
+ * new memory. Each buffer keeps the largest size it has been asked for.
+ * Rows that outlive the pool are simply deleted.
+ */
+class I3TableRowPool : public boost::enable_shared_from_this<I3TableRowPool> {
+    public:
+        // keep at most maxSize released rows around
+        I3TableRowPool(I3TableRowDescriptionConstPtr description, size_t maxSize=8);
+        ~I3TableRowPool();
+
+        // get nrows zeroed rows
+        I3TableRowPtr GetRows(size_t nrows);
+
+        // number of released rows waiting to be reused
+        size_t size() const;
+
+    private:
+        I3TableRowPool();
+        I3TableRowPool(const I3TableRowPool&);
+
+        struct Recycler;
+        void Release(I3TableRow* rows);
+
+        I3TableRowDescriptionConstPtr description_;
+        size_t maxSize_;
+        std::vector<I3TableRow*> free_;
+        mutable std::mutex mutex_;
+
+    SET_LOGGER("I3TableRowPool");
+};
+
+I3_POINTER_TYPEDEFS( I3TableRowPool );
+
+#endif
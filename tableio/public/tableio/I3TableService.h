@@ -14,6 +14,12 @@
 
 #include "icetray/I3Logging.h"
 #include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
 
 #include "icetray/IcetrayFwd.h"
 
@@ -47,12 +53,32 @@ class I3TableService {
         virtual void SetIndexConverter(I3ConverterPtr gen);
         void Finish();
 
+        // Hand the table writes to a background thread that keeps up to
+        // queueLength batches of rows in flight, so that conversion of the
+        // next frames overlaps with compression and disk I/O. 0 writes on
+        // the calling thread. Tables are created and the file is closed on
+        // the calling thread once the queue has drained, so backends only
+        // ever see one thread at a time. Services whose tables are
+        // implemented in Python must write on the calling thread.
+        virtual void SetBackgroundWriting(size_t queueLength);
+        bool WritesInBackground() const;
+        // Run a write, either now or on the writer thread. Errors from the
+        // writer thread are rethrown by the next call.
+        void RunWrite(const std::function<void()>& write);
+        // Block until all queued writes are done
+        void WaitForWrites();
+
     protected:
         // to be overridden by implementation
         virtual I3TablePtr CreateTable(const std::string& tableName,
                                        I3TableRowDescriptionConstPtr description) = 0;
         virtual void CloseFile() = 0;
 
+        // Run the queued writes and stop the writer thread. Backends call
+        // this first thing in their destructors, while the file the tables
+        // write to is still open. Errors are logged, not thrown.
+        void JoinWriter();
+
         std::map<std::string, I3TablePtr> tables_;
 
 
@@ -60,6 +86,20 @@ class I3TableService {
         bool EventHeadersEqual(const I3EventHeader& header1,
                                const I3EventHeader& header2);
 
+        void WriterLoop();
+        void StopWriter();
+        void RethrowWriteError();
+
+        std::thread writer_;
+        std::mutex writeMutex_;
+        std::condition_variable writeQueued_;
+        std::condition_variable writeDone_;
+        std::deque<std::function<void()> > writeQueue_;
+        size_t maxQueueLength_;
+        bool writing_;
+        bool stopWriter_;
+        std::exception_ptr writeError_;
+
         std::vector<I3EventHeaderConstPtr> eventHeaderCache_;
         I3ConverterPtr ticConverter_;
         I3TableRowDescriptionConstPtr indexDescription_;
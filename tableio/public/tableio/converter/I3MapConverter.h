@@ -27,6 +27,8 @@
 #include <tableio/converter/container_converter_detail.h>
 #include <dataclasses/physics/I3Particle.h>
 
+#include <cstring>
+
 template <class converter_type,
           typename map_type = I3Map<OMKey, std::vector<typename converter_type::booked_type> >,
           typename frameobject_type = map_type >
@@ -35,25 +37,36 @@ class I3MapOMKeyVectorConverter
 {
 public:
   // Here, we explicitly create different converters for different kinds of arguments (to avoid boost.args errors about ambiguity)
+  // With variableLength, each DOM gets a single row, and each field of the
+  // booked type becomes a variable-length field with all elements of the DOM
+  I3MapOMKeyVectorConverter(bool bookGeometry, std::string bookToParticle, bool variableLength)
+    : bookGeometry_(bookGeometry),
+    bookToParticle_(bookToParticle),
+    variableLength_(variableLength)
+  {}
   // For both options
   I3MapOMKeyVectorConverter(bool bookGeometry, std::string bookToParticle)
     : bookGeometry_(bookGeometry),
-    bookToParticle_(bookToParticle)
+    bookToParticle_(bookToParticle),
+    variableLength_(false)
   {}
   // For just one
   I3MapOMKeyVectorConverter(std::string bookToParticle)
     : bookGeometry_(false),
-    bookToParticle_(bookToParticle)
+    bookToParticle_(bookToParticle),
+    variableLength_(false)
   {}
   // For just the other
   I3MapOMKeyVectorConverter(bool bookGeometry)
     : bookGeometry_(bookGeometry),
-    bookToParticle_("")
+    bookToParticle_(""),
+    variableLength_(false)
   {}
   // For neither
   I3MapOMKeyVectorConverter()
     : bookGeometry_(false),
-    bookToParticle_("")
+    bookToParticle_(""),
+    variableLength_(false)
   {}
 
 
@@ -64,7 +77,10 @@ protected:
     size_t nrows = 0;
     while (iter != m.end())
       {
-        nrows += iter->second.size();
+        if (variableLength_)
+          nrows += !iter->second.empty();
+        else
+          nrows += iter->second.size();
         ++iter;
       }
     return nrows;
@@ -89,13 +105,32 @@ protected:
       desc->AddField<double>("l_"+bookToParticle_, "m", "longitudinal distance of the DOM along track from vertex");
       desc->AddField<double>("r_"+bookToParticle_, "m", "distance from DOM to vertex");
     }
-    desc->AddField<tableio_size_t>("vector_index", "", "index in vector");
+    if (!variableLength_)
+      desc->AddField<tableio_size_t>("vector_index", "", "index in vector");
+
+    // the fields of the booked type, which are copied field by field into
+    // the variable-length fields
+    I3TableRowDescriptionPtr fields = desc;
+    if (variableLength_)
+      fields = I3TableRowDescriptionPtr(new I3TableRowDescription());
 
     if (m.size() && m.begin()->second.size()) {
-      detail::add_fields(converter_, desc, *(m.begin()->second.begin()));
+      detail::add_fields(converter_, fields, *(m.begin()->second.begin()));
     } else {
       typedef typename map_type::mapped_type::value_type value_type;
-      detail::add_fields(converter_, desc, value_type());
+      detail::add_fields(converter_, fields, value_type());
+    }
+
+    if (variableLength_) {
+      elements_ = fields;
+      firstElementField_ = desc->GetNumberOfFields();
+      for (size_t i = 0; i < fields->GetNumberOfFields(); i++) {
+        if (fields->GetFieldArrayLengths()[i] != 1)
+          log_fatal("The array field '%s' can't be booked with variableLength.",
+                    fields->GetFieldNames()[i].c_str());
+        desc->AddField(fields->GetFieldNames()[i], fields->GetFieldTypes()[i],
+                       fields->GetFieldUnits()[i], fields->GetFieldDocStrings()[i], 0);
+      }
     }
 
     return desc;
@@ -151,47 +186,43 @@ protected:
           }
         }
 
+        if (variableLength_) {
+          const size_t n = mapiter->second.size();
+          if (n == 0)
+            continue;
+          rows->SetCurrentRow(index);
+          FillKeyFields(key, omgeo, track, rows);
+
+          // convert the elements into rows of their own, then copy each
+          // field into the values of its variable-length field
+          if (!elementRows_)
+            elementRows_ = I3TableRowPtr(new I3TableRow(elements_, n));
+          else
+            elementRows_->reset(n);
+          size_t i = 0;
+          for (typename map_type::mapped_type::const_iterator veciter = mapiter->second.begin();
+               veciter != mapiter->second.end();
+               veciter++, i++) {
+            elementRows_->SetCurrentRow(i);
+            detail::fill_single_row(converter_, *veciter, elementRows_, this->currentFrame_);
+          }
+          for (size_t field = 0; field < elements_->GetNumberOfFields(); field++) {
+            const size_t size = elements_->GetFieldSizes()[field];
+            char* values = static_cast<char*>(rows->AddVariableLength(firstElementField_ + field, index, n));
+            for (size_t i = 0; i < n; i++)
+              memcpy(values + i*size, elementRows_->GetPointerToField(field, i), size);
+          }
+          index++;
+          continue;
+        }
+
         int vecindex = 0;
         for (typename map_type::mapped_type::const_iterator veciter = mapiter->second.begin();
              veciter != mapiter->second.end();
              veciter++)
           {
             rows->SetCurrentRow(index);
-            rows->Set<int32_t>("string", mapiter->first.GetString());
-            rows->Set<uint32_t>("om", mapiter->first.GetOM());
-            rows->Set<uint32_t>("pmt", static_cast<uint32_t>(mapiter->first.GetPMT()));
-            if (bookGeometry_) {
-              rows->Set<double>("x", omgeo.position.GetX());
-              rows->Set<double>("y", omgeo.position.GetY());
-              rows->Set<double>("z", omgeo.position.GetZ());
-            }
-            if (bookToParticle_ != "") {
-                if (track) {
-                  log_debug("%s is present, let's fill it!", bookToParticle_.c_str());
-                  // This code stolen/adapted from toprec "GetDistTOAxis" and "GetDistToPlane" -- maybe there's a faster way? in dataclasses?
-                  double deltax = omgeo.position.GetX() - track->GetPos().GetX();
-                  double deltay = omgeo.position.GetY() - track->GetPos().GetY();
-                  double deltaz = omgeo.position.GetZ() - track->GetPos().GetZ();
-                  double nx = track->GetDir().GetX();
-                  double ny = track->GetDir().GetY();
-                  double nz = track->GetDir().GetZ();
-
-                  double abs_x_sq = deltax*deltax + deltay*deltay + deltaz*deltaz;
-                  double n_prod_x = nx*deltax + ny*deltay + nz*deltaz;
-                  double rho = sqrt(abs_x_sq - n_prod_x * n_prod_x);
-                  log_debug("Computing: delta-x y x = %f %f %f", deltax, deltay, deltaz);
-                  log_debug("Writing: rho, l, r = %f %f %f", rho, n_prod_x, sqrt(abs_x_sq));
-
-                  rows->Set<double>("rho_"+bookToParticle_, rho);
-                  rows->Set<double>("l_"+bookToParticle_, n_prod_x);
-                  rows->Set<double>("r_"+bookToParticle_, sqrt(abs_x_sq));
-                } else {
-                  log_debug("%s missing, but on we go with zeros!", bookToParticle_.c_str());
-                  rows->Set<double>("rho_"+bookToParticle_, 0);
-                  rows->Set<double>("l_"+bookToParticle_, 0);
-                  rows->Set<double>("r_"+bookToParticle_, 0);
-                }
-            }
+            FillKeyFields(key, omgeo, track, rows);
             rows->Set<tableio_size_t>("vector_index", vecindex);
 
             detail::fill_single_row(converter_, *veciter, rows, this->currentFrame_);
@@ -210,9 +241,55 @@ protected:
   }
 
 private:
+  void FillKeyFields(const OMKey& key, const I3OMGeo& omgeo, I3ParticleConstPtr track,
+                     I3TableRowPtr rows)
+  {
+    rows->Set<int32_t>("string", key.GetString());
+    rows->Set<uint32_t>("om", key.GetOM());
+    rows->Set<uint32_t>("pmt", static_cast<uint32_t>(key.GetPMT()));
+    if (bookGeometry_) {
+      rows->Set<double>("x", omgeo.position.GetX());
+      rows->Set<double>("y", omgeo.position.GetY());
+      rows->Set<double>("z", omgeo.position.GetZ());
+    }
+    if (bookToParticle_ != "") {
+        if (track) {
+          log_debug("%s is present, let's fill it!", bookToParticle_.c_str());
+          // This code stolen/adapted from toprec "GetDistTOAxis" and "GetDistToPlane" -- maybe there's a faster way? in dataclasses?
+          double deltax = omgeo.position.GetX() - track->GetPos().GetX();
+          double deltay = omgeo.position.GetY() - track->GetPos().GetY();
+          double deltaz = omgeo.position.GetZ() - track->GetPos().GetZ();
+          double nx = track->GetDir().GetX();
+          double ny = track->GetDir().GetY();
+          double nz = track->GetDir().GetZ();
+
+          double abs_x_sq = deltax*deltax + deltay*deltay + deltaz*deltaz;
+          double n_prod_x = nx*deltax + ny*deltay + nz*deltaz;
+          double rho = sqrt(abs_x_sq - n_prod_x * n_prod_x);
+          log_debug("Computing: delta-x y x = %f %f %f", deltax, deltay, deltaz);
+          log_debug("Writing: rho, l, r = %f %f %f", rho, n_prod_x, sqrt(abs_x_sq));
+
+          rows->Set<double>("rho_"+bookToParticle_, rho);
+          rows->Set<double>("l_"+bookToParticle_, n_prod_x);
+          rows->Set<double>("r_"+bookToParticle_, sqrt(abs_x_sq));
+        } else {
+          log_debug("%s missing, but on we go with zeros!", bookToParticle_.c_str());
+          rows->Set<double>("rho_"+bookToParticle_, 0);
+          rows->Set<double>("l_"+bookToParticle_, 0);
+          rows->Set<double>("r_"+bookToParticle_, 0);
+        }
+    }
+  }
+
   bool bookGeometry_;
   std::string bookToParticle_;
+  bool variableLength_;
   converter_type converter_;
+  // with variableLength, the description of the booked type and where its
+  // fields start, and zeroed rows to convert the elements of a DOM into
+  I3TableRowDescriptionPtr elements_;
+  size_t firstElementField_;
+  I3TableRowPtr elementRows_;
 };
 
 
@@ -36,6 +36,12 @@ class I3TableWriter(I3ConditionalModule):
         self.AddParameter('BookEverything','Book absolutely everything in the frame, \
 using the default converters. This has the tendency to produce very, very large files, \
 and is almost certainly not what you actually want to do.', False)
+        self.AddParameter('BackgroundWriteQueue','Write tables on a background thread \
+that keeps up to this many batches of rows in flight, so that conversion overlaps with \
+compression and disk I/O. 0 writes on the tray thread.', 0)
+        self.AddParameter('BatchSize','Convert the objects of this many physics frames \
+together, with one call to each converter. Python converters that define \
+FillColumns() then cross into Python once per batch instead of once per object.', 1)
 
     def _get_tableservice(self):
         """Get the table service (passed v3-style as a python object)"""
@@ -121,6 +127,9 @@ and is almost certainly not what you actually want to do.', False)
 
     def Configure(self):
         self._get_tableservice()
+        queue = self.GetParameter('BackgroundWriteQueue')
+        if queue:
+            self.table_service.SetBackgroundWriting(queue)
 
         streams = vector_string()
         streams.extend(self.GetParameter('SubEventStreams'))
@@ -180,6 +189,7 @@ $I3_BUILD/doc/projects/tableio/howto.html .
             converter_list.append(I3ConverterMill(converter))
 
         self.writer = I3TableWriterWorker(self.table_service, converter_list, streams)
+        self.writer.set_batch_size(self.GetParameter('BatchSize'))
         tablespec = I3TableWriterWorker.TableSpec
         typespec = I3TableWriterWorker.TypeSpec
 
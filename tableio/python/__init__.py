@@ -48,11 +48,20 @@ if I3_USE_HDF5:
 
     @icetray.traysegment_inherit(I3TableWriter,
         removeopts=('TableService',))
-    def I3HDFWriter(tray, name, Output=None, CompressionLevel=6, **kwargs):
+    def I3HDFWriter(tray, name, Output=None, CompressionLevel=6,
+                    CompressionFilter="deflate", ChunkBytes=0, ChunkCacheBytes=0,
+                    CompressionThreads=0, **kwargs):
         """Tabulate data to an HDF5 file.
 
         :param Output: Path to output file
         :param CompressionLevel: gzip compression to apply to each table
+        :param CompressionFilter: "deflate", or "lz4" or "zstd" if the HDF5
+                                  filter plugins are installed
+        :param ChunkBytes: size of the chunks tables are written in (0 for 64 kB)
+        :param ChunkCacheBytes: size of the chunk cache of each table (0 for
+                                the HDF5 default)
+        :param CompressionThreads: compress deflate chunks on this many threads
+                                   and write them directly (0 leaves it to HDF5)
         """
 
         if Output is None:
@@ -74,7 +83,9 @@ if I3_USE_HDF5:
             stager = tray.context['I3FileStager']
             Output = stager.GetWriteablePath(Output)
 
-        tabler = I3HDFTableService(Output, CompressionLevel)
+        tabler = I3HDFTableService(Output, CompressionLevel, 'w',
+                                   CompressionFilter, ChunkBytes,
+                                   ChunkCacheBytes, CompressionThreads)
         tray.AddModule(I3TableWriter, name, TableService=tabler,
             **kwargs)
 
@@ -114,16 +125,17 @@ if I3_USE_SQLITE3:
 
     @icetray.traysegment_inherit(I3TableWriter,
         removeopts=('TableService',))
-    def I3SQLiteWriter(tray, name, path=None, **kwargs):
+    def I3SQLiteWriter(tray, name, path=None, rows_per_transaction=1000000, **kwargs):
         """Tabulate data to an SQL database.
 
         :param path: Path to output database file
+        :param rows_per_transaction: Commit every this many rows (0: only at the end)
         """
 
         if path is None:
             raise ValueError("You must supply an output database path!")
 
-        tabler = I3SQLiteTableService(path)
+        tabler = I3SQLiteTableService(path, rows_per_transaction)
         tray.AddModule(I3TableWriter, name, TableService=tabler,
             **kwargs)
 
@@ -132,17 +144,21 @@ if I3_USE_ARROW:
 
     @icetray.traysegment_inherit(I3TableWriter,
         removeopts=('TableService',))
-    def I3ParquetWriter(tray, name, folder_path=None, compression="uncompressed", **kwargs):
+    def I3ParquetWriter(tray, name, folder_path=None, compression="uncompressed",
+                        row_group_size=100000, row_group_bytes=64 << 20, **kwargs):
         """Tabulate data to a parquet file.
 
         :param folder_path: Path to output folder
         :param compression: Compression type
+        :param row_group_size: Write a row group every this many rows (0: no limit)
+        :param row_group_bytes: Write a row group every this many bytes (0: no limit)
         """
 
         if folder_path is None:
             raise ValueError("You must supply an output folder path!")
 
-        tabler = I3ParquetTableService(folder_path, compression)
+        tabler = I3ParquetTableService(folder_path, compression,
+                                       row_group_size, row_group_bytes)
         tray.AddModule(I3TableWriter, name, TableService=tabler,
             **kwargs)
 
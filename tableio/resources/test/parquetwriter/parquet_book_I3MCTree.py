@@ -27,7 +27,9 @@ if os.path.isdir(out_folder):
     shutil.rmtree(out_folder)
 print(f"Writing test-parquet-files to {out_folder} ...")
 
-writer = I3ParquetTableService(folder_path = out_folder, compression = "gzip")
+# small row groups, so that several are flushed while booking
+writer = I3ParquetTableService(folder_path = out_folder, compression = "gzip",
+                               row_group_size = 100)
 tray.AddModule(I3TableWriter,
                "writer",
                TableService = writer,
@@ -38,6 +40,16 @@ tray.AddModule(I3TableWriter,
 tray.Execute()
 tray.Finish()
 
+try:
+    import pyarrow.parquet as pq
+except ImportError:
+    pq = None
+if pq is not None:
+    meta = pq.ParquetFile(os.path.join(out_folder, "I3MCTree.parquet.gz")).metadata
+    assert meta.num_rows > 100
+    assert meta.num_row_groups > 1, "rows are written in several row groups"
+    assert meta.row_group(0).column(0).statistics is not None
+
 shutil.rmtree(out_folder)
 
 
@@ -56,6 +56,7 @@ class I3PythonConverterTest(unittest.TestCase):
         for t,code in self.types.items():
             desc.add_field(t,code,'','')
             desc.add_field('%s_vec'%t,code,'','',128)
+        desc.add_field('double_vlen',self.types['double'],'','',0)
 
         desc.add_field('trigger_type',tableio.I3Datatype(dataclasses.I3DOMLaunch.TriggerType),'','')
 
@@ -128,6 +129,16 @@ class I3PythonConverterTest(unittest.TestCase):
         got = self.rows[field]
         for a,b in zip(vec,got):
             self.assertAlmostEqual(a,b)
+    def testVariableLength(self):
+        field = 'double_vlen'
+        self.assertEqual(self.rows[field], [])
+        for n in (5, 2):
+            self.rows[field] = array.array('d',range(n))
+            self.assertEqual(self.rows[field], list(range(n)))
+        vec = dataclasses.I3VectorDouble()
+        for r in range(200): vec.append(r)
+        self.rows[field] = vec
+        self.assertEqual(self.rows[field], list(vec))
 
 
 class DOMLaunchBookie(tableio.I3Converter):
@@ -246,6 +257,29 @@ class WaveformBookie(tableio.I3Converter):
         return rowno
 
 
+class DoubleBookie(tableio.I3Converter):
+    booked = dataclasses.I3Double
+    def CreateDescription(self,obj):
+        desc = tableio.I3TableRowDescription()
+        desc.add_field('value',tableio.types.Float64,'','')
+        return desc
+    def FillRows(self,obj,rows):
+        rows['value'] = obj.value
+        return 1
+
+
+class BatchedDoubleBookie(DoubleBookie):
+    batches = 0
+    kept = []
+    def FillColumns(self,objects,columns):
+        BatchedDoubleBookie.batches += 1
+        self.columns = columns
+        values = columns['value']
+        values[:] = [obj.value for obj in objects]
+        BatchedDoubleBookie.kept.append(values)
+        return len(objects)
+
+
 try:
     from icecube.tableio import I3HDFTableService
     have_hdf = True
@@ -314,6 +348,102 @@ if have_hdf:
 
                 self.tray.Execute(1)
 
+    try:
+        import h5py
+        have_h5py = True
+    except ImportError:
+        have_h5py = False
+    if have_numpy and have_h5py:
+        class BatchedConversionTest(unittest.TestCase):
+            """FillColumns gets whole batches and writes the same table as FillRows"""
+            def book(self,bookie,batch_size):
+                from icecube.tableio import I3TableWriter
+                from icecube.icetray import I3Tray
+                import tempfile
+                tray = I3Tray()
+                tray.AddModule("I3InfiniteSource","streams", Stream=icetray.I3Frame.Physics)
+                counter = [0]
+                def fill(frame):
+                    header = dataclasses.I3EventHeader()
+                    header.run_id = 1
+                    header.event_id = counter[0]
+                    header.sub_event_stream = 'in_ice'
+                    frame['I3EventHeader'] = header
+                    # leave some out, so that the table is padded
+                    if counter[0] % 3:
+                        frame['Value'] = dataclasses.I3Double(0.5*counter[0])
+                    counter[0] += 1
+                tray.Add(fill, Streams=[icetray.I3Frame.Physics])
+                output = tempfile.NamedTemporaryFile(suffix='.hdf5')
+                tray.AddModule(I3TableWriter,'scribe',
+                    tableservice = I3HDFTableService(output.name),
+                    keys = {'Value': bookie},
+                    subeventstreams = ['in_ice'],
+                    batchsize = batch_size,
+                    )
+                tray.Execute(20)
+                with h5py.File(output.name,'r') as hdf:
+                    rows = hdf['Value'][:]
+                output.close()
+                return [(int(r['Event']),bool(r['exists']),float(r['value'])) for r in rows]
+
+            def testSameRows(self):
+                expected = self.book(DoubleBookie(),1)
+                got = self.book(BatchedDoubleBookie(),7)
+                self.assertEqual(len(expected), 20)
+                self.assertEqual(expected, got)
+                self.assertEqual(BatchedDoubleBookie.batches, 3)
+
+            def testArraysOutliveTheCall(self):
+                bookie = BatchedDoubleBookie()
+                self.book(bookie,7)
+                kept = BatchedDoubleBookie.kept[-1]
+                self.assertEqual(kept[-1], 0.5*19, "the last batch is still there")
+                self.assertFalse(kept.flags.writeable)
+                with self.assertRaises(RuntimeError):
+                    bookie.columns['value']
+
+        class VariableLengthTest(unittest.TestCase):
+            """Waveforms of any length are booked whole in a variable-length field"""
+            def testWaveforms(self):
+                from icecube.tableio import I3TableWriter
+                from icecube.icetray import I3Tray
+                import tempfile
+                tray = I3Tray()
+                tray.AddModule("I3InfiniteSource","streams", Stream=icetray.I3Frame.Physics)
+                counter = [0]
+                def fill(frame):
+                    header = dataclasses.I3EventHeader()
+                    header.event_id = counter[0]
+                    header.sub_event_stream = 'in_ice'
+                    frame['I3EventHeader'] = header
+                    waveforms = dataclasses.I3WaveformSeriesMap()
+                    for om in range(1, 4):
+                        wf = dataclasses.I3Waveform()
+                        wf.waveform.extend([float(om)]*(counter[0] + om))
+                        series = dataclasses.I3WaveformSeries()
+                        series.append(wf)
+                        waveforms[icetray.OMKey(1,om)] = series
+                    frame['Waveforms'] = waveforms
+                    counter[0] += 1
+                tray.Add(fill, Streams=[icetray.I3Frame.Physics])
+                output = tempfile.NamedTemporaryFile(suffix='.hdf5')
+                converter = dataclasses.converters.I3WaveformSeriesMapConverter(variableLength=True)
+                tray.AddModule(I3TableWriter,'scribe',
+                    tableservice = I3HDFTableService(output.name),
+                    keys = {'Waveforms': converter},
+                    subeventstreams = ['in_ice'],
+                    )
+                tray.Execute(4)
+                with h5py.File(output.name,'r') as hdf:
+                    rows = hdf['Waveforms'][:]
+                output.close()
+                self.assertEqual(len(rows), 12)
+                for r in rows:
+                    self.assertEqual(len(r['wf']), r['Event'] + r['om'])
+                    self.assertEqual(len(r['wf']), r['nbins'])
+                    self.assertTrue(numpy.all(r['wf'] == r['om']/icetray.I3Units.mV))
+
 def test(fname='/Users/jakob/Documents/IceCube/nugen_nue_ic80_dc6.001568.000000.hits.001.1881140.domsim.001.2028732.i3.gz'):
     f = dataio.I3File(fname)
     fr = f.pop_physics()